@@ -138,6 +138,7 @@ SOURCES += \
     parser/Nodes.cpp \
     parser/ParserArena.cpp \
     parser/Parser.cpp \
+    parser/SourceProvider.cpp \
     parser/SourceProviderCache.cpp \
     profiler/Profile.cpp \
     profiler/ProfileGenerator.cpp \
@@ -232,10 +233,13 @@ SOURCES += \
     yarr/YarrJIT.cpp \
     instrumentation/jscexecutionlistener.cpp \
     symbolic/symbolicinterpreter.cpp \
+    symbolic/symbolicimmediatepool.cpp \
     symbolic/native/nativelookup.cpp \
     symbolic/native/nativefunction.cpp \
     symbolic/native/natives.cpp \
     instrumentation/bytecodeinfo.cpp \
+    instrumentation/bytecodebuffer.cpp \
+    symbolic/expression/expressionarena.cpp \
     symbolic/expression/symbolicinteger.cpp \
     symbolic/expression/constantinteger.cpp \
     symbolic/expression/integermaxmin.cpp \
@@ -295,11 +299,13 @@ lessThan(QT_GCC_MAJOR_VERSION, 5) {
 HEADERS += \
     instrumentation/jscexecutionlistener.h \
     symbolic/symbolicinterpreter.h \
+    symbolic/symbolicimmediatepool.h \
     symbolic/native/nativelookup.h \
     symbolic/native/nativefunction.h \
     symbolic/native/natives.h \
     symbolic/native/nativefunction.h \
     instrumentation/bytecodeinfo.h \
+    instrumentation/bytecodebuffer.h \
     symbolic/expression/expression.h \
     symbolic/expression/integerexpression.h \
     symbolic/expression/symbolicinteger.h \
@@ -324,6 +330,7 @@ HEADERS += \
     symbolic/expression/stringreplace.h \
     symbolic/expression/stringregexreplace.h \
     symbolic/expression/symbolicsource.h \
+    symbolic/expression/expressionarena.h \
     symbolic/expression/stringlength.h \
     symbolic/expression/stringcharat.h \
     symbolic/expression/stringregexsubmatch.h \
@@ -48,6 +48,10 @@
 #include <stdio.h>
 #include <wtf/StringExtras.h>
 
+#ifdef ARTEMIS
+#include "instrumentation/bytecodebuffer.h"
+#endif
+
 #if ENABLE(DFG_JIT)
 #include "DFGOperations.h"
 #endif
@@ -1496,6 +1500,12 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, CodeType codeType, JSGlo
 
 CodeBlock::~CodeBlock()
 {
+#ifdef ARTEMIS
+    // Pending bytecode records may point to this code block, resolve them while it is still alive.
+    if (!jscinst::bytecode_buffer.isEmpty())
+        jscinst::bytecode_buffer.flush();
+#endif
+
 #if ENABLE(DFG_JIT)
     // Remove myself from the set of DFG code blocks. Note that I may not be in this set
     // (because I'm not a DFG code block), in which case this is a no-op anyway.
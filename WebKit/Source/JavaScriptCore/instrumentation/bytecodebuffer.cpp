@@ -0,0 +1,50 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef ARTEMIS
+
+#include "jscexecutionlistener.h"
+
+#include "bytecodebuffer.h"
+
+namespace jscinst
+{
+
+BytecodeBuffer::BytecodeBuffer() :
+    m_size(0),
+    m_flushing(false)
+{
+}
+
+void BytecodeBuffer::flush()
+{
+    // The listener must not execute JavaScript, but guard against a code block being destroyed while
+    // the current batch is being resolved, which would otherwise drain the same records twice.
+    if (m_size == 0 || m_flushing) {
+        return;
+    }
+
+    m_flushing = true;
+    get_jsc_listener()->javascript_bytecodes_executed(m_records, m_size);
+    m_size = 0;
+    m_flushing = false;
+}
+
+BytecodeBuffer bytecode_buffer;
+
+}
+
+#endif
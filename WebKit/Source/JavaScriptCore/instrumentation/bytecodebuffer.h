@@ -0,0 +1,89 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BYTECODEBUFFER_H
+#define BYTECODEBUFFER_H
+
+#ifdef ARTEMIS
+
+#include <stddef.h>
+
+namespace JSC {
+    class CodeBlock;
+}
+
+namespace jscinst
+{
+
+/**
+ * A single executed bytecode as recorded by the interpreter loop.
+ *
+ * Records are plain data and are only resolved (line numbers, source ranges,
+ * source registry lookups) when the buffer is drained.
+ */
+struct BytecodeRecord
+{
+    JSC::CodeBlock* codeBlock;
+    unsigned bytecodeOffset;
+    bool isSymbolic;
+};
+
+/**
+ * Fixed size buffer of executed bytecodes.
+ *
+ * The interpreter appends one record per executed instruction without allocating. The buffer is drained
+ * into the registered JSCExecutionListener in batches, either when it is full, when a code block referenced
+ * by a pending record is about to be destroyed, or explicitly at event and handler boundaries.
+ */
+class BytecodeBuffer
+{
+
+public:
+    static const size_t CAPACITY = 8192;
+
+    BytecodeBuffer();
+
+    inline void append(JSC::CodeBlock* codeBlock, unsigned bytecodeOffset, bool isSymbolic)
+    {
+        BytecodeRecord& record = m_records[m_size++];
+        record.codeBlock = codeBlock;
+        record.bytecodeOffset = bytecodeOffset;
+        record.isSymbolic = isSymbolic;
+
+        if (m_size == CAPACITY) {
+            flush();
+        }
+    }
+
+    inline bool isEmpty() const
+    {
+        return m_size == 0;
+    }
+
+    void flush();
+
+private:
+    BytecodeRecord m_records[CAPACITY];
+    size_t m_size;
+    bool m_flushing;
+};
+
+extern BytecodeBuffer bytecode_buffer;
+
+}
+
+#endif
+#endif // BYTECODEBUFFER_H
@@ -26,9 +26,10 @@ using namespace std;
 
 namespace jscinst {
 
-JSCExecutionListener::JSCExecutionListener() :
-    m_propertyAccessInstrumentationEnabled(false),
-    m_constantStringInstrumentationEnabled(false)
+unsigned enabled_instrumentation = BYTECODE_COVERAGE;
+double virtual_time_offset = 0;
+
+JSCExecutionListener::JSCExecutionListener()
 {
 }
 
@@ -36,8 +37,8 @@ void JSCExecutionListener::javascript_eval_call(const char* eval_string) {
     qWarning()  << "Warning: Default listener for javascript_eval_call was invoked, args: " << eval_string << endl;
 }
 
-void JSCExecutionListener::javascript_bytecode_executed(JSC::Interpreter*, JSC::CodeBlock*, JSC::Instruction*, const JSC::BytecodeInfo&) {
-    qWarning()  << "Warning: Default listener for javascript_bytecode_executed was invoked " << endl;
+void JSCExecutionListener::javascript_bytecodes_executed(const BytecodeRecord*, size_t) {
+    qWarning()  << "Warning: Default listener for javascript_bytecodes_executed was invoked " << endl;
     //exit(1);
 }
 
@@ -55,13 +56,18 @@ void JSCExecutionListener::javascript_symbolic_field_read(std::string variable,
     qWarning() << "Warning: Default listener for javascript_symbolic_field_read was invoked." << endl;
 }
 
-void JSCExecutionListener::javascript_property_read(std::string, JSC::ExecState*)
+void JSCExecutionListener::javascript_source_provider_destroyed(JSC::SourceProvider*)
+{
+    // Source providers are destroyed all the time, nothing to warn about
+}
+
+void JSCExecutionListener::javascript_property_read(WTF::StringImpl*, JSC::ExecState*)
 {
     qWarning()  << "Warning: Default listener for javascript_property_read was invoked " << endl;
     //exit(1);
 }
 
-void JSCExecutionListener::javascript_property_written(std::string, JSC::ExecState*)
+void JSCExecutionListener::javascript_property_written(WTF::StringImpl*, JSC::ExecState*)
 {
     qWarning()  << "Warning: Default listener for javascript_property_written was invoked " << endl;
     //exit(1);
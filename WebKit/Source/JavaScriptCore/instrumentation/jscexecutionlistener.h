@@ -21,60 +21,106 @@
 #include "JavaScriptCore/symbolic/expr.h"
 
 #include "bytecodeinfo.h"
+#include "bytecodebuffer.h"
 
 namespace JSC {
     class CodeBlock;
     class Instruction;
     class ExecState;
     class Interpreter;
+    class SourceProvider;
+}
+
+namespace WTF {
+    class StringImpl;
 }
 
 
 namespace jscinst {
 
+/**
+ * Instrumentation hooks of the interpreter loop which can be turned off.
+ *
+ * ARTEMIS_INSTRUMENTATION_FEATURES selects the features compiled into the interpreter, the hooks of the remaining
+ * features are removed by the compiler. Of the compiled features, the ones in use are selected per session through
+ * the registered listener. Checking a feature is a load of a global, not a call into the listener.
+ */
+enum InstrumentationFeature {
+    BYTECODE_COVERAGE = 1 << 0,
+    PROPERTY_ACCESS = 1 << 1,
+    CONSTANT_STRINGS = 1 << 2
+};
+
+#ifndef ARTEMIS_INSTRUMENTATION_FEATURES
+#define ARTEMIS_INSTRUMENTATION_FEATURES (jscinst::BYTECODE_COVERAGE | jscinst::PROPERTY_ACCESS | jscinst::CONSTANT_STRINGS)
+#endif
+
+extern unsigned enabled_instrumentation;
+
+/**
+ * Milliseconds added to the wall clock by Date under virtual time, such that scripts comparing Date.now() see the
+ * time the virtual clock skipped when firing a timer ahead of time. Zero unless virtual time is enabled.
+ */
+extern double virtual_time_offset;
+
+inline bool isInstrumentationEnabled(InstrumentationFeature feature)
+{
+    return (ARTEMIS_INSTRUMENTATION_FEATURES & feature) && (enabled_instrumentation & feature);
+}
+
 class JSCExecutionListener
 {
 
 public:
     JSCExecutionListener();
     virtual void javascript_eval_call(const char * eval_string); //__attribute__((noreturn));
-    virtual void javascript_bytecode_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, JSC::Instruction* inst, const JSC::BytecodeInfo&); //__attribute__((noreturn));
+    virtual void javascript_bytecodes_executed(const BytecodeRecord* records, size_t count); //__attribute__((noreturn));
     virtual void javascript_branch_executed(bool jump, Symbolic::Expression* condition, JSC::ExecState*, const JSC::Instruction*, const JSC::BytecodeInfo&);
     virtual void javascriptConstantStringEncountered(std::string constant); //__attribute__((noreturn));
     virtual void javascript_symbolic_field_read(std::string variable, bool isSymbolic);
 
+    // Called when a source provider is destroyed, listeners keyed on the provider pointer must forget it.
+    virtual void javascript_source_provider_destroyed(JSC::SourceProvider* sourceProvider);
+
     /* Property Access Instrumentation */
 public:
-    virtual void javascript_property_read(std::string propertyName, JSC::ExecState*); //__attribute__((noreturn));
-    virtual void javascript_property_written(std::string propertyName, JSC::ExecState*); //__attribute__((noreturn));
+    // The name is only valid during the call; listeners which keep it must take a reference or copy it.
+    virtual void javascript_property_read(WTF::StringImpl* propertyName, JSC::ExecState*); //__attribute__((noreturn));
+    virtual void javascript_property_written(WTF::StringImpl* propertyName, JSC::ExecState*); //__attribute__((noreturn));
 
     inline bool isPropertyAccessInstrumentationEnabled()
     {
-        return m_propertyAccessInstrumentationEnabled;
+        return isInstrumentationEnabled(PROPERTY_ACCESS);
     }
 
     inline void enablePropertyAccessInstrumentation()
     {
-        m_propertyAccessInstrumentationEnabled = true;
+        enabled_instrumentation |= PROPERTY_ACCESS;
     }
 
-private:
-    bool m_propertyAccessInstrumentationEnabled;
-
     /* Constant String Instrumentation */
 public:
     inline bool isConstantStringInstrumentationEnabled()
     {
-        return m_constantStringInstrumentationEnabled;
+        return isInstrumentationEnabled(CONSTANT_STRINGS);
     }
 
     inline void enableConstantStringInstrumentation()
     {
-        m_constantStringInstrumentationEnabled = true;
+        enabled_instrumentation |= CONSTANT_STRINGS;
     }
 
-private:
-    bool m_constantStringInstrumentationEnabled;
+    /* Bytecode Coverage Instrumentation, enabled by default */
+public:
+    inline bool isBytecodeCoverageInstrumentationEnabled()
+    {
+        return isInstrumentationEnabled(BYTECODE_COVERAGE);
+    }
+
+    inline void disableBytecodeCoverageInstrumentation()
+    {
+        enabled_instrumentation &= ~BYTECODE_COVERAGE;
+    }
 
 
 };
@@ -78,6 +78,7 @@
 #include "symbolic/native/nativefunction.h"
 #include "instrumentation/jscexecutionlistener.h"
 #include "instrumentation/bytecodeinfo.h"
+#include "instrumentation/bytecodebuffer.h"
 #endif
 
 #if ENABLE(JIT)
@@ -123,8 +124,8 @@ NEVER_INLINE bool Interpreter::resolve(CallFrame* callFrame, Instruction* vPC, J
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -169,8 +170,8 @@ NEVER_INLINE bool Interpreter::resolveSkip(CallFrame* callFrame, Instruction* vP
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -202,8 +203,8 @@ NEVER_INLINE bool Interpreter::resolveGlobal(CallFrame* callFrame, Instruction*
     int offset = vPC[4].u.operand;
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -246,8 +247,8 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
     int skip = vPC[5].u.operand;
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -325,8 +326,8 @@ NEVER_INLINE void Interpreter::resolveBase(CallFrame* callFrame, Instruction* vP
     Identifier ident = callFrame->codeBlock()->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -392,8 +393,8 @@ NEVER_INLINE bool Interpreter::resolveThisAndProperty(CallFrame* callFrame, Inst
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+    if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -462,43 +463,59 @@ ALWAYS_INLINE void Interpreter::checkForConstantString(CallFrame* callFrame, con
     }
 }
 
-ALWAYS_INLINE void Interpreter::readProperty(CallFrame* callFrame, std::string identifier)
+ALWAYS_INLINE void Interpreter::readProperty(CallFrame* callFrame, StringImpl* identifier)
 {
     jscinst::get_jsc_listener()->javascript_property_read(identifier, callFrame);
 }
 
 ALWAYS_INLINE void Interpreter::readProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index)
 {
-    SymbolTable::const_iterator it = symbolTable.begin();
-    SymbolTable::const_iterator end = symbolTable.end();
-    for (; it != end; ++it) {
-        if (it->second.getIndex() == index) {
-            //printf("READ %s\n", UString(it->first).ascii().data());
-            jscinst::get_jsc_listener()->javascript_property_read(UString(it->first).ascii().data(), callFrame);
-            return;
-        }
+    StringImpl* identifier = globalVariableName(symbolTable, index);
+    if (identifier) {
+        jscinst::get_jsc_listener()->javascript_property_read(identifier, callFrame);
     }
-
 }
 
-ALWAYS_INLINE void Interpreter::writeProperty(CallFrame* callFrame, std::string identifier)
+ALWAYS_INLINE void Interpreter::writeProperty(CallFrame* callFrame, StringImpl* identifier)
 {
-    //printf("WRITE %s\n", identifier.c_str());
     jscinst::get_jsc_listener()->javascript_property_written(identifier, callFrame);
 }
 
 ALWAYS_INLINE void Interpreter::writeProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index)
 {
+    StringImpl* identifier = globalVariableName(symbolTable, index);
+    if (identifier) {
+        jscinst::get_jsc_listener()->javascript_property_written(identifier, callFrame);
+    }
+}
+
+/*
+ * The symbol table maps names to indices, so finding the name of a global variable needs a scan of the table.
+ * The result is remembered for each (table, index) pair, and is checked with a (hashed) lookup of the name on later
+ * accesses, as the table may have been freed and its memory reused for another table since.
+ */
+ALWAYS_INLINE StringImpl* Interpreter::globalVariableName(const SymbolTable& symbolTable, int index)
+{
+    std::pair<const SymbolTable*, int> key(&symbolTable, index);
+
+    GlobalVariableNameMap::iterator cached = m_globalVariableNames.find(key);
+    if (cached != m_globalVariableNames.end()) {
+        SymbolTableEntry entry = symbolTable.get(cached->second.get());
+        if (!entry.isNull() && entry.getIndex() == index) {
+            return cached->second.get();
+        }
+    }
+
     SymbolTable::const_iterator it = symbolTable.begin();
     SymbolTable::const_iterator end = symbolTable.end();
     for (; it != end; ++it) {
         if (it->second.getIndex() == index) {
-            //printf("WRITE %s\n", UString(it->first).ascii().data());
-            jscinst::get_jsc_listener()->javascript_property_written(UString(it->first).ascii().data(), callFrame);
-            return;
+            m_globalVariableNames.set(key, it->first);
+            return it->first.get();
         }
     }
 
+    return 0;
 }
 
 #endif
@@ -2107,7 +2124,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
 #define ARTEMIS_BYTECODE_PRE oldCodeBlock = codeBlock; oldPC = vPC;
-#define ARTEMIS_BYTECODE_POST jscinst::get_jsc_listener()->javascript_bytecode_executed(this, oldCodeBlock, oldPC, bytecodeInfo); bytecodeInfo = bytecodeInfoPrestine;
+#define ARTEMIS_BYTECODE_POST \
+    if (jscinst::isInstrumentationEnabled(jscinst::BYTECODE_COVERAGE) && Interpreter::m_enableInstrumentations) { \
+        jscinst::bytecode_buffer.append(oldCodeBlock, oldPC - oldCodeBlock->instructions().begin(), bytecodeInfo.isSymbolic()); \
+    } \
+    bytecodeInfo = bytecodeInfoPrestine;
 #else
 #define ARTEMIS_BYTECODE_PRE
 #define ARTEMIS_BYTECODE_LISTEN
@@ -2235,7 +2256,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                                                        src1, Symbolic::EQUAL, src2,
                                                        callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::CONSTANT_STRINGS)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2296,7 +2317,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                                                        src1, Symbolic::NOT_EQUAL, src2,
                                                        callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::CONSTANT_STRINGS)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2353,7 +2374,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                                                        src1, Symbolic::STRICT_EQUAL, src2,
                                                        callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::CONSTANT_STRINGS)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2382,7 +2403,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
                                                        src1, Symbolic::NOT_STRICT_EQUAL, src2,
                                                        callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::CONSTANT_STRINGS)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -3204,7 +3225,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int index = vPC[2].u.operand;
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3224,7 +3245,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int value = vPC[2].u.operand;
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3270,7 +3291,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         ASSERT(callFrame->r(dst).jsValue());
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3313,7 +3334,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         scope->registerAt(index).set(*globalData, scope, callFrame->r(value).jsValue());
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3346,8 +3367,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -3409,8 +3430,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -3451,8 +3472,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3494,8 +3515,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3545,8 +3566,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3602,8 +3623,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3656,8 +3677,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3718,8 +3739,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3773,8 +3794,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3820,8 +3841,8 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -3854,8 +3875,8 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -3921,8 +3942,8 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -4036,8 +4057,8 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -4089,8 +4110,8 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[2].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -4153,8 +4174,8 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[2].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, codeBlock->identifier(property).impl());
 	}
 #endif
 
@@ -4202,8 +4223,8 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -4234,8 +4255,8 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-		readProperty(callFrame, ident.ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+		readProperty(callFrame, ident.impl());
 	}
 #endif
 
@@ -4263,8 +4284,8 @@ skip_id_custom_self:
         JSValue expectedSubscript = callFrame->r(expected).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-        readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+        readProperty(callFrame, subscript.toUString(callFrame).impl());
 	}
 #endif
 
@@ -4336,8 +4357,8 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-        readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+        readProperty(callFrame, subscript.toUString(callFrame).impl());
 	}
 #endif
 
@@ -4392,8 +4413,8 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-        readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+        readProperty(callFrame, subscript.toUString(callFrame).impl());
 	}
 #endif
 
@@ -4435,8 +4456,8 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
-        readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
+        if (jscinst::isInstrumentationEnabled(jscinst::PROPERTY_ACCESS)) {
+        readProperty(callFrame, subscript.toUString(callFrame).impl());
 	}
 #endif
 
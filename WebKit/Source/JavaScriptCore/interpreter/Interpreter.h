@@ -248,10 +248,11 @@ namespace JSC {
 
 #ifdef ARTEMIS
         ALWAYS_INLINE void checkForConstantString(CallFrame*, const JSValue&);
-        ALWAYS_INLINE void readProperty(CallFrame* callFrame, std::string propertyName);
+        ALWAYS_INLINE void readProperty(CallFrame* callFrame, StringImpl* propertyName);
         ALWAYS_INLINE void readProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index);
-        ALWAYS_INLINE void writeProperty(CallFrame* callFrame, std::string propertyName);
+        ALWAYS_INLINE void writeProperty(CallFrame* callFrame, StringImpl* propertyName);
         ALWAYS_INLINE void writeProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index);
+        ALWAYS_INLINE StringImpl* globalVariableName(const SymbolTable& symbolTable, int index);
 #endif
 	
 #if ENABLE(CLASSIC_INTERPRETER)
@@ -303,6 +304,12 @@ namespace JSC {
         bool m_initialized;
 #endif
         bool m_classicEnabled;
+
+#ifdef ARTEMIS
+        // (symbol table, index) => name of the global variable, see globalVariableName.
+        typedef HashMap<std::pair<const SymbolTable*, int>, RefPtr<StringImpl> > GlobalVariableNameMap;
+        GlobalVariableNameMap m_globalVariableNames;
+#endif
     };
 
     // This value must not be an object that would require this conversion (WebCore's global object).
@@ -49,11 +49,7 @@ namespace JSC {
         {
             turnOffVerifier();
         }
-        virtual ~SourceProvider()
-        {
-            if (m_cacheOwned)
-                delete m_cache;
-        }
+        JS_EXPORT_PRIVATE virtual ~SourceProvider();
 
         virtual UString getRange(int start, int end) const = 0;
         virtual const StringImpl* data() const = 0;
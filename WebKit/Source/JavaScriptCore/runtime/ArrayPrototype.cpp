@@ -1254,14 +1254,14 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
             JSValue e = getProperty(exec, thisObj, index);
             symbList.push_back(e.isSymbolic() ?
                                    (Symbolic::Expression*)e.asSymbolic() :
-                                   (Symbolic::Expression*)new Symbolic::ConstantObject(e.toObject(exec)->getArtemisDomIdentifier(exec)));
+                                   (Symbolic::Expression*)Symbolic::ConstantObject::create(e.toObject(exec)->getArtemisDomIdentifier(exec)));
         }
 
         Symbolic::Expression* symbElement = searchElement.isSymbolic() ?
                     (Symbolic::Expression*)searchElement.asSymbolic() :
-                    (Symbolic::Expression*)new Symbolic::ConstantObject(searchElement.toObject(exec)->getArtemisDomIdentifier(exec));
+                    (Symbolic::Expression*)Symbolic::ConstantObject::create(searchElement.toObject(exec)->getArtemisDomIdentifier(exec));
 
-        value.makeSymbolic(new Symbolic::ObjectArrayIndexOf(symbList, symbElement), exec->globalData());
+        value.makeSymbolic(Symbolic::ObjectArrayIndexOf::create(symbList, symbElement), exec->globalData());
     }
 #endif
 
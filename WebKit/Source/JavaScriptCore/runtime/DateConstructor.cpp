@@ -47,6 +47,10 @@ extern "C" time_t time(time_t* timer); // Provided by libce.
 #include <sys/timeb.h>
 #endif
 
+#ifdef ARTEMIS
+#include "instrumentation/jscexecutionlistener.h"
+#endif
+
 using namespace WTF;
 
 namespace JSC {
@@ -96,6 +100,15 @@ bool DateConstructor::getOwnPropertyDescriptor(JSObject* object, ExecState* exec
     return getStaticFunctionDescriptor<InternalFunction>(exec, ExecState::dateConstructorTable(exec), jsCast<DateConstructor*>(object), propertyName, descriptor);
 }
 
+static inline double currentDateTimeMS()
+{
+#ifdef ARTEMIS
+    return currentTimeMS() + jscinst::virtual_time_offset;
+#else
+    return currentTimeMS();
+#endif
+}
+
 // ECMA 15.9.3
 JSObject* constructDate(ExecState* exec, JSGlobalObject* globalObject, const ArgList& args)
 {
@@ -104,7 +117,7 @@ JSObject* constructDate(ExecState* exec, JSGlobalObject* globalObject, const Arg
     double value;
 
     if (numArgs == 0) // new Date() ECMA 15.9.3.3
-        value = jsCurrentTime();
+        value = floor(currentDateTimeMS());
     else if (numArgs == 1) {
         if (args.at(0).inherits(&DateInstance::s_info))
             value = asDateInstance(args.at(0))->internalNumber();
@@ -167,7 +180,7 @@ ConstructType DateConstructor::getConstructData(JSCell*, ConstructData& construc
 static EncodedJSValue JSC_HOST_CALL callDate(ExecState* exec)
 {
     GregorianDateTime ts;
-    msToGregorianDateTime(exec, currentTimeMS(), false, ts);
+    msToGregorianDateTime(exec, currentDateTimeMS(), false, ts);
     DateConversionBuffer date;
     DateConversionBuffer time;
     formatDate(ts, date);
@@ -188,7 +201,7 @@ static EncodedJSValue JSC_HOST_CALL dateParse(ExecState* exec)
 
 static EncodedJSValue JSC_HOST_CALL dateNow(ExecState*)
 {
-    return JSValue::encode(jsNumber(jsCurrentTime()));
+    return JSValue::encode(jsNumber(floor(currentDateTimeMS())));
 }
 
 static EncodedJSValue JSC_HOST_CALL dateUTC(ExecState* exec) 
@@ -505,7 +505,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncEval(ExecState* exec)
     JSValue x = exec->argument(0);
 
     if (x.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncEval", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncEval");
+        missingInstrumentation.add(1);
     }
 
     if (!x.isString())
@@ -561,7 +562,7 @@ EncodedJSValue JSC_HOST_CALL globalFuncParseInt(ExecState* exec)
 #ifdef ARTEMIS
     if (value.isSymbolic()) {
         JSValue v = jsNumber(parseInt(s, radixValue.toInt32(exec)));
-        v.makeSymbolic(new Symbolic::IntegerCoercion(value.asSymbolic()), exec->globalData());
+        v.makeSymbolic(Symbolic::IntegerCoercion::create(value.asSymbolic()), exec->globalData());
         return JSValue::encode(v);
     } else {
         return JSValue::encode(jsNumber(parseInt(s, radixValue.toInt32(exec))));
@@ -574,7 +575,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncParseInt(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncParseFloat(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncParseFloat", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncParseFloat");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(jsNumber(parseFloat(exec->argument(0).toString(exec)->value(exec))));
@@ -583,7 +585,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncParseFloat(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncIsNaN(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncIsNaN", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncIsNaN");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(jsBoolean(isnan(exec->argument(0).toNumber(exec))));
@@ -592,7 +595,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncIsNaN(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncIsFinite(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncIsFinite", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncIsFinite");
+        missingInstrumentation.add(1);
     }
 
     double n = exec->argument(0).toNumber(exec);
@@ -602,7 +606,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncIsFinite(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncDecodeURI(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncDecodeURI", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncDecodeURI");
+        missingInstrumentation.add(1);
     }
 
     static const char do_not_unescape_when_decoding_URI[] =
@@ -614,7 +619,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncDecodeURI(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncDecodeURIComponent(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncDecodeURIComponent", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncDecodeURIComponent");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(decode(exec, "", true));
@@ -623,7 +629,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncDecodeURIComponent(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncEncodeURI(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncEncodeURI", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncEncodeURI");
+        missingInstrumentation.add(1);
     }
 
     static const char do_not_escape_when_encoding_URI[] =
@@ -638,7 +645,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncEncodeURI(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncEncodeURIComponent(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncEncodeURIComponent", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncEncodeURIComponent");
+        missingInstrumentation.add(1);
     }
 
     static const char do_not_escape_when_encoding_URI_component[] =
@@ -653,7 +661,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncEncodeURIComponent(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncEscape(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncEscape", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncEscape");
+        missingInstrumentation.add(1);
     }
 
     static const char do_not_escape[] =
@@ -702,7 +711,8 @@ EncodedJSValue JSC_HOST_CALL globalFuncEscape(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL globalFuncUnescape(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::globalFuncUnescape", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::globalFuncUnescape");
+        missingInstrumentation.add(1);
     }
 
     UStringBuilder builder;
@@ -515,7 +515,7 @@ namespace JSC {
 #ifdef ARTEMIS
             if (m_symbolic != NULL) {
                 JSValue v = jsNumber(m_length);
-                v.makeSymbolic(new Symbolic::StringLength(m_symbolic), exec->globalData());
+                v.makeSymbolic(Symbolic::StringLength::create(m_symbolic), exec->globalData());
                 slot.setValue(v);
             } else {
                 slot.setValue(jsNumber(m_length));
@@ -35,6 +35,10 @@
 #include <wtf/MathExtras.h>
 #include <wtf/StringExtras.h>
 
+#ifdef ARTEMIS
+#include "JavaScriptCore/symbolic/symbolicimmediatepool.h"
+#endif
+
 namespace JSC {
 
 static const double D32 = 4294967296.0;
@@ -354,7 +358,7 @@ void JSValue::makeExtended() {
         return;
     }
 
-    SymbolicImmediate* symbolicImmediate = new SymbolicImmediate();
+    SymbolicImmediate* symbolicImmediate = Symbolic::SymbolicImmediatePool::pool()->allocate();
     symbolicImmediate->symbolic = NULL;
     symbolicImmediate->indirectSymbolic = false;
 
@@ -394,33 +398,33 @@ Symbolic::Expression* JSValue::asSymbolic() const
 
 
 Symbolic::IntegerExpression* JSValue::generateIntegerExpression(ExecState* exec){
-    return this->isSymbolic()?(Symbolic::IntegerExpression*)this->asSymbolic() : new Symbolic::ConstantInteger(this->toPrimitive(exec).asNumber());
+    return this->isSymbolic()?(Symbolic::IntegerExpression*)this->asSymbolic() : Symbolic::ConstantInteger::create(this->toPrimitive(exec).asNumber());
 }
 
 Symbolic::StringExpression* JSValue::generateStringExpression(ExecState* exec){
-    return this->isSymbolic()?(Symbolic::StringExpression*) this->asSymbolic(): new Symbolic::ConstantString(new std::string(this->toPrimitive(exec).toUString(exec).ascii().data()));
+    return this->isSymbolic()?(Symbolic::StringExpression*) this->asSymbolic(): Symbolic::ConstantString::create(std::string(this->toPrimitive(exec).toUString(exec).ascii().data()));
 }
 
 Symbolic::ObjectExpression* JSValue::generateObjectExpression(ExecState* exec){
-    return this->isSymbolic()?(Symbolic::ObjectExpression*) this->asSymbolic(): new Symbolic::ConstantObject(this->isUndefinedOrNull() ? 0 : getObject()->getArtemisDomIdentifier(exec));
+    return this->isSymbolic()?(Symbolic::ObjectExpression*) this->asSymbolic(): Symbolic::ConstantObject::create(this->isUndefinedOrNull() ? 0 : getObject()->getArtemisDomIdentifier(exec));
 }
 
 Symbolic::IntegerExpression* JSValue::generateIntegerCoercionExpression(ExecState* exec){
-    return this->isSymbolic() ? (Symbolic::IntegerExpression*)new Symbolic::IntegerCoercion(this->asSymbolic()) : new Symbolic::ConstantInteger(this->toPrimitive(exec).toNumber(exec));
+    return this->isSymbolic() ? (Symbolic::IntegerExpression*)Symbolic::IntegerCoercion::create(this->asSymbolic()) : Symbolic::ConstantInteger::create(this->toPrimitive(exec).toNumber(exec));
 }
 
 Symbolic::StringExpression* JSValue::generateStringCoercionExpression(ExecState* exec){
-    return this->isSymbolic() ? (Symbolic::StringExpression*)new Symbolic::StringCoercion(this->asSymbolic()) :
-                            (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(this->toPrimitive(exec, PreferString).toUString(exec).ascii().data()));
+    return this->isSymbolic() ? (Symbolic::StringExpression*)Symbolic::StringCoercion::create(this->asSymbolic()) :
+                            (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(this->toPrimitive(exec, PreferString).toUString(exec).ascii().data()));
 }
 
 Symbolic::BooleanExpression* JSValue::generateBooleanExpression(ExecState* exec){
-    return this->isSymbolic()?(Symbolic::BooleanExpression*) this->asSymbolic():new Symbolic::ConstantBoolean(this->toPrimitive(exec).toBoolean(exec));
+    return this->isSymbolic()?(Symbolic::BooleanExpression*) this->asSymbolic():Symbolic::ConstantBoolean::create(this->toPrimitive(exec).toBoolean(exec));
 }
 
 Symbolic::BooleanExpression* JSValue::generateBooleanCoercionExpression(ExecState* exec){
-    return this->isSymbolic() ? (Symbolic::BooleanExpression*)new Symbolic::BooleanCoercion(this->asSymbolic()) :
-                            (Symbolic::BooleanExpression*)new Symbolic::ConstantBoolean(this->toPrimitive(exec).toBoolean(exec));
+    return this->isSymbolic() ? (Symbolic::BooleanExpression*)Symbolic::BooleanCoercion::create(this->asSymbolic()) :
+                            (Symbolic::BooleanExpression*)Symbolic::ConstantBoolean::create(this->toPrimitive(exec).toBoolean(exec));
 }
 
 #endif
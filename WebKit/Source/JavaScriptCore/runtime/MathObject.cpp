@@ -124,7 +124,8 @@ bool MathObject::getOwnPropertyDescriptor(JSObject* object, ExecState* exec, con
 EncodedJSValue JSC_HOST_CALL mathProtoFuncAbs(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncAbs", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncAbs");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsNumber(fabs(exec->argument(0).toNumber(exec))));
 }
@@ -132,7 +133,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncAbs(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncACos(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncACos", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncACos");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(acos(exec->argument(0).toNumber(exec))));
 }
@@ -140,7 +142,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncACos(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncASin(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncASin", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncASin");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(asin(exec->argument(0).toNumber(exec))));
 }
@@ -148,7 +151,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncASin(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncATan(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncATan", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncATan");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(atan(exec->argument(0).toNumber(exec))));
 }
@@ -156,7 +160,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncATan(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncATan2(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic() || exec->argument(1).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncATan2", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncATan2");
+        missingInstrumentation.add(1);
     }
 
     double arg0 = exec->argument(0).toNumber(exec);
@@ -173,7 +178,7 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncCeil(ExecState* exec)
         if (origin.isNumber()) {
             v.makeSymbolic(origin.asSymbolic(), exec->globalData());
         } else {
-            v.makeSymbolic((Symbolic::IntegerExpression*)new Symbolic::IntegerCoercion(origin.asSymbolic()), exec->globalData());
+            v.makeSymbolic((Symbolic::IntegerExpression*)Symbolic::IntegerCoercion::create(origin.asSymbolic()), exec->globalData());
         }
     }
 
@@ -183,7 +188,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncCeil(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncCos(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncCos", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncCos");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(cos(exec->argument(0).toNumber(exec))));
 }
@@ -191,7 +197,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncCos(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncExp(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncExp", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncExp");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(exp(exec->argument(0).toNumber(exec))));
 }
@@ -205,7 +212,7 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncFloor(ExecState* exec)
         if (origin.isNumber()) {
             v.makeSymbolic(origin.asSymbolic(), exec->globalData());
         } else {
-            v.makeSymbolic((Symbolic::IntegerExpression*)new Symbolic::IntegerCoercion(origin.asSymbolic()), exec->globalData());
+            v.makeSymbolic((Symbolic::IntegerExpression*)Symbolic::IntegerCoercion::create(origin.asSymbolic()), exec->globalData());
         }
     }
 
@@ -215,7 +222,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncFloor(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncLog(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncLog", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncLog");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(log(exec->argument(0).toNumber(exec))));
 }
@@ -245,17 +253,17 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncMax(ExecState* exec)
             if (v.isNumber()) {
                 args.push_back(v.asSymbolic());
             } else {
-                args.push_back((Symbolic::IntegerExpression*)new Symbolic::IntegerCoercion(v.asSymbolic()));
+                args.push_back((Symbolic::IntegerExpression*)Symbolic::IntegerCoercion::create(v.asSymbolic()));
             }
         } else {
-            args.push_back(new Symbolic::ConstantInteger(val));
+            args.push_back(Symbolic::ConstantInteger::create(val));
         }
     }
 
     JSValue res = jsNumber(result);
 
     if (isSymbolic) {
-        res.makeSymbolic(new Symbolic::IntegerMaxMin(args, true), exec->globalData());
+        res.makeSymbolic(Symbolic::IntegerMaxMin::create(args, true), exec->globalData());
     }
     return JSValue::encode(res);
 }
@@ -285,17 +293,17 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncMin(ExecState* exec)
             if (v.isNumber()) {
                 args.push_back(v.asSymbolic());
             } else {
-                args.push_back((Symbolic::IntegerExpression*)new Symbolic::IntegerCoercion(v.asSymbolic()));
+                args.push_back((Symbolic::IntegerExpression*)Symbolic::IntegerCoercion::create(v.asSymbolic()));
             }
         } else {
-            args.push_back(new Symbolic::ConstantInteger(val));
+            args.push_back(Symbolic::ConstantInteger::create(val));
         }
     }
 
     JSValue res = jsNumber(result);
 
     if (isSymbolic) {
-        res.makeSymbolic(new Symbolic::IntegerMaxMin(args, false), exec->globalData());
+        res.makeSymbolic(Symbolic::IntegerMaxMin::create(args, false), exec->globalData());
     }
     return JSValue::encode(res);
 }
@@ -305,7 +313,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncPow(ExecState* exec)
     // ECMA 15.8.2.1.13
 
     if (exec->argument(0).isSymbolic() || exec->argument(1).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncPow", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncPow");
+        missingInstrumentation.add(1);
     }
 
     double arg = exec->argument(0).toNumber(exec);
@@ -320,15 +329,16 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncPow(ExecState* exec)
 
 EncodedJSValue JSC_HOST_CALL mathProtoFuncRandom(ExecState* exec)
 {
-    Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncRandom", 1);
-
+    static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncRandom");
+    missingInstrumentation.add(1);
     return JSValue::encode(jsDoubleNumber(exec->lexicalGlobalObject()->weakRandomNumber()));
 }
 
 EncodedJSValue JSC_HOST_CALL mathProtoFuncRound(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncRound", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncRound");
+        missingInstrumentation.add(1);
     }
 
     double arg = exec->argument(0).toNumber(exec);
@@ -339,7 +349,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncRound(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncSin(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncSin", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncSin");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(exec->globalData().cachedSin(exec->argument(0).toNumber(exec)));
 }
@@ -347,7 +358,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncSin(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncSqrt(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncSqrt", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncSqrt");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(sqrt(exec->argument(0).toNumber(exec))));
 }
@@ -355,7 +367,8 @@ EncodedJSValue JSC_HOST_CALL mathProtoFuncSqrt(ExecState* exec)
 EncodedJSValue JSC_HOST_CALL mathProtoFuncTan(ExecState* exec)
 {
     if (exec->argument(0).isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::mathProtoFuncTan", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::mathProtoFuncTan");
+        missingInstrumentation.add(1);
     }
     return JSValue::encode(jsDoubleNumber(tan(exec->argument(0).toNumber(exec))));
 }
@@ -121,17 +121,17 @@ namespace JSC {
 
             Symbolic::StringExpression* symbolicConcat =
                     thisValue.isSymbolic() ? (Symbolic::StringExpression*)thisValue.asSymbolic() :
-                                             (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(thisValue.toUString(exec).ascii().data()));
+                                             (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(thisValue.toUString(exec).ascii().data()));
 
             for (unsigned i = 0; i < exec->argumentCount(); ++i) {
 
                 JSValue arg = exec->argument(i);
 
-                symbolicConcat = new Symbolic::StringBinaryOperation(
+                symbolicConcat = Symbolic::StringBinaryOperation::create(
                             symbolicConcat,
                             Symbolic::CONCAT,
                             arg.isSymbolic() ? (Symbolic::StringExpression*)arg.asSymbolic() :
-                                               (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(arg.toUString(exec).ascii().data())));
+                                               (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(arg.toUString(exec).ascii().data())));
 
             }
 
@@ -262,7 +262,8 @@ JSObject* constructRegExp(ExecState* exec, JSGlobalObject* globalObject, const A
     JSValue arg1 = args.at(1);
 
     if (arg0.isSymbolic() || arg1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::regExpProtoFuncConstructor", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::regExpProtoFuncConstructor");
+        missingInstrumentation.add(1);
     }
 
     if (arg0.inherits(&RegExpObject::s_info)) {
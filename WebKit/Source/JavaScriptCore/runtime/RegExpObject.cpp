@@ -292,10 +292,10 @@ JSValue RegExpObject::exec(ExecState* exec, JSString* string)
 
         if ((!regExp()->global() || result.end == 0)) {
 
-            Symbolic::StringRegexSubmatchArray* symbolicMatch = new Symbolic::StringRegexSubmatchArray(
+            Symbolic::StringRegexSubmatchArray* symbolicMatch = Symbolic::StringRegexSubmatchArray::create(
                         Symbolic::NEXT_SYMBOLIC_ID++,
                         (Symbolic::StringExpression*)string->asSymbolic(),
-                        new std::string(regExp()->pattern().ascii().data()));
+                        std::string(regExp()->pattern().ascii().data()));
 
             JSValue r;
 
@@ -308,7 +308,7 @@ JSValue RegExpObject::exec(ExecState* exec, JSString* string)
                     JSValue v = slot.getValue(exec, i);
 
                     if (!v.isEmpty() && !v.isDeleted() && v.isString()) {
-                        v.makeSymbolic(new Symbolic::StringRegexSubmatchArrayAt(symbolicMatch, i), exec->globalData());
+                        v.makeSymbolic(Symbolic::StringRegexSubmatchArrayAt::create(symbolicMatch, i), exec->globalData());
                         array->setIndex(exec->globalData(), i, v);
                     }
                 }
@@ -318,11 +318,12 @@ JSValue RegExpObject::exec(ExecState* exec, JSString* string)
                 r = jsNull();
             }
 
-            r.makeSymbolic(new Symbolic::StringRegexSubmatchArrayMatch(symbolicMatch), exec->globalData());
+            r.makeSymbolic(Symbolic::StringRegexSubmatchArrayMatch::create(symbolicMatch), exec->globalData());
             return r;
 
         } else {
-            Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::regExpProtoFuncExec", 1);
+            static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::regExpProtoFuncExec");
+            missingInstrumentation.add(1);
         }
     }
 #endif
@@ -93,8 +93,8 @@ EncodedJSValue JSC_HOST_CALL regExpProtoFuncTest(ExecState* exec)
 
 #ifdef ARTEMIS
     if (arg.isSymbolic()) {
-        result.makeSymbolic(new Symbolic::StringRegexSubmatch((Symbolic::StringExpression*)arg.asSymbolic(),
-                                                              new std::string(reg->regExp()->pattern().ascii().data())),
+        result.makeSymbolic(Symbolic::StringRegexSubmatch::create((Symbolic::StringExpression*)arg.asSymbolic(),
+                                                              std::string(reg->regExp()->pattern().ascii().data())),
                             exec->globalData());
     }
 #endif
@@ -129,7 +129,8 @@ EncodedJSValue JSC_HOST_CALL regExpProtoFuncCompile(ExecState* exec)
     JSValue arg1 = exec->argument(1);
 
     if (arg0.isSymbolic() || arg1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::regExpProtoFuncCompile", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::regExpProtoFuncCompile");
+        missingInstrumentation.add(1);
     }
     
     if (arg0.inherits(&RegExpObject::s_info)) {
@@ -81,7 +81,8 @@ static NEVER_INLINE JSValue stringFromCharCodeSlowCase(ExecState* exec)
     PassRefPtr<StringImpl> impl = StringImpl::createUninitialized(length, buf);
     for (unsigned i = 0; i < length; ++i) {
         if (exec->argument(i).isSymbolic()) {
-            Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringFromCharCode", 1);
+            static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringFromCharCode");
+            missingInstrumentation.add(1);
         }
         buf[i] = static_cast<UChar>(exec->argument(i).toUInt32(exec));
     }
@@ -93,7 +94,8 @@ static EncodedJSValue JSC_HOST_CALL stringFromCharCode(ExecState* exec)
     if (LIKELY(exec->argumentCount() == 1)) {
 
         if (exec->argument(0).isSymbolic()) {
-            Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringFromCharCode", 1);
+            static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringFromCharCode");
+            missingInstrumentation.add(1);
         }
 
         return JSValue::encode(jsSingleCharacterString(exec, exec->argument(0).toUInt32(exec)));
@@ -687,9 +687,9 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
     if (searchValue.inherits(&RegExpObject::s_info)) {
         if (thisValue.isSymbolic()) {
             JSValue value = JSValue::decode(replaceUsingRegExpSearch(exec, string, searchValue));
-            value.makeSymbolic(new Symbolic::StringRegexReplace((Symbolic::StringExpression*)thisValue.asSymbolic(),
-                                                                new std::string(searchValue.toUString(exec).ascii().data()),
-                                                                new std::string(replaceValue.toUString(exec).ascii().data())),
+            value.makeSymbolic(Symbolic::StringRegexReplace::create((Symbolic::StringExpression*)thisValue.asSymbolic(),
+                                                                std::string(searchValue.toUString(exec).ascii().data()),
+                                                                std::string(replaceValue.toUString(exec).ascii().data())),
                                exec->globalData());
             return JSValue::encode(value);
         } else {
@@ -704,16 +704,17 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncReplace(ExecState* exec)
 #ifdef ARTEMIS
     if (thisValue.isSymbolic()) {
         JSValue value = JSValue::decode(replaceUsingStringSearch(exec, string, searchValue));
-        value.makeSymbolic(new Symbolic::StringReplace((Symbolic::StringExpression*)thisValue.asSymbolic(),
-                                                       new std::string(searchValue.toUString(exec).ascii().data()),
-                                                       new std::string(replaceValue.toUString(exec).ascii().data())),
+        value.makeSymbolic(Symbolic::StringReplace::create((Symbolic::StringExpression*)thisValue.asSymbolic(),
+                                                       std::string(searchValue.toUString(exec).ascii().data()),
+                                                       std::string(replaceValue.toUString(exec).ascii().data())),
                            exec->globalData());
         return JSValue::encode(value);
     } else {
 
         assert(!thisValue.isSymbolic());
         if (searchValue.isSymbolic() || replaceValue.isSymbolic()) {
-            Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncReplace", 1);
+            static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncReplace");
+            missingInstrumentation.add(1);
         }
 
         return replaceUsingStringSearch(exec, string, searchValue);
@@ -764,7 +765,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
 
     #ifdef ARTEMIS
     if (thisValue.isSymbolic()) {
-        result.makeSymbolic(new Symbolic::StringCharAt((Symbolic::StringExpression*)thisValue.asSymbolic(),
+        result.makeSymbolic(Symbolic::StringCharAt::create((Symbolic::StringExpression*)thisValue.asSymbolic(),
                                                         a0.isUInt32() ? a0.asUInt32() : static_cast<uint32_t>(a0.toInteger(exec))),
                             exec->globalData());
     }
@@ -781,7 +782,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
 
 #ifdef ARTEMIS
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncCharCodeAt", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncCharCodeAt");
+        missingInstrumentation.add(1);
     }
 #endif
 
@@ -817,12 +819,12 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncConcat(ExecState* exec)
         JSValue result = jsString(exec, arg1, arg2);
 
         if (thisValue.isSymbolic() || thatValue.isSymbolic()) {
-            result.makeSymbolic(new Symbolic::StringBinaryOperation(
+            result.makeSymbolic(Symbolic::StringBinaryOperation::create(
                                     thisValue.isSymbolic() ? (Symbolic::StringExpression*)thisValue.asSymbolic() :
-                                                             (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(thisValue.toUString(exec).ascii().data())),
+                                                             (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(thisValue.toUString(exec).ascii().data())),
                                     Symbolic::CONCAT,
                                     thatValue.isSymbolic() ? (Symbolic::StringExpression*)thatValue.asSymbolic() :
-                                                             (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(thatValue.toUString(exec).ascii().data()))),
+                                                             (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(thatValue.toUString(exec).ascii().data()))),
                                 exec->globalData());
         }
 
@@ -873,13 +875,13 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncIndexOf(ExecState* exec)
     if (thisValue.isSymbolic() || a0.isSymbolic() || a1.isSymbolic()) {
 
         JSValue r = (result == notFound) ? jsNumber(-1) : jsNumber(result);
-        r.makeSymbolic(new Symbolic::StringIndexOf(
+        r.makeSymbolic(Symbolic::StringIndexOf::create(
                            thisValue.isSymbolic() ? (Symbolic::StringExpression*)thisValue.asSymbolic() :
-                                                    (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(s.ascii().data())),
+                                                    (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(s.ascii().data())),
                            a0.isSymbolic() ? (Symbolic::StringExpression*)a0.asSymbolic() :
-                                             (Symbolic::StringExpression*)new Symbolic::ConstantString(new std::string(u2.ascii().data())),
+                                             (Symbolic::StringExpression*)Symbolic::ConstantString::create(std::string(u2.ascii().data())),
                            a1.isSymbolic() ? (Symbolic::IntegerExpression*)a1.asSymbolic() :
-                                             (Symbolic::IntegerExpression*)new Symbolic::ConstantInteger(pos)),
+                                             (Symbolic::IntegerExpression*)Symbolic::ConstantInteger::create(pos)),
                        exec->globalData());
 
         return JSValue::encode(r);
@@ -905,7 +907,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncLastIndexOf(ExecState* exec)
 
 #ifdef ARTEMIS
     if (thisValue.isSymbolic() || a0.isSymbolic() || a1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncLastIndexOf", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncLastIndexOf");
+        missingInstrumentation.add(1);
     }
 #endif
 
@@ -963,10 +966,10 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncMatch(ExecState* exec)
 #ifdef ARTEMIS
         if (thisValue.isSymbolic()) {
 
-            Symbolic::StringRegexSubmatchArray* symbolicMatch = new Symbolic::StringRegexSubmatchArray(
+            Symbolic::StringRegexSubmatchArray* symbolicMatch = Symbolic::StringRegexSubmatchArray::create(
                         Symbolic::NEXT_SYMBOLIC_ID++,
                         (Symbolic::StringExpression*)thisValue.asSymbolic(),
-                        new std::string(regExp->pattern().ascii().data()));
+                        std::string(regExp->pattern().ascii().data()));
 
             JSValue r;
 
@@ -979,7 +982,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncMatch(ExecState* exec)
                     JSValue v = slot.getValue(exec, i);
 
                     if (!v.isEmpty() && !v.isDeleted() && v.isString()) {
-                        v.makeSymbolic(new Symbolic::StringRegexSubmatchArrayAt(symbolicMatch, i), exec->globalData());
+                        v.makeSymbolic(Symbolic::StringRegexSubmatchArrayAt::create(symbolicMatch, i), exec->globalData());
                         array->setIndex(exec->globalData(), i, v);
                     }
                 }
@@ -989,7 +992,7 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncMatch(ExecState* exec)
                 r = jsNull();
             }
 
-            r.makeSymbolic(new Symbolic::StringRegexSubmatchArrayMatch(symbolicMatch), exec->globalData());
+            r.makeSymbolic(Symbolic::StringRegexSubmatchArrayMatch::create(symbolicMatch), exec->globalData());
             return JSValue::encode(r);
         }
 #endif
@@ -1049,8 +1052,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSearch(ExecState* exec)
 
 #ifdef ARTEMIS
     if (thisValue.isSymbolic()) {
-        r.makeSymbolic(new Symbolic::StringRegexSubmatchIndex((Symbolic::StringExpression*)thisValue.asSymbolic(),
-                                                              new std::string(reg->pattern().ascii().data())),
+        r.makeSymbolic(Symbolic::StringRegexSubmatchIndex::create((Symbolic::StringExpression*)thisValue.asSymbolic(),
+                                                              std::string(reg->pattern().ascii().data())),
                        exec->globalData());
     }
 #endif
@@ -1070,7 +1073,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSlice(ExecState* exec)
     JSValue a1 = exec->argument(1);
 
     if (thisValue.isSymbolic() || a0.isSymbolic() || a1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSlice", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSlice");
+        missingInstrumentation.add(1);
     }
 
     // The arg processing is very much like ArrayProtoFunc::Slice
@@ -1142,7 +1146,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSplit(ExecState* exec)
     unsigned limit = limitValue.isUndefined() ? 0xFFFFFFFFu : limitValue.toUInt32(exec);
 
     if (thisValue.isSymbolic() || limitValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSplit", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSplit");
+        missingInstrumentation.add(1);
     }
 
     // 7. Let p = 0.
@@ -1378,16 +1383,17 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSubstr(ExecState* exec)
     }
 
     if (a0.isSymbolic() || a1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSubstrSymbolicLimits", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSubstrSymbolicLimits");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isSymbolic()) {
 
         double low = a0.toInteger(exec);
         double high = a1.isUndefined() ? -1 : a1.toInteger(exec);
-        result.makeSymbolic(new Symbolic::StringSubstring(jsString ?
+        result.makeSymbolic(Symbolic::StringSubstring::create(jsString ?
                                                               (Symbolic::StringExpression*)thisValue.asSymbolic() :
-                                                              new Symbolic::StringCoercion(thisValue.asSymbolic()),
+                                                              Symbolic::StringCoercion::create(thisValue.asSymbolic()),
                                                           (int)low, (int)high),
                             exec->globalData());
     }
@@ -1435,13 +1441,14 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSubstring(ExecState* exec)
     JSValue result = jsSubstring(exec, jsString, substringStart, substringLength);
 
     if (a0.isSymbolic() || a1.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSubstringSymbolicLimits", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSubstringSymbolicLimits");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isSymbolic()) {
         double low = a0.toInteger(exec);
         double high = a1.isUndefined() ? -1 : (a1.toInteger(exec) > low ? a1.toInteger(exec) - low : 0); // get length
-        result.makeSymbolic(new Symbolic::StringSubstring((Symbolic::StringExpression*)thisValue.asSymbolic(), (int)low, (int)high), exec->globalData());
+        result.makeSymbolic(Symbolic::StringSubstring::create((Symbolic::StringExpression*)thisValue.asSymbolic(), (int)low, (int)high), exec->globalData());
     }
 
     return JSValue::encode(result);
@@ -1452,7 +1459,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToLowerCase(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncTo[Locale]LowerCase", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncTo[Locale]LowerCase");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1476,7 +1484,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncToUpperCase(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncTo[Locale]UpperCase", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncTo[Locale]UpperCase");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1510,7 +1519,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncLocaleCompare(ExecState* exec)
 
 #ifdef ARTEMIS
     if (thisValue.isSymbolic() || a0.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncLocaleCompare", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncLocaleCompare");
+        missingInstrumentation.add(1);
     }
 #endif
 
@@ -1522,7 +1532,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncBig(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncBig", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncBig");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1536,7 +1547,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSmall(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSmall", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSmall");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1550,7 +1562,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncBlink(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncBlink", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncBlink");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1564,7 +1577,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncBold(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncBold", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncBold");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1578,7 +1592,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncFixed(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncFixed", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncFixed");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1592,7 +1607,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncItalics(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncItalics", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncItalics");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1606,7 +1622,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncStrike(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncStrike", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncStrike");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1620,7 +1637,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSub(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSub", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSub");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1634,7 +1652,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncSup(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncSup", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncSup");
+        missingInstrumentation.add(1);
     }
 
     if (thisValue.isUndefinedOrNull()) // CheckObjectCoercible
@@ -1652,7 +1671,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncFontcolor(ExecState* exec)
     JSValue a0 = exec->argument(0);
 
     if (thisValue.isSymbolic() || a0.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncFontcolor", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncFontcolor");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(jsMakeNontrivialString(exec, "<font color=\"", a0.toString(exec)->value(exec), "\">", s, "</font>"));
@@ -1667,7 +1687,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncFontsize(ExecState* exec)
     JSValue a0 = exec->argument(0);
 
     if (thisValue.isSymbolic() | a0.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncFontsize", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncFontsize");
+        missingInstrumentation.add(1);
     }
 
     uint32_t smallInteger;
@@ -1716,7 +1737,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncAnchor(ExecState* exec)
     JSValue a0 = exec->argument(0);
 
     if (thisValue.isSymbolic() || a0.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncAnchor", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncAnchor");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(jsMakeNontrivialString(exec, "<a name=\"", a0.toString(exec)->value(exec), "\">", s, "</a>"));
@@ -1732,7 +1754,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncLink(ExecState* exec)
     UString linkText = a0.toString(exec)->value(exec);
 
     if (thisValue.isSymbolic() || a0.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncLink", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncLink");
+        missingInstrumentation.add(1);
     }
 
     unsigned linkTextSize = linkText.length();
@@ -1800,7 +1823,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncTrim(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncTrim", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncTrim");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(trimString(exec, thisValue, TrimLeft | TrimRight));
@@ -1811,7 +1835,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncTrimLeft(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncTrimLeft", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncTrimLeft");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(trimString(exec, thisValue, TrimLeft));
@@ -1822,7 +1847,8 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncTrimRight(ExecState* exec)
     JSValue thisValue = exec->hostThisValue();
 
     if (thisValue.isSymbolic()) {
-        Statistics::statistics()->accumulate("Concolic::MissingInstrumentation::stringProtoFuncTrimRight", 1);
+        static Statistics::Counter missingInstrumentation("Concolic::MissingInstrumentation::stringProtoFuncTrimRight");
+        missingInstrumentation.add(1);
     }
 
     return JSValue::encode(trimString(exec, thisValue, TrimRight));
@@ -17,7 +17,10 @@
 #include "statsstorage.h"
 
 #include <QDebug>
+#include <cfloat>
+#include <cstdio>
 #include <iostream>
+#include <sstream>
 
 #ifdef ARTEMIS
 
@@ -25,12 +28,99 @@
 namespace Statistics
 {
 
+static const char* const counterOverflowKey = "Statistics::CounterOverflow";
+
+static void writeJSONString(std::ostream& out, const std::string& value)
+{
+    out << '"';
+
+    for (std::string::const_iterator iter = value.begin(); iter != value.end(); iter++) {
+        switch (*iter) {
+        case '"':
+            out << "\\\"";
+            break;
+        case '\\':
+            out << "\\\\";
+            break;
+        case '\n':
+            out << "\\n";
+            break;
+        case '\t':
+            out << "\\t";
+            break;
+        default:
+            if ((unsigned char)*iter < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char)*iter);
+                out << escaped;
+            } else {
+                out << *iter;
+            }
+        }
+    }
+
+    out << '"';
+}
+
+static void writeJSONNumber(std::ostream& out, double value)
+{
+    // NaN and infinity can not be represented in JSON.
+    if (value != value || value > DBL_MAX || value < -DBL_MAX) {
+        out << "null";
+    } else {
+        out << value;
+    }
+}
+
 StatsStorage::StatsStorage()
 {
+    // Slot 0 is shared by all counters registered after the others are used up.
+    mCounterSlots.insert(std::pair<std::string, CounterSlot>(counterOverflowKey, 0));
+}
+
+CounterSlot StatsStorage::registerCounter(const std::string& key)
+{
+    QMutexLocker locker(&mMutex);
+
+    CounterSlots::iterator iter = mCounterSlots.find(key);
+
+    if (iter != mCounterSlots.end()) {
+        return iter->second;
+    }
+
+    if (mCounterSlots.size() >= (size_t)MAX_COUNTERS) {
+        qWarning() << "Warning: Too many statistics counters, counting" << key.c_str() << "as" << counterOverflowKey;
+        return 0;
+    }
+
+    CounterSlot slot = mCounterSlots.size();
+    mCounterSlots.insert(std::pair<std::string, CounterSlot>(key, slot));
+
+    return slot;
+}
+
+// Adds up the plain integer statistics and the counters. Should be called with mMutex held.
+StatsStorage::IntStorage StatsStorage::collectInts()
+{
+    IntStorage result = mIntStorage;
+
+    for (CounterSlots::iterator iter = mCounterSlots.begin(); iter != mCounterSlots.end(); iter++) {
+        int value = mCounters[iter->second];
+
+        if (iter->second == 0 && value == 0) {
+            continue;
+        }
+
+        result[iter->first] += value;
+    }
+
+    return result;
 }
 
 void StatsStorage::accumulate(const std::string& key, int value)
 {
+    QMutexLocker locker(&mMutex);
+
     IntStorage::iterator iter = mIntStorage.find(key);
 
     if (iter == mIntStorage.end()) {
@@ -42,6 +132,8 @@ void StatsStorage::accumulate(const std::string& key, int value)
 
 void StatsStorage::accumulate(const std::string& key, double value)
 {
+    QMutexLocker locker(&mMutex);
+
     DoubleStorage::iterator iter = mDoubleStorage.find(key);
 
     if (iter == mDoubleStorage.end()) {
@@ -53,30 +145,44 @@ void StatsStorage::accumulate(const std::string& key, double value)
 
 void StatsStorage::set(const std::string& key, int value)
 {
-    mIntStorage.insert(std::pair<std::string, int>(key, value));
+    QMutexLocker locker(&mMutex);
+
+    CounterSlots::iterator slot = mCounterSlots.find(key);
+
+    if (slot != mCounterSlots.end() && slot->second != 0) {
+        mCounters[slot->second].fetchAndStoreRelaxed(value);
+        mIntStorage.erase(key);
+    } else {
+        mIntStorage[key] = value;
+    }
 }
 
 void StatsStorage::set(const std::string& key, bool value)
 {
-    mStringStorage.insert(std::pair<std::string, std::string>(key, (value ? "true" : "false")));
+    QMutexLocker locker(&mMutex);
+    mStringStorage[key] = value ? "true" : "false";
 }
 
 void StatsStorage::set(const std::string& key, double value)
 {
-    mDoubleStorage.insert(std::pair<std::string, double>(key, value));
+    QMutexLocker locker(&mMutex);
+    mDoubleStorage[key] = value;
 }
 
 void StatsStorage::set(const std::string& key, const std::string& value)
 {
-    mStringStorage.insert(std::pair<std::string, std::string>(key, value));
+    QMutexLocker locker(&mMutex);
+    mStringStorage[key] = value;
 }
 
 void StatsStorage::writeToStdOut()
 {
+    QMutexLocker locker(&mMutex);
 
-    IntStorage::iterator iiter = mIntStorage.begin();
+    IntStorage ints = collectInts();
+    IntStorage::iterator iiter = ints.begin();
 
-    while (iiter != mIntStorage.end()) {
+    while (iiter != ints.end()) {
         std::cout << iiter->first << ": " << iiter->second << std::endl;
         iiter++;
     }
@@ -97,6 +203,139 @@ void StatsStorage::writeToStdOut()
 
 }
 
+void StatsStorage::writeJSON(std::ostream& out)
+{
+    QMutexLocker locker(&mMutex);
+
+    IntStorage ints = collectInts();
+    bool first = true;
+
+    out << "{\n";
+
+    for (IntStorage::iterator iter = ints.begin(); iter != ints.end(); iter++) {
+        out << (first ? "  " : ",\n  ");
+        writeJSONString(out, iter->first);
+        out << ": " << iter->second;
+        first = false;
+    }
+
+    for (DoubleStorage::iterator iter = mDoubleStorage.begin(); iter != mDoubleStorage.end(); iter++) {
+        out << (first ? "  " : ",\n  ");
+        writeJSONString(out, iter->first);
+        out << ": ";
+        writeJSONNumber(out, iter->second);
+        first = false;
+    }
+
+    for (StringStorage::iterator iter = mStringStorage.begin(); iter != mStringStorage.end(); iter++) {
+        out << (first ? "  " : ",\n  ");
+        writeJSONString(out, iter->first);
+        out << ": ";
+        writeJSONString(out, iter->second);
+        first = false;
+    }
+
+    out << "\n}\n";
+}
+
+StatsSnapshot StatsStorage::snapshot()
+{
+    QMutexLocker locker(&mMutex);
+
+    StatsSnapshot result;
+    result.ints = collectInts();
+    result.doubles = mDoubleStorage;
+
+    return result;
+}
+
+void StatsStorage::writeJSONDiff(std::ostream& out, const StatsSnapshot& from, const StatsSnapshot& to)
+{
+    bool first = true;
+
+    out << "{";
+
+    for (IntStorage::const_iterator iter = to.ints.begin(); iter != to.ints.end(); iter++) {
+        IntStorage::const_iterator previous = from.ints.find(iter->first);
+        int difference = iter->second - (previous == from.ints.end() ? 0 : previous->second);
+
+        if (difference != 0) {
+            out << (first ? "" : ", ");
+            writeJSONString(out, iter->first);
+            out << ": " << difference;
+            first = false;
+        }
+    }
+
+    for (DoubleStorage::const_iterator iter = to.doubles.begin(); iter != to.doubles.end(); iter++) {
+        DoubleStorage::const_iterator previous = from.doubles.find(iter->first);
+        double difference = iter->second - (previous == from.doubles.end() ? 0 : previous->second);
+
+        if (difference != 0) {
+            out << (first ? "" : ", ");
+            writeJSONString(out, iter->first);
+            out << ": ";
+            writeJSONNumber(out, difference);
+            first = false;
+        }
+    }
+
+    out << "}";
+}
+
+void StatsStorage::writeTo(std::ostream& out)
+{
+    QMutexLocker locker(&mMutex);
+
+    IntStorage ints = collectInts();
+
+    for (IntStorage::iterator iter = ints.begin(); iter != ints.end(); iter++) {
+        out << "i\t" << iter->first << "\t" << iter->second << "\n";
+    }
+
+    for (DoubleStorage::iterator iter = mDoubleStorage.begin(); iter != mDoubleStorage.end(); iter++) {
+        out << "d\t" << iter->first << "\t" << iter->second << "\n";
+    }
+
+    for (StringStorage::iterator iter = mStringStorage.begin(); iter != mStringStorage.end(); iter++) {
+        out << "s\t" << iter->first << "\t" << iter->second << "\n";
+    }
+}
+
+void StatsStorage::mergeFrom(std::istream& in)
+{
+    std::string line;
+
+    while (std::getline(in, line)) {
+        size_t keyStart = line.find('\t');
+        size_t valueStart = line.find('\t', keyStart + 1);
+
+        if (keyStart != 1 || valueStart == std::string::npos) {
+            continue;
+        }
+
+        std::string key = line.substr(keyStart + 1, valueStart - keyStart - 1);
+        std::istringstream value(line.substr(valueStart + 1));
+
+        switch (line[0]) {
+        case 'i': {
+            int intValue = 0;
+            value >> intValue;
+            accumulate(key, intValue);
+            break;
+        }
+        case 'd': {
+            double doubleValue = 0;
+            value >> doubleValue;
+            accumulate(key, doubleValue);
+            break;
+        }
+        case 's':
+            set(key, value.str());
+            break;
+        }
+    }
+}
 
 StatsStorage* statistics()
 {
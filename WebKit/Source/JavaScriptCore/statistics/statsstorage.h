@@ -19,18 +19,40 @@
 
 #include <map>
 #include <string>
+#include <istream>
+#include <ostream>
+
+#include <QMutex>
+#include <QAtomicInt>
 
 #ifdef ARTEMIS
 
 namespace Statistics
 {
 
+typedef int CounterSlot;
+
+// The numeric statistics at some point of the run, see StatsStorage::snapshot.
+struct StatsSnapshot
+{
+    std::map<std::string, int> ints;
+    std::map<std::string, double> doubles;
+};
+
 class StatsStorage
 {
 
 public:
     StatsStorage();
 
+    // Counters for hot paths. The key is resolved to a slot once, after which increments are a lock-free add.
+    // Use through the Counter class below.
+    CounterSlot registerCounter(const std::string& key);
+    inline void increment(CounterSlot slot, int value)
+    {
+        mCounters[slot].fetchAndAddRelaxed(value);
+    }
+
     void accumulate(const std::string& key, int value);
     void accumulate(const std::string& key, double value);
     void set(const std::string& key, int value);
@@ -39,19 +61,64 @@ public:
     void set(const std::string& key, const std::string& value);
 
     void writeToStdOut();
+    void writeJSON(std::ostream& out);
+
+    StatsSnapshot snapshot();
+
+    // Writes the numbers which changed between the two snapshots as a single line JSON object.
+    static void writeJSONDiff(std::ostream& out, const StatsSnapshot& from, const StatsSnapshot& to);
+
+    // Used to combine statistics across processes. Numbers are added up, existing strings are kept.
+    void writeTo(std::ostream& out);
+    void mergeFrom(std::istream& in);
 
 private:
     typedef std::map<std::string, int> IntStorage;
     typedef std::map<std::string, double> DoubleStorage;
     typedef std::map<std::string, std::string> StringStorage;
+    typedef std::map<std::string, CounterSlot> CounterSlots;
+
+    IntStorage collectInts();
 
     IntStorage mIntStorage;
     DoubleStorage mDoubleStorage;
     StringStorage mStringStorage;
+
+    static const int MAX_COUNTERS = 8192;
+    QAtomicInt mCounters[MAX_COUNTERS];
+    CounterSlots mCounterSlots;
+
+    // Statistics are also reported from the concurrent solver workers.
+    QMutex mMutex;
 };
 
 StatsStorage* statistics();
 
+/**
+ * A statistic which is incremented on a hot path. Declare it as a function local static, such that the key is only
+ * registered on first use:
+ *
+ *     static Statistics::Counter counter("WebKit::readproperties");
+ *     counter.add(1);
+ */
+class Counter
+{
+
+public:
+    explicit Counter(const char* key)
+        : mSlot(statistics()->registerCounter(key))
+    {
+    }
+
+    inline void add(int value)
+    {
+        statistics()->increment(mSlot, value);
+    }
+
+private:
+    CounterSlot mSlot;
+};
+
 }
 
 #endif //ARTEMIS
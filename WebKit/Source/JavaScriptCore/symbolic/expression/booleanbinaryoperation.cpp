@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "booleanbinaryoperation.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -50,6 +51,42 @@ BooleanBinaryOperation::BooleanBinaryOperation(BooleanExpression* lhs, BooleanBi
 {
 }
 
+BooleanBinaryOperation* BooleanBinaryOperation::create(BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs)
+{
+    return create(ExpressionArena::current(), lhs, op, rhs);
+}
+
+BooleanBinaryOperation* BooleanBinaryOperation::create(ExpressionArena* arena, BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs)
+{
+    size_t hash = 33;
+    hash = hashCombine(hash, hashField(lhs));
+    hash = hashCombine(hash, hashField(op));
+    hash = hashCombine(hash, hashField(rhs));
+
+    ExpressionArena::InternTable& table = arena->internTable(33);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        BooleanBinaryOperation* candidate = static_cast<BooleanBinaryOperation*>(iter->second);
+        if (equalField(candidate->m_lhs, lhs) &&
+            equalField(candidate->m_op, op) &&
+            equalField(candidate->m_rhs, rhs)) {
+            return candidate;
+        }
+    }
+
+    BooleanBinaryOperation* created = new (arena->allocate(sizeof(BooleanBinaryOperation))) BooleanBinaryOperation(lhs, op, rhs);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* BooleanBinaryOperation::copyTo(ExpressionArena* arena)
+{
+    return BooleanBinaryOperation::create(arena, arena->import(m_lhs), m_op, arena->import(m_rhs));
+}
+
 void BooleanBinaryOperation::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -42,9 +42,13 @@ Type opGetType(BooleanBinaryOp op);
 class BooleanBinaryOperation : public BooleanExpression
 {
 public:
-    explicit BooleanBinaryOperation(BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static BooleanBinaryOperation* create(BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs);
+    static BooleanBinaryOperation* create(ExpressionArena* arena, BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline BooleanExpression* getLhs() {
 		return m_lhs;
@@ -57,6 +61,8 @@ public:
 	}
 
 private:
+    explicit BooleanBinaryOperation(BooleanExpression* lhs, BooleanBinaryOp op, BooleanExpression* rhs);
+
 	BooleanExpression* m_lhs;
 	BooleanBinaryOp m_op;
 	BooleanExpression* m_rhs;
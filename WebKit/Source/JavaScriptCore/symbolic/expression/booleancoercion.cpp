@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "booleancoercion.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ BooleanCoercion::BooleanCoercion(Expression* expression) :
 {
 }
 
+BooleanCoercion* BooleanCoercion::create(Expression* expression)
+{
+    return create(ExpressionArena::current(), expression);
+}
+
+BooleanCoercion* BooleanCoercion::create(ExpressionArena* arena, Expression* expression)
+{
+    size_t hash = 32;
+    hash = hashCombine(hash, hashField(expression));
+
+    ExpressionArena::InternTable& table = arena->internTable(32);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        BooleanCoercion* candidate = static_cast<BooleanCoercion*>(iter->second);
+        if (equalField(candidate->m_expression, expression)) {
+            return candidate;
+        }
+    }
+
+    BooleanCoercion* created = new (arena->allocate(sizeof(BooleanCoercion))) BooleanCoercion(expression);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* BooleanCoercion::copyTo(ExpressionArena* arena)
+{
+    return BooleanCoercion::create(arena, arena->import(m_expression));
+}
+
 void BooleanCoercion::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
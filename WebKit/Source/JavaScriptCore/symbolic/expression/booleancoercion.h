@@ -35,15 +35,21 @@ namespace Symbolic
 class BooleanCoercion : public BooleanExpression
 {
 public:
-    explicit BooleanCoercion(Expression* expression);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static BooleanCoercion* create(Expression* expression);
+    static BooleanCoercion* create(ExpressionArena* arena, Expression* expression);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline Expression* getExpression() {
 		return m_expression;
 	}
 
 private:
+    explicit BooleanCoercion(Expression* expression);
+
 	Expression* m_expression;
 
 };
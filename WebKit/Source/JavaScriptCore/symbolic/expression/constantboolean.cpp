@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "constantboolean.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ ConstantBoolean::ConstantBoolean(bool value) :
 {
 }
 
+ConstantBoolean* ConstantBoolean::create(bool value)
+{
+    return create(ExpressionArena::current(), value);
+}
+
+ConstantBoolean* ConstantBoolean::create(ExpressionArena* arena, bool value)
+{
+    size_t hash = 31;
+    hash = hashCombine(hash, hashField(value));
+
+    ExpressionArena::InternTable& table = arena->internTable(31);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ConstantBoolean* candidate = static_cast<ConstantBoolean*>(iter->second);
+        if (equalField(candidate->m_value, value)) {
+            return candidate;
+        }
+    }
+
+    ConstantBoolean* created = new (arena->allocate(sizeof(ConstantBoolean))) ConstantBoolean(value);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ConstantBoolean::copyTo(ExpressionArena* arena)
+{
+    return ConstantBoolean::create(arena, m_value);
+}
+
 void ConstantBoolean::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
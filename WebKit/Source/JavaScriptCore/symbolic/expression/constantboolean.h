@@ -34,15 +34,21 @@ namespace Symbolic
 class ConstantBoolean : public BooleanExpression
 {
 public:
-    explicit ConstantBoolean(bool value);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ConstantBoolean* create(bool value);
+    static ConstantBoolean* create(ExpressionArena* arena, bool value);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline bool getValue() {
 		return m_value;
 	}
 
 private:
+    explicit ConstantBoolean(bool value);
+
 	bool m_value;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "constantinteger.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ ConstantInteger::ConstantInteger(double value) :
 {
 }
 
+ConstantInteger* ConstantInteger::create(double value)
+{
+    return create(ExpressionArena::current(), value);
+}
+
+ConstantInteger* ConstantInteger::create(ExpressionArena* arena, double value)
+{
+    size_t hash = 3;
+    hash = hashCombine(hash, hashField(value));
+
+    ExpressionArena::InternTable& table = arena->internTable(3);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ConstantInteger* candidate = static_cast<ConstantInteger*>(iter->second);
+        if (equalField(candidate->m_value, value)) {
+            return candidate;
+        }
+    }
+
+    ConstantInteger* created = new (arena->allocate(sizeof(ConstantInteger))) ConstantInteger(value);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ConstantInteger::copyTo(ExpressionArena* arena)
+{
+    return ConstantInteger::create(arena, m_value);
+}
+
 void ConstantInteger::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
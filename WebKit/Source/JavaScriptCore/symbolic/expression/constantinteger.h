@@ -34,15 +34,21 @@ namespace Symbolic
 class ConstantInteger : public IntegerExpression
 {
 public:
-    explicit ConstantInteger(double value);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ConstantInteger* create(double value);
+    static ConstantInteger* create(ExpressionArena* arena, double value);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline double getValue() {
 		return m_value;
 	}
 
 private:
+    explicit ConstantInteger(double value);
+
 	double m_value;
 
 };
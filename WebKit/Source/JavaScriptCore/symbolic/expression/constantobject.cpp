@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "constantobject.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ ConstantObject::ConstantObject(unsigned instanceIdentifier) :
 {
 }
 
+ConstantObject* ConstantObject::create(unsigned instanceIdentifier)
+{
+    return create(ExpressionArena::current(), instanceIdentifier);
+}
+
+ConstantObject* ConstantObject::create(ExpressionArena* arena, unsigned instanceIdentifier)
+{
+    size_t hash = 10;
+    hash = hashCombine(hash, hashField(instanceIdentifier));
+
+    ExpressionArena::InternTable& table = arena->internTable(10);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ConstantObject* candidate = static_cast<ConstantObject*>(iter->second);
+        if (equalField(candidate->m_instanceIdentifier, instanceIdentifier)) {
+            return candidate;
+        }
+    }
+
+    ConstantObject* created = new (arena->allocate(sizeof(ConstantObject))) ConstantObject(instanceIdentifier);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ConstantObject::copyTo(ExpressionArena* arena)
+{
+    return ConstantObject::create(arena, m_instanceIdentifier);
+}
+
 void ConstantObject::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
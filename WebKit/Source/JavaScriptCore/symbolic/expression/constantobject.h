@@ -34,19 +34,25 @@ namespace Symbolic
 class ConstantObject : public ObjectExpression
 {
 public:
-    explicit ConstantObject(unsigned instanceIdentifier);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ConstantObject* create(unsigned instanceIdentifier);
+    static ConstantObject* create(ExpressionArena* arena, unsigned instanceIdentifier);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
-    inline unsigned getInstanceidentifier() {
+	inline unsigned getInstanceidentifier() {
 		return m_instanceIdentifier;
 	}
 
 private:
-    unsigned m_instanceIdentifier;
+    explicit ConstantObject(unsigned instanceIdentifier);
+
+	unsigned m_instanceIdentifier;
 
 };
 }
 
 #endif
-#endif // SYMBOLIC_CONSTANTOBJECT_H
+#endif // SYMBOLIC_CONSTANTOBJECT_H
\ No newline at end of file
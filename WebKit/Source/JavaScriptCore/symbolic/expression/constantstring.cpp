@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "constantstring.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,40 @@ ConstantString::ConstantString(std::string* value) :
 {
 }
 
+ConstantString* ConstantString::create(const std::string& value)
+{
+    return create(ExpressionArena::current(), value);
+}
+
+ConstantString* ConstantString::create(ExpressionArena* arena, const std::string& value)
+{
+    std::string* internedValue = arena->internString(value);
+
+    size_t hash = 15;
+    hash = hashCombine(hash, hashField(internedValue));
+
+    ExpressionArena::InternTable& table = arena->internTable(15);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ConstantString* candidate = static_cast<ConstantString*>(iter->second);
+        if (equalField(candidate->m_value, internedValue)) {
+            return candidate;
+        }
+    }
+
+    ConstantString* created = new (arena->allocate(sizeof(ConstantString))) ConstantString(internedValue);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ConstantString::copyTo(ExpressionArena* arena)
+{
+    return ConstantString::create(arena, *m_value);
+}
+
 void ConstantString::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
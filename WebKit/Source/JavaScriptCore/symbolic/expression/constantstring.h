@@ -34,15 +34,21 @@ namespace Symbolic
 class ConstantString : public StringExpression
 {
 public:
-    explicit ConstantString(std::string* value);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ConstantString* create(const std::string& value);
+    static ConstantString* create(ExpressionArena* arena, const std::string& value);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline std::string* getValue() {
 		return m_value;
 	}
 
 private:
+    explicit ConstantString(std::string* value);
+
 	std::string* m_value;
 
 };
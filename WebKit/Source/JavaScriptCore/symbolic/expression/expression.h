@@ -27,11 +27,18 @@
 namespace Symbolic
 {
 
+class ExpressionArena;
+
 class Expression 
 {
 public:
+    virtual ~Expression() {}
+
     virtual void accept(Visitor* visitor) = 0;
     virtual void accept(Visitor* visitor, void* arg) = 0;
+
+    // Creates a (structurally equal) copy of this expression in the given arena, see ExpressionArena::import.
+    virtual Expression* copyTo(ExpressionArena* arena) = 0;
 };
 
 }
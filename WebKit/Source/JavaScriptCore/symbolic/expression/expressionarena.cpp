@@ -0,0 +1,140 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifdef ARTEMIS
+
+#include <cstdlib>
+
+#include "expressionarena.h"
+
+namespace Symbolic
+{
+
+ExpressionArena* ExpressionArena::m_current = NULL;
+
+ExpressionArena::ExpressionArena()
+    : mChunkOffset(CHUNK_SIZE)
+{
+}
+
+ExpressionArena::~ExpressionArena()
+{
+    for (std::vector<Expression*>::iterator iter = mExpressions.begin(); iter != mExpressions.end(); ++iter) {
+        (*iter)->~Expression();
+    }
+
+    for (std::vector<char*>::iterator iter = mChunks.begin(); iter != mChunks.end(); ++iter) {
+        free(*iter);
+    }
+
+    if (m_current == this) {
+        m_current = NULL;
+    }
+
+    // The imports of other arenas may be keyed on expressions in this arena, which are now gone.
+    if (this != persistent()) {
+        persistent()->mImported.clear();
+    }
+}
+
+ExpressionArena* ExpressionArena::current()
+{
+    return m_current != NULL ? m_current : persistent();
+}
+
+void ExpressionArena::setCurrent(ExpressionArena* arena)
+{
+    m_current = arena;
+}
+
+ExpressionArena* ExpressionArena::persistent()
+{
+    static ExpressionArena* arena = new ExpressionArena();
+    return arena;
+}
+
+void* ExpressionArena::allocate(size_t size)
+{
+    size = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    if (mChunkOffset + size > CHUNK_SIZE) {
+        char* chunk = (char*)malloc(size > CHUNK_SIZE ? size : CHUNK_SIZE);
+        if (chunk == NULL) {
+            abort();
+        }
+
+        mChunks.push_back(chunk);
+        mChunkOffset = 0;
+    }
+
+    void* memory = mChunks.back() + mChunkOffset;
+    mChunkOffset += size;
+
+    return memory;
+}
+
+void ExpressionArena::adopt(Expression* expression)
+{
+    mExpressions.push_back(expression);
+}
+
+ExpressionArena::InternTable& ExpressionArena::internTable(unsigned int kind)
+{
+    if (kind >= mInternTables.size()) {
+        mInternTables.resize(kind + 1);
+    }
+
+    return mInternTables[kind];
+}
+
+std::string* ExpressionArena::internString(const std::string& value)
+{
+    // Elements of a set are never moved, the interned strings must not be modified.
+    return const_cast<std::string*>(&*mStrings.insert(value).first);
+}
+
+Expression* ExpressionArena::importExpression(Expression* expression)
+{
+    if (expression == NULL) {
+        return NULL;
+    }
+
+    std::tr1::unordered_map<Expression*, Expression*>::iterator iter = mImported.find(expression);
+    if (iter != mImported.end()) {
+        return iter->second;
+    }
+
+    Expression* copy = expression->copyTo(this);
+    mImported.insert(std::make_pair(expression, copy));
+    mImported.insert(std::make_pair(copy, copy));
+
+    return copy;
+}
+
+std::list<Expression*> ExpressionArena::importList(const std::list<Expression*>& expressions)
+{
+    std::list<Expression*> copies;
+    for (std::list<Expression*>::const_iterator iter = expressions.begin(); iter != expressions.end(); ++iter) {
+        copies.push_back(importExpression(*iter));
+    }
+
+    return copies;
+}
+
+}
+
+#endif
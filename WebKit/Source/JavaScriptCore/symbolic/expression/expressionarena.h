@@ -0,0 +1,177 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SYMBOLIC_EXPRESSIONARENA_H
+#define SYMBOLIC_EXPRESSIONARENA_H
+
+#include <cstring>
+#include <list>
+#include <new>
+#include <set>
+#include <string>
+#include <vector>
+#include <tr1/functional>
+#include <tr1/unordered_map>
+
+#include "expression.h"
+#include "symbolicsource.h"
+
+#ifdef ARTEMIS
+
+namespace Symbolic
+{
+
+/**
+ * Owns all symbolic expressions created while it is the current arena.
+ *
+ * Expressions are bump-allocated in large chunks and released together when the arena is deleted. The
+ * generated create() functions hash-cons expressions, such that an arena never contains two structurally
+ * equal expressions. Because sub-expressions are themselves unique, structural equality of two expressions
+ * in the same arena is pointer equality.
+ *
+ * The symbolic interpreter creates an arena per session (see SymbolicInterpreter::beginSession). Anything
+ * which should outlive its session, e.g. the branch conditions stored in the execution tree, must be
+ * copied into the persistent arena with ExpressionArena::persistent()->import(...).
+ */
+class ExpressionArena
+{
+public:
+    ExpressionArena();
+    ~ExpressionArena();
+
+    // The arena used by create() when no arena is given explicitly. Falls back to the persistent arena.
+    static ExpressionArena* current();
+    static void setCurrent(ExpressionArena* arena);
+
+    // Process wide arena which is never released.
+    static ExpressionArena* persistent();
+
+    /**
+     * Deep-copies the given expression (from any arena) into this arena and returns the copy. Sub-expressions
+     * which were imported before are shared.
+     */
+    Expression* importExpression(Expression* expression);
+
+    template <typename T>
+    T* import(T* expression) {
+        return static_cast<T*>(importExpression(expression));
+    }
+
+    std::list<Expression*> importList(const std::list<Expression*>& expressions);
+
+    inline size_t size() const {
+        return mExpressions.size();
+    }
+
+    // Used by the generated create() functions.
+
+    typedef std::tr1::unordered_multimap<size_t, Expression*> InternTable;
+
+    void* allocate(size_t size);
+    void adopt(Expression* expression);
+    InternTable& internTable(unsigned int kind);
+    std::string* internString(const std::string& value);
+
+private:
+    ExpressionArena(const ExpressionArena&);
+    ExpressionArena& operator=(const ExpressionArena&);
+
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    static const size_t ALIGNMENT = 16;
+
+    std::vector<char*> mChunks;
+    size_t mChunkOffset;
+
+    std::vector<Expression*> mExpressions;
+    std::vector<InternTable> mInternTables; // indexed by expression kind
+    std::set<std::string> mStrings;
+
+    // Expressions imported from other arenas, cleared whenever an arena is released as the keys could be reused.
+    std::tr1::unordered_map<Expression*, Expression*> mImported;
+
+    static ExpressionArena* m_current;
+};
+
+// Hashing and equality of expression fields, used by the generated create() functions.
+
+inline size_t hashCombine(size_t seed, size_t value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+inline size_t hashField(const void* pointer) // sub-expressions and interned strings
+{
+    return std::tr1::hash<const void*>()(pointer);
+}
+
+inline size_t hashField(int value)
+{
+    return (size_t)value;
+}
+
+inline size_t hashField(unsigned int value)
+{
+    return (size_t)value;
+}
+
+inline size_t hashField(bool value)
+{
+    return value ? 1 : 0;
+}
+
+inline size_t hashField(double value)
+{
+    unsigned long long bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return std::tr1::hash<unsigned long long>()(bits);
+}
+
+inline size_t hashField(const std::string& value)
+{
+    return std::tr1::hash<std::string>()(value);
+}
+
+inline size_t hashField(const SymbolicSource& source)
+{
+    return source.hash();
+}
+
+inline size_t hashField(const std::list<Expression*>& expressions)
+{
+    size_t hash = expressions.size();
+    for (std::list<Expression*>::const_iterator iter = expressions.begin(); iter != expressions.end(); ++iter) {
+        hash = hashCombine(hash, hashField(*iter));
+    }
+    return hash;
+}
+
+template <typename T>
+inline bool equalField(const T& a, const T& b)
+{
+    return a == b;
+}
+
+// Doubles are compared bitwise such that NaN constants can be shared as well.
+inline bool equalField(double a, double b)
+{
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+}
+
+#endif
+#endif // SYMBOLIC_EXPRESSIONARENA_H
@@ -7,6 +7,29 @@ import simplejson
 def field_filter_include(field):
 	return field.replace('*', '').lower()
 
+def create_parameter_type(field_type, enum_ids):
+	# Strings are interned by the arena, so create() takes them by value.
+	if field_type == 'std::string*':
+		return 'const std::string&'
+
+	if field_type.endswith('*') or field_type.islower() or field_type in enum_ids:
+		return field_type
+
+	return 'const %s&' % field_type
+
+def copy_field(field_type, field_name, expression_IDs):
+	# Expressions are imported (deep-copied) into the target arena, everything else is passed on as is.
+	if field_type.endswith('*') and field_type.replace('*', '') in expression_IDs:
+		return 'arena->import(m_%s)' % field_name
+
+	if field_type == 'std::list<Expression*>':
+		return 'arena->importList(m_%s)' % field_name
+
+	if field_type == 'std::string*':
+		return '*m_%s' % field_name
+
+	return 'm_%s' % field_name
+
 def generate_interface(target_dir, ID, parent):
 	
 	with open(os.path.join(target_dir, '%s.h' % ID.lower()), 'w') as fp:
@@ -50,7 +73,33 @@ def generate_interface(target_dir, ID, parent):
 			parent_inherit = ': public %s' % parent
 			parent_init = ': %s()' % parent
 
-		fp.write("""
+		if parent is None:
+			fp.write("""
+
+namespace Symbolic
+{
+
+class ExpressionArena;
+
+class %s %s
+{
+public:
+    virtual ~%s() {}
+
+    virtual void accept(Visitor* visitor) = 0;
+    virtual void accept(Visitor* visitor, void* arg) = 0;
+
+    // Creates a (structurally equal) copy of this expression in the given arena, see ExpressionArena::import.
+    virtual Expression* copyTo(ExpressionArena* arena) = 0;
+};
+
+}
+
+#endif
+""" % (ID, parent_inherit, ID))
+
+		else:
+			fp.write("""
 
 namespace Symbolic
 {
@@ -69,13 +118,18 @@ public:
 
 		fp.write("#endif // SYMBOLIC_%s_H" % ID.upper())
 
-def generate_expression(target_dir, ID, parent, fields, enums):
+def generate_expression(target_dir, ID, kind, parent, fields, enums, expression_IDs):
 	
 	########### HEADER ##############
 
 	signature = ', '.join(
 		['%s %s' % (field_type, field_name) for (field_type, field_name) in fields])
 
+	enum_ids = [enum['ID'] for enum in enums]
+
+	create_signature = ', '.join(
+		['%s %s' % (create_parameter_type(field_type, enum_ids), field_name) for (field_type, field_name) in fields])
+
 	with open(os.path.join(target_dir, '%s.h' % ID.lower()), 'w') as fp:
 		
 		fp.write(
@@ -105,8 +159,6 @@ def generate_expression(target_dir, ID, parent, fields, enums):
 		fp.write("#include <string>\n\n")
 		fp.write("#include <list>\n\n")
 
-		enum_ids = [enum['ID'] for enum in enums]
-
 		dependencies = [field_type.replace('*', '') for (field_type, field_name) in fields \
 			if not field_type.islower() and \
 			field_type.replace('*', '') not in enum_ids and \
@@ -139,10 +191,14 @@ Type opGetType(%s op);
 class %s : public %s
 {
 public:
-    explicit %s(%s);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static %s* create(%s);
+    static %s* create(ExpressionArena* arena, %s);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
-""" % (ID, parent, ID, signature))
+    Expression* copyTo(ExpressionArena* arena);
+""" % (ID, parent, ID, create_signature, ID, create_signature))
 
 		for field_type, field_name in fields:
 			fp.write("""
@@ -151,6 +207,7 @@ public:
 	}""" % (field_type, field_name.capitalize(), field_name))
 
 		fp.write("\n\nprivate:\n")
+		fp.write("    explicit %s(%s);\n\n" % (ID, signature))
 
 		for field_type, field_name in fields:
 			fp.write("\t%s m_%s;\n" % (field_type, field_name))
@@ -191,7 +248,7 @@ public:
 		
 		fp.write("#ifdef ARTEMIS\n\n");
 
-		dependencies = [ID]
+		dependencies = [ID, 'ExpressionArena']
 
 		for dependency in dependencies:
 			fp.write("#include \"%s.h\"\n" % field_filter_include(dependency))
@@ -236,6 +293,67 @@ Type opGetType(%s op)
 }
 """ % (ID, ID, signature, parent, init))
 
+		# interning constructors
+
+		arguments = ', '.join([field_name for (field_type, field_name) in fields])
+
+		interned = ''.join(
+			['    std::string* interned%s = arena->internString(%s);\n' % (field_name.capitalize(), field_name) \
+				for (field_type, field_name) in fields if field_type == 'std::string*'])
+
+		if interned:
+			interned += '\n'
+
+		def stored(field_type, field_name):
+			return 'interned%s' % field_name.capitalize() if field_type == 'std::string*' else field_name
+
+		hashes = ''.join(
+			['    hash = hashCombine(hash, hashField(%s));\n' % stored(field_type, field_name) \
+				for (field_type, field_name) in fields])
+
+		equals = ' &&\n            '.join(
+			['equalField(candidate->m_%s, %s)' % (field_name, stored(field_type, field_name)) \
+				for (field_type, field_name) in fields])
+
+		constructor_arguments = ', '.join([stored(field_type, field_name) for (field_type, field_name) in fields])
+
+		fp.write("""
+%s* %s::create(%s)
+{
+    return create(ExpressionArena::current(), %s);
+}
+
+%s* %s::create(ExpressionArena* arena, %s)
+{
+%s    size_t hash = %d;
+%s
+    ExpressionArena::InternTable& table = arena->internTable(%d);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        %s* candidate = static_cast<%s*>(iter->second);
+        if (%s) {
+            return candidate;
+        }
+    }
+
+    %s* created = new (arena->allocate(sizeof(%s))) %s(%s);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* %s::copyTo(ExpressionArena* arena)
+{
+    return %s::create(arena, %s);
+}
+""" % (ID, ID, create_signature, arguments,
+	   ID, ID, create_signature, interned, kind, hashes, kind,
+	   ID, ID, equals,
+	   ID, ID, ID, constructor_arguments,
+	   ID, ID, ', '.join([copy_field(field_type, field_name, expression_IDs) for (field_type, field_name) in fields])))
+
 		# visitor
 
 		fp.write("""
@@ -369,7 +487,9 @@ if __name__ == '__main__':
 
 		expressions = simplejson.loads(fp.read())
 
-		for expression in expressions:
+		expression_IDs = [expression['ID'] for expression in expressions]
+
+		for kind, expression in enumerate(expressions):
 			
 			if expression['type'] == 'interface':
 				generate_interface(
@@ -383,9 +503,11 @@ if __name__ == '__main__':
 				generate_expression(
 					target_dir,
 					expression['ID'],
+					kind,
 					expression['parent'],
 					fields,
-					expression.get('enums', []))
+					expression.get('enums', []),
+					expression_IDs)
 
 		cexps = [expression['ID'] for expression in expressions \
 					if expression['type'] == 'expression']
@@ -400,10 +522,14 @@ if __name__ == '__main__':
 			print '    symbolic/expression/%s.h \\' % expression['ID'].lower()
 
 		print '    symbolic/expression/visitor.h \\'
+		print '    symbolic/expression/symbolicsource.h \\'
+		print '    symbolic/expression/expressionarena.h \\'
 		print '    symbolic/expr.h'
 
 		print ''
 
+		print '    symbolic/expression/expressionarena.cpp \\'
+
 		for expression in expressions:
 
 			if expression['type'] == 'expression':
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "integerbinaryoperation.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -50,6 +51,42 @@ IntegerBinaryOperation::IntegerBinaryOperation(IntegerExpression* lhs, IntegerBi
 {
 }
 
+IntegerBinaryOperation* IntegerBinaryOperation::create(IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs)
+{
+    return create(ExpressionArena::current(), lhs, op, rhs);
+}
+
+IntegerBinaryOperation* IntegerBinaryOperation::create(ExpressionArena* arena, IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs)
+{
+    size_t hash = 4;
+    hash = hashCombine(hash, hashField(lhs));
+    hash = hashCombine(hash, hashField(op));
+    hash = hashCombine(hash, hashField(rhs));
+
+    ExpressionArena::InternTable& table = arena->internTable(4);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        IntegerBinaryOperation* candidate = static_cast<IntegerBinaryOperation*>(iter->second);
+        if (equalField(candidate->m_lhs, lhs) &&
+            equalField(candidate->m_op, op) &&
+            equalField(candidate->m_rhs, rhs)) {
+            return candidate;
+        }
+    }
+
+    IntegerBinaryOperation* created = new (arena->allocate(sizeof(IntegerBinaryOperation))) IntegerBinaryOperation(lhs, op, rhs);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* IntegerBinaryOperation::copyTo(ExpressionArena* arena)
+{
+    return IntegerBinaryOperation::create(arena, arena->import(m_lhs), m_op, arena->import(m_rhs));
+}
+
 void IntegerBinaryOperation::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
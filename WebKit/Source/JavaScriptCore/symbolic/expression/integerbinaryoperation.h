@@ -42,9 +42,13 @@ Type opGetType(IntegerBinaryOp op);
 class IntegerBinaryOperation : public IntegerExpression
 {
 public:
-    explicit IntegerBinaryOperation(IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static IntegerBinaryOperation* create(IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs);
+    static IntegerBinaryOperation* create(ExpressionArena* arena, IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline IntegerExpression* getLhs() {
 		return m_lhs;
@@ -57,6 +61,8 @@ public:
 	}
 
 private:
+    explicit IntegerBinaryOperation(IntegerExpression* lhs, IntegerBinaryOp op, IntegerExpression* rhs);
+
 	IntegerExpression* m_lhs;
 	IntegerBinaryOp m_op;
 	IntegerExpression* m_rhs;
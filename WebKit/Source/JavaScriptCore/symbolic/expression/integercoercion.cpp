@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "integercoercion.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ IntegerCoercion::IntegerCoercion(Expression* expression) :
 {
 }
 
+IntegerCoercion* IntegerCoercion::create(Expression* expression)
+{
+    return create(ExpressionArena::current(), expression);
+}
+
+IntegerCoercion* IntegerCoercion::create(ExpressionArena* arena, Expression* expression)
+{
+    size_t hash = 5;
+    hash = hashCombine(hash, hashField(expression));
+
+    ExpressionArena::InternTable& table = arena->internTable(5);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        IntegerCoercion* candidate = static_cast<IntegerCoercion*>(iter->second);
+        if (equalField(candidate->m_expression, expression)) {
+            return candidate;
+        }
+    }
+
+    IntegerCoercion* created = new (arena->allocate(sizeof(IntegerCoercion))) IntegerCoercion(expression);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* IntegerCoercion::copyTo(ExpressionArena* arena)
+{
+    return IntegerCoercion::create(arena, arena->import(m_expression));
+}
+
 void IntegerCoercion::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -35,15 +35,21 @@ namespace Symbolic
 class IntegerCoercion : public IntegerExpression
 {
 public:
-    explicit IntegerCoercion(Expression* expression);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static IntegerCoercion* create(Expression* expression);
+    static IntegerCoercion* create(ExpressionArena* arena, Expression* expression);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline Expression* getExpression() {
 		return m_expression;
 	}
 
 private:
+    explicit IntegerCoercion(Expression* expression);
+
 	Expression* m_expression;
 
 };
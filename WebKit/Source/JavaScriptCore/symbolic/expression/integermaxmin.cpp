@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "integermaxmin.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,40 @@ IntegerMaxMin::IntegerMaxMin(std::list<Expression*> expressions, bool max) :
 {
 }
 
+IntegerMaxMin* IntegerMaxMin::create(const std::list<Expression*>& expressions, bool max)
+{
+    return create(ExpressionArena::current(), expressions, max);
+}
+
+IntegerMaxMin* IntegerMaxMin::create(ExpressionArena* arena, const std::list<Expression*>& expressions, bool max)
+{
+    size_t hash = 6;
+    hash = hashCombine(hash, hashField(expressions));
+    hash = hashCombine(hash, hashField(max));
+
+    ExpressionArena::InternTable& table = arena->internTable(6);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        IntegerMaxMin* candidate = static_cast<IntegerMaxMin*>(iter->second);
+        if (equalField(candidate->m_expressions, expressions) &&
+            equalField(candidate->m_max, max)) {
+            return candidate;
+        }
+    }
+
+    IntegerMaxMin* created = new (arena->allocate(sizeof(IntegerMaxMin))) IntegerMaxMin(expressions, max);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* IntegerMaxMin::copyTo(ExpressionArena* arena)
+{
+    return IntegerMaxMin::create(arena, arena->importList(m_expressions), m_max);
+}
+
 void IntegerMaxMin::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -34,9 +34,13 @@ namespace Symbolic
 class IntegerMaxMin : public IntegerExpression
 {
 public:
-    explicit IntegerMaxMin(std::list<Expression*> expressions, bool max);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static IntegerMaxMin* create(const std::list<Expression*>& expressions, bool max);
+    static IntegerMaxMin* create(ExpressionArena* arena, const std::list<Expression*>& expressions, bool max);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline std::list<Expression*> getExpressions() {
 		return m_expressions;
@@ -46,6 +50,8 @@ public:
 	}
 
 private:
+    explicit IntegerMaxMin(std::list<Expression*> expressions, bool max);
+
 	std::list<Expression*> m_expressions;
 	bool m_max;
 
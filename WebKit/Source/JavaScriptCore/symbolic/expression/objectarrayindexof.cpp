@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "objectarrayindexof.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,40 @@ ObjectArrayIndexOf::ObjectArrayIndexOf(std::list<Expression*> array, Expression*
 {
 }
 
+ObjectArrayIndexOf* ObjectArrayIndexOf::create(const std::list<Expression*>& array, Expression* searchElement)
+{
+    return create(ExpressionArena::current(), array, searchElement);
+}
+
+ObjectArrayIndexOf* ObjectArrayIndexOf::create(ExpressionArena* arena, const std::list<Expression*>& array, Expression* searchElement)
+{
+    size_t hash = 11;
+    hash = hashCombine(hash, hashField(array));
+    hash = hashCombine(hash, hashField(searchElement));
+
+    ExpressionArena::InternTable& table = arena->internTable(11);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ObjectArrayIndexOf* candidate = static_cast<ObjectArrayIndexOf*>(iter->second);
+        if (equalField(candidate->m_array, array) &&
+            equalField(candidate->m_searchElement, searchElement)) {
+            return candidate;
+        }
+    }
+
+    ObjectArrayIndexOf* created = new (arena->allocate(sizeof(ObjectArrayIndexOf))) ObjectArrayIndexOf(array, searchElement);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ObjectArrayIndexOf::copyTo(ExpressionArena* arena)
+{
+    return ObjectArrayIndexOf::create(arena, arena->importList(m_array), arena->import(m_searchElement));
+}
+
 void ObjectArrayIndexOf::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
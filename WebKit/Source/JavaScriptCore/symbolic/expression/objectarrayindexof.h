@@ -35,9 +35,13 @@ namespace Symbolic
 class ObjectArrayIndexOf : public IntegerExpression
 {
 public:
-    explicit ObjectArrayIndexOf(std::list<Expression*> array, Expression* searchElement);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ObjectArrayIndexOf* create(const std::list<Expression*>& array, Expression* searchElement);
+    static ObjectArrayIndexOf* create(ExpressionArena* arena, const std::list<Expression*>& array, Expression* searchElement);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline std::list<Expression*> getArray() {
 		return m_array;
@@ -47,6 +51,8 @@ public:
 	}
 
 private:
+    explicit ObjectArrayIndexOf(std::list<Expression*> array, Expression* searchElement);
+
 	std::list<Expression*> m_array;
 	Expression* m_searchElement;
 
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "objectbinaryoperation.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -50,6 +51,42 @@ ObjectBinaryOperation::ObjectBinaryOperation(ObjectExpression* lhs, ObjectBinary
 {
 }
 
+ObjectBinaryOperation* ObjectBinaryOperation::create(ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs)
+{
+    return create(ExpressionArena::current(), lhs, op, rhs);
+}
+
+ObjectBinaryOperation* ObjectBinaryOperation::create(ExpressionArena* arena, ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs)
+{
+    size_t hash = 12;
+    hash = hashCombine(hash, hashField(lhs));
+    hash = hashCombine(hash, hashField(op));
+    hash = hashCombine(hash, hashField(rhs));
+
+    ExpressionArena::InternTable& table = arena->internTable(12);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        ObjectBinaryOperation* candidate = static_cast<ObjectBinaryOperation*>(iter->second);
+        if (equalField(candidate->m_lhs, lhs) &&
+            equalField(candidate->m_op, op) &&
+            equalField(candidate->m_rhs, rhs)) {
+            return candidate;
+        }
+    }
+
+    ObjectBinaryOperation* created = new (arena->allocate(sizeof(ObjectBinaryOperation))) ObjectBinaryOperation(lhs, op, rhs);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* ObjectBinaryOperation::copyTo(ExpressionArena* arena)
+{
+    return ObjectBinaryOperation::create(arena, arena->import(m_lhs), m_op, arena->import(m_rhs));
+}
+
 void ObjectBinaryOperation::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -43,9 +43,13 @@ Type opGetType(ObjectBinaryOp op);
 class ObjectBinaryOperation : public BooleanExpression
 {
 public:
-    explicit ObjectBinaryOperation(ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static ObjectBinaryOperation* create(ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs);
+    static ObjectBinaryOperation* create(ExpressionArena* arena, ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline ObjectExpression* getLhs() {
 		return m_lhs;
@@ -58,6 +62,8 @@ public:
 	}
 
 private:
+    explicit ObjectBinaryOperation(ObjectExpression* lhs, ObjectBinaryOp op, ObjectExpression* rhs);
+
 	ObjectExpression* m_lhs;
 	ObjectBinaryOp m_op;
 	ObjectExpression* m_rhs;
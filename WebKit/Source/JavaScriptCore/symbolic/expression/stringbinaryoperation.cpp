@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringbinaryoperation.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -50,6 +51,42 @@ StringBinaryOperation::StringBinaryOperation(StringExpression* lhs, StringBinary
 {
 }
 
+StringBinaryOperation* StringBinaryOperation::create(StringExpression* lhs, StringBinaryOp op, StringExpression* rhs)
+{
+    return create(ExpressionArena::current(), lhs, op, rhs);
+}
+
+StringBinaryOperation* StringBinaryOperation::create(ExpressionArena* arena, StringExpression* lhs, StringBinaryOp op, StringExpression* rhs)
+{
+    size_t hash = 16;
+    hash = hashCombine(hash, hashField(lhs));
+    hash = hashCombine(hash, hashField(op));
+    hash = hashCombine(hash, hashField(rhs));
+
+    ExpressionArena::InternTable& table = arena->internTable(16);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringBinaryOperation* candidate = static_cast<StringBinaryOperation*>(iter->second);
+        if (equalField(candidate->m_lhs, lhs) &&
+            equalField(candidate->m_op, op) &&
+            equalField(candidate->m_rhs, rhs)) {
+            return candidate;
+        }
+    }
+
+    StringBinaryOperation* created = new (arena->allocate(sizeof(StringBinaryOperation))) StringBinaryOperation(lhs, op, rhs);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringBinaryOperation::copyTo(ExpressionArena* arena)
+{
+    return StringBinaryOperation::create(arena, arena->import(m_lhs), m_op, arena->import(m_rhs));
+}
+
 void StringBinaryOperation::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -42,9 +42,13 @@ Type opGetType(StringBinaryOp op);
 class StringBinaryOperation : public StringExpression
 {
 public:
-    explicit StringBinaryOperation(StringExpression* lhs, StringBinaryOp op, StringExpression* rhs);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringBinaryOperation* create(StringExpression* lhs, StringBinaryOp op, StringExpression* rhs);
+    static StringBinaryOperation* create(ExpressionArena* arena, StringExpression* lhs, StringBinaryOp op, StringExpression* rhs);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getLhs() {
 		return m_lhs;
@@ -57,6 +61,8 @@ public:
 	}
 
 private:
+    explicit StringBinaryOperation(StringExpression* lhs, StringBinaryOp op, StringExpression* rhs);
+
 	StringExpression* m_lhs;
 	StringBinaryOp m_op;
 	StringExpression* m_rhs;
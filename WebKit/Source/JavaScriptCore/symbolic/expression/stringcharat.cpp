@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringcharat.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,40 @@ StringCharAt::StringCharAt(StringExpression* source, unsigned int position) :
 {
 }
 
+StringCharAt* StringCharAt::create(StringExpression* source, unsigned int position)
+{
+    return create(ExpressionArena::current(), source, position);
+}
+
+StringCharAt* StringCharAt::create(ExpressionArena* arena, StringExpression* source, unsigned int position)
+{
+    size_t hash = 21;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(position));
+
+    ExpressionArena::InternTable& table = arena->internTable(21);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringCharAt* candidate = static_cast<StringCharAt*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_position, position)) {
+            return candidate;
+        }
+    }
+
+    StringCharAt* created = new (arena->allocate(sizeof(StringCharAt))) StringCharAt(source, position);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringCharAt::copyTo(ExpressionArena* arena)
+{
+    return StringCharAt::create(arena, arena->import(m_source), m_position);
+}
+
 void StringCharAt::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -34,9 +34,13 @@ namespace Symbolic
 class StringCharAt : public StringExpression
 {
 public:
-    explicit StringCharAt(StringExpression* source, unsigned int position);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringCharAt* create(StringExpression* source, unsigned int position);
+    static StringCharAt* create(ExpressionArena* arena, StringExpression* source, unsigned int position);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -46,6 +50,8 @@ public:
 	}
 
 private:
+    explicit StringCharAt(StringExpression* source, unsigned int position);
+
 	StringExpression* m_source;
 	unsigned int m_position;
 
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringcoercion.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ StringCoercion::StringCoercion(Expression* expression) :
 {
 }
 
+StringCoercion* StringCoercion::create(Expression* expression)
+{
+    return create(ExpressionArena::current(), expression);
+}
+
+StringCoercion* StringCoercion::create(ExpressionArena* arena, Expression* expression)
+{
+    size_t hash = 17;
+    hash = hashCombine(hash, hashField(expression));
+
+    ExpressionArena::InternTable& table = arena->internTable(17);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringCoercion* candidate = static_cast<StringCoercion*>(iter->second);
+        if (equalField(candidate->m_expression, expression)) {
+            return candidate;
+        }
+    }
+
+    StringCoercion* created = new (arena->allocate(sizeof(StringCoercion))) StringCoercion(expression);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringCoercion::copyTo(ExpressionArena* arena)
+{
+    return StringCoercion::create(arena, arena->import(m_expression));
+}
+
 void StringCoercion::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -35,15 +35,21 @@ namespace Symbolic
 class StringCoercion : public StringExpression
 {
 public:
-    explicit StringCoercion(Expression* expression);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringCoercion* create(Expression* expression);
+    static StringCoercion* create(ExpressionArena* arena, Expression* expression);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline Expression* getExpression() {
 		return m_expression;
 	}
 
 private:
+    explicit StringCoercion(Expression* expression);
+
 	Expression* m_expression;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringindexof.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -31,6 +32,42 @@ StringIndexOf::StringIndexOf(StringExpression* source, StringExpression* pattern
 {
 }
 
+StringIndexOf* StringIndexOf::create(StringExpression* source, StringExpression* pattern, IntegerExpression* offset)
+{
+    return create(ExpressionArena::current(), source, pattern, offset);
+}
+
+StringIndexOf* StringIndexOf::create(ExpressionArena* arena, StringExpression* source, StringExpression* pattern, IntegerExpression* offset)
+{
+    size_t hash = 20;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(pattern));
+    hash = hashCombine(hash, hashField(offset));
+
+    ExpressionArena::InternTable& table = arena->internTable(20);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringIndexOf* candidate = static_cast<StringIndexOf*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_pattern, pattern) &&
+            equalField(candidate->m_offset, offset)) {
+            return candidate;
+        }
+    }
+
+    StringIndexOf* created = new (arena->allocate(sizeof(StringIndexOf))) StringIndexOf(source, pattern, offset);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringIndexOf::copyTo(ExpressionArena* arena)
+{
+    return StringIndexOf::create(arena, arena->import(m_source), arena->import(m_pattern), arena->import(m_offset));
+}
+
 void StringIndexOf::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
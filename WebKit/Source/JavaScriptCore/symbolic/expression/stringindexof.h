@@ -35,9 +35,13 @@ namespace Symbolic
 class StringIndexOf : public IntegerExpression
 {
 public:
-    explicit StringIndexOf(StringExpression* source, StringExpression* pattern, IntegerExpression* offset);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringIndexOf* create(StringExpression* source, StringExpression* pattern, IntegerExpression* offset);
+    static StringIndexOf* create(ExpressionArena* arena, StringExpression* source, StringExpression* pattern, IntegerExpression* offset);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -50,6 +54,8 @@ public:
 	}
 
 private:
+    explicit StringIndexOf(StringExpression* source, StringExpression* pattern, IntegerExpression* offset);
+
 	StringExpression* m_source;
 	StringExpression* m_pattern;
 	IntegerExpression* m_offset;
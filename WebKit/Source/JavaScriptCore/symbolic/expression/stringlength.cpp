@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringlength.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ StringLength::StringLength(StringExpression* string) :
 {
 }
 
+StringLength* StringLength::create(StringExpression* string)
+{
+    return create(ExpressionArena::current(), string);
+}
+
+StringLength* StringLength::create(ExpressionArena* arena, StringExpression* string)
+{
+    size_t hash = 18;
+    hash = hashCombine(hash, hashField(string));
+
+    ExpressionArena::InternTable& table = arena->internTable(18);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringLength* candidate = static_cast<StringLength*>(iter->second);
+        if (equalField(candidate->m_string, string)) {
+            return candidate;
+        }
+    }
+
+    StringLength* created = new (arena->allocate(sizeof(StringLength))) StringLength(string);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringLength::copyTo(ExpressionArena* arena)
+{
+    return StringLength::create(arena, arena->import(m_string));
+}
+
 void StringLength::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -35,15 +35,21 @@ namespace Symbolic
 class StringLength : public IntegerExpression
 {
 public:
-    explicit StringLength(StringExpression* string);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringLength* create(StringExpression* string);
+    static StringLength* create(ExpressionArena* arena, StringExpression* string);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getString() {
 		return m_string;
 	}
 
 private:
+    explicit StringLength(StringExpression* string);
+
 	StringExpression* m_string;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexreplace.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -31,6 +32,45 @@ StringRegexReplace::StringRegexReplace(StringExpression* source, std::string* re
 {
 }
 
+StringRegexReplace* StringRegexReplace::create(StringExpression* source, const std::string& regexpattern, const std::string& replace)
+{
+    return create(ExpressionArena::current(), source, regexpattern, replace);
+}
+
+StringRegexReplace* StringRegexReplace::create(ExpressionArena* arena, StringExpression* source, const std::string& regexpattern, const std::string& replace)
+{
+    std::string* internedRegexpattern = arena->internString(regexpattern);
+    std::string* internedReplace = arena->internString(replace);
+
+    size_t hash = 22;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(internedRegexpattern));
+    hash = hashCombine(hash, hashField(internedReplace));
+
+    ExpressionArena::InternTable& table = arena->internTable(22);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexReplace* candidate = static_cast<StringRegexReplace*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_regexpattern, internedRegexpattern) &&
+            equalField(candidate->m_replace, internedReplace)) {
+            return candidate;
+        }
+    }
+
+    StringRegexReplace* created = new (arena->allocate(sizeof(StringRegexReplace))) StringRegexReplace(source, internedRegexpattern, internedReplace);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexReplace::copyTo(ExpressionArena* arena)
+{
+    return StringRegexReplace::create(arena, arena->import(m_source), *m_regexpattern, *m_replace);
+}
+
 void StringRegexReplace::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -34,9 +34,13 @@ namespace Symbolic
 class StringRegexReplace : public StringExpression
 {
 public:
-    explicit StringRegexReplace(StringExpression* source, std::string* regexpattern, std::string* replace);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringRegexReplace* create(StringExpression* source, const std::string& regexpattern, const std::string& replace);
+    static StringRegexReplace* create(ExpressionArena* arena, StringExpression* source, const std::string& regexpattern, const std::string& replace);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -49,6 +53,8 @@ public:
 	}
 
 private:
+    explicit StringRegexReplace(StringExpression* source, std::string* regexpattern, std::string* replace);
+
 	StringExpression* m_source;
 	std::string* m_regexpattern;
 	std::string* m_replace;
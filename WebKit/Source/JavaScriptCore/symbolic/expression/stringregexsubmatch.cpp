@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexsubmatch.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,42 @@ StringRegexSubmatch::StringRegexSubmatch(StringExpression* source, std::string*
 {
 }
 
+StringRegexSubmatch* StringRegexSubmatch::create(StringExpression* source, const std::string& regexpattern)
+{
+    return create(ExpressionArena::current(), source, regexpattern);
+}
+
+StringRegexSubmatch* StringRegexSubmatch::create(ExpressionArena* arena, StringExpression* source, const std::string& regexpattern)
+{
+    std::string* internedRegexpattern = arena->internString(regexpattern);
+
+    size_t hash = 23;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(internedRegexpattern));
+
+    ExpressionArena::InternTable& table = arena->internTable(23);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexSubmatch* candidate = static_cast<StringRegexSubmatch*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_regexpattern, internedRegexpattern)) {
+            return candidate;
+        }
+    }
+
+    StringRegexSubmatch* created = new (arena->allocate(sizeof(StringRegexSubmatch))) StringRegexSubmatch(source, internedRegexpattern);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexSubmatch::copyTo(ExpressionArena* arena)
+{
+    return StringRegexSubmatch::create(arena, arena->import(m_source), *m_regexpattern);
+}
+
 void StringRegexSubmatch::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -35,9 +35,13 @@ namespace Symbolic
 class StringRegexSubmatch : public BooleanExpression
 {
 public:
-    explicit StringRegexSubmatch(StringExpression* source, std::string* regexpattern);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringRegexSubmatch* create(StringExpression* source, const std::string& regexpattern);
+    static StringRegexSubmatch* create(ExpressionArena* arena, StringExpression* source, const std::string& regexpattern);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -47,6 +51,8 @@ public:
 	}
 
 private:
+    explicit StringRegexSubmatch(StringExpression* source, std::string* regexpattern);
+
 	StringExpression* m_source;
 	std::string* m_regexpattern;
 
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexsubmatcharray.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -31,6 +32,44 @@ StringRegexSubmatchArray::StringRegexSubmatchArray(unsigned int identifier, Stri
 {
 }
 
+StringRegexSubmatchArray* StringRegexSubmatchArray::create(unsigned int identifier, StringExpression* source, const std::string& regexpattern)
+{
+    return create(ExpressionArena::current(), identifier, source, regexpattern);
+}
+
+StringRegexSubmatchArray* StringRegexSubmatchArray::create(ExpressionArena* arena, unsigned int identifier, StringExpression* source, const std::string& regexpattern)
+{
+    std::string* internedRegexpattern = arena->internString(regexpattern);
+
+    size_t hash = 25;
+    hash = hashCombine(hash, hashField(identifier));
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(internedRegexpattern));
+
+    ExpressionArena::InternTable& table = arena->internTable(25);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexSubmatchArray* candidate = static_cast<StringRegexSubmatchArray*>(iter->second);
+        if (equalField(candidate->m_identifier, identifier) &&
+            equalField(candidate->m_source, source) &&
+            equalField(candidate->m_regexpattern, internedRegexpattern)) {
+            return candidate;
+        }
+    }
+
+    StringRegexSubmatchArray* created = new (arena->allocate(sizeof(StringRegexSubmatchArray))) StringRegexSubmatchArray(identifier, source, internedRegexpattern);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexSubmatchArray::copyTo(ExpressionArena* arena)
+{
+    return StringRegexSubmatchArray::create(arena, m_identifier, arena->import(m_source), *m_regexpattern);
+}
+
 void StringRegexSubmatchArray::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -35,9 +35,13 @@ namespace Symbolic
 class StringRegexSubmatchArray : public Expression
 {
 public:
-    explicit StringRegexSubmatchArray(unsigned int identifier, StringExpression* source, std::string* regexpattern);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringRegexSubmatchArray* create(unsigned int identifier, StringExpression* source, const std::string& regexpattern);
+    static StringRegexSubmatchArray* create(ExpressionArena* arena, unsigned int identifier, StringExpression* source, const std::string& regexpattern);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline unsigned int getIdentifier() {
 		return m_identifier;
@@ -50,6 +54,8 @@ public:
 	}
 
 private:
+    explicit StringRegexSubmatchArray(unsigned int identifier, StringExpression* source, std::string* regexpattern);
+
 	unsigned int m_identifier;
 	StringExpression* m_source;
 	std::string* m_regexpattern;
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexsubmatcharrayat.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,40 @@ StringRegexSubmatchArrayAt::StringRegexSubmatchArrayAt(StringRegexSubmatchArray*
 {
 }
 
+StringRegexSubmatchArrayAt* StringRegexSubmatchArrayAt::create(StringRegexSubmatchArray* match, int group)
+{
+    return create(ExpressionArena::current(), match, group);
+}
+
+StringRegexSubmatchArrayAt* StringRegexSubmatchArrayAt::create(ExpressionArena* arena, StringRegexSubmatchArray* match, int group)
+{
+    size_t hash = 26;
+    hash = hashCombine(hash, hashField(match));
+    hash = hashCombine(hash, hashField(group));
+
+    ExpressionArena::InternTable& table = arena->internTable(26);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexSubmatchArrayAt* candidate = static_cast<StringRegexSubmatchArrayAt*>(iter->second);
+        if (equalField(candidate->m_match, match) &&
+            equalField(candidate->m_group, group)) {
+            return candidate;
+        }
+    }
+
+    StringRegexSubmatchArrayAt* created = new (arena->allocate(sizeof(StringRegexSubmatchArrayAt))) StringRegexSubmatchArrayAt(match, group);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexSubmatchArrayAt::copyTo(ExpressionArena* arena)
+{
+    return StringRegexSubmatchArrayAt::create(arena, arena->import(m_match), m_group);
+}
+
 void StringRegexSubmatchArrayAt::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
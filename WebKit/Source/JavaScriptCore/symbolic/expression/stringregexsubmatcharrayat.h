@@ -35,9 +35,13 @@ namespace Symbolic
 class StringRegexSubmatchArrayAt : public StringExpression
 {
 public:
-    explicit StringRegexSubmatchArrayAt(StringRegexSubmatchArray* match, int group);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringRegexSubmatchArrayAt* create(StringRegexSubmatchArray* match, int group);
+    static StringRegexSubmatchArrayAt* create(ExpressionArena* arena, StringRegexSubmatchArray* match, int group);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringRegexSubmatchArray* getMatch() {
 		return m_match;
@@ -47,6 +51,8 @@ public:
 	}
 
 private:
+    explicit StringRegexSubmatchArrayAt(StringRegexSubmatchArray* match, int group);
+
 	StringRegexSubmatchArray* m_match;
 	int m_group;
 
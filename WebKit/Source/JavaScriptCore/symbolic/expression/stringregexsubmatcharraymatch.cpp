@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexsubmatcharraymatch.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ StringRegexSubmatchArrayMatch::StringRegexSubmatchArrayMatch(StringRegexSubmatch
 {
 }
 
+StringRegexSubmatchArrayMatch* StringRegexSubmatchArrayMatch::create(StringRegexSubmatchArray* match)
+{
+    return create(ExpressionArena::current(), match);
+}
+
+StringRegexSubmatchArrayMatch* StringRegexSubmatchArrayMatch::create(ExpressionArena* arena, StringRegexSubmatchArray* match)
+{
+    size_t hash = 27;
+    hash = hashCombine(hash, hashField(match));
+
+    ExpressionArena::InternTable& table = arena->internTable(27);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexSubmatchArrayMatch* candidate = static_cast<StringRegexSubmatchArrayMatch*>(iter->second);
+        if (equalField(candidate->m_match, match)) {
+            return candidate;
+        }
+    }
+
+    StringRegexSubmatchArrayMatch* created = new (arena->allocate(sizeof(StringRegexSubmatchArrayMatch))) StringRegexSubmatchArrayMatch(match);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexSubmatchArrayMatch::copyTo(ExpressionArena* arena)
+{
+    return StringRegexSubmatchArrayMatch::create(arena, arena->import(m_match));
+}
+
 void StringRegexSubmatchArrayMatch::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
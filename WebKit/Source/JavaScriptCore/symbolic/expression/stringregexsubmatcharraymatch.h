@@ -35,15 +35,21 @@ namespace Symbolic
 class StringRegexSubmatchArrayMatch : public ObjectExpression
 {
 public:
-    explicit StringRegexSubmatchArrayMatch(StringRegexSubmatchArray* match);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringRegexSubmatchArrayMatch* create(StringRegexSubmatchArray* match);
+    static StringRegexSubmatchArrayMatch* create(ExpressionArena* arena, StringRegexSubmatchArray* match);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringRegexSubmatchArray* getMatch() {
 		return m_match;
 	}
 
 private:
+    explicit StringRegexSubmatchArrayMatch(StringRegexSubmatchArray* match);
+
 	StringRegexSubmatchArray* m_match;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringregexsubmatchindex.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,42 @@ StringRegexSubmatchIndex::StringRegexSubmatchIndex(StringExpression* source, std
 {
 }
 
+StringRegexSubmatchIndex* StringRegexSubmatchIndex::create(StringExpression* source, const std::string& regexpattern)
+{
+    return create(ExpressionArena::current(), source, regexpattern);
+}
+
+StringRegexSubmatchIndex* StringRegexSubmatchIndex::create(ExpressionArena* arena, StringExpression* source, const std::string& regexpattern)
+{
+    std::string* internedRegexpattern = arena->internString(regexpattern);
+
+    size_t hash = 24;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(internedRegexpattern));
+
+    ExpressionArena::InternTable& table = arena->internTable(24);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringRegexSubmatchIndex* candidate = static_cast<StringRegexSubmatchIndex*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_regexpattern, internedRegexpattern)) {
+            return candidate;
+        }
+    }
+
+    StringRegexSubmatchIndex* created = new (arena->allocate(sizeof(StringRegexSubmatchIndex))) StringRegexSubmatchIndex(source, internedRegexpattern);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringRegexSubmatchIndex::copyTo(ExpressionArena* arena)
+{
+    return StringRegexSubmatchIndex::create(arena, arena->import(m_source), *m_regexpattern);
+}
+
 void StringRegexSubmatchIndex::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
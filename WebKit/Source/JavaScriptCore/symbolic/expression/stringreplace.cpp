@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringreplace.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -31,6 +32,45 @@ StringReplace::StringReplace(StringExpression* source, std::string* pattern, std
 {
 }
 
+StringReplace* StringReplace::create(StringExpression* source, const std::string& pattern, const std::string& replace)
+{
+    return create(ExpressionArena::current(), source, pattern, replace);
+}
+
+StringReplace* StringReplace::create(ExpressionArena* arena, StringExpression* source, const std::string& pattern, const std::string& replace)
+{
+    std::string* internedPattern = arena->internString(pattern);
+    std::string* internedReplace = arena->internString(replace);
+
+    size_t hash = 19;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(internedPattern));
+    hash = hashCombine(hash, hashField(internedReplace));
+
+    ExpressionArena::InternTable& table = arena->internTable(19);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringReplace* candidate = static_cast<StringReplace*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_pattern, internedPattern) &&
+            equalField(candidate->m_replace, internedReplace)) {
+            return candidate;
+        }
+    }
+
+    StringReplace* created = new (arena->allocate(sizeof(StringReplace))) StringReplace(source, internedPattern, internedReplace);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringReplace::copyTo(ExpressionArena* arena)
+{
+    return StringReplace::create(arena, arena->import(m_source), *m_pattern, *m_replace);
+}
+
 void StringReplace::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
@@ -34,9 +34,13 @@ namespace Symbolic
 class StringReplace : public StringExpression
 {
 public:
-    explicit StringReplace(StringExpression* source, std::string* pattern, std::string* replace);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringReplace* create(StringExpression* source, const std::string& pattern, const std::string& replace);
+    static StringReplace* create(ExpressionArena* arena, StringExpression* source, const std::string& pattern, const std::string& replace);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -49,6 +53,8 @@ public:
 	}
 
 private:
+    explicit StringReplace(StringExpression* source, std::string* pattern, std::string* replace);
+
 	StringExpression* m_source;
 	std::string* m_pattern;
 	std::string* m_replace;
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "stringsubstring.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -31,6 +32,42 @@ StringSubstring::StringSubstring(StringExpression* source, int from, int length)
 {
 }
 
+StringSubstring* StringSubstring::create(StringExpression* source, int from, int length)
+{
+    return create(ExpressionArena::current(), source, from, length);
+}
+
+StringSubstring* StringSubstring::create(ExpressionArena* arena, StringExpression* source, int from, int length)
+{
+    size_t hash = 28;
+    hash = hashCombine(hash, hashField(source));
+    hash = hashCombine(hash, hashField(from));
+    hash = hashCombine(hash, hashField(length));
+
+    ExpressionArena::InternTable& table = arena->internTable(28);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        StringSubstring* candidate = static_cast<StringSubstring*>(iter->second);
+        if (equalField(candidate->m_source, source) &&
+            equalField(candidate->m_from, from) &&
+            equalField(candidate->m_length, length)) {
+            return candidate;
+        }
+    }
+
+    StringSubstring* created = new (arena->allocate(sizeof(StringSubstring))) StringSubstring(source, from, length);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* StringSubstring::copyTo(ExpressionArena* arena)
+{
+    return StringSubstring::create(arena, arena->import(m_source), m_from, m_length);
+}
+
 void StringSubstring::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
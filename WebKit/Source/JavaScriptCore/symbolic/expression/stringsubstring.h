@@ -34,9 +34,13 @@ namespace Symbolic
 class StringSubstring : public StringExpression
 {
 public:
-    explicit StringSubstring(StringExpression* source, int from, int length);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static StringSubstring* create(StringExpression* source, int from, int length);
+    static StringSubstring* create(ExpressionArena* arena, StringExpression* source, int from, int length);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline StringExpression* getSource() {
 		return m_source;
@@ -49,6 +53,8 @@ public:
 	}
 
 private:
+    explicit StringSubstring(StringExpression* source, int from, int length);
+
 	StringExpression* m_source;
 	int m_from;
 	int m_length;
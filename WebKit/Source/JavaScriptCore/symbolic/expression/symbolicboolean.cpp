@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "symbolicboolean.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ SymbolicBoolean::SymbolicBoolean(SymbolicSource source) :
 {
 }
 
+SymbolicBoolean* SymbolicBoolean::create(const SymbolicSource& source)
+{
+    return create(ExpressionArena::current(), source);
+}
+
+SymbolicBoolean* SymbolicBoolean::create(ExpressionArena* arena, const SymbolicSource& source)
+{
+    size_t hash = 30;
+    hash = hashCombine(hash, hashField(source));
+
+    ExpressionArena::InternTable& table = arena->internTable(30);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        SymbolicBoolean* candidate = static_cast<SymbolicBoolean*>(iter->second);
+        if (equalField(candidate->m_source, source)) {
+            return candidate;
+        }
+    }
+
+    SymbolicBoolean* created = new (arena->allocate(sizeof(SymbolicBoolean))) SymbolicBoolean(source);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* SymbolicBoolean::copyTo(ExpressionArena* arena)
+{
+    return SymbolicBoolean::create(arena, m_source);
+}
+
 void SymbolicBoolean::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
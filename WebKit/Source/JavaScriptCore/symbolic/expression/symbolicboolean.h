@@ -35,15 +35,21 @@ namespace Symbolic
 class SymbolicBoolean : public BooleanExpression
 {
 public:
-    explicit SymbolicBoolean(SymbolicSource source);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static SymbolicBoolean* create(const SymbolicSource& source);
+    static SymbolicBoolean* create(ExpressionArena* arena, const SymbolicSource& source);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline SymbolicSource getSource() {
 		return m_source;
 	}
 
 private:
+    explicit SymbolicBoolean(SymbolicSource source);
+
 	SymbolicSource m_source;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "symbolicinteger.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ SymbolicInteger::SymbolicInteger(SymbolicSource source) :
 {
 }
 
+SymbolicInteger* SymbolicInteger::create(const SymbolicSource& source)
+{
+    return create(ExpressionArena::current(), source);
+}
+
+SymbolicInteger* SymbolicInteger::create(ExpressionArena* arena, const SymbolicSource& source)
+{
+    size_t hash = 2;
+    hash = hashCombine(hash, hashField(source));
+
+    ExpressionArena::InternTable& table = arena->internTable(2);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        SymbolicInteger* candidate = static_cast<SymbolicInteger*>(iter->second);
+        if (equalField(candidate->m_source, source)) {
+            return candidate;
+        }
+    }
+
+    SymbolicInteger* created = new (arena->allocate(sizeof(SymbolicInteger))) SymbolicInteger(source);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* SymbolicInteger::copyTo(ExpressionArena* arena)
+{
+    return SymbolicInteger::create(arena, m_source);
+}
+
 void SymbolicInteger::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
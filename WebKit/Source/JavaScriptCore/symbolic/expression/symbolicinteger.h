@@ -35,15 +35,21 @@ namespace Symbolic
 class SymbolicInteger : public IntegerExpression
 {
 public:
-    explicit SymbolicInteger(SymbolicSource source);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static SymbolicInteger* create(const SymbolicSource& source);
+    static SymbolicInteger* create(ExpressionArena* arena, const SymbolicSource& source);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline SymbolicSource getSource() {
 		return m_source;
 	}
 
 private:
+    explicit SymbolicInteger(SymbolicSource source);
+
 	SymbolicSource m_source;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "symbolicobject.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ SymbolicObject::SymbolicObject(SymbolicSource source) :
 {
 }
 
+SymbolicObject* SymbolicObject::create(const SymbolicSource& source)
+{
+    return create(ExpressionArena::current(), source);
+}
+
+SymbolicObject* SymbolicObject::create(ExpressionArena* arena, const SymbolicSource& source)
+{
+    size_t hash = 8;
+    hash = hashCombine(hash, hashField(source));
+
+    ExpressionArena::InternTable& table = arena->internTable(8);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        SymbolicObject* candidate = static_cast<SymbolicObject*>(iter->second);
+        if (equalField(candidate->m_source, source)) {
+            return candidate;
+        }
+    }
+
+    SymbolicObject* created = new (arena->allocate(sizeof(SymbolicObject))) SymbolicObject(source);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* SymbolicObject::copyTo(ExpressionArena* arena)
+{
+    return SymbolicObject::create(arena, m_source);
+}
+
 void SymbolicObject::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
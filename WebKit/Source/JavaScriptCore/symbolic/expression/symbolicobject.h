@@ -35,15 +35,21 @@ namespace Symbolic
 class SymbolicObject : public ObjectExpression
 {
 public:
-    explicit SymbolicObject(SymbolicSource source);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static SymbolicObject* create(const SymbolicSource& source);
+    static SymbolicObject* create(ExpressionArena* arena, const SymbolicSource& source);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline SymbolicSource getSource() {
 		return m_source;
 	}
 
 private:
+    explicit SymbolicObject(SymbolicSource source);
+
 	SymbolicSource m_source;
 
 };
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "symbolicobjectpropertystring.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -30,6 +31,40 @@ SymbolicObjectPropertyString::SymbolicObjectPropertyString(SymbolicObject* obj,
 {
 }
 
+SymbolicObjectPropertyString* SymbolicObjectPropertyString::create(SymbolicObject* obj, std::string propertyName)
+{
+    return create(ExpressionArena::current(), obj, propertyName);
+}
+
+SymbolicObjectPropertyString* SymbolicObjectPropertyString::create(ExpressionArena* arena, SymbolicObject* obj, std::string propertyName)
+{
+    size_t hash = 9;
+    hash = hashCombine(hash, hashField(obj));
+    hash = hashCombine(hash, hashField(propertyName));
+
+    ExpressionArena::InternTable& table = arena->internTable(9);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        SymbolicObjectPropertyString* candidate = static_cast<SymbolicObjectPropertyString*>(iter->second);
+        if (equalField(candidate->m_obj, obj) &&
+            equalField(candidate->m_propertyName, propertyName)) {
+            return candidate;
+        }
+    }
+
+    SymbolicObjectPropertyString* created = new (arena->allocate(sizeof(SymbolicObjectPropertyString))) SymbolicObjectPropertyString(obj, propertyName);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* SymbolicObjectPropertyString::copyTo(ExpressionArena* arena)
+{
+    return SymbolicObjectPropertyString::create(arena, arena->import(m_obj), m_propertyName);
+}
+
 void SymbolicObjectPropertyString::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
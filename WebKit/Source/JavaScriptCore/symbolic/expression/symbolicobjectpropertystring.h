@@ -35,9 +35,13 @@ namespace Symbolic
 class SymbolicObjectPropertyString : public StringExpression
 {
 public:
-    explicit SymbolicObjectPropertyString(SymbolicObject* obj, std::string propertyName);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static SymbolicObjectPropertyString* create(SymbolicObject* obj, std::string propertyName);
+    static SymbolicObjectPropertyString* create(ExpressionArena* arena, SymbolicObject* obj, std::string propertyName);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline SymbolicObject* getObj() {
 		return m_obj;
@@ -47,6 +51,8 @@ public:
 	}
 
 private:
+    explicit SymbolicObjectPropertyString(SymbolicObject* obj, std::string propertyName);
+
 	SymbolicObject* m_obj;
 	std::string m_propertyName;
 
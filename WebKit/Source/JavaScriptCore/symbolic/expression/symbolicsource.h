@@ -20,6 +20,7 @@
 #include <strings.h>
 #include <map>
 #include <string>
+#include <tr1/functional>
 
 namespace Symbolic {
 
@@ -112,6 +113,21 @@ public:
         return m_domSnapshot;
     }
 
+    // Sources are equal if they refer to the same input (and DOM snapshot), used for hash-consing expressions.
+    inline bool operator==(const SymbolicSource& other) const {
+        return m_type == other.m_type &&
+                m_identifier_method == other.m_identifier_method &&
+                m_identifier == other.m_identifier &&
+                m_domSnapshot == other.m_domSnapshot;
+    }
+
+    inline size_t hash() const {
+        return std::tr1::hash<std::string>()(m_identifier) ^
+                ((size_t)m_type << 4) ^
+                ((size_t)m_identifier_method << 8) ^
+                std::tr1::hash<const void*>()(m_domSnapshot);
+    }
+
     static SourceType stringAccessTypeAttrToSourceType(const char * type) {
         if(strncasecmp(type, "select", 6) == 0){
             return SELECT;
@@ -19,6 +19,7 @@
 #ifdef ARTEMIS
 
 #include "symbolicstring.h"
+#include "expressionarena.h"
 
 namespace Symbolic
 {
@@ -29,6 +30,38 @@ SymbolicString::SymbolicString(SymbolicSource source) :
 {
 }
 
+SymbolicString* SymbolicString::create(const SymbolicSource& source)
+{
+    return create(ExpressionArena::current(), source);
+}
+
+SymbolicString* SymbolicString::create(ExpressionArena* arena, const SymbolicSource& source)
+{
+    size_t hash = 14;
+    hash = hashCombine(hash, hashField(source));
+
+    ExpressionArena::InternTable& table = arena->internTable(14);
+    std::pair<ExpressionArena::InternTable::iterator, ExpressionArena::InternTable::iterator> range = table.equal_range(hash);
+
+    for (ExpressionArena::InternTable::iterator iter = range.first; iter != range.second; ++iter) {
+        SymbolicString* candidate = static_cast<SymbolicString*>(iter->second);
+        if (equalField(candidate->m_source, source)) {
+            return candidate;
+        }
+    }
+
+    SymbolicString* created = new (arena->allocate(sizeof(SymbolicString))) SymbolicString(source);
+    arena->adopt(created);
+    table.insert(std::make_pair(hash, static_cast<Expression*>(created)));
+
+    return created;
+}
+
+Expression* SymbolicString::copyTo(ExpressionArena* arena)
+{
+    return SymbolicString::create(arena, m_source);
+}
+
 void SymbolicString::accept(Visitor* visitor) 
 {
 	visitor->visit(this, NULL); 	
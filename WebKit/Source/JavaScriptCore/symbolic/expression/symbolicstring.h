@@ -35,15 +35,21 @@ namespace Symbolic
 class SymbolicString : public StringExpression
 {
 public:
-    explicit SymbolicString(SymbolicSource source);
+    // Returns the (unique) expression with these fields in the current arena, creating it if needed.
+    static SymbolicString* create(const SymbolicSource& source);
+    static SymbolicString* create(ExpressionArena* arena, const SymbolicSource& source);
+
     void accept(Visitor* visitor);
     void accept(Visitor* visitor, void* arg);
+    Expression* copyTo(ExpressionArena* arena);
 
 	inline SymbolicSource getSource() {
 		return m_source;
 	}
 
 private:
+    explicit SymbolicString(SymbolicSource source);
+
 	SymbolicSource m_source;
 
 };
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifdef ARTEMIS
+
+#include <stdlib.h>
+
+#include "JavaScriptCore/statistics/statsstorage.h"
+
+#include "symbolicimmediatepool.h"
+
+namespace Symbolic
+{
+
+SymbolicImmediatePool::SymbolicImmediatePool()
+    : m_chunkOffset(CHUNK_SIZE)
+    , m_currentCount(0)
+    , m_previousCount(0)
+    , m_allocated(0)
+    , m_recycled(0)
+{
+}
+
+SymbolicImmediatePool::~SymbolicImmediatePool()
+{
+    Chunks* lists[] = { &m_current, &m_previous, &m_free };
+
+    for (size_t i = 0; i < 3; i++) {
+        for (Chunks::iterator iter = lists[i]->begin(); iter != lists[i]->end(); ++iter) {
+            free(*iter);
+        }
+    }
+}
+
+SymbolicImmediatePool* SymbolicImmediatePool::pool()
+{
+    static SymbolicImmediatePool* pool = new SymbolicImmediatePool();
+    return pool;
+}
+
+void SymbolicImmediatePool::newChunk()
+{
+    JSC::SymbolicImmediate* chunk;
+
+    if (m_free.empty()) {
+        chunk = (JSC::SymbolicImmediate*)malloc(CHUNK_SIZE * sizeof(JSC::SymbolicImmediate));
+        if (chunk == NULL) {
+            abort();
+        }
+    } else {
+        chunk = m_free.back();
+        m_free.pop_back();
+    }
+
+    m_current.push_back(chunk);
+    m_chunkOffset = 0;
+}
+
+void SymbolicImmediatePool::beginGeneration()
+{
+    m_allocated += m_currentCount;
+    m_recycled += m_previousCount;
+
+    m_free.insert(m_free.end(), m_previous.begin(), m_previous.end());
+
+    m_previous.swap(m_current);
+    m_current.clear();
+    m_chunkOffset = CHUNK_SIZE;
+
+    m_previousCount = m_currentCount;
+    m_currentCount = 0;
+}
+
+void SymbolicImmediatePool::exportStatistics()
+{
+    Statistics::statistics()->set("Concolic::Interpreter::SymbolicBoxesLive", (int)(m_currentCount + m_previousCount));
+    Statistics::statistics()->set("Concolic::Interpreter::SymbolicBoxesAllocated", (int)(m_allocated + m_currentCount));
+    Statistics::statistics()->set("Concolic::Interpreter::SymbolicBoxesRecycled", (int)m_recycled);
+    Statistics::statistics()->set("Concolic::Interpreter::SymbolicBoxChunks", (int)(m_current.size() + m_previous.size() + m_free.size()));
+}
+
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SYMBOLICIMMEDIATEPOOL_H
+#define SYMBOLICIMMEDIATEPOOL_H
+
+#ifdef ARTEMIS
+
+#include <stddef.h>
+#include <vector>
+
+#include "JavaScriptCore/runtime/JSValue.h"
+
+namespace Symbolic
+{
+
+/**
+ * Allocator for the boxes (JSC::SymbolicImmediate) backing symbolic JSValues.
+ *
+ * Boxes are carved out of fixed size chunks and are never freed individually. Instead all boxes allocated
+ * during a session (a generation) are recycled wholesale: their chunks are put on a free list and reused
+ * by later sessions.
+ *
+ * A box holds the concrete value of the JSValue as well as its symbolic expression, so it must stay valid
+ * as long as the page which created it can still run. Like the expression arenas, a generation is only
+ * recycled when the session after the next one begins (see SymbolicInterpreter::beginSession).
+ */
+class SymbolicImmediatePool
+{
+public:
+    static const size_t CHUNK_SIZE = 1024; // boxes per chunk
+
+    SymbolicImmediatePool();
+    ~SymbolicImmediatePool();
+
+    inline JSC::SymbolicImmediate* allocate()
+    {
+        if (m_chunkOffset == CHUNK_SIZE) {
+            newChunk();
+        }
+
+        m_currentCount++;
+        return &m_current.back()[m_chunkOffset++];
+    }
+
+    // Starts a new generation, recycling the generation before the previous one.
+    void beginGeneration();
+
+    // Publishes the pool counters to the statistics storage.
+    void exportStatistics();
+
+    static SymbolicImmediatePool* pool();
+
+private:
+    typedef std::vector<JSC::SymbolicImmediate*> Chunks;
+
+    void newChunk();
+
+    Chunks m_current;
+    Chunks m_previous;
+    Chunks m_free;
+
+    size_t m_chunkOffset;
+
+    // Boxes allocated in the current and previous generation
+    size_t m_currentCount;
+    size_t m_previousCount;
+
+    // Totals over the lifetime of the pool
+    size_t m_allocated;
+    size_t m_recycled;
+};
+
+}
+
+#endif
+#endif // SYMBOLICIMMEDIATEPOOL_H
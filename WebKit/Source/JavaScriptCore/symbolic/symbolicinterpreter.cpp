@@ -29,6 +29,8 @@
 #include "instrumentation/jscexecutionlistener.h"
 
 #include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/symbolic/expression/expressionarena.h"
+#include "JavaScriptCore/symbolic/symbolicimmediatepool.h"
 
 #include "symbolicinterpreter.h"
 #include <QDebug>
@@ -64,6 +66,8 @@ SymbolicInterpreter::SymbolicInterpreter() :
     m_nextSymbolicValue(0),
     m_inSession(false),
     m_sessionId(0),
+    m_arena(NULL),
+    m_previousArena(NULL),
     m_shouldGC(false)
 {
 }
@@ -127,7 +131,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
             Symbolic::IntegerExpression* sx = x.generateIntegerExpression(callFrame);
             Symbolic::IntegerExpression* sy = y.generateIntegerExpression(callFrame);
 
-            result.makeSymbolic(new IntegerBinaryOperation(sx, neq?INT_NEQ:INT_EQ, sy), callFrame->globalData());
+            result.makeSymbolic(IntegerBinaryOperation::create(sx, neq?INT_NEQ:INT_EQ, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -140,20 +144,20 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
 
             if (x.isObject() && !x.isString() && x.isSymbolic()) {
                 // object -> string coercion
-                xx.makeSymbolic(new Symbolic::StringCoercion(x.asSymbolic()), callFrame->globalData());
+                xx.makeSymbolic(Symbolic::StringCoercion::create(x.asSymbolic()), callFrame->globalData());
                 x = xx;
             }
 
             if (y.isObject() && !y.isString() && y.isSymbolic()) {
                 // object -> string coercion
-                yy.makeSymbolic(new Symbolic::StringCoercion(y.asSymbolic()), callFrame->globalData());
+                yy.makeSymbolic(Symbolic::StringCoercion::create(y.asSymbolic()), callFrame->globalData());
                 y = yy;
             }
 
             Symbolic::StringExpression* sx = x.generateStringExpression(callFrame);
             Symbolic::StringExpression* sy = y.generateStringExpression(callFrame);
 
-            result.makeSymbolic(new StringBinaryOperation(sx, neq?STRING_NEQ:STRING_EQ, sy), callFrame->globalData());
+            result.makeSymbolic(StringBinaryOperation::create(sx, neq?STRING_NEQ:STRING_EQ, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -170,7 +174,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
                 Symbolic::ObjectExpression* sx = x.generateObjectExpression(callFrame);
                 Symbolic::ObjectExpression* sy = y.generateObjectExpression(callFrame);
 
-                result.makeSymbolic(new ObjectBinaryOperation(sx, neq ? OBJ_NEQ : OBJ_EQ, sy), callFrame->globalData());
+                result.makeSymbolic(ObjectBinaryOperation::create(sx, neq ? OBJ_NEQ : OBJ_EQ, sy), callFrame->globalData());
             }
 
             return result;
@@ -187,7 +191,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
         if(xx.isBoolean() && yy.isBoolean()){
             Symbolic::BooleanExpression* sx = x.generateBooleanExpression(callFrame);
             Symbolic::BooleanExpression* sy = y.generateBooleanExpression(callFrame);
-            result.makeSymbolic(new BooleanBinaryOperation(sx,neq?BOOL_NEQ:BOOL_EQ,sy), callFrame->globalData());
+            result.makeSymbolic(BooleanBinaryOperation::create(sx,neq?BOOL_NEQ:BOOL_EQ,sy), callFrame->globalData());
             return result;
         }
 
@@ -203,7 +207,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
             ASSERT(sx != NULL);
             ASSERT(sy != NULL);
 
-            result.makeSymbolic(new IntegerBinaryOperation(sx, neq?INT_NEQ:INT_EQ, sy), callFrame->globalData());
+            result.makeSymbolic(IntegerBinaryOperation::create(sx, neq?INT_NEQ:INT_EQ, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -223,21 +227,21 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
         if(x.isString() && y.isString()){
             Symbolic::StringExpression* sx = x.generateStringExpression(callFrame);
             Symbolic::StringExpression* sy = y.generateStringExpression(callFrame);
-            result.makeSymbolic(new StringBinaryOperation(sx,neq?STRING_SNEQ:STRING_SEQ,sy), callFrame->globalData());
+            result.makeSymbolic(StringBinaryOperation::create(sx,neq?STRING_SNEQ:STRING_SEQ,sy), callFrame->globalData());
             return result;
         }
 
         if(x.isNumber() && y.isNumber()){
             Symbolic::IntegerExpression* sx = x.generateIntegerExpression(callFrame);
             Symbolic::IntegerExpression* sy = y.generateIntegerExpression(callFrame);
-            result.makeSymbolic(new IntegerBinaryOperation(sx,neq?INT_SNEQ:INT_SEQ,sy), callFrame->globalData());
+            result.makeSymbolic(IntegerBinaryOperation::create(sx,neq?INT_SNEQ:INT_SEQ,sy), callFrame->globalData());
             return result;
         }
 
         if(x.isBoolean() && y.isBoolean()){
             Symbolic::BooleanExpression* sx = x.generateBooleanExpression(callFrame);
             Symbolic::BooleanExpression* sy = y.generateBooleanExpression(callFrame);
-            result.makeSymbolic(new BooleanBinaryOperation(sx,neq?BOOL_SNEQ:BOOL_SEQ,sy), callFrame->globalData());
+            result.makeSymbolic(BooleanBinaryOperation::create(sx,neq?BOOL_SNEQ:BOOL_SEQ,sy), callFrame->globalData());
             return result;
         }
 
@@ -266,12 +270,12 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
         if(xx.isString() && yy.isString()){
             Symbolic::StringExpression* sx = x.generateStringExpression(callFrame);
             Symbolic::StringExpression* sy = y.generateStringExpression(callFrame);
-            result.makeSymbolic(new StringBinaryOperation(sx,strOp,sy), callFrame->globalData());
+            result.makeSymbolic(StringBinaryOperation::create(sx,strOp,sy), callFrame->globalData());
             return result;
         }
         Symbolic::IntegerExpression* sx = xx.isNumber()?x.generateIntegerExpression(callFrame):x.generateIntegerCoercionExpression(callFrame);
         Symbolic::IntegerExpression* sy = yy.isNumber()?y.generateIntegerExpression(callFrame):y.generateIntegerCoercionExpression(callFrame);
-        result.makeSymbolic(new IntegerBinaryOperation(sx,intOp,sy), callFrame->globalData());
+        result.makeSymbolic(IntegerBinaryOperation::create(sx,intOp,sy), callFrame->globalData());
         return result;
         break;
 }
@@ -288,7 +292,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
             ASSERT(sx);
             ASSERT(sy);
 
-            result.makeSymbolic(new IntegerBinaryOperation(sx, INT_ADD, sy), callFrame->globalData());
+            result.makeSymbolic(IntegerBinaryOperation::create(sx, INT_ADD, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -315,7 +319,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
             ASSERT(sx != NULL);
             ASSERT(sy != NULL);
 
-            result.makeSymbolic(new StringBinaryOperation(sx, CONCAT, sy), callFrame->globalData());
+            result.makeSymbolic(StringBinaryOperation::create(sx, CONCAT, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -334,7 +338,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
             ASSERT(sx != NULL);
             ASSERT(sy != NULL);
 
-            result.makeSymbolic(new StringBinaryOperation(sx, CONCAT, sy), callFrame->globalData());
+            result.makeSymbolic(StringBinaryOperation::create(sx, CONCAT, sy), callFrame->globalData());
 
             ASSERT(result.isSymbolic());
 
@@ -352,7 +356,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
         ASSERT(sx != NULL);
         ASSERT(sy != NULL);
 
-        result.makeSymbolic(new IntegerBinaryOperation(sx, INT_ADD, sy), callFrame->globalData());
+        result.makeSymbolic(IntegerBinaryOperation::create(sx, INT_ADD, sy), callFrame->globalData());
 
         ASSERT(result.isSymbolic());
 
@@ -374,7 +378,7 @@ JSC::JSValue SymbolicInterpreter::ail_op_binary(JSC::CallFrame* callFrame,
         ASSERT(sx != NULL);
         ASSERT(sy != NULL);
 
-        result.makeSymbolic(new IntegerBinaryOperation(sx,intOp,sy), callFrame->globalData());
+        result.makeSymbolic(IntegerBinaryOperation::create(sx,intOp,sy), callFrame->globalData());
         ASSERT(result.isSymbolic());
         return result;
 
@@ -450,11 +454,21 @@ void SymbolicInterpreter::beginSession(unsigned int sessionId)
     m_shouldGC = true;
     m_inSession = true;
     m_sessionId = sessionId;
+
+    delete m_previousArena;
+    m_previousArena = m_arena;
+
+    m_arena = new ExpressionArena();
+    ExpressionArena::setCurrent(m_arena);
+
+    SymbolicImmediatePool::pool()->beginGeneration();
 }
 
 void SymbolicInterpreter::endSession()
 {
     m_inSession = false;
+
+    SymbolicImmediatePool::pool()->exportStatistics();
 }
 
 
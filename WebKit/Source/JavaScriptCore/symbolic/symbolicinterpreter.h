@@ -37,6 +37,8 @@ namespace JSC {
 namespace Symbolic
 {
 
+class ExpressionArena;
+
 extern unsigned int NEXT_SYMBOLIC_ID;
 
 typedef enum {
@@ -71,6 +73,11 @@ public:
 
     /*
      * Called from Artemis
+     *
+     * Each session allocates its symbolic expressions in a fresh arena and its symbolic value boxes in a new
+     * generation of the SymbolicImmediatePool. Those of the previous session are kept alive during the
+     * following session, as values from the previous page can still be reachable until the new page has
+     * replaced it, and are released when the session after that begins.
      */
     void beginSession();
     void beginSession(unsigned int sessionId);
@@ -142,6 +149,9 @@ private:
     bool m_inSession;
     unsigned int m_sessionId;
 
+    ExpressionArena* m_arena;
+    ExpressionArena* m_previousArena;
+
     bool m_shouldGC;
 
     static bool m_isOpGetByValWithSymbolicArg;
@@ -1823,14 +1823,16 @@ sub GenerateImplementation
                     
                     if ($attribute->signature->extendedAttributes->{"UsageWarning"}) {
                         # ARTEMIS BEGIN
-                        push(@implContent, "Statistics::statistics()->accumulate(\"DOM::APIUsageWarning::$className.${name}\", 1);\n");
+                        push(@implContent, "    static Statistics::Counter usageWarning(\"DOM::APIUsageWarning::$className.${name}\");\n");
+                        push(@implContent, "    usageWarning.add(1);\n");
                         # ARTEMIS END
                     }
 
                     if ($attribute->signature->extendedAttributes->{"WarningIfSymbolic"}) {
                         # ARTEMIS BEGIN
                         push(@implContent, "        if (slotBase.isSymbolic()) {\n");
-                        push(@implContent, "            Statistics::statistics()->accumulate(\"Concolic::SymbolicAPIUsageWarning::$className.${name}\", 1);\n");
+                        push(@implContent, "            static Statistics::Counter symbolicUsageWarning(\"Concolic::SymbolicAPIUsageWarning::$className.${name}\");\n");
+                        push(@implContent, "            symbolicUsageWarning.add(1);\n");
                         push(@implContent, "        }\n");
                         # ARTEMIS END
                     }
@@ -1857,7 +1859,7 @@ sub GenerateImplementation
                         push(@implContent, "       std::ostringstream sessionId;\n");
                         push(@implContent, "       sessionId << \"SYM_TARGET_\" << JSC::Interpreter::m_symbolic->getSessionId();\n");
                         push(@implContent, "       Symbolic::SymbolicSource source(Symbolic::EVENT_TARGET, Symbolic::EVENT_TARGET_IDENT, sessionId.str(), domSnapshot);\n");
-                        push(@implContent, "       result.makeSymbolic(new Symbolic::SymbolicObject(source), exec->globalData());\n");
+                        push(@implContent, "       result.makeSymbolic(Symbolic::SymbolicObject::create(source), exec->globalData());\n");
                         push(@implContent, "   }\n");
                         # ARTEMIS END
                     }
@@ -1869,10 +1871,10 @@ sub GenerateImplementation
                         my $pReflect = $attribute->signature->extendedAttributes->{"Reflect"};
                         my $pAttr = ($pReflect and $pReflect ne "VALUE_IS_MISSING") ? $pReflect : $name;
 
-                        my $symbolicVar = "new Symbolic::SymbolicObjectPropertyString((Symbolic::SymbolicObject*)slotBase.asSymbolic(), \"" . $pAttr . "\")";
+                        my $symbolicVar = "Symbolic::SymbolicObjectPropertyString::create((Symbolic::SymbolicObject*)slotBase.asSymbolic(), \"" . $pAttr . "\")";
 
                         if ($attribute->signature->extendedAttributes->{"SymbolicObjectIntProperty"}) {
-                            $symbolicVar = "new Symbolic::IntegerCoercion(" . $symbolicVar . ")";
+                            $symbolicVar = "Symbolic::IntegerCoercion::create(" . $symbolicVar . ")";
                         }
 
                         push(@implContent, "        if (slotBase.isSymbolic()) {\n");
@@ -2085,11 +2087,11 @@ sub GenerateImplementation
                         push(@implContent, "    if (castedThis->m_" . $attribute->signature->name . "Symbolic == NULL) {\n");
 
                         if ($attribute->signature->extendedAttributes->{"SymbolicString"}) {
-                            push(@implContent, "        result.makeSymbolic(new Symbolic::SymbolicString(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
+                            push(@implContent, "        result.makeSymbolic(Symbolic::SymbolicString::create(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
                         } elsif ($attribute->signature->extendedAttributes->{"SymbolicBoolean"}) {
-                            push(@implContent, "        result.makeSymbolic(new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
+                            push(@implContent, "        result.makeSymbolic(Symbolic::SymbolicBoolean::create(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
                         } else { # SymbolicInteger
-                            push(@implContent, "        result.makeSymbolic(new Symbolic::SymbolicInteger(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
+                            push(@implContent, "        result.makeSymbolic(Symbolic::SymbolicInteger::create(Symbolic::SymbolicSource(inputSourceType, method, std::string(strs.str()))), exec->globalData());\n");
                         }
 
                         push(@implContent, "\n");
@@ -3139,7 +3141,7 @@ sub GenerateImplementationFunctionCall()
         # Artemis
         if (!$function->isStatic and $addSymbolicProperty) {
             push(@implContent, $indent . "if (thisValue.isSymbolic()) {\n");
-            push(@implContent, $indent . "    result.makeSymbolic(new Symbolic::SymbolicObjectPropertyString((Symbolic::SymbolicObject*)thisValue.asSymbolic(), name.ascii().data()), exec->globalData());\n");
+            push(@implContent, $indent . "    result.makeSymbolic(Symbolic::SymbolicObjectPropertyString::create((Symbolic::SymbolicObject*)thisValue.asSymbolic(), name.ascii().data()), exec->globalData());\n");
             push(@implContent, $indent . "}\n");
         }
 
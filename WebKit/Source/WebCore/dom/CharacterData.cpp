@@ -34,6 +34,10 @@
 #include "TextBreakIterator.h"
 #include "WebKitMutationObserver.h"
 
+#ifdef ARTEMIS
+#include "instrumentation/executionlistener.h"
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -80,8 +84,14 @@ unsigned CharacterData::parserAppendData(const UChar* data, unsigned dataLength,
 
     m_data.append(data, end);
 
+#ifdef ARTEMIS
+    if (inDocument() && isTextNode())
+        inst::getListener()->dom_text_inserted(String(data, end));
+#endif
+
     updateRenderer(oldLength, 0);
     document()->incDOMTreeVersion();
+    invalidateFingerprint();
     // We don't call dispatchModifiedEvent here because we don't want the
     // parser to dispatch DOM mutation events.
     if (parentNode())
@@ -178,8 +188,15 @@ void CharacterData::setDataAndUpdate(const String& newData, unsigned offsetOfRep
         document()->frame()->selection()->textWillBeReplaced(this, offsetOfReplacedData, oldLength, newLength);
     String oldData = m_data;
     m_data = newData;
+
+#ifdef ARTEMIS
+    if (inDocument() && isTextNode())
+        inst::getListener()->dom_text_inserted(m_data.substring(offsetOfReplacedData, newLength));
+#endif
+
     updateRenderer(offsetOfReplacedData, oldLength);
     document()->incDOMTreeVersion();
+    invalidateFingerprint();
     dispatchModifiedEvent(oldData);
 }
 
@@ -689,6 +689,9 @@ void ContainerNode::detach()
 void ContainerNode::childrenChanged(bool changedByParser, Node*, Node*, int childCountDelta)
 {
     document()->incDOMTreeVersion();
+    if (childCountDelta)
+        document()->incChildListVersion();
+    invalidateFingerprint();
     if (!changedByParser && childCountDelta)
         document()->updateRangesAfterChildrenChanged(this);
     invalidateNodeListsCacheAfterChildrenChanged();
@@ -938,6 +938,10 @@ public:
     void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+    // Like the DOM tree version, but only changed when nodes are inserted or removed.
+    void incChildListVersion() { m_childListVersion = ++s_globalTreeVersion; }
+    uint64_t childListVersion() const { return m_childListVersion; }
+
     void setDocType(PassRefPtr<DocumentType>);
 
     // XPathEvaluator methods
@@ -1300,6 +1304,7 @@ private:
     RefPtr<Element> m_documentElement;
 
     uint64_t m_domTreeVersion;
+    uint64_t m_childListVersion;
     static uint64_t s_globalTreeVersion;
     
     HashSet<NodeIterator*> m_nodeIterators;
@@ -1518,6 +1523,7 @@ inline Node::Node(Document* document, ConstructionType type)
     , m_next(0)
     , m_renderer(0)
     , m_artemisId(++Node::_artemisId)
+    , m_fingerprint(0)
 {
     if (document)
         document->guardRef();
@@ -80,6 +80,10 @@
 #include "SVGNames.h"
 #endif
 
+#ifdef ARTEMIS
+#include "instrumentation/executionlistener.h"
+#endif
+
 namespace WebCore {
 
 using namespace HTMLNames;
@@ -701,6 +705,13 @@ inline void Element::setAttributeInternal(size_t index, const QualifiedName& nam
 void Element::attributeChanged(Attribute* attr)
 {
     document()->incDOMTreeVersion();
+    invalidateFingerprint();
+
+#ifdef ARTEMIS
+    // Attributes set before the element is inserted are reported on insertion, see Node::insertedInto
+    if (inDocument() && !attr->isNull())
+        inst::getListener()->dom_text_inserted(attr->value());
+#endif
 
     if (isIdAttributeName(attr->name()))
         idAttributeChanged(attr);
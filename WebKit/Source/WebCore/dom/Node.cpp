@@ -38,6 +38,7 @@
 #include "CSSSelectorList.h"
 #include "CSSStyleRule.h"
 #include "CSSStyleSheet.h"
+#include "CharacterData.h"
 #include "ChildNodeList.h"
 #include "ClassNodeList.h"
 #include "ContextMenuController.h"
@@ -125,6 +126,10 @@
 #include "HTMLPropertiesCollection.h"
 #endif
 
+#ifdef ARTEMIS
+#include "instrumentation/executionlistener.h"
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -547,6 +552,64 @@ unsigned Node::artemisId() const
     return m_artemisId;
 }
 
+static inline unsigned stringFingerprint(const String& string)
+{
+    return string.isNull() ? 0 : string.impl()->hash();
+}
+
+static inline unsigned combineFingerprint(unsigned hash, unsigned value)
+{
+    return WTF::intHash((static_cast<uint64_t>(hash) << 32) | value);
+}
+
+unsigned Node::fingerprint(Vector<Node*>* changedNodes)
+{
+    if (getFlag(HasValidFingerprintFlag))
+        return m_fingerprint;
+
+    unsigned hash = nodeType();
+
+    if (isElementNode()) {
+        Element* element = static_cast<Element*>(this);
+        hash = combineFingerprint(hash, stringFingerprint(element->tagQName().localName()));
+
+        // Synchronizes lazily updated attributes (e.g. style), which may invalidate this node again
+        if (ElementAttributeData* attributeData = element->updatedAttributeData()) {
+            for (unsigned i = 0; i < attributeData->length(); i++) {
+                Attribute* attribute = attributeData->attributeItem(i);
+                hash = combineFingerprint(hash, stringFingerprint(attribute->localName()));
+                hash = combineFingerprint(hash, stringFingerprint(attribute->value()));
+            }
+        }
+    } else if (isCharacterDataNode()) {
+        hash = combineFingerprint(hash, stringFingerprint(static_cast<CharacterData*>(this)->data()));
+    } else if (!isContainerNode()) {
+        hash = combineFingerprint(hash, stringFingerprint(nodeName()));
+        hash = combineFingerprint(hash, stringFingerprint(nodeValue()));
+    }
+
+    if (changedNodes && getFlag(FingerprintChangedFlag))
+        changedNodes->append(this);
+
+    for (Node* child = firstChild(); child; child = child->nextSibling())
+        hash = combineFingerprint(hash, child->fingerprint(changedNodes));
+
+    m_fingerprint = hash;
+    setFlag(HasValidFingerprintFlag);
+    clearFlag(FingerprintChangedFlag);
+
+    return hash;
+}
+
+void Node::invalidateFingerprint()
+{
+    setFlag(FingerprintChangedFlag);
+
+    // A node with an invalid fingerprint always has invalid ancestors, so we can stop at the first one
+    for (Node* node = this; node && node->getFlag(HasValidFingerprintFlag); node = node->parentNode())
+        node->clearFlag(HasValidFingerprintFlag);
+}
+
 String Node::nodeValue() const
 {
     return String();
@@ -2392,11 +2455,29 @@ ScriptExecutionContext* Node::scriptExecutionContext() const
 Node::InsertionNotificationRequest Node::insertedInto(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
-    if (insertionPoint->inDocument())
+    if (insertionPoint->inDocument()) {
         setFlag(InDocumentFlag);
+#ifdef ARTEMIS
+        reportInsertedText();
+#endif
+    }
     return InsertionDone;
 }
 
+#ifdef ARTEMIS
+void Node::reportInsertedText()
+{
+    if (isTextNode()) {
+        inst::getListener()->dom_text_inserted(static_cast<CharacterData*>(this)->data());
+    } else if (isElementNode()) {
+        if (ElementAttributeData* attributeData = static_cast<Element*>(this)->attributeData()) {
+            for (unsigned i = 0; i < attributeData->length(); i++)
+                inst::getListener()->dom_text_inserted(attributeData->attributeItem(i)->value());
+        }
+    }
+}
+#endif
+
 void Node::removedFrom(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
@@ -150,6 +150,13 @@ public:
     bool hasTagName(const QualifiedName&) const;
     bool hasLocalName(const AtomicString&) const;
     unsigned artemisId() const;
+
+    // Structural hash of the subtree rooted at this node (names, attributes and character data). The hash is cached
+    // per node and only recomputed for the parts of the subtree which were mutated since the last call. If
+    // changedNodes is given, the nodes which were themselves mutated since then are appended to it.
+    unsigned fingerprint(Vector<Node*>* changedNodes = 0);
+    void invalidateFingerprint();
+
     virtual String nodeName() const = 0;
     virtual String nodeValue() const;
     virtual void setNodeValue(const String&, ExceptionCode&);
@@ -645,6 +652,11 @@ public:
     size_t numberOfScopedHTMLStyleChildren() const;
 
 private:
+#ifdef ARTEMIS
+    // Reports the text this node adds to the document (character data or attribute values) to the execution listener
+    void reportInsertedText();
+#endif
+
     enum NodeFlags {
         IsTextFlag = 1,
         IsContainerFlag = 1 << 1,
@@ -688,10 +700,13 @@ private:
 #else
         DefaultNodeFlags = IsParsingChildrenFinishedFlag | IsStyleAttributeValidFlag,
 #endif
-        InNamedFlowFlag = 1 << 29
+        InNamedFlowFlag = 1 << 29,
+
+        HasValidFingerprintFlag = 1 << 28,
+        FingerprintChangedFlag = 1 << 30
     };
 
-    // 3 bits remaining
+    // 1 bit remaining
 
     bool getFlag(NodeFlags mask) const { return m_nodeFlags & mask; }
     void setFlag(bool f, NodeFlags mask) const { m_nodeFlags = (m_nodeFlags & ~mask) | (-(int32_t)f & mask); } 
@@ -809,6 +824,7 @@ protected:
 
     static unsigned _artemisId;
     unsigned m_artemisId;
+    unsigned m_fingerprint;
 };
 
 // Used in Node::addSubresourceAttributeURLs() and in addSubresourceStyleURLs()
@@ -187,6 +187,7 @@ void StyledElement::inlineStyleChanged()
 {
     setNeedsStyleRecalc(InlineStyleChange);
     setIsStyleAttributeValid(false);
+    invalidateFingerprint();
     InspectorInstrumentation::didInvalidateStyleAttr(document(), this);
 }
     
@@ -16,6 +16,10 @@ namespace WebCore {
     class LazyXMLHttpRequest;
 }
 
+namespace WTF {
+    class String;
+}
+
 namespace JSC {
     class Debugger;
     class SourceProvider;
@@ -53,6 +57,11 @@ public:
     virtual void timerAdded(WebCore::ScriptExecutionContext* context, int timerId, int timeout, bool singleShot) = 0;
     virtual void timerRemoved(WebCore::ScriptExecutionContext* context, int timerId) = 0;
 
+    /**
+      Under virtual time timers are not armed, they only run when fired through the listener.
+      */
+    virtual bool isVirtualTimeEnabled() = 0;
+
     /**
       Loading of files
       */
@@ -94,6 +103,11 @@ public:
       */
     virtual void page_load_scheduled(const char* url) = 0;
 
+    /**
+      DOM modifications, invoked with text (character data or attribute values) as it is inserted into a document
+      */
+    virtual void dom_text_inserted(const WTF::String& text) = 0;
+
 };
 
 extern ExecutionListener* listener;
@@ -74,9 +74,21 @@ DOMTimer::DOMTimer(ScriptExecutionContext* context, PassOwnPtr<ScheduledAction>
     , m_action(action)
     , m_originalInterval(interval)
     , m_shouldForwardUserGesture(shouldForwardUserGesture(interval, m_nestingLevel))
+#ifdef ARTEMIS
+    , m_singleShot(singleShot)
+    , m_virtualTime(inst::getListener()->isVirtualTimeEnabled())
+#endif
 {
     scriptExecutionContext()->addTimeout(m_timeoutId, this);
 
+#ifdef ARTEMIS
+    // The virtual clock in Artemis decides when the timer fires, it is never armed.
+    if (m_virtualTime) {
+        inst::getListener()->timerAdded(scriptExecutionContext(), m_timeoutId, interval, singleShot);
+        return;
+    }
+#endif
+
     double intervalMilliseconds = intervalClampedToMinimum(interval, context->minimumTimerInterval());
     if (singleShot)
         startOneShot(intervalMilliseconds);
@@ -138,7 +150,12 @@ void DOMTimer::fired()
     InspectorInstrumentationCookie cookie = InspectorInstrumentation::willFireTimer(context, m_timeoutId);
 
     // Simple case for non-one-shot timers.
+#ifdef ARTEMIS
+    // Unarmed timers are never active, under virtual time they repeat until they are removed.
+    if (m_virtualTime ? !m_singleShot : isActive()) {
+#else
     if (isActive()) {
+#endif
         double minimumInterval = context->minimumTimerInterval();
         if (repeatInterval() && repeatInterval() < minimumInterval) {
             m_nestingLevel++;
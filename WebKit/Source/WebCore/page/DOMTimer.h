@@ -75,6 +75,10 @@ namespace WebCore {
         OwnPtr<ScheduledAction> m_action;
         int m_originalInterval;
         bool m_shouldForwardUserGesture;
+#ifdef ARTEMIS
+        bool m_singleShot;
+        bool m_virtualTime;
+#endif
         static double s_minDefaultTimerInterval;
     };
 
@@ -17,7 +17,9 @@ SOURCES += \
     $$PWD/qt/Api/qhttpheader.cpp \
     $$PWD/qt/Api/qwebexecutionlistener.cpp \ 
     WebKit/qt/Api/artemis/qsourceregistry.cpp \
-    WebKit/qt/Api/artemis/qsource.cpp
+    WebKit/qt/Api/artemis/qpropertyregistry.cpp \
+    WebKit/qt/Api/artemis/qsource.cpp \
+    WebKit/qt/Api/artemis/qsourcetext.cpp
 
 HEADERS += \
     $$PWD/qt/Api/qwebframe.h \
@@ -40,7 +42,10 @@ HEADERS += \
     $$PWD/qt/Api/qhttpheader_p.h \
     $$PWD/qt/Api/qwebexecutionlistener.h \ 
     WebKit/qt/Api/artemis/qsourceregistry.h \
-    WebKit/qt/Api/artemis/qsource.h
+    WebKit/qt/Api/artemis/qpropertyregistry.h \
+    WebKit/qt/Api/artemis/qsource.h \
+    WebKit/qt/Api/artemis/qsourcetext.h \
+    WebKit/qt/Api/artemis/qwebformcontrol.h
 
 
 
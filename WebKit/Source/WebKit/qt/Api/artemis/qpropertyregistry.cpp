@@ -0,0 +1,79 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "wtf/text/StringImpl.h"
+
+#include "qpropertyregistry.h"
+
+QPropertyRegistry::QPropertyRegistry()
+{
+}
+
+QPropertyRegistry::~QPropertyRegistry()
+{
+    foreach (WTF::StringImpl* identifier, m_identifiers.keys()) {
+        identifier->deref();
+    }
+}
+
+propertyid_t QPropertyRegistry::intern(WTF::StringImpl* name)
+{
+    if (name == NULL) {
+        return internName(QString());
+    }
+
+    // Quick case, the names in property accesses are almost always identifiers.
+
+    if (name->isIdentifier()) {
+        QHash<WTF::StringImpl*, propertyid_t>::const_iterator iter = m_identifiers.constFind(name);
+
+        if (iter != m_identifiers.constEnd()) {
+            return iter.value();
+        }
+    }
+
+    // Slow lookup by name, e.g. for subscripts converted to a string.
+
+    propertyid_t id = internName(QString(reinterpret_cast<const QChar*>(name->characters()), name->length()));
+
+    if (name->isIdentifier()) {
+        name->ref();
+        m_identifiers.insert(name, id);
+    }
+
+    return id;
+}
+
+QString QPropertyRegistry::getName(propertyid_t id) const
+{
+    return m_names.value(id);
+}
+
+propertyid_t QPropertyRegistry::internName(const QString& name)
+{
+    QHash<QString, propertyid_t>::const_iterator iter = m_ids.constFind(name);
+
+    if (iter != m_ids.constEnd()) {
+        return iter.value();
+    }
+
+    propertyid_t id = m_names.size();
+    m_names.append(name);
+    m_ids.insert(name, id);
+
+    return id;
+}
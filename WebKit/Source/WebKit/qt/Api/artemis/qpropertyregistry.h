@@ -0,0 +1,59 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QPROPERTYREGISTRY_H
+#define QPROPERTYREGISTRY_H
+
+#include <qwebkitglobal.h>
+
+#include <QString>
+#include <QHash>
+#include <QVector>
+
+namespace WTF {
+    class StringImpl;
+}
+
+typedef uint propertyid_t;
+
+/**
+ * Interns the property names seen by the property access instrumentation.
+ *
+ * Names are given small consecutive ids, such that sets of accessed properties can be kept as bit arrays, and are
+ * only converted to a QString once per distinct name.
+ */
+class QPropertyRegistry
+{
+
+public:
+    QPropertyRegistry();
+    ~QPropertyRegistry();
+
+    propertyid_t intern(WTF::StringImpl* name);
+    QString getName(propertyid_t id) const;
+
+private:
+    propertyid_t internName(const QString& name);
+
+    // Identifiers are kept alive by the registry, so their address can not be reused by another string.
+    QHash<WTF::StringImpl*, propertyid_t> m_identifiers;
+
+    QHash<QString, propertyid_t> m_ids;
+    QVector<QString> m_names;
+
+};
+
+#endif // QPROPERTYREGISTRY_H
@@ -14,11 +14,14 @@
  * limitations under the License.
  */
 
+#include <QHash>
+
 #include "qsource.h"
 
 QSource::QSource(uint key, QString url, uint startLine) :
     m_key(key),
     m_url(url),
+    m_urlHash(qHash(url)),
     m_startLine(startLine)
 {
 }
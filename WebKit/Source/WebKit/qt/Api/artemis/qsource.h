@@ -37,10 +37,17 @@ public:
         return m_startLine;
     }
 
+    // qHash of the url, computed once such that source and code block ids can be derived without rehashing the url
+    inline uint getUrlHash() const
+    {
+        return m_urlHash;
+    }
+
 private:
 
     uint m_key;
     QString m_url;
+    uint m_urlHash;
     uint m_startLine;
 
 
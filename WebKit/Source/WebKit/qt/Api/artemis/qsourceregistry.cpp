@@ -48,31 +48,54 @@ QSource* QSourceRegistry::get(JSC::SourceProvider* sourceProvider)
     }
 
     // Normal lookup (hash lookup of sourceProvider memory location)
-    // TODO
 
-    // Slow lookup
+    QHash<JSC::SourceProvider*, QSource*>::const_iterator providerIter = m_providers.find(sourceProvider);
+
+    if (providerIter != m_providers.end()) {
+        m_cache_key = sourceProvider;
+        m_cache_source = providerIter.value();
+
+        return providerIter.value();
+    }
+
+    // Slow lookup, only done once for each source provider
 
     QString url = QString::fromStdString(sourceProvider->url().utf8().data());
     uint lineOffset = sourceProvider->startPosition().m_line.zeroBasedInt() + 1;
 
-    uint key = qHash(QPair<QString, uint>(url, lineOffset));
+    QSource* source = get(url, lineOffset);
 
-    QHash<uint, QSource*>::iterator iter = m_registry.find(key);
+    m_providers.insert(sourceProvider, source);
 
-    if (iter == m_registry.end()) {
-        QSource* source = new QSource(key, url, lineOffset);
-        m_registry.insert(key, source);
+    m_cache_key = sourceProvider;
+    m_cache_source = source;
 
-        m_cache_key = sourceProvider;
-        m_cache_source = source;
+    return source;
+}
 
-        return source;
+QSource* QSourceRegistry::get(const QString& url, uint startLine)
+{
+    uint key = qHash(QPair<QString, uint>(url, startLine));
+
+    QHash<uint, QSource*>::iterator iter = m_registry.find(key);
+
+    if (iter != m_registry.end()) {
+        // A known source, e.g. the same script loaded again
+        return iter.value();
     }
 
-    // We should not hit this case, a slow lookup of a known element
+    QSource* source = new QSource(key, url, startLine);
+    m_registry.insert(key, source);
 
-    m_cache_key = sourceProvider;
-    m_cache_source = iter.value();
+    return source;
+}
 
-    return iter.value();
+void QSourceRegistry::forget(JSC::SourceProvider* sourceProvider)
+{
+    m_providers.remove(sourceProvider);
+
+    if (m_cache_key == sourceProvider) {
+        m_cache_key = NULL;
+        m_cache_source = NULL;
+    }
 }
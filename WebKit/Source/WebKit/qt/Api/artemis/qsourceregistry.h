@@ -35,18 +35,24 @@ class QSourceRegistry
 public:
     QSourceRegistry();
 
-    // <url, lineoffset>
-    //QPair<QString, uint> getLocation(sourceid_t sourceID) const;
     QSource* get(JSC::SourceProvider* sourceProvider);
 
-private:
-    //QHash<JSC::SourceProvider*, sourceid_t> m_registry;
+    // Looks up (or creates) the source by its url and start line, used when sources are restored from a checkpoint
+    // before the scripts are loaded
+    QSource* get(const QString& url, uint startLine);
+
+    // Must be called when a source provider is destroyed, its address may be reused by a different source
+    void forget(JSC::SourceProvider* sourceProvider);
 
+private:
     JSC::SourceProvider* m_cache_key;
     QSource* m_cache_source;
 
-    QHash<uint, QSource*> m_registry;
+    // Live source providers, several providers may share a source (e.g. the same script loaded on each page load)
+    QHash<JSC::SourceProvider*, QSource*> m_providers;
 
+    // All sources seen, keyed on <url, lineoffset>. Sources are never deleted as they are referenced by the listeners.
+    QHash<uint, QSource*> m_registry;
 
 };
 
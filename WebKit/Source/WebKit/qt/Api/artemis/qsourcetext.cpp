@@ -0,0 +1,107 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config.h"
+#include "wtf/text/StringImpl.h"
+
+#include "qsourcetext.h"
+
+class QSourceTextData : public QSharedData
+{
+
+public:
+    QSourceTextData(const QString& text) :
+        m_impl(NULL),
+        m_text(text)
+    {
+    }
+
+    QSourceTextData(const WTF::StringImpl* impl) :
+        m_impl(const_cast<WTF::StringImpl*>(impl))
+    {
+        if (m_impl) {
+            m_impl->ref();
+        }
+    }
+
+    ~QSourceTextData()
+    {
+        releaseImpl();
+    }
+
+    void releaseImpl()
+    {
+        if (m_impl) {
+            m_impl->deref();
+            m_impl = NULL;
+        }
+    }
+
+    // Set until the text is converted, after which only m_text is kept
+    WTF::StringImpl* m_impl;
+    QString m_text;
+};
+
+QSourceText::QSourceText() :
+    d(new QSourceTextData(QString()))
+{
+}
+
+QSourceText::QSourceText(const QString& text) :
+    d(new QSourceTextData(text))
+{
+}
+
+QSourceText::QSourceText(const WTF::StringImpl* text) :
+    d(new QSourceTextData(text))
+{
+}
+
+QSourceText::QSourceText(const QSourceText& other) :
+    d(other.d)
+{
+}
+
+QSourceText& QSourceText::operator=(const QSourceText& other)
+{
+    d = other.d;
+    return *this;
+}
+
+QSourceText::~QSourceText()
+{
+}
+
+QString QSourceText::getText() const
+{
+    if (d->m_impl) {
+        // Avoid characters() on 8-bit strings, it would leave an upconverted copy in the shared string
+        if (d->m_impl->is8Bit()) {
+            d->m_text = QString::fromLatin1(reinterpret_cast<const char*>(d->m_impl->characters8()), d->m_impl->length());
+        } else {
+            d->m_text = QString(reinterpret_cast<const QChar*>(d->m_impl->characters()), d->m_impl->length());
+        }
+
+        d->releaseImpl();
+    }
+
+    return d->m_text;
+}
+
+int QSourceText::length() const
+{
+    return d->m_impl ? d->m_impl->length() : d->m_text.length();
+}
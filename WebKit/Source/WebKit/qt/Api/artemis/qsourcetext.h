@@ -0,0 +1,60 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QSOURCETEXT_H
+#define QSOURCETEXT_H
+
+#include <qwebkitglobal.h>
+
+#include <QString>
+#include <QMetaType>
+#include <QExplicitlySharedDataPointer>
+
+namespace WTF {
+    class StringImpl;
+}
+
+class QSourceTextData;
+
+/**
+ * The text of a loaded script.
+ *
+ * Holds a reference to the string owned by the script's source provider instead of a copy, and only converts it
+ * to a QString the first time the text is requested. Copies of a QSourceText share the same text.
+ */
+class QWEBKIT_EXPORT QSourceText
+{
+
+public:
+    QSourceText();
+    explicit QSourceText(const QString& text);
+    explicit QSourceText(const WTF::StringImpl* text);
+
+    QSourceText(const QSourceText& other);
+    QSourceText& operator=(const QSourceText& other);
+    ~QSourceText();
+
+    QString getText() const;
+    int length() const;
+
+private:
+    QExplicitlySharedDataPointer<QSourceTextData> d;
+
+};
+
+Q_DECLARE_METATYPE(QSourceText)
+
+#endif // QSOURCETEXT_H
@@ -0,0 +1,57 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef QWEBFORMCONTROL_H
+#define QWEBFORMCONTROL_H
+
+#include <qwebkitglobal.h>
+
+#include <QString>
+#include <QList>
+
+#include <qwebelement.h>
+
+/**
+ * An option of a select element.
+ */
+struct QWebFormOption
+{
+    QString value; // The value property, i.e. the value attribute or the text if the option has none
+    QString text;
+    bool hasValueAttribute;
+};
+
+/**
+ * A form control (input, textarea or select element) as collected by QWebElement::formControls.
+ *
+ * Everything needed to describe the control and its restricted values is read in the same pass over the document,
+ * such that callers do not have to query the element again.
+ */
+struct QWebFormControl
+{
+    QWebElement element;
+    uint elementId; // See QWebElement::artemisId
+
+    QString tagName; // Lower case
+    QString type; // The type attribute
+    QString id;
+    QString name;
+    bool checked; // Has the checked attribute, i.e. is checked by default
+
+    QList<QWebFormOption> options; // Select elements only, in document order
+};
+
+#endif // QWEBFORMCONTROL_H
@@ -64,6 +64,10 @@
 #include "interpreter/Interpreter.h"
 #include "WebCore/dom/Element.h"
 #include "WebCore/xml/XPathResult.h"
+#include "HTMLNames.h"
+#include "HTMLOptionElement.h"
+#include "HTMLSelectElement.h"
+#include "artemis/qwebformcontrol.h"
 #include <iostream>
 
 #endif
@@ -883,6 +887,124 @@ int QWebElement::numberOfChildren(QString cssSelector){
     return counter;
 }
 
+/*!
+    Returns a structural hash of this element and its descendants (tag names, attributes and text).
+
+    The hash is maintained incrementally, only the subtrees which were mutated since the last call are rehashed.
+    If \a changedElements is given, the elements which were mutated since then are appended to it, where changes to
+    text nodes are reported as changes to their parent element.
+*/
+uint QWebElement::fingerprint(QList<QWebElement>* changedElements)
+{
+    if (!m_element)
+        return 0;
+
+    if (!changedElements)
+        return m_element->fingerprint();
+
+    Vector<Node*> changedNodes;
+    uint hash = m_element->fingerprint(&changedNodes);
+
+    Element* lastElement = 0;
+    for (size_t i = 0; i < changedNodes.size(); i++) {
+        Node* node = changedNodes[i];
+        Element* element = node->isElementNode() ? static_cast<Element*>(node) : node->parentElement();
+
+        if (element && element != lastElement) {
+            changedElements->append(QWebElement(element));
+            lastElement = element;
+        }
+    }
+
+    return hash;
+}
+
+/*!
+    Returns the version of the element tree of this element's document. The version changes whenever a node is
+    inserted into or removed from the document, but not when attributes or text change, and is never shared between
+    two documents. Lookups of elements by position can be cached for as long as the version is unchanged.
+*/
+quint64 QWebElement::childListVersion() const
+{
+    if (!m_element || !m_element->document())
+        return 0;
+
+    return m_element->document()->childListVersion();
+}
+
+/*!
+    Returns the id Artemis assigned to the underlying node when it was created. It is unique within a run and can be
+    used to key elements in hash tables. Returns 0 for a null element.
+*/
+uint QWebElement::artemisId() const
+{
+    if (!m_element)
+        return 0;
+
+    return m_element->artemisId();
+}
+
+/*!
+    Returns the input, textarea and select elements below this element (including the element itself) in document
+    order, together with their attributes and the options of select elements, collected in a single traversal.
+*/
+QList<QWebFormControl> QWebElement::formControls() const
+{
+    QList<QWebFormControl> controls;
+
+    if (!m_element)
+        return controls;
+
+    Node* node = m_element;
+    while (node) {
+        if (!node->isElementNode()) {
+            node = node->traverseNextNode(m_element);
+            continue;
+        }
+
+        Element* element = static_cast<Element*>(node);
+        bool isSelect = element->hasTagName(HTMLNames::selectTag);
+
+        if (!isSelect && !element->hasTagName(HTMLNames::inputTag) && !element->hasTagName(HTMLNames::textareaTag)) {
+            node = node->traverseNextNode(m_element);
+            continue;
+        }
+
+        QWebFormControl control;
+        control.element = QWebElement(element);
+        control.elementId = element->artemisId();
+        control.tagName = QString(element->tagName()).toLower();
+        control.type = element->getAttribute(HTMLNames::typeAttr);
+        control.id = element->getIdAttribute();
+        control.name = element->getAttribute(HTMLNames::nameAttr);
+        control.checked = element->hasAttribute(HTMLNames::checkedAttr);
+
+        if (isSelect) {
+            const Vector<HTMLElement*>& items = toHTMLSelectElement(element)->listItems();
+
+            for (size_t i = 0; i < items.size(); i++) {
+                if (!items[i]->hasTagName(HTMLNames::optionTag))
+                    continue;
+
+                HTMLOptionElement* option = toHTMLOptionElement(items[i]);
+
+                QWebFormOption formOption;
+                formOption.value = option->value();
+                formOption.text = option->text();
+                formOption.hasValueAttribute = option->hasAttribute(HTMLNames::valueAttr);
+                control.options.append(formOption);
+            }
+        }
+
+        controls.append(control);
+
+        // Form controls are not nested, and the options were read above
+        node = node->traverseNextSibling(m_element);
+    }
+
+    return controls;
+}
+
 #endif
 
 
@@ -38,6 +38,7 @@ namespace WebCore {
 
 #ifdef ARTEMIS
 class QWebExecutionListener;
+struct QWebFormControl;
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -144,6 +145,10 @@ public:
     QWebElement lookupXPath(QString xPath);
     bool  isUserVisible();
     int numberOfChildren(QString cssSelector);
+    uint fingerprint(QList<QWebElement>* changedElements = 0);
+    quint64 childListVersion() const;
+    uint artemisId() const;
+    QList<QWebFormControl> formControls() const;
 
 #else
     QVariant evaluateJavaScript(const QString& scriptSource);
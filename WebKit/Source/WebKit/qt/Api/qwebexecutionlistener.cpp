@@ -44,6 +44,7 @@
 #include "JavaScriptCore/bytecode/CodeBlock.h"
 #include "JavaScriptCore/bytecode/Opcode.h"
 #include "JavaScriptCore/interpreter/Interpreter.h"
+#include "JavaScriptCore/runtime/JSGlobalData.h"
 #include "WebCore/dom/Node.h"
 #include "WebCore/dom/Document.h"
 
@@ -55,11 +56,13 @@ QWebExecutionListener::QWebExecutionListener(QObject *parent)
     : QObject(parent)
     , inst::ExecutionListener()
     , jscinst::JSCExecutionListener()
+    , m_virtualTime(false)
     , m_ajax_callback_next_id(0)
     , m_reportHeapMode(0)
     , m_heapReportNumber(0)
     , m_heapReportFactor(1)
 {
+    m_bytecodeBatch.reserve(jscinst::BytecodeBuffer::CAPACITY);
 }
 
 void QWebExecutionListener::eventAdded(WebCore::EventTarget* target, const char* type) {
@@ -172,6 +175,18 @@ void QWebExecutionListener::page_load_scheduled(const char* url) {
     emit sigPageLoadScheduled(newUrl);
 }
 
+void QWebExecutionListener::dom_text_inserted(const WTF::String& text) {
+
+    if (!JSC::Interpreter::m_enableInstrumentations)
+        return;
+
+    // Called for every text node and attribute of every page, avoid the conversion if nobody listens
+    if (receivers(SIGNAL(sigDomTextInserted(QString))) == 0 || text.isEmpty())
+        return;
+
+    emit sigDomTextInserted(text);
+}
+
 // TIMERS START
 
 void QWebExecutionListener::timerAdded(WebCore::ScriptExecutionContext* context, int timerId, int timeout, bool singleShot) {
@@ -187,20 +202,40 @@ void QWebExecutionListener::timerRemoved(WebCore::ScriptExecutionContext* contex
 void QWebExecutionListener::timerFire(int timerId) {
     Q_ASSERT(timerId > 0);
 
-    QMap<int, WebCore::ScriptExecutionContext*>::const_iterator i = m_timers.find(timerId);
-    
-    if (i != m_timers.constEnd() && i.key() == timerId) {
-        i.value()->findTimeout(timerId)->fired();
+    WebCore::ScriptExecutionContext* context = m_timers.value(timerId, NULL);
+
+    if (context == NULL) {
+        return;
     }
 
-    i++;
-    Q_ASSERT(i != m_timers.constEnd());
+    WebCore::DOMTimer* timer = context->findTimeout(timerId);
+
+    if (timer == NULL) {
+        return;
+    }
+
+    emit firingTimer(timerId);
+
+    // A single shot timer is deleted (and removed from m_timers) by fired()
+    timer->fired();
 }
 
 void QWebExecutionListener::clearTimers() {
     m_timers.clear();
 }
 
+bool QWebExecutionListener::isVirtualTimeEnabled() {
+    return m_virtualTime;
+}
+
+void QWebExecutionListener::enableVirtualTime() {
+    m_virtualTime = true;
+}
+
+void QWebExecutionListener::setVirtualTimeOffset(double milliseconds) {
+    jscinst::virtual_time_offset = milliseconds;
+}
+
 // TIMERS END
 
 bool domNodeSignature(JSC::CallFrame * cframe, JSC::JSObject * domElement, QString * signature) {
@@ -421,9 +456,12 @@ void QWebExecutionListener::javascript_code_loaded(JSC::SourceProvider* sp, JSC:
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    std::string source(sp->getRange(0, sp->length()).utf8().data());
+    // The text is shared with the source provider, receivers only pay for the conversion if they use it
+    emit loadedJavaScript(QSourceText(sp->data()), m_sourceRegistry.get(sp));
+}
 
-    emit loadedJavaScript(QString(tr(source.c_str())), m_sourceRegistry.get(sp));
+void QWebExecutionListener::javascript_source_provider_destroyed(JSC::SourceProvider* sourceProvider) {
+    m_sourceRegistry.forget(sourceProvider);
 }
 
 void QWebExecutionListener::javascript_executed_statement(const JSC::DebuggerCallFrame& callFrame, uint linenumber) {
@@ -437,48 +475,94 @@ void QWebExecutionListener::javascript_executed_statement(const JSC::DebuggerCal
                            m_sourceRegistry.get(sourceProvider));
 }
 
-void QWebExecutionListener::javascript_bytecode_executed(JSC::Interpreter* interpreter,
-                                                         JSC::CodeBlock* codeBlock,
-                                                         JSC::Instruction* instruction,
-                                                         const JSC::BytecodeInfo& info) {
-    
-    
-    if (!JSC::Interpreter::m_enableInstrumentations)
-        return;
+/**
+ * Delivers a batch of executed bytecodes drained from the interpreter's bytecode buffer.
+ *
+ * The code block details are only looked up when the code block changes, as consecutive records usually belong to
+ * the same one. The source location of a bytecode is not resolved here, most executed bytecodes are already covered
+ * and the receivers call resolveBytecodeLocation for the ones they keep. The batch vector is reused between drains
+ * and must not be kept by the receivers.
+ */
+void QWebExecutionListener::javascript_bytecodes_executed(const jscinst::BytecodeRecord* records, size_t count) {
 
-    uint bytecodeOffset = instruction - codeBlock->instructions().begin();
+    m_bytecodeBatch.resize(count);
 
-    ByteCodeInfoStruct binfo;
-    binfo.opcodeId = interpreter->getOpcodeID(instruction->u.opcode);
-    binfo.linenumber = codeBlock->lineNumberForBytecodeOffset(bytecodeOffset);
-    binfo.isSymbolic = info.isSymbolic();
-    binfo.bytecodeOffset = bytecodeOffset;
+    JSC::CodeBlock* lastCodeBlock = NULL;
+    QSource* source = NULL;
+    uint sourceOffset = 0;
+    uint codeBlockSize = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const jscinst::BytecodeRecord& record = records[i];
+        JSC::CodeBlock* codeBlock = record.codeBlock;
 
-    codeBlock->expressionRangeForBytecodeOffset(bytecodeOffset, binfo.divot, binfo.startOffset, binfo.endOffset);
-    emit sigJavascriptBytecodeExecuted(binfo,
-                                       codeBlock->sourceOffset(),
-                                       m_sourceRegistry.get(codeBlock->source()));
+        if (codeBlock != lastCodeBlock) {
+            source = m_sourceRegistry.get(codeBlock->source());
+            sourceOffset = codeBlock->sourceOffset();
+            codeBlockSize = codeBlock->numberOfInstructions();
+            lastCodeBlock = codeBlock;
+        }
+
+        ByteCodeInfoStruct& binfo = m_bytecodeBatch[i];
+        binfo.isSymbolic = record.isSymbolic;
+        binfo.bytecodeOffset = record.bytecodeOffset;
+        binfo.sourceOffset = sourceOffset;
+        binfo.codeBlockSize = codeBlockSize;
+        binfo.source = source;
+        binfo.codeBlock = codeBlock;
+    }
+
+    emit sigJavascriptBytecodesExecuted(m_bytecodeBatch);
+}
+
+void QWebExecutionListener::resolveBytecodeLocation(ByteCodeInfoStruct& binfo)
+{
+    JSC::CodeBlock* codeBlock = binfo.codeBlock;
+
+    binfo.opcodeId = codeBlock->globalData()->interpreter->getOpcodeID(codeBlock->instructions()[binfo.bytecodeOffset].u.opcode);
+    binfo.linenumber = codeBlock->lineNumberForBytecodeOffset(binfo.bytecodeOffset);
+
+    codeBlock->expressionRangeForBytecodeOffset(binfo.bytecodeOffset, binfo.divot, binfo.startOffset, binfo.endOffset);
+}
+
+/**
+ * Drains the pending executed bytecodes. Should be called at event and handler boundaries, and before
+ * anything reads the coverage information.
+ */
+void QWebExecutionListener::flushBytecodes()
+{
+    jscinst::bytecode_buffer.flush();
+}
+
+QString QWebExecutionListener::getPropertyName(uint propertyId) const
+{
+    return m_propertyRegistry.getName(propertyId);
+}
+
+QSource* QWebExecutionListener::getSource(const QString& url, uint startLine)
+{
+    return m_sourceRegistry.get(url, startLine);
 }
 
-void QWebExecutionListener::javascript_property_read(std::string propertyName, JSC::CallFrame* callFrame)
+void QWebExecutionListener::javascript_property_read(WTF::StringImpl* propertyName, JSC::CallFrame* callFrame)
 {
 
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    emit sigJavascriptPropertyRead(QString::fromStdString(propertyName),
+    emit sigJavascriptPropertyRead(m_propertyRegistry.intern(propertyName),
                                    (intptr_t)callFrame->codeBlock(),
                                    callFrame->codeBlock()->source()->asID(),
                                    m_sourceRegistry.get(callFrame->codeBlock()->source()));
 }
 
-void QWebExecutionListener::javascript_property_written(std::string propertyName, JSC::CallFrame* callFrame)
+void QWebExecutionListener::javascript_property_written(WTF::StringImpl* propertyName, JSC::CallFrame* callFrame)
 {
 
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    emit sigJavascriptPropertyWritten(QString::fromStdString(propertyName),
+    emit sigJavascriptPropertyWritten(m_propertyRegistry.intern(propertyName),
                                       (intptr_t)callFrame->codeBlock(),
                                       callFrame->codeBlock()->source()->asID(),
                                       m_sourceRegistry.get(callFrame->codeBlock()->source()));
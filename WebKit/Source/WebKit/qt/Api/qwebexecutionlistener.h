@@ -17,6 +17,7 @@
 #include <QtCore/qobject.h>
 #include <QUrl>
 #include <QMap>
+#include <QVector>
 #include "qwebkitglobal.h"
 #include "qwebelement.h"
 
@@ -29,13 +30,16 @@
 #include "../JavaScriptCore/bytecode/Opcode.h"
 
 #include "artemis/qsource.h"
+#include "artemis/qsourcetext.h"
 #include "artemis/qsourceregistry.h"
+#include "artemis/qpropertyregistry.h"
 
 #ifndef QWEBEXECUTIONLISTENER_H
 #define QWEBEXECUTIONLISTENER_H
 
 namespace JSC {
     class ExecState;
+    class CodeBlock;
 }
 
 struct ByteCodeInfoStruct
@@ -48,6 +52,14 @@ struct ByteCodeInfoStruct
     int endOffset;
     bool isSymbolic;
 
+    // Only set for bytecodes delivered through sigJavascriptBytecodesExecuted. These carry neither the opcode nor the
+    // source location, which are filled in by QWebExecutionListener::resolveBytecodeLocation on request. The code
+    // block is only valid while the batch is being delivered.
+    uint sourceOffset;
+    uint codeBlockSize;
+    QSource* source;
+    JSC::CodeBlock* codeBlock;
+
     QString getOpcodeName() const {
         return QString::fromStdString(JSC::opcodeNames[opcodeId]);
     }
@@ -55,6 +67,8 @@ struct ByteCodeInfoStruct
 
 Q_DECLARE_METATYPE(ByteCodeInfoStruct);
 
+typedef QVector<ByteCodeInfoStruct> ByteCodeInfoBatch;
+
 class QWEBKIT_EXPORT QWebExecutionListener : public QObject, public inst::ExecutionListener, public jscinst::JSCExecutionListener
 {
     Q_OBJECT
@@ -76,11 +90,12 @@ public:
     virtual void javascript_returned_function(const JSC::DebuggerCallFrame&);
 
     virtual void javascript_executed_statement(const JSC::DebuggerCallFrame&, uint lineNumber); // from the debugger
-    virtual void javascript_bytecode_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, JSC::Instruction* inst, const JSC::BytecodeInfo& info); // interpreter instrumentation
-    virtual void javascript_property_read(std::string propertyName, JSC::ExecState*);
-    virtual void javascript_property_written(std::string propertyName, JSC::ExecState*);
+    virtual void javascript_bytecodes_executed(const jscinst::BytecodeRecord* records, size_t count); // interpreter instrumentation (batched)
+    virtual void javascript_property_read(WTF::StringImpl* propertyName, JSC::ExecState*);
+    virtual void javascript_property_written(WTF::StringImpl* propertyName, JSC::ExecState*);
     virtual void javascript_branch_executed(bool jump, Symbolic::Expression* condition, JSC::ExecState*, const JSC::Instruction*, const JSC::BytecodeInfo&);
     virtual void javascript_symbolic_field_read(std::string variable, bool isSymbolic);
+    virtual void javascript_source_provider_destroyed(JSC::SourceProvider* sourceProvider);
 
     void javascriptConstantStringEncountered(std::string constant);
     virtual void javascript_eval_call(const char * eval_string);
@@ -92,14 +107,33 @@ public:
 
     void page_load_scheduled(const char* url);
 
+    virtual void dom_text_inserted(const WTF::String& text);
+
     virtual void timerAdded(WebCore::ScriptExecutionContext* context, int timerId, int timeout, bool singleShot);
     virtual void timerRemoved(WebCore::ScriptExecutionContext* context, int timerId);
     void timerFire(int timerId);
     void clearTimers();
 
+    // Under virtual time DOM timers only fire through timerFire, see WebCore::DOMTimer
+    virtual bool isVirtualTimeEnabled();
+    void enableVirtualTime();
+    void setVirtualTimeOffset(double milliseconds);
+
     void enableHeapReport(bool namedOnly, int heapReportNumber, int factor);
     QList<QString> getHeapReport(int &heapReportNumber);
 
+    void flushBytecodes();
+
+    // Fills in the opcode and source location of a bytecode delivered through sigJavascriptBytecodesExecuted. Must be
+    // called while the batch is being delivered.
+    static void resolveBytecodeLocation(ByteCodeInfoStruct& binfo);
+
+    // Resolves the ids given by sigJavascriptPropertyRead and sigJavascriptPropertyWritten.
+    QString getPropertyName(uint propertyId) const;
+
+    // The source which scripts with this url and start line will be reported with, see QSourceRegistry.
+    QSource* getSource(const QString& url, uint startLine);
+
     void beginSymbolicSession();
     void endSymbolicSession();
 
@@ -108,11 +142,14 @@ public:
 
 private:
     QMap<int, WebCore::ScriptExecutionContext*> m_timers;
+    bool m_virtualTime;
 
     QMap<int, WebCore::LazyXMLHttpRequest*> m_ajax_callbacks;
     int m_ajax_callback_next_id;
 
     QSourceRegistry m_sourceRegistry;
+    QPropertyRegistry m_propertyRegistry;
+    ByteCodeInfoBatch m_bytecodeBatch;
     QList<QString> m_heapReport;
     int m_reportHeapMode;
     int m_heapReportNumber;
@@ -126,6 +163,7 @@ signals:
 
     void addedTimer(int timerId, int timeout, bool singleShot);
     void removedTimer(int timerId);
+    void firingTimer(int timerId); // emitted before the timer callback runs
 
     void script_crash(QString cause, intptr_t sourceID, int lineNumber);
     void script_url_load(QUrl url);
@@ -138,20 +176,23 @@ signals:
     void sigJavascriptConstantStringEncountered(QString constant);
 
     /* Property Access Instrumentation */
-    void sigJavascriptPropertyRead(QString propertyName, intptr_t codeBlockID, intptr_t SourceID, QSource* source);
-    void sigJavascriptPropertyWritten(QString propertyName, intptr_t codeBlockID, intptr_t SourceID, QSource* source);
+    void sigJavascriptPropertyRead(uint propertyId, intptr_t codeBlockID, intptr_t SourceID, QSource* source);
+    void sigJavascriptPropertyWritten(uint propertyId, intptr_t codeBlockID, intptr_t SourceID, QSource* source);
 
     /* JavaScript Instrumentation */
-    void loadedJavaScript(QString sourcecode, QSource* source);
+    void loadedJavaScript(QSourceText sourcecode, QSource* source);
     void statementExecuted(uint linenumber, QSource* source);
     void sigJavascriptFunctionCalled(QString functionName, size_t bytecodeSize, uint functionLine, uint sourceOffset, QSource* source);
     void sigJavascriptFunctionReturned(QString functionName);
-    void sigJavascriptBytecodeExecuted(const ByteCodeInfoStruct byteInfo, uint sourceOffset, QSource* source);
+    void sigJavascriptBytecodesExecuted(const ByteCodeInfoBatch& batch);
     void sigJavascriptBranchExecuted(bool jump, Symbolic::Expression* condition, uint sourceOffset, QSource* source, const ByteCodeInfoStruct byteInfo);
     void sigJavascriptSymbolicFieldRead(QString variable, bool isSymbolic);
 
     /* Page Load Instrumentation */
     void sigPageLoadScheduled(QUrl url);
+
+    // Text (character data or attribute values) inserted into a document, only converted if something is connected
+    void sigDomTextInserted(QString text);
 };
 
 
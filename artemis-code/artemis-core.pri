@@ -19,6 +19,11 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/browser/ajax/ajaxrequest.h \
     src/runtime/browser/ajax/ajaxrequestlistener.h \
     src/runtime/browser/cookies/immutablecookiejar.h \
+    src/runtime/browser/snapshot/networkcache.h \
+    src/runtime/worker/workerpool.h \
+    src/runtime/worker/workerqueue.h \
+    src/runtime/worker/configurationserialiser.h \
+    src/runtime/browser/snapshot/snapshotreply.h \
     src/runtime/input/events/baseeventparameters.h \
     src/runtime/input/events/domelementdescriptor.h \
     src/runtime/input/events/eventhandlerdescriptor.h \
@@ -34,6 +39,7 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/browser/executionresult.h \
     src/runtime/browser/webkitexecutor.h \
     src/runtime/browser/timer.h \
+    src/runtime/browser/virtualclock.h \
     src/runtime/worklist/deterministicworklist.h \
     src/runtime/worklist/worklist.h \
     src/strategies/termination/numberofiterationstermination.h \
@@ -71,6 +77,7 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/toplevel/artemisruntime.h \
     src/runtime/browser/artemiswebview.h \
     src/runtime/browser/artemiswebpage.h \
+    src/runtime/browser/domelementresolver.h \
     src/concolic/search/search.h \
     src/concolic/solver/solver.h \
     src/concolic/search/searchdfs.h \
@@ -98,9 +105,13 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/concolic/executiontree/nodes/tracesymbolicbranch.h \
     src/concolic/executiontree/tracenodes.h \
     src/concolic/executiontree/tracemerger.h \
+    src/concolic/executiontree/executiontreelog.h \
+    src/concolic/executiontree/executiontreereplay.h \
+    src/concolic/executiontree/executiontreecheckpoint.h \
     src/concolic/executiontree/tracedisplay.h \
     src/concolic/solver/expressionvalueprinter.h \
     src/concolic/solver/expressionfreevariablelister.h \
+    src/concolic/solver/expressionserialiser.h \
     src/concolic/solver/constraintwriter/abstract.h \
     src/concolic/solver/constraintwriter/kaluza.h \
     src/concolic/solver/constraintwriter/z3str.h \
@@ -116,6 +127,9 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/input/clickinput.h \
     src/concolic/executiontree/tracedisplayoverview.h \
     src/concolic/solver/cvc4solver.h \
+    src/concolic/solver/solverpool.h \
+    src/concolic/solver/solvercache.h \
+    src/concolic/solver/cvc4session.h \
     src/concolic/solver/constraintwriter/cvc4.h \
     src/concolic/solver/constraintwriter/smt.h \
     src/concolic/solver/constraintwriter/cvc4regexcompiler.h \
@@ -154,6 +168,11 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/browser/ajax/ajaxrequest.cpp \
     src/runtime/browser/ajax/ajaxrequestlistener.cpp \
     src/runtime/browser/cookies/immutablecookiejar.cpp \
+    src/runtime/browser/snapshot/networkcache.cpp \
+    src/runtime/worker/workerpool.cpp \
+    src/runtime/worker/workerqueue.cpp \
+    src/runtime/worker/configurationserialiser.cpp \
+    src/runtime/browser/snapshot/snapshotreply.cpp \
     src/runtime/input/events/baseeventparameters.cpp \
     src/runtime/input/events/domelementdescriptor.cpp \
     src/runtime/input/events/eventhandlerdescriptor.cpp \
@@ -162,6 +181,7 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/input/events/mouseeventparameters.cpp \
     src/runtime/browser/artemiswebview.cpp \
     src/runtime/browser/artemiswebpage.cpp \
+    src/runtime/browser/domelementresolver.cpp \
     src/runtime/executableconfiguration.cpp \
     src/runtime/input/dominput.cpp \
     src/runtime/input/inputsequence.cpp \
@@ -169,6 +189,7 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/browser/executionresult.cpp \
     src/runtime/browser/webkitexecutor.cpp \
     src/runtime/browser/timer.cpp \
+    src/runtime/browser/virtualclock.cpp \
     src/runtime/worklist/deterministicworklist.cpp \
     src/strategies/termination/numberofiterationstermination.cpp \
     src/strategies/inputgenerator/randominputgenerator.cpp \
@@ -218,14 +239,19 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/strategies/inputgenerator/form/forminputgenerator.cpp \
     src/concolic/pathcondition.cpp \
     src/concolic/executiontree/nodes/traceunexplored.cpp \
+    src/concolic/executiontree/nodes/trace.cpp \
     src/concolic/executiontree/nodes/tracebranch.cpp \
     src/concolic/executiontree/nodes/traceconcretebranch.cpp \
     src/concolic/executiontree/nodes/tracesymbolicbranch.cpp \
     src/concolic/executiontree/tracemerger.cpp \
+    src/concolic/executiontree/executiontreelog.cpp \
+    src/concolic/executiontree/executiontreereplay.cpp \
+    src/concolic/executiontree/executiontreecheckpoint.cpp \
     src/concolic/executiontree/tracedisplay.cpp \
     src/concolic/search/searchdfs.cpp \
     src/concolic/solver/expressionvalueprinter.cpp \
     src/concolic/solver/expressionfreevariablelister.cpp \
+    src/concolic/solver/expressionserialiser.cpp \
     src/concolic/solver/constraintwriter/abstract.cpp \
     src/concolic/solver/constraintwriter/kaluza.cpp \
     src/concolic/solver/constraintwriter/z3str.cpp \
@@ -241,6 +267,9 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/input/clickinput.cpp \
     src/concolic/executiontree/tracedisplayoverview.cpp \
     src/concolic/solver/cvc4solver.cpp \
+    src/concolic/solver/solverpool.cpp \
+    src/concolic/solver/solvercache.cpp \
+    src/concolic/solver/cvc4session.cpp \
     src/concolic/solver/constraintwriter/cvc4.cpp \
     src/concolic/solver/constraintwriter/smt.cpp \
     src/concolic/solver/constraintwriter/cvc4regexcompiler.cpp \
@@ -29,6 +29,9 @@
 #include "artemisglobals.h"
 #include "runtime/input/forms/injectionvalue.h"
 #include "util/useragents.h"
+#include "concolic/executiontree/executiontreereplay.h"
+#include "concolic/executiontree/tracedisplay.h"
+#include "concolic/executiontree/tracedisplayoverview.h"
 
 #include "JavaScriptCore/symbolic/symbolicinterpreter.h"
 
@@ -101,6 +104,53 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "--event-visibility-check <true|false>:\n"
             "           Enable or disable event visibility checks, which filters out any event which is not attached to a user visible element. Default: (false).\n"
             "\n"
+            "--network-cache <mode>:\n"
+            "           Serve repeated network requests from memory instead of the server. Requests are identified by their\n"
+            "           method, URL and body.\n"
+            "\n"
+            "           off - (default) every request goes to the server\n"
+            "           page-load - replay the GET requests of the page load once it has been recorded\n"
+            "           replay - record the first response to every HTTP request, including AJAX requests, and replay it\n"
+            "           strict - as replay, but only the first page load is recorded and unseen requests fail afterwards,\n"
+            "                    every iteration sees exactly the same responses\n"
+            "\n"
+            "--network-cache-archive <file>:\n"
+            "           Load recorded responses from <file> and append newly recorded responses to it, such that later runs\n"
+            "           are served without contacting the server. In strict mode a non-empty archive is never extended.\n"
+            "           Implies --network-cache replay unless another mode is given. Not supported with --workers.\n"
+            "\n"
+            "--bytecode-coverage <true|false>:\n"
+            "           Record the executed bytecodes. Without it the interpreter skips the coverage hook entirely, but line\n"
+            "           coverage is not measured (WebKit::coverage::covered-unique is 0). Always enabled when a coverage\n"
+            "           report or the coverage prioritizer is used. Default: (true).\n"
+            "\n"
+            "--constant-string-instrumentation <true|false>:\n"
+            "           Report the constant strings used by the interpreter. Always enabled with the javascript-constants\n"
+            "           form input strategy. Default: (false).\n"
+            "\n"
+            "--property-access-instrumentation <true|false>:\n"
+            "           Report the property reads and writes of the interpreter. Always enabled with the readwrite\n"
+            "           prioritizer. Default: (false).\n"
+            "\n"
+            "--virtual-time <mode>:\n"
+            "           Run the timers of the page (setTimeout and setInterval) on a virtual clock instead of the wall clock.\n"
+            "           The clock jumps to the due time of a timer when it fires, and Date follows it.\n"
+            "\n"
+            "           off - (default) timers run on the wall clock\n"
+            "           manual - timers only fire when an input sequence fires them\n"
+            "           auto - as manual, but after the page load and after every input the timers due within the\n"
+            "                  horizon are fired, in order of their due time\n"
+            "\n"
+            "--virtual-time-horizon <ms>:\n"
+            "           How far the virtual clock may advance after the page load and after every input in auto mode.\n"
+            "           Default: 10000.\n"
+            "\n"
+            "--workers <n>:\n"
+            "           Run <n> worker processes in parallel (major-mode artemis only). The configurations found by each\n"
+            "           execution are dealt out between the workers, which explore them with their own worklist. Coverage and\n"
+            "           statistics of the workers are merged when all of them are done. Path trace, heap and event sequence\n"
+            "           reports are not produced in this mode. Default: 1.\n"
+            "\n"
             "--input-strategy-same-length <num>:\n"
             "           Set the number of permutations of an executed sequence (of same length) generated by the input generator.\n"
             "\n"
@@ -132,6 +182,17 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "           final-overview - Like final but also includes a simplified overview graph.\n"
             "           all - Generate a graph of the tree at every iteration.\n"
             "           all-overview - Like all but also includes simplified overview graphs.\n"
+            "           log - Only write a log of the changes to the tree at every iteration, from which\n"
+            "                 --concolic-tree-replay can produce the graph of any iteration.\n"
+            "           (final and final-overview also keep this log while the analysis runs.)\n"
+            "\n"
+            "--concolic-tree-replay <path>:\n"
+            "           Rebuild the execution tree from a log written with --concolic-tree-output and write its graph\n"
+            "           (and the overview graph with final-overview or all-overview) instead of running an analysis.\n"
+            "           No URL is needed.\n"
+            "\n"
+            "--concolic-tree-replay-iteration <n>:\n"
+            "           Show the tree as it was after iteration n. Default: the latest tree in the log.\n"
             "\n"
             "--concolic-search-procedure <search>\n"
             "           Choose the search procedure used to choose new areas of the concolic execution tree to explore.\n"
@@ -189,6 +250,42 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "           cvc4 (default) - Use the CVC4 SMT solver as backend.\n"
             "           kaluza - Use the Kaluza solver as backend.\n"
             "\n"
+            "--concolic-solver-workers <n>:\n"
+            "           Solve up to n search targets concurrently, each with its own CVC4 process (default 1).\n"
+            "           Only supported with the cvc4 solver.\n"
+            "\n"
+            "--concolic-solver-cache <true|false>:\n"
+            "           Reuse solutions of path conditions which were solved before (default false). Path conditions are\n"
+            "           compared after renaming their variables, and a path condition containing all the clauses of an\n"
+            "           UNSAT one is known to be UNSAT without calling the solver.\n"
+            "\n"
+            "--concolic-solver-cache-file <path>:\n"
+            "           Load the solver cache from the given file and append new solutions to it, such that later runs\n"
+            "           against the same application start with the solutions found before. Implies --concolic-solver-cache.\n"
+            "\n"
+            "--concolic-checkpoint <path>:\n"
+            "           Save the execution tree and the state of the search to the given file every\n"
+            "           concolic-checkpoint-interval iterations and when the analysis ends.\n"
+            "\n"
+            "--concolic-checkpoint-interval <n>:\n"
+            "           The number of iterations between checkpoints (default 10).\n"
+            "\n"
+            "--concolic-resume <path>:\n"
+            "           Continue the analysis saved in the given checkpoint instead of starting a new execution tree.\n"
+            "           The search options should match those of the saved analysis, except that the budget given\n"
+            "           by concolic-selection-budget may be raised.\n"
+            "\n"
+            "--concolic-constraint-dir <path>:\n"
+            "           Write the constraint log, the constraint index and the constraints of each solver query to the\n"
+            "           given directory (default is a directory in the system temp directory named after the process id).\n"
+            "\n"
+            "--statistics-json <path>:\n"
+            "           Write the final statistics to the given file as a JSON object.\n"
+            "\n"
+            "--statistics-timeline <path>:\n"
+            "           Write one JSON object per iteration to the given file, containing the statistics which changed\n"
+            "           during that iteration.\n"
+            "\n"
             "--export-event-sequence <output type> :\n"
             "           selenium - Will create a selenium test suite of all the iterations.\n"
             "           json - Will create a JSON file containing the iterations.\n"
@@ -239,6 +336,27 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
     {"concolic-dfs-depth", required_argument, NULL, 'D'},
     {"debug-concolic", no_argument, NULL, 'E'},
     {"event-visibility-check", required_argument, NULL, 'G'},
+    {"network-cache", required_argument, NULL, 'Q'},
+    {"network-cache-archive", required_argument, NULL, 'Z'},
+    {"bytecode-coverage", required_argument, NULL, 'M'},
+    {"constant-string-instrumentation", required_argument, NULL, '7'},
+    {"property-access-instrumentation", required_argument, NULL, '8'},
+    {"virtual-time", required_argument, NULL, '1'},
+    {"virtual-time-horizon", required_argument, NULL, '2'},
+    {"workers", required_argument, NULL, 'N'},
+    {"worker-shard", required_argument, NULL, 'K'},
+    {"worker-output", required_argument, NULL, 'O'},
+    {"concolic-solver-workers", required_argument, NULL, 'V'},
+    {"concolic-solver-cache", required_argument, NULL, 'J'},
+    {"concolic-solver-cache-file", required_argument, NULL, 'L'},
+    {"statistics-json", required_argument, NULL, 'X'},
+    {"statistics-timeline", required_argument, NULL, 'Y'},
+    {"concolic-checkpoint", required_argument, NULL, '3'},
+    {"concolic-checkpoint-interval", required_argument, NULL, '4'},
+    {"concolic-resume", required_argument, NULL, '5'},
+    {"concolic-constraint-dir", required_argument, NULL, '6'},
+    {"concolic-tree-replay", required_argument, NULL, '9'},
+    {"concolic-tree-replay-iteration", required_argument, NULL, 'P'},
     {0, 0, 0, 0}
     };
 
@@ -329,6 +447,8 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             } else if (string(optarg).compare("all-overview") == 0) {
                 options.concolicTreeOutput = artemis::TREE_ALL;
                 options.concolicTreeOutputOverview = true;
+            } else if (string(optarg).compare("log") == 0) {
+                options.concolicTreeOutput = artemis::TREE_LOG;
             } else {
                 cerr << "ERROR: Invalid choice of concolic-tree-output " << optarg << endl;
                 exit(1);
@@ -478,7 +598,7 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
                 } else if(string(optarg).compare("--path-trace-report") == 0){
                     std::cout << "all click html none";
                 } else if(string(optarg).compare("--concolic-tree-output") == 0){
-                    std::cout << "none final all final-overview all-overview";
+                    std::cout << "none final all final-overview all-overview log";
                 } else if(string(optarg).compare("----concolic-search-procedure") == 0){
                     std::cout << "dfs dfs-testing random easily-bored";
                 } else if(string(optarg).compare("--concolic-event-sequences") == 0){
@@ -771,6 +891,197 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             break;
         }
 
+        case 'Q': {
+
+            if (string(optarg).compare("off") == 0) {
+                options.networkCache = artemis::NETWORK_CACHE_OFF;
+            } else if (string(optarg).compare("page-load") == 0) {
+                options.networkCache = artemis::NETWORK_CACHE_PAGE_LOAD;
+            } else if (string(optarg).compare("replay") == 0) {
+                options.networkCache = artemis::NETWORK_CACHE_REPLAY;
+            } else if (string(optarg).compare("strict") == 0) {
+                options.networkCache = artemis::NETWORK_CACHE_STRICT;
+            } else {
+                cerr << "ERROR: Invalid choice of network cache " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'Z': {
+            options.networkCacheArchive = QString(optarg);
+            break;
+        }
+
+        case 'M': {
+
+            if (string(optarg).compare("true") == 0) {
+                options.enableBytecodeCoverage = true;
+            } else if (string(optarg).compare("false") == 0) {
+                options.enableBytecodeCoverage = false;
+            } else {
+                cerr << "ERROR: Invalid choice of bytecode coverage " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case '7': {
+
+            if (string(optarg).compare("true") == 0) {
+                options.enableConstantStringInstrumentation = true;
+            } else if (string(optarg).compare("false") == 0) {
+                options.enableConstantStringInstrumentation = false;
+            } else {
+                cerr << "ERROR: Invalid choice of constant string instrumentation " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case '8': {
+
+            if (string(optarg).compare("true") == 0) {
+                options.enablePropertyAccessInstrumentation = true;
+            } else if (string(optarg).compare("false") == 0) {
+                options.enablePropertyAccessInstrumentation = false;
+            } else {
+                cerr << "ERROR: Invalid choice of property access instrumentation " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case '1': {
+
+            if (string(optarg).compare("off") == 0) {
+                options.virtualTime = artemis::VIRTUAL_TIME_OFF;
+            } else if (string(optarg).compare("manual") == 0) {
+                options.virtualTime = artemis::VIRTUAL_TIME_MANUAL;
+            } else if (string(optarg).compare("auto") == 0) {
+                options.virtualTime = artemis::VIRTUAL_TIME_AUTO;
+            } else {
+                cerr << "ERROR: Invalid choice of virtual time " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case '2': {
+            options.virtualTimeHorizon = QString(optarg).toUInt();
+            break;
+        }
+
+        case 'N': {
+            options.workers = QString(optarg).toInt();
+
+            if (options.workers < 1) {
+                cerr << "ERROR: Invalid number of workers " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'K': {
+            options.workerShard = QString(optarg).toInt();
+            break;
+        }
+
+        case 'O': {
+            options.workerOutput = QString(optarg);
+            break;
+        }
+
+        case 'V': {
+            options.concolicSolverWorkers = QString(optarg).toInt();
+
+            if (options.concolicSolverWorkers < 1) {
+                cerr << "ERROR: Invalid number of solver workers " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'J': {
+
+            if (string(optarg).compare("true") == 0) {
+                options.concolicSolverCache = true;
+            } else if (string(optarg).compare("false") == 0) {
+                options.concolicSolverCache = false;
+            } else {
+                cerr << "ERROR: Invalid choice of concolic solver cache " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'L': {
+            options.concolicSolverCacheFile = QString(optarg);
+            options.concolicSolverCache = true;
+            break;
+        }
+
+        case 'X': {
+            options.statisticsJSON = QString(optarg);
+            break;
+        }
+
+        case 'Y': {
+            options.statisticsTimeline = QString(optarg);
+            break;
+        }
+
+        case '3': {
+            options.concolicCheckpointFile = QString(optarg);
+            break;
+        }
+
+        case '4': {
+            options.concolicCheckpointInterval = QString(optarg).toUInt();
+
+            if (options.concolicCheckpointInterval < 1) {
+                cerr << "ERROR: Invalid concolic checkpoint interval " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case '5': {
+            options.concolicResumeFile = QString(optarg);
+            break;
+        }
+
+        case '6': {
+            options.concolicConstraintDir = QString(optarg);
+            break;
+        }
+
+        case '9': {
+            options.concolicTreeReplayFile = QString(optarg);
+            break;
+        }
+
+        case 'P': {
+            bool ok;
+            options.concolicTreeReplayIteration = QString(optarg).toInt(&ok);
+
+            if (!ok || options.concolicTreeReplayIteration < 0) {
+                cerr << "ERROR: Invalid concolic tree replay iteration " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
         case '?': {
             // getopt has already printed an error
             exit(1);
@@ -790,12 +1101,54 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
         options.iterationLimit = 2; // anything else does not make sense
     }
 
+    if (options.workers > 1) {
+        if (options.majorMode != artemis::AUTOMATED || options.eventGenerationStrategy == artemis::EVENT_FASTTRACK) {
+            cerr << "ERROR: --workers is only supported in major-mode artemis with the random-incremental event generation strategy" << endl;
+            exit(1);
+        }
+
+        if (options.workerShard >= 0) {
+            // Every worker executes the initial configuration before exploring its share of the rest
+            options.iterationLimit = 1 + (options.iterationLimit - 1 + options.workers - 1) / options.workers;
+        }
+    }
+
+    if (!options.networkCacheArchive.isEmpty()) {
+        if (options.networkCache == artemis::NETWORK_CACHE_OFF) {
+            options.networkCache = artemis::NETWORK_CACHE_REPLAY;
+        } else if (options.networkCache == artemis::NETWORK_CACHE_PAGE_LOAD) {
+            cerr << "ERROR: --network-cache-archive is not supported with the page-load network cache" << endl;
+            exit(1);
+        }
+
+        if (options.workers > 1) {
+            // The workers would append to the same archive concurrently
+            cerr << "ERROR: --network-cache-archive is not supported with --workers" << endl;
+            exit(1);
+        }
+    }
+
+    if (options.concolicSolverWorkers > 1 && options.solver != artemis::CVC4) {
+        cerr << "ERROR: --concolic-solver-workers is only supported with the cvc4 solver" << endl;
+        exit(1);
+    }
+
+    if ((!options.concolicCheckpointFile.isEmpty() || !options.concolicResumeFile.isEmpty()) &&
+            options.majorMode != artemis::CONCOLIC) {
+        cerr << "ERROR: --concolic-checkpoint and --concolic-resume are only supported in major-mode concolic" << endl;
+        exit(1);
+    }
+
     // url handling
 
     QUrl url;
 
     if (optind >= argc) {
-        // If we are in manual mode then the url is optional.
+        // If we are in manual mode or only replay a tree log then the url is optional.
+        if (!options.concolicTreeReplayFile.isEmpty()) {
+            return url;
+        }
+
         if(options.majorMode != artemis::MANUAL){
             cerr << "Error: You must specify a URL" << endl;
             exit(1);
@@ -897,6 +1250,34 @@ void artemisConsoleMessageHandler(QtMsgType type, const char* msg)
     }
 }
 
+/**
+ *  Writes the graphs of a tree rebuilt from an execution tree log (--concolic-tree-replay).
+ */
+int replayTreeLog(const artemis::Options& options)
+{
+    artemis::ExecutionTreeReplay replay(options.concolicTreeReplayFile);
+    artemis::TraceNodePtr tree = replay.replay(options.concolicTreeReplayIteration);
+
+    if (tree.isNull()) {
+        cerr << "ERROR: The execution tree log does not contain a tree at the given iteration" << endl;
+        return 1;
+    }
+
+    QString name = QString("tree-replay_%1.gv").arg(replay.getIteration());
+    artemis::TraceDisplay display(replay.isLinkedToCoverage());
+    display.writeGraphFile(tree, name, false);
+    artemis::Log::info(QString("Wrote the tree to %1").arg(name).toStdString());
+
+    if (options.concolicTreeOutputOverview) {
+        QString name_min = QString("tree-replay_min_%1.gv").arg(replay.getIteration());
+        artemis::TraceDisplayOverview overview(replay.isLinkedToCoverage());
+        overview.writeGraphFile(tree, name_min, false);
+        artemis::Log::info(QString("Wrote the overview tree to %1").arg(name_min).toStdString());
+    }
+
+    return 0;
+}
+
 int main(int argc, char* argv[])
 {
     qInstallMsgHandler(artemisConsoleMessageHandler);
@@ -906,6 +1287,10 @@ int main(int argc, char* argv[])
     artemis::Options options;
     QUrl url = parseCmd(argc, argv, options);
 
+    if (!options.concolicTreeReplayFile.isEmpty()) {
+        return replayTreeLog(options);
+    }
+
     artemis::ArtemisApplication artemisApp(0, &app, options, url);
     artemisApp.run(url);
 
@@ -36,10 +36,15 @@ ConcolicAnalysis::ConcolicAnalysis(Options options, OutputMode output)
     : mOptions(options)
     , mOutput(output)
     , mExecutionTree(TraceNodePtr())
+    , mTreeManager(TreeManagerPtr(new TreeManager()))
     , mSearchStrategy(TreeSearchPtr())
+    , mSolver(Solver::getSolver(options))
     , mExplorationIndex(1)
     , mPreviousConstraintID()
 {
+    if (options.concolicSolverWorkers > 1) {
+        mSolverPool = SolverPoolPtr(new SolverPool(options, options.concolicSolverWorkers));
+    }
 }
 
 // Add a new trace to the tree.
@@ -53,6 +58,9 @@ void ConcolicAnalysis::addTrace(TraceNodePtr trace, ExplorationHandle target)
     // pointer to the tree, which will be replaced in that case.
     if (mExecutionTree.isNull()) {
         mExecutionTree = trace;
+        if (!mTreeLog.isNull()) {
+            mTreeLog->logTree(mExecutionTree);
+        }
         initSearchProcedure();
     } else {
         mergeTraceIntoTree(trace, target);
@@ -61,6 +69,13 @@ void ConcolicAnalysis::addTrace(TraceNodePtr trace, ExplorationHandle target)
     emit sigExecutionTreeUpdated(mExecutionTree);
 }
 
+void ConcolicAnalysis::setTreeLog(ExecutionTreeLogPtr treeLog)
+{
+    mTreeLog = treeLog;
+    mTraceMerger.setTreeLog(treeLog);
+    mTreeManager->setTreeLog(treeLog);
+}
+
 // Initilises mSearchProcedure.
 void ConcolicAnalysis::initSearchProcedure()
 {
@@ -71,12 +86,14 @@ void ConcolicAnalysis::initSearchProcedure()
     switch(mOptions.concolicSearchProcedure) {
     case SEARCH_DFS:
         mSearchStrategy = TreeSearchPtr(new DepthFirstSearch(mExecutionTree,
+                                                             mTreeManager,
                                                              mOptions.concolicDfsDepthLimit,
                                                              mOptions.concolicDfsRestartLimit));
         break;
 
     case SEARCH_SELECTOR:
         mSearchStrategy = TreeSearchPtr(new RandomAccessSearch(mExecutionTree,
+                                                               mTreeManager,
                                                                buildSelector(mOptions.concolicSearchSelector),
                                                                mOptions.concolicSearchBudget));
         QObject::connect(&mTraceMerger, SIGNAL(sigTraceJoined(TraceNodePtr, int, TraceNodePtr, TraceNodePtr)),
@@ -97,7 +114,7 @@ void ConcolicAnalysis::mergeTraceIntoTree(TraceNodePtr trace, ExplorationHandle
 
     // Check if we actually explored the intended target.
     if (!target.noExplorationTarget && TreeManager::isQueuedOrNotAttempted(target.target)) {
-        TreeManager::markNodeMissed(target.target);
+        mTreeManager->markNodeMissed(target.target);
         concolicRuntimeInfo("  Recorded trace did not take the expected path.");
     }
 }
@@ -154,6 +171,10 @@ ConcolicAnalysis::ExplorationResult ConcolicAnalysis::nextExploration()
         return nothingToExplore();
     }
 
+    if (!mSolverPool.isNull()) {
+        return nextConcurrentExploration();
+    }
+
     // Search until we find a solution for new exploration
     foundResult = false;
     while (!foundResult) {
@@ -177,7 +198,7 @@ ConcolicAnalysis::ExplorationResult ConcolicAnalysis::nextExploration()
                 result.constraintID = mPreviousConstraintID;
 
                 foundResult = true;
-                TreeManager::markNodeQueued(handle.target);
+                mTreeManager->markNodeQueued(handle.target);
             }
 
         } else {
@@ -192,34 +213,109 @@ ConcolicAnalysis::ExplorationResult ConcolicAnalysis::nextExploration()
 }
 
 
+// Returns the next solved target with a pool of solvers.
+// The search is asked for targets until every solver is busy, and the first SAT result is returned while the rest are
+// still being solved. Targets are marked as queued when they are chosen, so the search moves on to a new target each
+// time.
+ConcolicAnalysis::ExplorationResult ConcolicAnalysis::nextConcurrentExploration()
+{
+    forever {
+        while (mSolverPool->pending() < mSolverPool->size() && mSearchStrategy->chooseNextTarget()) {
+            ExplorationHandle handle;
+            handle.noExplorationTarget = false;
+            handle.target = mSearchStrategy->getTargetDescriptor();
+            handle.explorationIndex = mExplorationIndex;
+
+            SolverPool::TaskPtr task = SolverPool::TaskPtr(new SolverPool::Task());
+            task->pc = mSearchStrategy->getTargetPC();
+
+            if (!prepareTargetPC(handle.target, task->pc, mSearchStrategy->getTargetDomConstraints(), &task->restrictions)) {
+                continue;
+            }
+
+            mTreeManager->markNodeQueued(handle.target);
+
+            mSolvingExplorations.insert(task.data(), handle);
+            mSolverPool->submit(task);
+        }
+
+        // Search procedure could not find anything new to search.
+        if (mSolverPool->pending() == 0) {
+            return nothingToExplore();
+        }
+
+        SolverPool::TaskPtr task = mSolverPool->takeSolved();
+        ExplorationHandle handle = mSolvingExplorations.take(task.data());
+
+        mPreviousConstraintID = task->constraintID;
+
+        SolutionPtr solution = retryTargetPC(handle.target, task->pc, task->restrictions, task->solution);
+
+        if (solution.isNull() || !solution->isSolved()) {
+            continue;
+        }
+
+        // A trace which was executed while this target was being solved may have explored it already.
+        if (!TreeManager::isQueuedOrNotAttempted(handle.target)) {
+            Statistics::statistics()->accumulate("Concolic::Solver::SolutionsNotNeeded", 1);
+            continue;
+        }
+
+        ExplorationResult result;
+        result.newExploration = true;
+        result.pc = task->pc;
+        result.solution = solution;
+        result.target = handle;
+        result.constraintID = mPreviousConstraintID;
+
+        return result;
+    }
+}
+
 // Runs the solver on the current search target and returns the solution.
 // Includes the optimisation to re-try unsolvable constraints with clauses dropped.
 SolutionPtr ConcolicAnalysis::solveTargetPC()
 {
     PathConditionPtr pc = mSearchStrategy->getTargetPC();
     ExplorationDescriptor target = mSearchStrategy->getTargetDescriptor();
-    QSet<SelectRestriction> dynamicSelectConstraints = mSearchStrategy->getTargetDomConstraints();
+    FormRestrictions dynamicRestrictions;
 
+    if (!prepareTargetPC(target, pc, mSearchStrategy->getTargetDomConstraints(), &dynamicRestrictions)) {
+        return SolutionPtr();
+    }
+
+    // Try to solve this PC to get some concrete input.
+    SolutionPtr solution = mSolver->solve(pc, dynamicRestrictions);
+    mPreviousConstraintID = mSolver->getLastConstraintID();
+
+    return retryTargetPC(target, pc, dynamicRestrictions, solution);
+}
+
+// Prepares the form restrictions for solving a target.
+// Returns false if the PC is empty, in which case the target is marked as unsolvable.
+bool ConcolicAnalysis::prepareTargetPC(ExplorationDescriptor target, PathConditionPtr pc, QSet<SelectRestriction> dynamicSelectConstraints, FormRestrictions* restrictions)
+{
     printPCInfo(pc);
 
     // If the returned PC is empty then there are no solvable copnstraints on the path.
     if (pc->size() < 1) {
         handleEmptyPC(target);
-        return SolutionPtr();
+        return false;
     }
 
     // Merge the dynamic DOM constraints (select only for now) with the static "defaults".
-    FormRestrictions dynamicRestrictions = mergeDynamicSelectRestrictions(mFormFieldInitialRestrictions, dynamicSelectConstraints);
-    dynamicRestrictions = updateFormRestrictionsForFeatureFlags(dynamicRestrictions);
+    *restrictions = mergeDynamicSelectRestrictions(mFormFieldInitialRestrictions, dynamicSelectConstraints);
+    *restrictions = updateFormRestrictionsForFeatureFlags(*restrictions);
 
     mExplorationIndex++;
-    TreeManager::markExplorationIndex(target, mExplorationIndex);
+    mTreeManager->markExplorationIndex(target, mExplorationIndex);
 
-    // Try to solve this PC to get some concrete input.
-    SolverPtr solver = Solver::getSolver(mOptions);
-    SolutionPtr solution = solver->solve(pc, dynamicRestrictions);
-    mPreviousConstraintID = solver->getLastConstraintID();
+    return true;
+}
 
+// Handles the first solution for a target, re-trying with difficult clauses dropped if it could not be solved.
+SolutionPtr ConcolicAnalysis::retryTargetPC(ExplorationDescriptor target, PathConditionPtr pc, FormRestrictions dynamicRestrictions, SolutionPtr solution)
+{
     // If the constraint could not be solved, then we have an oppourtunity to retry.
     bool canRetry = true;
     while (!solution->isSolved() && !solution->isUnsat() && canRetry) {
@@ -227,9 +323,18 @@ SolutionPtr ConcolicAnalysis::solveTargetPC()
         // Check if there was a specific clause which caused this PC to be unsolvable and mark it as difficult.
         if(solution->getUnsolvableClause() >= 0) {
             TraceSymbolicBranch* difficultBranch = pc->getBranch(solution->getUnsolvableClause());
-            assert(!difficultBranch->isDifficult()); // We should never have tried to solve a known difficult branch. Otherwise we may get stuck in a loop when we retry!
-            difficultBranch->markDifficult();
-            Statistics::statistics()->accumulate("Concolic::ExecutionTree::DifficultBranches", 1);
+
+            // We should never have tried to solve a known difficult branch. Otherwise we may get stuck in a loop when we retry!
+            // The exception is a batch of concurrently solved targets, which may share the branch found to be difficult.
+            assert(!difficultBranch->isDifficult() || !mSolverPool.isNull());
+
+            if (!difficultBranch->isDifficult()) {
+                difficultBranch->markDifficult();
+                if (!mTreeLog.isNull()) {
+                    mTreeLog->logDifficult(difficultBranch);
+                }
+                Statistics::statistics()->accumulate("Concolic::ExecutionTree::DifficultBranches", 1);
+            }
         }
 
         // There is nothing we can do in the following cases:
@@ -237,7 +342,7 @@ SolutionPtr ConcolicAnalysis::solveTargetPC()
         //    * The bad clause was from the node we were directly targeting
         // Otherwise we can re-try writing the PC without this difficult clause.
         if (solution->getUnsolvableClause() < 0 || (uint)solution->getUnsolvableClause() == pc->size()-1) {
-            TreeManager::markNodeUnsolvable(target);
+            mTreeManager->markNodeUnsolvable(target);
             concolicRuntimeInfo("  Could not solve constraint:");
             concolicRuntimeInfo(QString("    %1").arg(solution->getUnsolvableReason()));
             concolicRuntimeDebug("Skipping this target!");
@@ -249,8 +354,8 @@ SolutionPtr ConcolicAnalysis::solveTargetPC()
             concolicRuntimeInfo("  Could not solve this constraint. Re-trying after marking as difficult.");
             Statistics::statistics()->accumulate("Concolic::DifficultBranchRetries", 1);
 
-            // As we have marked the bad node as difficult already, Search::getTargetPC() will return an updated PC.
-            pc = mSearchStrategy->getTargetPC();
+            // As we have marked the bad node as difficult already, the updated PC will not include it.
+            pc = pc->withoutDifficultBranches();
 
             printPCInfo(pc);
 
@@ -261,8 +366,8 @@ SolutionPtr ConcolicAnalysis::solveTargetPC()
                 canRetry = false;
             } else {
 
-                solution = solver->solve(pc, dynamicRestrictions);
-                mPreviousConstraintID = solver->getLastConstraintID();
+                solution = mSolver->solve(pc, dynamicRestrictions);
+                mPreviousConstraintID = mSolver->getLastConstraintID();
 
             }
 
@@ -272,7 +377,7 @@ SolutionPtr ConcolicAnalysis::solveTargetPC()
     // Now we have made a "best-effort" to solve the PC, but it could still be either solved, unsat, or unsolvable.
 
     if (solution->isUnsat()) {
-        TreeManager::markNodeUnsat(target);
+        mTreeManager->markNodeUnsat(target);
         concolicRuntimeInfo("  Constraint is UNSAT.");
         concolicRuntimeDebug("Skipping this target!");
         emit sigExecutionTreeUpdated(mExecutionTree);
@@ -298,7 +403,7 @@ void ConcolicAnalysis::printPCInfo(PathConditionPtr pc)
 
 void ConcolicAnalysis::handleEmptyPC(ExplorationDescriptor target)
 {
-    TreeManager::markNodeUnsolvable(target);
+    mTreeManager->markNodeUnsolvable(target);
 
     concolicRuntimeInfo("  Could not solve constraint:");
     concolicRuntimeInfo("    All branches on path were known to be difficult.");
@@ -328,6 +433,45 @@ uint ConcolicAnalysis::getExplorationIndex()
     return mExplorationIndex;
 }
 
+void ConcolicAnalysis::restoreSession(const ConcolicSessionState& state)
+{
+    assert(mExecutionTree.isNull());
+    assert(!state.tree.isNull());
+
+    mExecutionTree = state.tree;
+    mExplorationIndex = state.explorationIndex;
+
+    if (!mTreeLog.isNull()) {
+        mTreeLog->logTree(mExecutionTree);
+    }
+
+    initSearchProcedure();
+
+    QSharedPointer<RandomAccessSearch> randomAccessSearch = mSearchStrategy.dynamicCast<RandomAccessSearch>();
+    if (!randomAccessSearch.isNull()) {
+        randomAccessSearch->setBudgetUsed(state.searchBudgetUsed);
+    }
+
+    QSharedPointer<DepthFirstSearch> depthFirstSearch = mSearchStrategy.dynamicCast<DepthFirstSearch>();
+    if (!depthFirstSearch.isNull() && state.dfsDepthLimit > 0) {
+        depthFirstSearch->resumeAtDepthLimit(state.dfsDepthLimit);
+    }
+
+    emit sigExecutionTreeUpdated(mExecutionTree);
+}
+
+void ConcolicAnalysis::saveSession(ConcolicSessionState* state)
+{
+    state->tree = mExecutionTree;
+    state->explorationIndex = mExplorationIndex;
+
+    QSharedPointer<RandomAccessSearch> randomAccessSearch = mSearchStrategy.dynamicCast<RandomAccessSearch>();
+    state->searchBudgetUsed = randomAccessSearch.isNull() ? 0 : randomAccessSearch->getBudgetUsed();
+
+    QSharedPointer<DepthFirstSearch> depthFirstSearch = mSearchStrategy.dynamicCast<DepthFirstSearch>();
+    state->dfsDepthLimit = depthFirstSearch.isNull() ? 0 : depthFirstSearch->getDepthLimit();
+}
+
 FormRestrictions ConcolicAnalysis::mergeDynamicSelectRestrictions(FormRestrictions base, QSet<SelectRestriction> replacements)
 {
     // Copy the radio constraints across as-is, they are not handled dynamically yet.
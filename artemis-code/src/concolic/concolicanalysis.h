@@ -15,15 +15,19 @@
  */
 
 #include <QSharedPointer>
+#include <QMap>
 
 #include "runtime/options.h"
 
 #include "concolic/executiontree/tracenodes.h"
 #include "concolic/executiontree/tracemerger.h"
+#include "concolic/executiontree/treemanager.h"
+#include "concolic/executiontree/executiontreecheckpoint.h"
 #include "concolic/search/explorationdescriptor.h"
 #include "concolic/search/search.h"
 #include "concolic/search/abstractselector.h"
 #include "concolic/solver/solver.h"
+#include "concolic/solver/solverpool.h"
 
 #ifndef CONCOLICANALYSIS_H
 #define CONCOLICANALYSIS_H
@@ -122,10 +126,18 @@ public:
     // Updating this once the analysis has started will lead to inconsistent results between different traces.
     void setFormRestrictions(FormRestrictions restrictions);
 
+    // Records every change to the execution tree in the given log.
+    void setTreeLog(ExecutionTreeLogPtr treeLog);
+
     // Accessor for the search tree, which should not be externally modified!
     TraceNodePtr getExecutionTree();
     uint getExplorationIndex();
 
+    // Continues a session saved with saveSession(), used in place of adding the first trace.
+    void restoreSession(const ConcolicSessionState& state);
+    // Fills in the tree, exploration index and search progress of the session.
+    void saveSession(ConcolicSessionState* state);
+
 
 signals:
     void sigExecutionTreeUpdated(TraceNodePtr tree);
@@ -138,8 +150,18 @@ protected:
     TraceNodePtr mExecutionTree;
 
     TraceMerger mTraceMerger;
+    ExecutionTreeLogPtr mTreeLog;
+    TreeManagerPtr mTreeManager;
     TreeSearchPtr mSearchStrategy;
 
+    // Kept for the lifetime of the analysis so solver sessions can be reused between explorations.
+    SolverPtr mSolver;
+
+    // With --concolic-solver-workers the search hands out one target per worker and they are solved concurrently.
+    // Targets which were submitted to the pool and not taken back yet are kept in mSolvingExplorations.
+    SolverPoolPtr mSolverPool;
+    QMap<SolverPool::Task*, ExplorationHandle> mSolvingExplorations;
+
     FormRestrictions mFormFieldInitialRestrictions;
     FormRestrictions mergeDynamicSelectRestrictions(FormRestrictions base, QSet<SelectRestriction> replacements);
     FormRestrictions updateFormRestrictionsForFeatureFlags(FormRestrictions restrictions);
@@ -154,7 +176,10 @@ protected:
     AbstractSelectorPtr buildSelector(ConcolicSearchSelector description);
 
     // Helpers for nextExploration
+    ExplorationResult nextConcurrentExploration();
     SolutionPtr solveTargetPC();
+    bool prepareTargetPC(ExplorationDescriptor target, PathConditionPtr pc, QSet<SelectRestriction> dynamicSelectConstraints, FormRestrictions* restrictions);
+    SolutionPtr retryTargetPC(ExplorationDescriptor target, PathConditionPtr pc, FormRestrictions restrictions, SolutionPtr solution);
     void printPCInfo(PathConditionPtr pc);
     void handleEmptyPC(ExplorationDescriptor target);
 
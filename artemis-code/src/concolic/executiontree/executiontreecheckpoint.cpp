@@ -0,0 +1,484 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+#include <cstdio>
+
+#include <QFile>
+#include <QtWebKit/qwebexecutionlistener.h>
+
+#include "util/loggingutil.h"
+
+#include "executiontreecheckpoint.h"
+
+namespace artemis
+{
+
+bool ExecutionTreeCheckpoint::save(const QString& pathToFile, const ConcolicSessionState& state)
+{
+    assert(!state.tree.isNull());
+
+    // The tree is written first, as the source and expression tables are filled in while writing it.
+    QByteArray tree;
+    QByteArray sources;
+    QByteArray expressions;
+
+    QDataStream treeStream(&tree, QIODevice::WriteOnly);
+    QDataStream sourceStream(&sources, QIODevice::WriteOnly);
+    QDataStream expressionStream(&expressions, QIODevice::WriteOnly);
+    treeStream.setVersion(QDataStream::Qt_4_8);
+    sourceStream.setVersion(QDataStream::Qt_4_8);
+    expressionStream.setVersion(QDataStream::Qt_4_8);
+
+    ExecutionTreeCheckpointWriter writer(&treeStream, &sourceStream, &expressionStream);
+    writer.write(state.tree);
+
+    QString temporaryPath = pathToFile + ".tmp";
+    QFile file(temporaryPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    stream << MAGIC << VERSION;
+    stream << state.url.toUtf8() << (quint32)state.iterations << (quint32)state.explorationIndex
+           << (quint32)state.searchBudgetUsed << (quint32)state.dfsDepthLimit;
+
+    stream << writer.getNumSources();
+    stream.writeRawData(sources.constData(), sources.size());
+    stream.writeRawData(expressions.constData(), expressions.size());
+    stream.writeRawData(tree.constData(), tree.size());
+
+    file.close();
+    if (stream.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+        QFile::remove(temporaryPath);
+        return false;
+    }
+
+    // QFile::rename does not replace an existing file, rename(2) does so atomically.
+    return std::rename(QFile::encodeName(temporaryPath).constData(), QFile::encodeName(pathToFile).constData()) == 0;
+}
+
+bool ExecutionTreeCheckpoint::load(const QString& pathToFile, ConcolicSessionState* state)
+{
+    QFile file(pathToFile);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    // The checkpoint is read straight from the mapped file instead of being copied into memory first.
+    uchar* data = file.map(0, file.size());
+    if (data == NULL) {
+        return false;
+    }
+
+    QByteArray contents = QByteArray::fromRawData((const char*)data, file.size());
+    QDataStream stream(contents);
+    stream.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic;
+    quint32 version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+        return false;
+    }
+
+    QByteArray url;
+    quint32 iterations;
+    quint32 explorationIndex;
+    quint32 searchBudgetUsed;
+    quint32 dfsDepthLimit;
+    stream >> url >> iterations >> explorationIndex >> searchBudgetUsed >> dfsDepthLimit;
+
+    // Sources are looked up in the registry, so branches in new traces share the restored source pointers.
+    QList<QSource*> sources;
+    quint32 numSources;
+    stream >> numSources;
+    for (quint32 i = 0; i < numSources && stream.status() == QDataStream::Ok; i++) {
+        QByteArray sourceUrl;
+        quint32 startLine;
+        stream >> sourceUrl >> startLine;
+        sources.append(QWebExecutionListener::getListener()->getSource(QString::fromUtf8(sourceUrl), startLine));
+    }
+
+    ExpressionDeserialiser expressions(&stream);
+    if (stream.status() != QDataStream::Ok || !expressions.read()) {
+        return false;
+    }
+
+    TraceNodePtr tree = readNode(&stream, sources, expressions);
+    if (tree.isNull() || stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    state->url = QString::fromUtf8(url);
+    state->iterations = iterations;
+    state->explorationIndex = explorationIndex;
+    state->searchBudgetUsed = searchBudgetUsed;
+    state->dfsDepthLimit = dfsDepthLimit;
+    state->tree = tree;
+
+    return true;
+}
+
+// Reads a node and its children, returns a null pointer if the checkpoint is corrupt.
+TraceNodePtr ExecutionTreeCheckpoint::readNode(QDataStream* stream, const QList<QSource*>& sources,
+                                               const ExpressionDeserialiser& expressions)
+{
+    quint8 kind;
+    *stream >> kind;
+
+    if (stream->status() != QDataStream::Ok) {
+        return TraceNodePtr();
+    }
+
+    switch (kind) {
+    case NODE_UNEXPLORED:
+        return TraceUnexplored::getInstance();
+
+    case NODE_UNSAT:
+        return TraceUnexploredUnsat::getInstance();
+
+    case NODE_UNSOLVABLE:
+        return TraceUnexploredUnsolvable::getInstance();
+
+    case NODE_MISSED:
+        return TraceUnexploredMissed::getInstance();
+
+    case NODE_CONCRETE_BRANCH:
+    case NODE_SYMBOLIC_BRANCH: {
+        quint32 sourceOffset;
+        quint32 sourceIndex;
+        quint32 linenumber;
+        *stream >> sourceOffset >> sourceIndex >> linenumber;
+
+        if (sourceIndex != NO_SOURCE && sourceIndex >= (quint32)sources.size()) {
+            return TraceNodePtr();
+        }
+        QSource* source = sourceIndex == NO_SOURCE ? NULL : sources.at(sourceIndex);
+
+        TraceBranchPtr branch;
+
+        if (kind == NODE_CONCRETE_BRANCH) {
+            branch = TraceBranchPtr(new TraceConcreteBranch(sourceOffset, source, linenumber));
+
+        } else {
+            quint32 conditionIndex;
+            quint8 difficult;
+            quint32 explorationIndex;
+            quint8 explorationDirection;
+            *stream >> conditionIndex >> difficult >> explorationIndex >> explorationDirection;
+
+            Symbolic::Expression* condition = expressions.get(conditionIndex);
+            if (condition == NULL) {
+                return TraceNodePtr();
+            }
+
+            TraceSymbolicBranchPtr symbolicBranch = TraceSymbolicBranchPtr(
+                        new TraceSymbolicBranch(condition, sourceOffset, source, linenumber));
+            if (difficult) {
+                symbolicBranch->markDifficult();
+            }
+            if (explorationIndex != 0) {
+                symbolicBranch->markExploration(explorationIndex, explorationDirection);
+            }
+            branch = symbolicBranch;
+        }
+
+        TraceNodePtr falseBranch = readNode(stream, sources, expressions);
+        if (falseBranch.isNull()) {
+            return TraceNodePtr();
+        }
+        TraceNodePtr trueBranch = readNode(stream, sources, expressions);
+        if (trueBranch.isNull()) {
+            return TraceNodePtr();
+        }
+
+        branch->setFalseBranch(falseBranch);
+        branch->setTrueBranch(trueBranch);
+        return branch;
+    }
+
+    case NODE_ALERT:
+    case NODE_DOM_MODIFICATION:
+    case NODE_PAGE_LOAD:
+    case NODE_MARKER:
+    case NODE_FUNCTION_CALL: {
+        TraceAnnotationPtr annotation;
+
+        if (kind == NODE_ALERT) {
+            QSharedPointer<TraceAlert> alert = QSharedPointer<TraceAlert>(new TraceAlert());
+            *stream >> alert->message;
+            annotation = alert;
+
+        } else if (kind == NODE_DOM_MODIFICATION) {
+            QSharedPointer<TraceDomModification> modification = QSharedPointer<TraceDomModification>(new TraceDomModification());
+            *stream >> modification->amountModified >> modification->words;
+            annotation = modification;
+
+        } else if (kind == NODE_PAGE_LOAD) {
+            QSharedPointer<TracePageLoad> pageLoad = QSharedPointer<TracePageLoad>(new TracePageLoad());
+            *stream >> pageLoad->url;
+            annotation = pageLoad;
+
+        } else if (kind == NODE_MARKER) {
+            TraceMarkerPtr marker = TraceMarkerPtr(new TraceMarker());
+            quint8 isSelectRestriction;
+            *stream >> marker->label >> marker->index >> isSelectRestriction;
+            marker->isSelectRestriction = isSelectRestriction;
+            *stream >> marker->selectRestriction.variable >> marker->selectRestriction.values;
+            annotation = marker;
+
+        } else {
+            QSharedPointer<TraceFunctionCall> call = QSharedPointer<TraceFunctionCall>(new TraceFunctionCall());
+            *stream >> call->name;
+            annotation = call;
+        }
+
+        annotation->next = readNode(stream, sources, expressions);
+        if (annotation->next.isNull()) {
+            return TraceNodePtr();
+        }
+        return annotation;
+    }
+
+    case NODE_SUMMARY: {
+        TraceConcreteSummarisationPtr summary = TraceConcreteSummarisationPtr(new TraceConcreteSummarisation());
+
+        quint32 numExecutions;
+        *stream >> numExecutions;
+        if (numExecutions == 0) {
+            return TraceNodePtr(); // There is always at least one execution.
+        }
+
+        for (quint32 i = 0; i < numExecutions; i++) {
+            TraceConcreteSummarisation::SingleExecution execution;
+
+            quint32 numEvents;
+            *stream >> numEvents;
+            for (quint32 j = 0; j < numEvents && stream->status() == QDataStream::Ok; j++) {
+                quint8 event;
+                *stream >> event;
+                if (event > TraceConcreteSummarisation::FUNCTION_CALL) {
+                    return TraceNodePtr();
+                }
+                execution.first.append((TraceConcreteSummarisation::EventType)event);
+            }
+
+            execution.second = readNode(stream, sources, expressions);
+            if (execution.second.isNull()) {
+                return TraceNodePtr();
+            }
+            summary->executions.append(execution);
+        }
+
+        return summary;
+    }
+
+    case NODE_END_SUCCESS:
+    case NODE_END_FAILURE:
+    case NODE_END_UNKNOWN: {
+        TraceEndPtr end;
+
+        // The rest of the trace after an end marker is not part of the tree, so it is not saved either.
+        if (kind == NODE_END_SUCCESS) {
+            QSharedPointer<TraceEndSuccess> success = QSharedPointer<TraceEndSuccess>(new TraceEndSuccess());
+            success->next = TraceNodePtr(new TraceEndUnknown());
+            end = success;
+        } else if (kind == NODE_END_FAILURE) {
+            QSharedPointer<TraceEndFailure> failure = QSharedPointer<TraceEndFailure>(new TraceEndFailure());
+            failure->next = TraceNodePtr(new TraceEndUnknown());
+            end = failure;
+        } else {
+            end = TraceEndPtr(new TraceEndUnknown());
+        }
+
+        *stream >> end->traceIndices;
+        return end;
+    }
+
+    default:
+        return TraceNodePtr();
+    }
+}
+
+
+ExecutionTreeCheckpointWriter::ExecutionTreeCheckpointWriter(QDataStream* treeStream, QDataStream* sourceStream,
+                                                             QDataStream* expressionStream)
+    : mTreeStream(treeStream)
+    , mSourceStream(sourceStream)
+    , mExpressions(expressionStream)
+{
+}
+
+void ExecutionTreeCheckpointWriter::write(TraceNodePtr tree)
+{
+    tree->accept(this);
+    mExpressions.finish();
+}
+
+/*
+ *  The node visitor methods.
+ *
+ *  Each node is written as its kind, then its own data, then its children in order (false before true).
+ */
+
+void ExecutionTreeCheckpointWriter::visit(TraceNode* node)
+{
+    // Should never be reached.
+    Log::fatal("Execution tree checkpoint visited a node of unknown type.");
+    exit(1);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceConcreteBranch* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_CONCRETE_BRANCH;
+    writeBranch(node);
+
+    node->getFalseBranch()->accept(this);
+    node->getTrueBranch()->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceSymbolicBranch* node)
+{
+    quint32 condition = mExpressions.write(node->getSymbolicCondition());
+
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_SYMBOLIC_BRANCH;
+    writeBranch(node);
+    *mTreeStream << condition << (quint8)node->isDifficult() << (quint32)node->getExplorationIndex()
+                 << (quint8)node->getExplorationDirection();
+
+    node->getFalseBranch()->accept(this);
+    node->getTrueBranch()->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceUnexplored* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_UNEXPLORED;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceUnexploredUnsat* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_UNSAT;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceUnexploredUnsolvable* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_UNSOLVABLE;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceUnexploredMissed* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_MISSED;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceUnexploredQueued* node)
+{
+    // The queued solution is lost with the session, so the node becomes a target again.
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_UNEXPLORED;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceAlert* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_ALERT << node->message;
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceDomModification* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_DOM_MODIFICATION << node->amountModified << node->words;
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TracePageLoad* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_PAGE_LOAD << node->url;
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceMarker* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_MARKER << node->label << node->index
+                 << (quint8)node->isSelectRestriction
+                 << node->selectRestriction.variable << node->selectRestriction.values;
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceFunctionCall* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_FUNCTION_CALL << node->name;
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceConcreteSummarisation* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_SUMMARY << (quint32)node->executions.length();
+
+    foreach(TraceConcreteSummarisation::SingleExecution execution, node->executions) {
+        *mTreeStream << (quint32)execution.first.length();
+        foreach(TraceConcreteSummarisation::EventType event, execution.first) {
+            *mTreeStream << (quint8)event;
+        }
+
+        execution.second->accept(this);
+    }
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceEndSuccess* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_END_SUCCESS << node->traceIndices;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceEndFailure* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_END_FAILURE << node->traceIndices;
+}
+
+void ExecutionTreeCheckpointWriter::visit(TraceEndUnknown* node)
+{
+    *mTreeStream << (quint8)ExecutionTreeCheckpoint::NODE_END_UNKNOWN << node->traceIndices;
+}
+
+
+void ExecutionTreeCheckpointWriter::writeBranch(TraceBranch* node)
+{
+    *mTreeStream << (quint32)node->getSourceOffset() << writeSource(node->getSource())
+                 << (quint32)node->getLinenumber();
+}
+
+quint32 ExecutionTreeCheckpointWriter::writeSource(QSource* source)
+{
+    if (source == NULL) {
+        return ExecutionTreeCheckpoint::NO_SOURCE;
+    }
+
+    if (!mSourceIndices.contains(source)) {
+        mSourceIndices.insert(source, mSourceIndices.size());
+        *mSourceStream << source->getUrl().toUtf8() << (quint32)source->getStartLine();
+    }
+
+    return mSourceIndices.value(source);
+}
+
+} // namespace artemis
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QHash>
+#include <QString>
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/tracevisitor.h"
+#include "concolic/solver/expressionserialiser.h"
+
+#ifndef EXECUTIONTREECHECKPOINT_H
+#define EXECUTIONTREECHECKPOINT_H
+
+namespace artemis
+{
+
+/**
+ * The state of a concolic session which is needed to continue it in a later run of artemis.
+ */
+struct ConcolicSessionState
+{
+    QString url;
+    uint iterations;
+    uint explorationIndex;
+
+    // Progress of the search procedure, only the one which is used is meaningful.
+    uint searchBudgetUsed;
+    uint dfsDepthLimit;
+
+    TraceNodePtr tree;
+
+    ConcolicSessionState()
+        : iterations(0)
+        , explorationIndex(1)
+        , searchBudgetUsed(0)
+        , dfsDepthLimit(0)
+    {}
+};
+
+/**
+ * Saves the execution tree and session state to a checkpoint file and restores them from it.
+ *
+ * Unlike ExecutionTreeLog, which only keeps what the graph output needs, a checkpoint holds the complete tree
+ * including the symbolic branch conditions, so the search can continue from it.
+ *
+ * The file has four sections: the session state, a table of the script sources, a table of the symbolic
+ * expressions (see ExpressionSerialiser) and finally the tree in pre-order, where the nodes refer to the sources
+ * and conditions by their index in the tables. Shared sub-expressions are written once, and everything is read
+ * back in a single pass from the mapped file.
+ *
+ * Queued nodes are saved as unexplored. Their solutions were never run, so they are explored again on resume.
+ */
+class ExecutionTreeCheckpoint
+{
+public:
+    // The checkpoint is written to a temporary file first and then moved over pathToFile, so a crash while
+    // writing it never leaves a truncated checkpoint behind.
+    static bool save(const QString& pathToFile, const ConcolicSessionState& state);
+
+    // Returns false if the file could not be read or is not a valid checkpoint.
+    static bool load(const QString& pathToFile, ConcolicSessionState* state);
+
+    enum NodeKind {
+        NODE_UNEXPLORED, NODE_UNSAT, NODE_UNSOLVABLE, NODE_MISSED,
+        NODE_CONCRETE_BRANCH, NODE_SYMBOLIC_BRANCH, NODE_ALERT, NODE_DOM_MODIFICATION, NODE_PAGE_LOAD, NODE_MARKER,
+        NODE_FUNCTION_CALL, NODE_SUMMARY, NODE_END_SUCCESS, NODE_END_FAILURE, NODE_END_UNKNOWN
+    };
+
+    static const quint32 MAGIC = 0x4143484b; // "ACHK"
+    static const quint32 VERSION = 1;
+    static const quint32 NO_SOURCE = 0xffffffff;
+
+private:
+    static TraceNodePtr readNode(QDataStream* stream, const QList<QSource*>& sources,
+                                 const ExpressionDeserialiser& expressions);
+};
+
+/**
+ * Writes the tree section of a checkpoint, collecting the sources and expressions it refers to on the way.
+ */
+class ExecutionTreeCheckpointWriter : public TraceVisitor
+{
+public:
+    ExecutionTreeCheckpointWriter(QDataStream* treeStream, QDataStream* sourceStream,
+                                  QDataStream* expressionStream);
+
+    void write(TraceNodePtr tree);
+
+    inline quint32 getNumSources()
+    {
+        return mSourceIndices.size();
+    }
+
+    void visit(TraceNode* node);
+    void visit(TraceConcreteBranch* node);
+    void visit(TraceSymbolicBranch* node);
+    void visit(TraceUnexplored* node);
+    void visit(TraceUnexploredUnsat* node);
+    void visit(TraceUnexploredUnsolvable* node);
+    void visit(TraceUnexploredMissed* node);
+    void visit(TraceUnexploredQueued* node);
+    void visit(TraceAlert* node);
+    void visit(TraceDomModification* node);
+    void visit(TracePageLoad* node);
+    void visit(TraceMarker* node);
+    void visit(TraceFunctionCall* node);
+    void visit(TraceConcreteSummarisation* node);
+    void visit(TraceEndSuccess* node);
+    void visit(TraceEndFailure* node);
+    void visit(TraceEndUnknown* node);
+
+private:
+    void writeBranch(TraceBranch* node);
+    quint32 writeSource(QSource* source);
+
+    QDataStream* mTreeStream;
+    QDataStream* mSourceStream;
+
+    QHash<QSource*, quint32> mSourceIndices;
+    ExpressionSerialiser mExpressions;
+};
+
+} // namespace artemis
+
+#endif // EXECUTIONTREECHECKPOINT_H
@@ -0,0 +1,310 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+
+#include "util/loggingutil.h"
+#include "concolic/traceeventdetectors.h"
+
+#include "executiontreelog.h"
+
+namespace artemis
+{
+
+ExecutionTreeLog::ExecutionTreeLog(const QString& pathToFile, bool linkToCoverage)
+    : mFile(pathToFile)
+    , mNextNodeId(0)
+{
+    if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        Log::fatal(QString("Could not open the execution tree log %1").arg(pathToFile).toStdString());
+        exit(1);
+    }
+
+    mStream.setDevice(&mFile);
+    mStream.setVersion(QDataStream::Qt_4_8);
+
+    mStream << MAGIC << VERSION << (quint8)linkToCoverage;
+    mFile.flush();
+}
+
+ExecutionTreeLog::~ExecutionTreeLog()
+{
+    mFile.close();
+}
+
+void ExecutionTreeLog::logTree(TraceNodePtr tree)
+{
+    assert(!tree.isNull());
+
+    mStream << (quint8)RECORD_TREE;
+    tree->accept(this);
+}
+
+void ExecutionTreeLog::logJoin(TraceNodePtr parent, int slot, TraceNodePtr suffix)
+{
+    assert(!suffix.isNull());
+
+    if (parent.isNull()) {
+        logTree(suffix);
+        return;
+    }
+
+    quint32 parentId = mNodeIds.value(parent.data(), UNKNOWN_NODE);
+    if (parentId == UNKNOWN_NODE) {
+        return; // The parent was never logged, so the reader could not place this either.
+    }
+
+    mStream << (quint8)RECORD_JOIN << parentId << (quint32)slot;
+
+    // A new execution of a summary needs its counts as well as the subtree, so these are always included.
+    TraceConcreteSummarisationPtr summary = parent.dynamicCast<TraceConcreteSummarisation>();
+    if (!summary.isNull()) {
+        assert(slot >= 0 && slot < summary->executions.length());
+        mStream << (quint32)summary->numBranches().at(slot) << (quint32)summary->numFunctions().at(slot);
+    }
+
+    suffix->accept(this);
+}
+
+void ExecutionTreeLog::logExplorationIndex(const ExplorationDescriptor& target, uint index)
+{
+    quint32 branchId = mNodeIds.value(target.branch.data(), UNKNOWN_NODE);
+    if (branchId != UNKNOWN_NODE) {
+        mStream << (quint8)RECORD_EXPLORATION << branchId << (quint32)index << (quint8)target.branchDirection;
+    }
+}
+
+void ExecutionTreeLog::logDifficult(TraceSymbolicBranch* branch)
+{
+    quint32 branchId = mNodeIds.value(branch, UNKNOWN_NODE);
+    if (branchId != UNKNOWN_NODE) {
+        mStream << (quint8)RECORD_DIFFICULT << branchId;
+    }
+}
+
+void ExecutionTreeLog::logTraceIndices(TraceNodePtr end, const QSet<uint>& indices)
+{
+    quint32 endId = mNodeIds.value(end.data(), UNKNOWN_NODE);
+    if (endId != UNKNOWN_NODE) {
+        mStream << (quint8)RECORD_INDICES << endId;
+        writeIndices(indices);
+    }
+}
+
+void ExecutionTreeLog::logUpdate(int iteration)
+{
+    mStream << (quint8)RECORD_UPDATE << (quint32)iteration;
+    mFile.flush();
+}
+
+
+/*
+ *  The node visitor methods.
+ *
+ *  Each node is written as its kind, then its own data, then its children in order (false before true).
+ */
+
+void ExecutionTreeLog::visit(TraceNode* node)
+{
+    // Should never be reached.
+    Log::fatal("Execution tree log visited a node of unknown type.");
+    exit(1);
+}
+
+void ExecutionTreeLog::visit(TraceConcreteBranch* node)
+{
+    beginNode(node, NODE_CONCRETE_BRANCH);
+    writeSource(node->getSource());
+    mStream << (quint32)node->getLinenumber();
+
+    node->getFalseBranch()->accept(this);
+    node->getTrueBranch()->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceSymbolicBranch* node)
+{
+    beginNode(node, NODE_SYMBOLIC_BRANCH);
+    writeSource(node->getSource());
+    mStream << (quint32)node->getLinenumber();
+
+    node->getSymbolicCondition()->accept(&mExpressionPrinter);
+    writeString(QString::fromStdString(mExpressionPrinter.getResult()));
+    mExpressionPrinter.clear();
+
+    mStream << (quint8)node->isDifficult() << (quint32)node->getExplorationIndex()
+            << (quint8)node->getExplorationDirection();
+
+    node->getFalseBranch()->accept(this);
+    node->getTrueBranch()->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceUnexplored* node)
+{
+    beginNode(node, NODE_UNEXPLORED);
+}
+
+void ExecutionTreeLog::visit(TraceUnexploredUnsat* node)
+{
+    beginNode(node, NODE_UNSAT);
+}
+
+void ExecutionTreeLog::visit(TraceUnexploredUnsolvable* node)
+{
+    beginNode(node, NODE_UNSOLVABLE);
+}
+
+void ExecutionTreeLog::visit(TraceUnexploredMissed* node)
+{
+    beginNode(node, NODE_MISSED);
+}
+
+void ExecutionTreeLog::visit(TraceUnexploredQueued* node)
+{
+    beginNode(node, NODE_QUEUED);
+}
+
+void ExecutionTreeLog::visit(TraceAlert* node)
+{
+    beginNode(node, NODE_ALERT);
+    writeString(node->message);
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceDomModification* node)
+{
+    beginNode(node, NODE_DOM_MODIFICATION);
+    mStream << node->amountModified << (quint32)node->words.size();
+    foreach(int index, node->words.keys()) {
+        writeString(TraceDomModDetector::indicators.at(index));
+        mStream << (qint32)node->words.value(index);
+    }
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeLog::visit(TracePageLoad* node)
+{
+    beginNode(node, NODE_PAGE_LOAD);
+    writeString(node->url.toString());
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceMarker* node)
+{
+    beginNode(node, NODE_MARKER);
+    writeString(node->label);
+    writeString(node->index);
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceFunctionCall* node)
+{
+    beginNode(node, NODE_FUNCTION_CALL);
+    writeString(node->name);
+
+    node->next->accept(this);
+}
+
+void ExecutionTreeLog::visit(TraceConcreteSummarisation* node)
+{
+    beginNode(node, NODE_SUMMARY);
+
+    QList<int> branches = node->numBranches();
+    QList<int> functions = node->numFunctions();
+
+    mStream << (quint32)node->executions.length();
+    for (int i = 0; i < node->executions.length(); i++) {
+        mStream << (quint32)branches[i] << (quint32)functions[i];
+        node->executions[i].second->accept(this);
+    }
+}
+
+// The nodes following an end marker are not part of the tree (see TraceDisplay::mPassThroughEndMarkers).
+
+void ExecutionTreeLog::visit(TraceEndSuccess* node)
+{
+    beginNode(node, NODE_END_SUCCESS);
+    writeIndices(node->traceIndices);
+}
+
+void ExecutionTreeLog::visit(TraceEndFailure* node)
+{
+    beginNode(node, NODE_END_FAILURE);
+    writeIndices(node->traceIndices);
+}
+
+void ExecutionTreeLog::visit(TraceEndUnknown* node)
+{
+    beginNode(node, NODE_END_UNKNOWN);
+    writeIndices(node->traceIndices);
+}
+
+
+void ExecutionTreeLog::beginNode(TraceNode* node, NodeKind kind)
+{
+    // The unexplored nodes are shared instances, so they can not be referred to by later records.
+    if (kind > NODE_QUEUED) {
+        mNodeIds.insert(node, mNextNodeId);
+        mNextNodeId++;
+    }
+
+    mStream << (quint8)kind;
+}
+
+void ExecutionTreeLog::writeSource(QSource* source)
+{
+    if (source == NULL) {
+        mStream << NO_SOURCE;
+        return;
+    }
+
+    quint32 sourceId = mSourceIds.value(source, NO_SOURCE);
+    if (sourceId != NO_SOURCE) {
+        mStream << sourceId;
+        return;
+    }
+
+    sourceId = mSourceIds.size();
+    mSourceIds.insert(source, sourceId);
+
+    mStream << sourceId;
+    writeString(source->getUrl());
+    mStream << (quint32)source->getStartLine();
+}
+
+void ExecutionTreeLog::writeString(const QString& string)
+{
+    // Empty strings are written as an empty array rather than a null one, which QDataStream would mark as length -1.
+    QByteArray utf8 = string.toUtf8();
+    if (utf8.isNull()) {
+        utf8 = QByteArray("");
+    }
+    mStream << utf8;
+}
+
+void ExecutionTreeLog::writeIndices(const QSet<uint>& indices)
+{
+    mStream << (quint32)indices.size();
+    foreach(uint index, indices) {
+        mStream << (quint32)index;
+    }
+}
+
+} // namespace artemis
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QFile>
+#include <QDataStream>
+#include <QHash>
+#include <QSet>
+#include <QSharedPointer>
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/tracevisitor.h"
+#include "concolic/search/explorationdescriptor.h"
+#include "concolic/solver/expressionvalueprinter.h"
+
+#ifndef EXECUTIONTREELOG_H
+#define EXECUTIONTREELOG_H
+
+namespace artemis
+{
+
+/**
+ * Append-only binary log of the changes made to the execution tree.
+ *
+ * Instead of writing the whole tree every time it changes, only the new parts are written: the first trace, the
+ * suffix of every trace merged into the tree, and the annotations made by the search (UNSAT, queued, exploration
+ * indices, etc.). An update record marks each point where the tree was complete, the log is flushed at these.
+ *
+ * ExecutionTreeReplay rebuilds the tree from the log at any update, such that it can be written with TraceDisplay or
+ * TraceDisplayOverview. Nodes are not given explicit ids in the log, they are numbered in the order they are
+ * written, and later records refer to them by that number. Sources are numbered in the same way, and the url and
+ * start line follow the number of a source the first time it is written.
+ *
+ * The node payloads hold what the graph output needs, e.g. symbolic conditions are stored as printed by
+ * ExpressionValuePrinter, so a replayed tree can be displayed but not searched.
+ */
+class ExecutionTreeLog : public TraceVisitor
+{
+public:
+    ExecutionTreeLog(const QString& pathToFile, bool linkToCoverage);
+    ~ExecutionTreeLog();
+
+    void logTree(TraceNodePtr tree);
+
+    // A new subtree replacing an unexplored node under parent, either a merged trace suffix or one of the
+    // unexplored markers set by the search. The slot is the branch direction for branches (0 false, 1 true), the
+    // execution index for concrete summaries (which may be one past the end, for a new execution) and 0 for
+    // annotations. A null parent replaces the whole tree.
+    void logJoin(TraceNodePtr parent, int slot, TraceNodePtr suffix);
+
+    void logExplorationIndex(const ExplorationDescriptor& target, uint index);
+    void logDifficult(TraceSymbolicBranch* branch);
+    void logTraceIndices(TraceNodePtr end, const QSet<uint>& indices);
+
+    void logUpdate(int iteration);
+
+    // Serialisation of new nodes.
+    void visit(TraceNode* node);
+    void visit(TraceConcreteBranch* node);
+    void visit(TraceSymbolicBranch* node);
+    void visit(TraceUnexplored* node);
+    void visit(TraceUnexploredUnsat* node);
+    void visit(TraceUnexploredUnsolvable* node);
+    void visit(TraceUnexploredMissed* node);
+    void visit(TraceUnexploredQueued* node);
+    void visit(TraceAlert* node);
+    void visit(TraceDomModification* node);
+    void visit(TracePageLoad* node);
+    void visit(TraceMarker* node);
+    void visit(TraceFunctionCall* node);
+    void visit(TraceConcreteSummarisation* node);
+    void visit(TraceEndSuccess* node);
+    void visit(TraceEndFailure* node);
+    void visit(TraceEndUnknown* node);
+
+    enum RecordType {
+        RECORD_TREE = 'T', RECORD_JOIN = 'J', RECORD_EXPLORATION = 'X', RECORD_DIFFICULT = 'D', RECORD_INDICES = 'I',
+        RECORD_UPDATE = 'U'
+    };
+
+    // Unexplored kinds come first, these are shared placeholders which are not numbered.
+    enum NodeKind {
+        NODE_UNEXPLORED, NODE_UNSAT, NODE_UNSOLVABLE, NODE_MISSED, NODE_QUEUED,
+        NODE_CONCRETE_BRANCH, NODE_SYMBOLIC_BRANCH, NODE_ALERT, NODE_DOM_MODIFICATION, NODE_PAGE_LOAD, NODE_MARKER,
+        NODE_FUNCTION_CALL, NODE_SUMMARY, NODE_END_SUCCESS, NODE_END_FAILURE, NODE_END_UNKNOWN
+    };
+
+    static const quint32 MAGIC = 0x4154524c; // "ATRL"
+    static const quint32 VERSION = 2;
+    static const quint32 UNKNOWN_NODE = 0xffffffff;
+    static const quint32 NO_SOURCE = 0xffffffff;
+
+private:
+    void beginNode(TraceNode* node, NodeKind kind);
+    void writeSource(QSource* source);
+    void writeString(const QString& string);
+    void writeIndices(const QSet<uint>& indices);
+
+    QFile mFile;
+    QDataStream mStream;
+
+    // Nodes which have been written to the log. Unlike most visitors we keep node pointers, this is safe as long as
+    // only nodes in the tree are logged, as nothing is ever removed from the tree.
+    QHash<TraceNode*, quint32> mNodeIds;
+    quint32 mNextNodeId;
+
+    QHash<QSource*, quint32> mSourceIds;
+
+    ExpressionValuePrinter mExpressionPrinter;
+};
+
+typedef QSharedPointer<ExecutionTreeLog> ExecutionTreeLogPtr;
+
+} // namespace artemis
+
+#endif // EXECUTIONTREELOG_H
@@ -0,0 +1,496 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QtWebKit/qwebexecutionlistener.h>
+
+#include "util/loggingutil.h"
+#include "concolic/traceeventdetectors.h"
+
+#include "executiontreereplay.h"
+
+namespace artemis
+{
+
+ExecutionTreeReplay::ExecutionTreeReplay(const QString& pathToFile)
+    : mFile(pathToFile)
+    , mLinkToCoverage(false)
+    , mIteration(-1)
+{
+    if (!mFile.open(QIODevice::ReadOnly)) {
+        Log::fatal(QString("Could not open the execution tree log %1").arg(pathToFile).toStdString());
+        exit(1);
+    }
+
+    mStream.setDevice(&mFile);
+    mStream.setVersion(QDataStream::Qt_4_8);
+
+    quint32 magic;
+    quint32 version;
+    quint8 linkToCoverage;
+    mStream >> magic >> version >> linkToCoverage;
+
+    if (mStream.status() != QDataStream::Ok || magic != ExecutionTreeLog::MAGIC) {
+        Log::fatal(QString("%1 is not an execution tree log").arg(pathToFile).toStdString());
+        exit(1);
+    }
+
+    if (version != ExecutionTreeLog::VERSION) {
+        Log::fatal(QString("Unsupported execution tree log version %1").arg(version).toStdString());
+        exit(1);
+    }
+
+    mLinkToCoverage = linkToCoverage;
+}
+
+TraceNodePtr ExecutionTreeReplay::replay(int iteration)
+{
+    // Records are held back until the next update, so a tree is only returned at a point where it was complete.
+    QList<Record> pending;
+
+    while (!mStream.atEnd()) {
+        Record record;
+        if (!readRecord(&record)) {
+            break;
+        }
+
+        if (record.type != ExecutionTreeLog::RECORD_UPDATE) {
+            pending.append(record);
+            continue;
+        }
+
+        if (iteration >= 0 && record.value > (quint32)iteration) {
+            return mTree;
+        }
+
+        foreach (const Record& pendingRecord, pending) {
+            apply(pendingRecord);
+        }
+        pending.clear();
+
+        mIteration = record.value;
+    }
+
+    // Without an update after them the remaining records may be only part of an iteration, but if we want the
+    // latest tree then they are still the best information available.
+    if (iteration < 0) {
+        foreach (const Record& pendingRecord, pending) {
+            apply(pendingRecord);
+        }
+    }
+
+    return mTree;
+}
+
+// Returns false at the end of the log, including at an incomplete last record.
+bool ExecutionTreeReplay::readRecord(Record* record)
+{
+    quint8 type;
+    mStream >> type;
+
+    if (mStream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    record->type = (ExecutionTreeLog::RecordType)type;
+
+    switch (record->type) {
+    case ExecutionTreeLog::RECORD_TREE:
+        record->tree = readTree();
+        break;
+
+    case ExecutionTreeLog::RECORD_JOIN:
+        mStream >> record->node >> record->value;
+
+        if (mStream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        if (record->node >= (quint32)mNodes.size()) {
+            Log::fatal("The execution tree log refers to a node which was never written");
+            exit(1);
+        }
+
+        // A summary parent is followed by the counts of the execution the new subtree belongs to.
+        if (mNodes.at(record->node)->getKind() == TraceNode::CONCRETE_SUMMARISATION) {
+            quint32 numBranches;
+            quint32 numFunctions;
+            mStream >> numBranches >> numFunctions;
+
+            for (quint32 i = 0; i < numBranches; i++) {
+                record->events.append(TraceConcreteSummarisation::BRANCH_TRUE);
+            }
+            for (quint32 i = 0; i < numFunctions; i++) {
+                record->events.append(TraceConcreteSummarisation::FUNCTION_CALL);
+            }
+        }
+
+        record->tree = readTree();
+        break;
+
+    case ExecutionTreeLog::RECORD_EXPLORATION: {
+        quint8 direction;
+        mStream >> record->node >> record->value >> direction;
+        record->direction = direction;
+        break;
+    }
+
+    case ExecutionTreeLog::RECORD_DIFFICULT:
+        mStream >> record->node;
+        break;
+
+    case ExecutionTreeLog::RECORD_INDICES:
+        mStream >> record->node;
+        record->indices = readIndices();
+        break;
+
+    case ExecutionTreeLog::RECORD_UPDATE:
+        mStream >> record->value;
+        break;
+
+    default:
+        Log::fatal(QString("Unknown execution tree log record %1").arg(type).toStdString());
+        exit(1);
+    }
+
+    if (mStream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    bool hasTree = record->type == ExecutionTreeLog::RECORD_TREE || record->type == ExecutionTreeLog::RECORD_JOIN;
+    if (hasTree && record->tree.isNull()) {
+        return false;
+    }
+
+    // The new nodes are only numbered once the whole record has been read.
+    mNodes.append(mNewNodes);
+    mNewNodes.clear();
+
+    return true;
+}
+
+void ExecutionTreeReplay::apply(const Record& record)
+{
+    if (record.type == ExecutionTreeLog::RECORD_TREE) {
+        mTree = record.tree;
+        return;
+    }
+
+    if (record.node >= (quint32)mNodes.size()) {
+        Log::fatal("The execution tree log refers to a node which was never written");
+        exit(1);
+    }
+
+    TraceNodePtr node = mNodes.at(record.node);
+
+    switch (record.type) {
+    case ExecutionTreeLog::RECORD_JOIN: {
+        TraceConcreteSummarisationPtr summary = node.dynamicCast<TraceConcreteSummarisation>();
+        if (!summary.isNull() && record.value == (quint32)summary->executions.size()) {
+            summary->executions.append(TraceConcreteSummarisation::SingleExecution(record.events, record.tree));
+        } else {
+            setChild(node, record.value, record.tree);
+        }
+        break;
+    }
+
+    case ExecutionTreeLog::RECORD_EXPLORATION:
+        node.staticCast<TraceSymbolicBranch>()->markExploration(record.value, record.direction);
+        break;
+
+    case ExecutionTreeLog::RECORD_DIFFICULT:
+        node.staticCast<TraceSymbolicBranch>()->markDifficult();
+        break;
+
+    case ExecutionTreeLog::RECORD_INDICES:
+        node.staticCast<TraceEnd>()->traceIndices = record.indices;
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Returns a null pointer if the log ends within the tree.
+TraceNodePtr ExecutionTreeReplay::readTree()
+{
+    mNewNodes.clear();
+    return readNode();
+}
+
+// Reads a node and its children, returns a null pointer if the log ends within them.
+TraceNodePtr ExecutionTreeReplay::readNode()
+{
+    quint8 kind;
+    mStream >> kind;
+
+    if (mStream.status() != QDataStream::Ok) {
+        return TraceNodePtr();
+    }
+
+    // Unexplored nodes are shared instances and are not numbered.
+    switch (kind) {
+    case ExecutionTreeLog::NODE_UNEXPLORED:
+        return TraceUnexplored::getInstance();
+
+    case ExecutionTreeLog::NODE_UNSAT:
+        return TraceUnexploredUnsat::getInstance();
+
+    case ExecutionTreeLog::NODE_UNSOLVABLE:
+        return TraceUnexploredUnsolvable::getInstance();
+
+    case ExecutionTreeLog::NODE_MISSED:
+        return TraceUnexploredMissed::getInstance();
+
+    case ExecutionTreeLog::NODE_QUEUED:
+        return TraceUnexploredQueued::getInstance();
+
+    default:
+        break;
+    }
+
+    TraceNodePtr node;
+    int numChildren = 0;
+
+    switch (kind) {
+    case ExecutionTreeLog::NODE_CONCRETE_BRANCH: {
+        QSource* source = readSource();
+        quint32 linenumber;
+        mStream >> linenumber;
+
+        node = TraceNodePtr(new TraceConcreteBranch(0, source, linenumber));
+        numChildren = 2;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_SYMBOLIC_BRANCH: {
+        QSource* source = readSource();
+        quint32 linenumber;
+        mStream >> linenumber;
+
+        QString condition = readString();
+        quint8 difficult;
+        quint32 explorationIndex;
+        quint8 explorationDirection;
+        mStream >> difficult >> explorationIndex >> explorationDirection;
+
+        Symbolic::SymbolicSource standIn(Symbolic::UNKNOWN, Symbolic::INPUT_NAME, condition.toStdString());
+        TraceSymbolicBranchPtr branch = TraceSymbolicBranchPtr(
+                    new TraceSymbolicBranch(Symbolic::SymbolicBoolean::create(standIn), 0, source, linenumber));
+        if (difficult) {
+            branch->markDifficult();
+        }
+        if (explorationIndex != 0) {
+            branch->markExploration(explorationIndex, explorationDirection);
+        }
+
+        node = branch;
+        numChildren = 2;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_ALERT: {
+        QSharedPointer<TraceAlert> alert = QSharedPointer<TraceAlert>(new TraceAlert());
+        alert->message = readString();
+
+        node = alert;
+        numChildren = 1;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_DOM_MODIFICATION: {
+        QSharedPointer<TraceDomModification> modification = QSharedPointer<TraceDomModification>(new TraceDomModification());
+        quint32 numWords;
+        mStream >> modification->amountModified >> numWords;
+
+        for (quint32 i = 0; i < numWords && mStream.status() == QDataStream::Ok; i++) {
+            QString word = readString();
+            qint32 count;
+            mStream >> count;
+            modification->words.insert(TraceDomModDetector::indicators.indexOf(word), count);
+        }
+
+        node = modification;
+        numChildren = 1;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_PAGE_LOAD: {
+        QSharedPointer<TracePageLoad> pageLoad = QSharedPointer<TracePageLoad>(new TracePageLoad());
+        pageLoad->url = QUrl(readString());
+
+        node = pageLoad;
+        numChildren = 1;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_MARKER: {
+        TraceMarkerPtr marker = TraceMarkerPtr(new TraceMarker());
+        marker->label = readString();
+        marker->index = readString();
+        marker->isSelectRestriction = false;
+
+        node = marker;
+        numChildren = 1;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_FUNCTION_CALL: {
+        QSharedPointer<TraceFunctionCall> call = QSharedPointer<TraceFunctionCall>(new TraceFunctionCall());
+        call->name = readString();
+
+        node = call;
+        numChildren = 1;
+        break;
+    }
+
+    case ExecutionTreeLog::NODE_SUMMARY: {
+        TraceConcreteSummarisationPtr summary = TraceConcreteSummarisationPtr(new TraceConcreteSummarisation());
+        quint32 numExecutions;
+        mStream >> numExecutions;
+
+        // The children are read with the counts of their execution below.
+        mNewNodes.append(summary);
+
+        for (quint32 i = 0; i < numExecutions && mStream.status() == QDataStream::Ok; i++) {
+            quint32 numBranches;
+            quint32 numFunctions;
+            mStream >> numBranches >> numFunctions;
+
+            TraceConcreteSummarisation::SingleExecution execution;
+            for (quint32 j = 0; j < numBranches; j++) {
+                execution.first.append(TraceConcreteSummarisation::BRANCH_TRUE);
+            }
+            for (quint32 j = 0; j < numFunctions; j++) {
+                execution.first.append(TraceConcreteSummarisation::FUNCTION_CALL);
+            }
+
+            execution.second = readNode();
+            if (execution.second.isNull()) {
+                return TraceNodePtr();
+            }
+            summary->executions.append(execution);
+        }
+
+        return mStream.status() == QDataStream::Ok ? summary : TraceNodePtr();
+    }
+
+    case ExecutionTreeLog::NODE_END_SUCCESS:
+    case ExecutionTreeLog::NODE_END_FAILURE:
+    case ExecutionTreeLog::NODE_END_UNKNOWN: {
+        TraceEndPtr end;
+        if (kind == ExecutionTreeLog::NODE_END_SUCCESS) {
+            end = TraceEndPtr(new TraceEndSuccess());
+        } else if (kind == ExecutionTreeLog::NODE_END_FAILURE) {
+            end = TraceEndPtr(new TraceEndFailure());
+        } else {
+            end = TraceEndPtr(new TraceEndUnknown());
+        }
+        end->traceIndices = readIndices();
+
+        node = end;
+        break;
+    }
+
+    default:
+        Log::fatal(QString("Unknown execution tree log node kind %1").arg(kind).toStdString());
+        exit(1);
+    }
+
+    // Nodes are numbered in pre-order, as they were written.
+    mNewNodes.append(node);
+
+    for (int i = 0; i < numChildren; i++) {
+        TraceNodePtr child = readNode();
+        if (child.isNull()) {
+            return TraceNodePtr();
+        }
+        setChild(node, i, child);
+    }
+
+    return mStream.status() == QDataStream::Ok ? node : TraceNodePtr();
+}
+
+// Looks up the sources in the registry, so the ids in the coverage links match those of the logged run.
+QSource* ExecutionTreeReplay::readSource()
+{
+    quint32 sourceId;
+    mStream >> sourceId;
+
+    if (mStream.status() != QDataStream::Ok || sourceId == ExecutionTreeLog::NO_SOURCE) {
+        return NULL;
+    }
+
+    if (sourceId == (quint32)mSources.size()) {
+        QString url = readString();
+        quint32 startLine;
+        mStream >> startLine;
+
+        mSources.append(QWebExecutionListener::getListener()->getSource(url, startLine));
+    }
+
+    if (sourceId >= (quint32)mSources.size()) {
+        Log::fatal("The execution tree log refers to a source which was never written");
+        exit(1);
+    }
+
+    return mSources.at(sourceId);
+}
+
+QString ExecutionTreeReplay::readString()
+{
+    QByteArray utf8;
+    mStream >> utf8;
+    return QString::fromUtf8(utf8);
+}
+
+QSet<uint> ExecutionTreeReplay::readIndices()
+{
+    QSet<uint> indices;
+    quint32 numIndices;
+    mStream >> numIndices;
+
+    for (quint32 i = 0; i < numIndices && mStream.status() == QDataStream::Ok; i++) {
+        quint32 index;
+        mStream >> index;
+        indices.insert(index);
+    }
+
+    return indices;
+}
+
+// The slots are those of ExecutionTreeLog::logJoin.
+void ExecutionTreeReplay::setChild(TraceNodePtr parent, quint32 slot, TraceNodePtr child)
+{
+    if (parent->isBranch()) {
+        if (slot == 1) {
+            parent.staticCast<TraceBranch>()->setTrueBranch(child);
+        } else {
+            parent.staticCast<TraceBranch>()->setFalseBranch(child);
+        }
+
+    } else if (parent->isAnnotation()) {
+        parent.staticCast<TraceAnnotation>()->next = child;
+
+    } else if (parent->getKind() == TraceNode::CONCRETE_SUMMARISATION) {
+        TraceConcreteSummarisationPtr summary = parent.staticCast<TraceConcreteSummarisation>();
+        if (slot < (quint32)summary->executions.size()) {
+            summary->executions[slot].second = child;
+        }
+    }
+}
+
+} // namespace artemis
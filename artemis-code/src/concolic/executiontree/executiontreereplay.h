@@ -0,0 +1,101 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QFile>
+#include <QDataStream>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/executiontreelog.h"
+
+#ifndef EXECUTIONTREEREPLAY_H
+#define EXECUTIONTREEREPLAY_H
+
+namespace artemis
+{
+
+/**
+ * Rebuilds the execution tree from an ExecutionTreeLog, as it was at any of the logged updates.
+ *
+ * The log only holds what the graph output needs, so the replayed tree is meant for TraceDisplay and
+ * TraceDisplayOverview. In particular each symbolic branch gets a stand-in condition, a symbolic boolean named by the
+ * condition as it was printed, which ExpressionValuePrinter prints in the same way.
+ *
+ * If Artemis did not exit cleanly the last record may be incomplete, in which case it is ignored.
+ */
+class ExecutionTreeReplay
+{
+public:
+    explicit ExecutionTreeReplay(const QString& pathToFile);
+
+    // Returns the tree after the last update at or before the given iteration, or the latest tree in the log if the
+    // iteration is negative. Returns a null pointer if the log holds no tree at that point.
+    TraceNodePtr replay(int iteration);
+
+    // The iteration of the last update which was replayed, or -1 if there was none.
+    inline int getIteration()
+    {
+        return mIteration;
+    }
+
+    // Whether the graphs of the logged run linked to its coverage report.
+    inline bool isLinkedToCoverage()
+    {
+        return mLinkToCoverage;
+    }
+
+private:
+    struct Record
+    {
+        ExecutionTreeLog::RecordType type;
+        quint32 node; // The parent, branch or end node the record refers to.
+        quint32 value; // The slot, exploration index or iteration.
+        bool direction;
+        QList<TraceConcreteSummarisation::EventType> events; // The counts of a new summary execution.
+        TraceNodePtr tree;
+        QSet<uint> indices;
+    };
+
+    bool readRecord(Record* record);
+    void apply(const Record& record);
+
+    TraceNodePtr readTree();
+    TraceNodePtr readNode();
+    QSource* readSource();
+    QString readString();
+    QSet<uint> readIndices();
+
+    static void setChild(TraceNodePtr parent, quint32 slot, TraceNodePtr child);
+
+    QFile mFile;
+    QDataStream mStream;
+    bool mLinkToCoverage;
+
+    TraceNodePtr mTree;
+    int mIteration;
+
+    // Indexed by the implicit ids of the log, in the order the nodes and sources were written.
+    QList<TraceNodePtr> mNodes;
+    QList<TraceNodePtr> mNewNodes;
+    QList<QSource*> mSources;
+};
+
+} // namespace artemis
+
+#endif // EXECUTIONTREEREPLAY_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QList>
+
+#include "trace.h"
+
+namespace artemis
+{
+
+// Trace nodes are only created and released on the main thread.
+static bool releasingTree = false;
+static QList<TraceNodePtr> releaseQueue;
+
+void TraceNode::releaseChild(TraceNodePtr* child)
+{
+    if (child->isNull()) {
+        return;
+    }
+
+    releaseQueue.append(*child);
+    child->clear();
+
+    if (releasingTree) {
+        return;
+    }
+
+    releasingTree = true;
+
+    while (!releaseQueue.isEmpty()) {
+        // Taken out of the queue first, as releasing the node may queue its own children.
+        TraceNodePtr node = releaseQueue.takeLast();
+        node.clear();
+    }
+
+    releasingTree = false;
+}
+
+}
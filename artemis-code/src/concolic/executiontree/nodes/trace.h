@@ -37,9 +37,60 @@ class TraceNode
 {
     // Abstract
 public:
+    /*
+     * Every concrete node type has its own kind, fixed on construction. Code which walks large trees (merging,
+     * searching) switches on the kind instead of going through the visitor or a dynamic cast, and can then loop over
+     * the nodes rather than recurse. The kinds of each abstract node type are kept together.
+     */
+    enum Kind {
+        UNEXPLORED, UNEXPLORED_UNSAT, UNEXPLORED_UNSOLVABLE, UNEXPLORED_MISSED, UNEXPLORED_QUEUED,
+        CONCRETE_BRANCH, SYMBOLIC_BRANCH,
+        ALERT, DOM_MODIFICATION, PAGE_LOAD, MARKER, FUNCTION_CALL,
+        CONCRETE_SUMMARISATION,
+        END_SUCCESS, END_FAILURE, END_UNKNOWN
+    };
+
+    inline Kind getKind() const {
+        return mKind;
+    }
+
+    inline bool isUnexplored() const {
+        return mKind <= UNEXPLORED_QUEUED;
+    }
+
+    inline bool isBranch() const {
+        return mKind == CONCRETE_BRANCH || mKind == SYMBOLIC_BRANCH;
+    }
+
+    inline bool isAnnotation() const {
+        return mKind >= ALERT && mKind <= FUNCTION_CALL;
+    }
+
+    inline bool isEnd() const {
+        return mKind >= END_SUCCESS;
+    }
+
+    // Null safe kind check, used by the isEqualShallow implementations.
+    static inline bool hasKind(const QSharedPointer<const TraceNode>& node, Kind kind) {
+        return !node.isNull() && node->mKind == kind;
+    }
+
     virtual void accept(TraceVisitor* visitor) = 0;
     virtual bool isEqualShallow(const QSharedPointer<const TraceNode>& other) = 0;
     virtual ~TraceNode() {}
+
+protected:
+    explicit TraceNode(Kind kind) : mKind(kind) {}
+
+    /*
+     * Drops a child in the destructor of its parent. Releasing a deep tree through the nested destructors would
+     * recurse once per node and overflow the call stack, so while a tree is being released the children are queued
+     * and released one at a time by the outermost call instead.
+     */
+    static void releaseChild(QSharedPointer<TraceNode>* child);
+
+private:
+    const Kind mKind;
 };
 
 typedef QSharedPointer<TraceNode> TraceNodePtr;
@@ -49,6 +100,14 @@ class TraceAnnotation : public TraceNode
     // Abstract
 public:
     TraceNodePtr next;
+
+    ~TraceAnnotation()
+    {
+        releaseChild(&next);
+    }
+
+protected:
+    explicit TraceAnnotation(Kind kind) : TraceNode(kind) {}
 };
 
 typedef QSharedPointer<TraceAnnotation> TraceAnnotationPtr;
@@ -58,6 +117,7 @@ class TraceAlert : public TraceAnnotation
 {
 
 public:
+    TraceAlert() : TraceAnnotation(ALERT) {}
 
     void accept(TraceVisitor* visitor)
     {
@@ -66,7 +126,7 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceAlert>().isNull();
+        return hasKind(other, ALERT);
     }
 
     ~TraceAlert() {}
@@ -78,6 +138,7 @@ public:
 class TraceDomModification : public TraceAnnotation
 {
 public:
+    TraceDomModification() : TraceAnnotation(DOM_MODIFICATION) {}
 
     void accept(TraceVisitor* visitor) {
         visitor->visit(this);
@@ -85,7 +146,7 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceDomModification>().isNull();
+        return hasKind(other, DOM_MODIFICATION);
     }
 
      ~TraceDomModification() {}
@@ -98,11 +159,13 @@ public:
 class TracePageLoad : public TraceAnnotation
 {
 public:
+    TracePageLoad() : TraceAnnotation(PAGE_LOAD) {}
+
     QUrl url; // The NEW url being loaded.
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TracePageLoad>().isNull();
+        return hasKind(other, PAGE_LOAD);
     }
 
     void accept(TraceVisitor* visitor) {
@@ -116,6 +179,8 @@ public:
 class TraceMarker : public TraceAnnotation
 {
 public:
+    TraceMarker() : TraceAnnotation(MARKER) {}
+
     QString label;
     QString index;
     bool isSelectRestriction;
@@ -123,7 +188,7 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceMarker>().isNull();
+        return hasKind(other, MARKER);
     }
 
     void accept(TraceVisitor* visitor) {
@@ -139,6 +204,8 @@ typedef QSharedPointer<TraceMarker> TraceMarkerPtr;
 class TraceFunctionCall : public TraceAnnotation
 {
 public:
+    TraceFunctionCall() : TraceAnnotation(FUNCTION_CALL) {}
+
     QString name;
 
     void accept(TraceVisitor* visitor) {
@@ -147,9 +214,8 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-         const QSharedPointer<const TraceFunctionCall> otherCasted = other.dynamicCast<const TraceFunctionCall>();
-
-         return !otherCasted.isNull() && name.compare(otherCasted->name) == 0;
+         return hasKind(other, FUNCTION_CALL) &&
+                 name.compare(static_cast<const TraceFunctionCall*>(other.data())->name) == 0;
     }
 
     ~TraceFunctionCall(){}
@@ -160,6 +226,9 @@ class TraceEnd : public TraceNode
 {
 public:
     QSet<uint> traceIndices;
+
+protected:
+    explicit TraceEnd(Kind kind) : TraceNode(kind) {}
 };
 
 typedef QSharedPointer<TraceEnd> TraceEndPtr;
@@ -169,6 +238,8 @@ class TraceEndSuccess : public TraceEnd
 {
     // Empty marker.
 public:
+    TraceEndSuccess() : TraceEnd(END_SUCCESS) {}
+
     TraceNodePtr next;
 
     void accept(TraceVisitor* visitor) {
@@ -177,10 +248,13 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceEndSuccess>().isNull();
+        return hasKind(other, END_SUCCESS);
     }
 
-    ~TraceEndSuccess(){}
+    ~TraceEndSuccess()
+    {
+        releaseChild(&next);
+    }
 };
 
 
@@ -188,6 +262,8 @@ class TraceEndFailure : public TraceEnd
 {
     // Empty marker.
 public:
+    TraceEndFailure() : TraceEnd(END_FAILURE) {}
+
     TraceNodePtr next;
 
     void accept(TraceVisitor* visitor) {
@@ -196,10 +272,13 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceEndFailure>().isNull();
+        return hasKind(other, END_FAILURE);
     }
 
-    ~TraceEndFailure(){}
+    ~TraceEndFailure()
+    {
+        releaseChild(&next);
+    }
 };
 
 
@@ -207,6 +286,7 @@ class TraceEndUnknown : public TraceEnd
 {
     // Empty placeholder.
 public:
+    TraceEndUnknown() : TraceEnd(END_UNKNOWN) {}
 
     void accept(TraceVisitor* visitor) {
         visitor->visit(this);
@@ -214,7 +294,7 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceEndUnknown>().isNull();
+        return hasKind(other, END_UNKNOWN);
     }
 
     ~TraceEndUnknown(){}
@@ -239,6 +319,8 @@ public:
 class TraceConcreteSummarisation : public TraceNode
 {
 public:
+    TraceConcreteSummarisation() : TraceNode(CONCRETE_SUMMARISATION) {}
+
     enum EventType {
         BRANCH_FALSE, BRANCH_TRUE, FUNCTION_CALL
     };
@@ -253,7 +335,7 @@ public:
 
     bool isEqualShallow(const QSharedPointer<const TraceNode>& other)
     {
-        return !other.dynamicCast<const TraceConcreteSummarisation>().isNull();
+        return hasKind(other, CONCRETE_SUMMARISATION);
     }
 
     QList<int> numBranches()
@@ -298,7 +380,12 @@ public:
         return result;
     }
 
-    ~TraceConcreteSummarisation(){}
+    ~TraceConcreteSummarisation()
+    {
+        for (int i = 0; i < executions.size(); i++) {
+            releaseChild(&executions[i].second);
+        }
+    }
 };
 
 typedef QSharedPointer<TraceConcreteSummarisation> TraceConcreteSummarisationPtr;
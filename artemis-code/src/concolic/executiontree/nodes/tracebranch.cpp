@@ -20,8 +20,9 @@
 
 namespace artemis {
 
-TraceBranch::TraceBranch(uint sourceOffset, QSource* source, uint linenumber)
-    : mSourceOffset(sourceOffset)
+TraceBranch::TraceBranch(Kind kind, uint sourceOffset, QSource* source, uint linenumber)
+    : TraceNode(kind)
+    , mSourceOffset(sourceOffset)
     , mSource(source)
     , mLinenumber(linenumber)
     , mBranchTrue(TraceUnexplored::getInstance())
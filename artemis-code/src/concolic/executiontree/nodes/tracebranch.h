@@ -35,7 +35,11 @@ public:
     friend class TraceBranchDetector; // direct modification of mBranchTrue and mBranchFalse
     friend class TraceClassifier; // Takes address of mBranchTrue and mBranchFalse and uses this to modify them directly. It seemed even more of a hack to add getTrueBranchPtr() to the interface.
 
-    ~TraceBranch() {}
+    ~TraceBranch()
+    {
+        releaseChild(&mBranchTrue);
+        releaseChild(&mBranchFalse);
+    }
 
     inline TraceNodePtr getTrueBranch()
     {
@@ -73,7 +77,7 @@ public:
     }
 
 protected:
-    TraceBranch(uint sourceOffset, QSource* source, uint linenumber); // we should only use the concrete or symbolic subclasses
+    TraceBranch(Kind kind, uint sourceOffset, QSource* source, uint linenumber); // we should only use the concrete or symbolic subclasses
 
     uint mSourceOffset;
     QSource* mSource;
@@ -19,7 +19,7 @@
 namespace artemis {
 
 TraceConcreteBranch::TraceConcreteBranch(uint sourceOffset, QSource* source, uint linenumber) :
-    TraceBranch(sourceOffset, source, linenumber)
+    TraceBranch(CONCRETE_BRANCH, sourceOffset, source, linenumber)
 {
 }
 
@@ -30,9 +30,7 @@ void TraceConcreteBranch::accept(TraceVisitor* visitor)
 
 bool TraceConcreteBranch::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    QSharedPointer<const TraceConcreteBranch> otherCasted = other.dynamicCast<const TraceConcreteBranch>();
-
-    return !otherCasted.isNull();
+    return hasKind(other, CONCRETE_BRANCH);
 }
 
 
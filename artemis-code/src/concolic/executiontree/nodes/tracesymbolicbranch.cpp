@@ -16,13 +16,15 @@
 
 #include <assert.h>
 
+#include "JavaScriptCore/symbolic/expression/expressionarena.h"
+
 #include "tracesymbolicbranch.h"
 
 namespace artemis {
 
 TraceSymbolicBranch::TraceSymbolicBranch(Symbolic::Expression* condition, uint sourceOffset, QSource* source, uint linenumber) :
-    TraceBranch(sourceOffset, source, linenumber),
-    mCondition(condition),
+    TraceBranch(SYMBOLIC_BRANCH, sourceOffset, source, linenumber),
+    mCondition(Symbolic::ExpressionArena::persistent()->import(condition)),
     mDifficult(false),
     mExplorationIndex(0)
 {
@@ -35,13 +37,13 @@ void TraceSymbolicBranch::accept(TraceVisitor* visitor) {
 
 bool TraceSymbolicBranch::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    QSharedPointer<const TraceSymbolicBranch> otherCasted = other.dynamicCast<const TraceSymbolicBranch>();
-
-    if (otherCasted.isNull()) {
+    if (!hasKind(other, SYMBOLIC_BRANCH)) {
         return false;
     }
 
     // TODO, should we also check equality of the symbolic expression?
+    // Conditions are hash-consed in the persistent arena, so this would be a pointer comparison. However,
+    // conditions on the same branch legitimately differ between traces (e.g. event target sources).
 
     return true;
 }
@@ -61,7 +61,7 @@ public:
     }
 
 private:
-    Symbolic::Expression* mCondition; // TODO: MEMORY
+    Symbolic::Expression* mCondition; // Owned by the persistent expression arena
     bool mDifficult;
 
     // Used to add an index to the output graph linking which attempted explorations by the search procedure lead to which explored traces.
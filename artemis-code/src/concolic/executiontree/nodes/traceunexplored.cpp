@@ -32,7 +32,7 @@ void TraceUnexplored::accept(TraceVisitor* visitor)
 
 bool TraceUnexplored::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    return !other.dynamicCast<const TraceUnexplored>().isNull();
+    return !other.isNull() && other->isUnexplored();
 }
 
 }
@@ -45,10 +45,8 @@ public:
     static QSharedPointer<TraceUnexplored>* mInstance;
 
 protected:
-    TraceUnexplored() {}
-
-
-
+    TraceUnexplored() : TraceNode(UNEXPLORED) {}
+    explicit TraceUnexplored(Kind kind) : TraceNode(kind) {} // for the marked subclasses
 };
 
 typedef QSharedPointer<TraceUnexplored> TraceUnexploredPtr;
@@ -32,7 +32,7 @@ void TraceUnexploredMissed::accept(TraceVisitor* visitor)
 
 bool TraceUnexploredMissed::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    return !other.dynamicCast<const TraceUnexploredMissed>().isNull();
+    return hasKind(other, UNEXPLORED_MISSED);
 }
 
 }
@@ -39,7 +39,7 @@ public:
     static QSharedPointer<TraceUnexploredMissed>* mInstance;
 
 private:
-    TraceUnexploredMissed() {}
+    TraceUnexploredMissed() : TraceUnexplored(UNEXPLORED_MISSED) {}
 };
 
 
@@ -32,7 +32,7 @@ void TraceUnexploredQueued::accept(TraceVisitor* visitor)
 
 bool TraceUnexploredQueued::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    return !other.dynamicCast<const TraceUnexploredQueued>().isNull();
+    return hasKind(other, UNEXPLORED_QUEUED);
 }
 
 }
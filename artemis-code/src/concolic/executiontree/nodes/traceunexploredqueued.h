@@ -39,7 +39,7 @@ public:
     static QSharedPointer<TraceUnexploredQueued>* mInstance;
 
 private:
-    TraceUnexploredQueued() {}
+    TraceUnexploredQueued() : TraceUnexplored(UNEXPLORED_QUEUED) {}
 };
 
 
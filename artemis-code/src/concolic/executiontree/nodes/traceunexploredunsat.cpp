@@ -32,7 +32,7 @@ void TraceUnexploredUnsat::accept(TraceVisitor* visitor)
 
 bool TraceUnexploredUnsat::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    return !other.dynamicCast<const TraceUnexploredUnsat>().isNull();
+    return hasKind(other, UNEXPLORED_UNSAT);
 }
 
 }
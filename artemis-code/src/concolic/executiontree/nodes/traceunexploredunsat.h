@@ -39,7 +39,7 @@ public:
     static QSharedPointer<TraceUnexploredUnsat>* mInstance;
 
 private:
-    TraceUnexploredUnsat() {}
+    TraceUnexploredUnsat() : TraceUnexplored(UNEXPLORED_UNSAT) {}
 };
 
 
@@ -32,7 +32,7 @@ void TraceUnexploredUnsolvable::accept(TraceVisitor* visitor)
 
 bool TraceUnexploredUnsolvable::isEqualShallow(const QSharedPointer<const TraceNode>& other)
 {
-    return !other.dynamicCast<const TraceUnexploredUnsolvable>().isNull();
+    return hasKind(other, UNEXPLORED_UNSOLVABLE);
 }
 
 }
@@ -39,7 +39,7 @@ public:
     static QSharedPointer<TraceUnexploredUnsolvable>* mInstance;
 
 private:
-    TraceUnexploredUnsolvable() {}
+    TraceUnexploredUnsolvable() : TraceUnexplored(UNEXPLORED_UNSOLVABLE) {}
 };
 
 
@@ -247,7 +247,7 @@ void TraceDisplay::visit(TraceConcreteBranch *node)
     mNodeCounter++;
 
     std::stringstream sourceId;
-    sourceId << SourceInfo::getId(node->getSource()->getUrl(), node->getSource()->getStartLine());
+    sourceId << SourceInfo::getId(node->getSource());
 
     std::stringstream sourceLine;
     sourceLine << node->getLinenumber();
@@ -291,7 +291,7 @@ void TraceDisplay::visit(TraceSymbolicBranch *node)
     symbolicExpression.replace("\"", "\\\"");
 
     std::stringstream sourceId;
-    sourceId << SourceInfo::getId(node->getSource()->getUrl(), node->getSource()->getStartLine());
+    sourceId << SourceInfo::getId(node->getSource());
 
     std::stringstream sourceLine;
     sourceLine << node->getLinenumber();
@@ -186,7 +186,7 @@ void TraceDisplayOverview::visit(TraceSymbolicBranch *node)
     // We always show symbolic brnaches, but we no longer need to find their conditions, etc.
 
     std::stringstream sourceId;
-    sourceId << SourceInfo::getId(node->getSource()->getUrl(), node->getSource()->getStartLine());
+    sourceId << SourceInfo::getId(node->getSource());
 
     std::stringstream sourceLine;
     sourceLine << node->getLinenumber();
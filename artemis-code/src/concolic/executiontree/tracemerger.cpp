@@ -26,6 +26,11 @@
 namespace artemis
 {
 
+void TraceMerger::setTreeLog(ExecutionTreeLogPtr treeLog)
+{
+    mTreeLog = treeLog;
+}
+
 TraceNodePtr TraceMerger::merge(TraceNodePtr trace, TraceNodePtr executiontree)
 {
     if (trace.isNull()) {
@@ -40,221 +45,222 @@ TraceNodePtr TraceMerger::merge(TraceNodePtr trace, TraceNodePtr executiontree)
     mStartingTrace = trace;
     mStartingTree = executiontree;
 
-    mCurrentTrace = trace;
-    mCurrentTree = executiontree;
+    mResult = executiontree;
 
     mPreviousParent = TraceNodePtr();
+    mJoinParent = TraceNodePtr();
+    mJoinSlot = 0;
 
-    trace->accept(this);
-
-    return mCurrentTree;
-}
+    QStack<MergeItem> stack;
+    MergeItem root = {trace, executiontree, TraceNodePtr(), 0, TraceNodePtr(), 0};
+    stack.push(root);
 
-void TraceMerger::visit(TraceUnexplored* node)
-{
-    // Ignore, we can't add any information to the execution tree
-    return;
-}
+    while (!stack.isEmpty()) {
+        MergeItem item = stack.pop();
 
-void TraceMerger::visit(TraceEnd* node)
-{
-    // case: unexplored branch in the tree
-    if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
+        // case: unexplored node in the trace
+        if (item.trace->isUnexplored()) {
+            // Ignore, we can't add any information to the execution tree
+            continue;
+        }
 
-        // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
-        reportMerge(mCurrentTrace);
-        return;
-    }
+        // case: unexplored branch in the tree
+        if (TraceVisitor::isImmediatelyUnexplored(item.tree)) {
+            // Insert this trace directly into the tree
+            join(item);
+            continue;
+        }
 
-    // case: trace end
-    if (mCurrentTrace->isEqualShallow(mCurrentTree)) {
-        // Merge the exploration indices.
-        TraceEndPtr treeEnd =  mCurrentTree.dynamicCast<TraceEnd>();
-        treeEnd->traceIndices.unite(node->traceIndices);
+        switch (item.trace->getKind()) {
 
-    } else {
-        handleDivergence();
-    }
-}
+        case TraceNode::CONCRETE_BRANCH:
+        case TraceNode::SYMBOLIC_BRANCH: {
+            if (!item.trace->isEqualShallow(item.tree)) {
+                handleDivergence();
+                break;
+            }
 
-void TraceMerger::visit(TraceBranch* node)
-{
-    // case: unexplored branch in the tree
-    if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
+            TraceBranch* traceBranch = static_cast<TraceBranch*>(item.trace.data());
+            TraceBranchPtr treeBranch = item.tree.staticCast<TraceBranch>();
 
-        // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
-        reportMerge(mCurrentTrace);
-        return;
-    }
+            // Merge the traces for each branch, the true branch first.
+            MergeItem falseItem = {traceBranch->getFalseBranch(), treeBranch->getFalseBranch(), treeBranch, 0, treeBranch, 0};
+            MergeItem trueItem = {traceBranch->getTrueBranch(), treeBranch->getTrueBranch(), treeBranch, 1, treeBranch, 1};
+            stack.push(falseItem);
+            stack.push(trueItem);
+            break;
+        }
 
-    // case: traceBranch
-    if (node->isEqualShallow(mCurrentTree)) {
+        case TraceNode::ALERT:
+        case TraceNode::DOM_MODIFICATION:
+        case TraceNode::PAGE_LOAD:
+        case TraceNode::MARKER:
+        case TraceNode::FUNCTION_CALL: {
+            if (!item.trace->isEqualShallow(item.tree)) {
+                handleDivergence();
+                break;
+            }
 
-        TraceBranchPtr treeBranch = mCurrentTree.dynamicCast<TraceBranch>();
+            TraceAnnotation* traceAnnotation = static_cast<TraceAnnotation*>(item.trace.data());
+            TraceAnnotationPtr treeAnnotation = item.tree.staticCast<TraceAnnotation>();
 
-        // Merge the traces for each branch
+            MergeItem nextItem = {traceAnnotation->next, treeAnnotation->next, treeAnnotation, 0, item.previousParent, item.previousDirection};
+            stack.push(nextItem);
+            break;
+        }
 
-        mCurrentTree = treeBranch->getTrueBranch();
-        mCurrentTrace = node->getTrueBranch();
-        mPreviousParent = treeBranch;
-        mPreviousDirection = 1;
-        mCurrentTrace->accept(this);
+        case TraceNode::CONCRETE_SUMMARISATION:
+            mergeSummary(item, &stack);
+            break;
 
-        treeBranch->setTrueBranch(mCurrentTree);
+        case TraceNode::END_SUCCESS:
+        case TraceNode::END_FAILURE:
+        case TraceNode::END_UNKNOWN: {
+            // case: trace end
+            if (!item.trace->isEqualShallow(item.tree)) {
+                handleDivergence();
+                break;
+            }
 
-        mCurrentTree = treeBranch->getFalseBranch();
-        mCurrentTrace = node->getFalseBranch();
-        mPreviousParent = treeBranch;
-        mPreviousDirection = 0;
-        mCurrentTrace->accept(this);
+            // Merge the exploration indices.
+            TraceEndPtr treeEnd = item.tree.staticCast<TraceEnd>();
+            treeEnd->traceIndices.unite(static_cast<TraceEnd*>(item.trace.data())->traceIndices);
 
-        treeBranch->setFalseBranch(mCurrentTree);
+            if (!mTreeLog.isNull()) {
+                mTreeLog->logTraceIndices(treeEnd, treeEnd->traceIndices);
+            }
+            break;
+        }
 
-        mCurrentTree = treeBranch;
-        return;
+        default:
+            qWarning() << "Unknown node kind reached, this indicates a missing case in the TraceMerger!";
+            exit(1);
+        }
     }
 
-    handleDivergence();
+    return mResult;
 }
 
-void TraceMerger::visit(TraceAnnotation* node)
+void TraceMerger::mergeSummary(const MergeItem& item, QStack<MergeItem>* stack)
 {
-    // case: unexplored branch in the tree
-    if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
-
-        // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
-        reportMerge(mCurrentTrace);
+    if (!item.trace->isEqualShallow(item.tree)) {
+        // Corresponding tree node was not a concrete summary.
+        handleDivergence();
         return;
     }
 
-    if (node->isEqualShallow(mCurrentTree)) {
-        TraceAnnotationPtr treeAnnotation = mCurrentTree.dynamicCast<TraceAnnotation>();
+    TraceConcreteSummarisation* node = static_cast<TraceConcreteSummarisation*>(item.trace.data());
+    TraceConcreteSummarisationPtr treeSummary = item.tree.staticCast<TraceConcreteSummarisation>();
+
+    // Check that the event sequences from these two summaries can be merged.
+
+    // The trace summary is assumed to have a single execution path.
+    // To merge it with the tree, we check each of the execution paths in the tree node in turn.
+    // For each tree node execution sequence:
+    //     If the sequences match perfectly, then this is a match and we are done. Continue merging the children.
+    //     If the sequences have matching prefixes until a BRANCH_TRUE and BRANCH_FALSE, then this is is a
+    //       fully explored concrete branch which does not match this execution so move on to the next.
+    //     If the sequences first diverge without a BRANCH_TRUE and BRANCH_FALSE then this is a trace divergence.
+    // If the end of the list of executions is reached and the trace still has not been matched or marked as a
+    //   divergence then it must be a new branch point and is added to the list.
+
+    // Check the trace has a unique execution path.
+    if(node->executions.length() != 1) {
+        Log::fatal("Attempting to merge a trace with multiple concrete execution paths within a summary node.");
+        exit(1);
+    }
+    QPair<QList<TraceConcreteSummarisation::EventType>, TraceNodePtr> traceExec = node->executions[0];
 
-        mCurrentTree = treeAnnotation->next;
-        mCurrentTrace = node->next;
-        mCurrentTrace->accept(this);
+    // Attempt to match with each tree execution path in turn.
+    for(int idx = 0; idx < treeSummary->executions.length(); idx++) {
+        const TraceConcreteSummarisation::SingleExecution& treeExec = treeSummary->executions[idx];
 
-        treeAnnotation->next = mCurrentTree;
+        // If the executions match exactly then merge the successor nodes and end.
+        if(treeExec.first == traceExec.first) {
+            MergeItem nextItem = {traceExec.second, treeExec.second, treeSummary, idx, treeSummary, idx};
+            stack->push(nextItem);
+            return;
+        }
 
-        mCurrentTree = treeAnnotation;
-        return;
+        // Otherwise, we need to check the first difference between them.
+        bool goodMatch = false;
+        int len = min(treeExec.first.length(), traceExec.first.length());
+        for(int i = 0; i < len; i++) {
+            if(treeExec.first[i] != traceExec.first[i]){
+                qDebug() << "found mismatch!" << treeExec.first[i] << traceExec.first[i];
+
+                if(treeExec.first[i] == TraceConcreteSummarisation::FUNCTION_CALL ||
+                        traceExec.first[i] == TraceConcreteSummarisation::FUNCTION_CALL) {
+                    // The traces diverged but not at BRANCH_TRUE and BRANCH_FALSE.
+                    handleDivergence();
+                    return;
+
+                } else {
+                    // The traces have differed at BRANCH_TRUE vs BRANCH_FALSE.
+                    // So we should continue the outer loop to check if any other traces will match it.
+                    goodMatch = true;
+                    break;
+                }
+            }
+        }
+
+        if(!goodMatch) {
+            // If we reach here then one must be shorter than the other (but matches a prefix).
+            // This counts as a divergence, as one trace will continue with the summary while the other goes on to
+            // an "interesting" node.
+            handleDivergence();
+            return;
+        }
     }
 
-    handleDivergence();
+    // If we have checked each execution without finding a match or a divergence, then this is a valid new path.
+    // Insert the new path into the tree and return.
+    treeSummary->executions.append(traceExec);
+    Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+    mPreviousParent = treeSummary;
+    mPreviousDirection = treeSummary->executions.length()-1;
+    mJoinParent = treeSummary;
+    mJoinSlot = treeSummary->executions.length()-1;
+    reportMerge(traceExec.second);
 }
 
-
-void TraceMerger::visit(TraceConcreteSummarisation *node)
+// Replaces the unexplored tree node in the item's slot with the remaining trace.
+void TraceMerger::join(const MergeItem& item)
 {
-    // case: unexplored branch in the tree
-    if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
-
-        // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
-        reportMerge(mCurrentTrace);
-        return;
+    if (item.joinParent.isNull()) {
+        mResult = item.trace;
+    } else {
+        setChild(item.joinParent, item.joinSlot, item.trace);
     }
 
-    if (node->isEqualShallow(mCurrentTree)) {
-        TraceConcreteSummarisationPtr treeSummary = mCurrentTree.dynamicCast<TraceConcreteSummarisation>();
-
-        // Check that the event sequences from these two summaries can be merged.
+    Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
 
-        // The trace summary is assumed to have a single execution path.
-        // To merge it with the tree, we check each of the execution paths in the tree node in turn.
-        // For each tree node execution sequence:
-        //     If the sequences match perfectly, then this is a match and we are done. Continue merging the children.
-        //     If the sequences have matching prefixes until a BRANCH_TRUE and BRANCH_FALSE, then this is is a
-        //       fully explored concrete branch which does not match this execution so move on to the next.
-        //     If the sequences first diverge without a BRANCH_TRUE and BRANCH_FALSE then this is a trace divergence.
-        // If the end of the list of executions is reached and the trace still has not been matched or marked as a
-        //   divergence then it must be a new branch point and is added to the list.
+    mPreviousParent = item.previousParent;
+    mPreviousDirection = item.previousDirection;
+    mJoinParent = item.joinParent;
+    mJoinSlot = item.joinSlot;
+    reportMerge(item.trace);
+}
 
-        // Check the trace has a unique execution path.
-        if(node->executions.length() != 1) {
-            Log::fatal("Attempting to merge a trace with multiple concrete execution paths within a summary node.");
-            exit(1);
+void TraceMerger::setChild(TraceNodePtr parent, int slot, TraceNodePtr child)
+{
+    if (parent->isBranch()) {
+        TraceBranchPtr branch = parent.staticCast<TraceBranch>();
+        if (slot == 1) {
+            branch->setTrueBranch(child);
+        } else {
+            branch->setFalseBranch(child);
         }
-        QPair<QList<TraceConcreteSummarisation::EventType>, TraceNodePtr> traceExec = node->executions[0];
-
-        // Attempt to match with each tree execution path in turn.
-        int idx = 0;
-        foreach(TraceConcreteSummarisation::SingleExecution treeExec, treeSummary->executions) {
 
-            // If the executions match exactly then merge the successor nodes and end.
-            if(treeExec.first == traceExec.first) {
-                mCurrentTree = treeExec.second;
-                mCurrentTrace = traceExec.second;
-                mPreviousParent = treeSummary;
-                mPreviousDirection = idx;
-                mCurrentTrace->accept(this);
+    } else if (parent->isAnnotation()) {
+        parent.staticCast<TraceAnnotation>()->next = child;
 
-                treeExec.second = mCurrentTree;
-
-                mCurrentTree = treeSummary;
-                return;
-            }
+    } else if (parent->getKind() == TraceNode::CONCRETE_SUMMARISATION) {
+        parent.staticCast<TraceConcreteSummarisation>()->executions[slot].second = child;
 
-            // Otherwise, we need to check the first difference between them.
-            bool goodMatch = false;
-            int len = min(treeExec.first.length(), traceExec.first.length());
-            for(int i = 0; i < len; i++) {
-                if(treeExec.first[i] != traceExec.first[i]){
-                    qDebug() << "found mismatch!" << treeExec.first[i] << traceExec.first[i];
-
-                    if(treeExec.first[i] == TraceConcreteSummarisation::FUNCTION_CALL ||
-                            traceExec.first[i] == TraceConcreteSummarisation::FUNCTION_CALL) {
-                        // The traces diverged but not at BRANCH_TRUE and BRANCH_FALSE.
-                        handleDivergence();
-                        return;
-
-                    } else {
-                        // The traces have differed at BRANCH_TRUE vs BRANCH_FALSE.
-                        // So we should continue the outer loop to check if any other traces will match it.
-                        goodMatch = true;
-                        break;
-                    }
-                }
-            }
-
-            if(!goodMatch) {
-                // If we reach here then one must be shorter than the other (but matches a prefix).
-                // This counts as a divergence, as one trace will continue with the summary while the other goes on to
-                // an "interesting" node.
-                handleDivergence();
-                return;
-            }
-
-            idx++;
-        }
-
-        // If we have checked each execution without finding a match or a divergence, then this is a valid new path.
-        // Insert the new path into the tree and return.
-        treeSummary->executions.append(traceExec);
-        // mCurrentTree is not changed.
-        Statistics::statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
-        mPreviousParent = treeSummary;
-        mPreviousDirection = treeSummary->executions.length()-1;
-        reportMerge(traceExec.second);
-        return;
+    } else {
+        assert(false);
     }
-
-    // Corresponding tree node was not a concrete summary.
-    handleDivergence();
-}
-
-
-void TraceMerger::visit(TraceNode* node)
-{
-    qWarning() << "TraceNode reached, this indicates a missing case in the TraceMerger visitor!";
-    exit(1);
 }
 
 
@@ -280,6 +286,10 @@ void TraceMerger::handleDivergence()
 // When we merge a trace, trigger the signals.
 void TraceMerger::reportMerge(TraceNodePtr newPart)
 {
+    if (!mTreeLog.isNull()) {
+        mTreeLog->logJoin(mJoinParent, mJoinSlot, newPart);
+    }
+
     assert(!mPreviousParent.isNull());
     emit sigTraceJoined(mPreviousParent, mPreviousDirection, newPart, mStartingTrace);
 }
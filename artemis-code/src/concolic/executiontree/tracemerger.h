@@ -14,8 +14,10 @@
  * limitations under the License.
  */
 
+#include <QStack>
+
 #include "concolic/executiontree/tracenodes.h"
-#include "concolic/executiontree/tracevisitor.h"
+#include "concolic/executiontree/executiontreelog.h"
 
 #include "statistics/statsstorage.h"
 
@@ -35,20 +37,15 @@ namespace artemis
  * Thus, the usage of a pointer to the executiontree pointer.
  *
  */
-class TraceMerger : public QObject, public TraceVisitor
+class TraceMerger : public QObject
 {
     Q_OBJECT
 
 public:
     TraceNodePtr merge(TraceNodePtr trace, TraceNodePtr executiontree);
 
-    void visit(TraceNode* node);
-
-    void visit(TraceBranch* node);
-    void visit(TraceUnexplored* node);
-    void visit(TraceAnnotation* node);
-    void visit(TraceConcreteSummarisation* node);
-    void visit(TraceEnd* node);
+    // If set, every change made to the tree is also written to the log.
+    void setTreeLog(ExecutionTreeLogPtr treeLog);
 
     void handleDivergence();
 
@@ -58,8 +55,30 @@ signals:
     void sigTraceJoined(TraceNodePtr parent, int direction, TraceNodePtr suffix, TraceNodePtr fullTrace);
 
 private:
-    TraceNodePtr mCurrentTree;
-    TraceNodePtr mCurrentTrace;
+    /*
+     * The merge walks the trace and the tree side by side with an explicit stack instead of recursing, as traces of
+     * long running pages easily get deep enough to overflow the call stack.
+     *
+     * Each pending pair of nodes remembers the tree slot it fills: the direction of a branch, the next pointer of
+     * an annotation or the execution of a summary (the same slots as ExecutionTreeLog::logJoin). A NULL parent is
+     * the root of the tree.
+     */
+    struct MergeItem {
+        TraceNodePtr trace;
+        TraceNodePtr tree;
+
+        TraceNodePtr joinParent;
+        int joinSlot;
+
+        TraceNodePtr previousParent;
+        int previousDirection;
+    };
+
+    void mergeSummary(const MergeItem& item, QStack<MergeItem>* stack);
+    void join(const MergeItem& item);
+    static void setChild(TraceNodePtr parent, int slot, TraceNodePtr child);
+
+    TraceNodePtr mResult;
 
     TraceNodePtr mStartingTrace;
     TraceNodePtr mStartingTree;
@@ -71,6 +90,11 @@ private:
     TraceNodePtr mPreviousParent;
     int mPreviousDirection;
     void reportMerge(TraceNodePtr newPart);
+
+    // The exact node the next join would be made under, which unlike mPreviousParent includes annotations.
+    ExecutionTreeLogPtr mTreeLog;
+    TraceNodePtr mJoinParent;
+    int mJoinSlot;
 };
 
 }
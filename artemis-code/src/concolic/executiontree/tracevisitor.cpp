@@ -54,36 +54,32 @@ void TraceVisitor::visit(TraceEndUnknown* node)         { visit(static_cast<Trac
 // Useful for checking the branch conditions in visitors which work on straight-line traces.
 bool TraceVisitor::isImmediatelyUnexplored(QSharedPointer<TraceNode> trace)
 {
-    return !trace.dynamicCast<TraceUnexplored>().isNull(); // Is there a more elegant way to do this?
+    return !trace.isNull() && trace->isUnexplored();
 }
 
 bool TraceVisitor::isImmediatelyUnsat(QSharedPointer<TraceNode> trace)
 {
-    return !trace.dynamicCast<TraceUnexploredUnsat>().isNull();
+    return TraceNode::hasKind(trace, TraceNode::UNEXPLORED_UNSAT);
 }
 
 bool TraceVisitor::isImmediatelyUnsolvable(QSharedPointer<TraceNode> trace)
 {
-    return !trace.dynamicCast<TraceUnexploredUnsolvable>().isNull();
+    return TraceNode::hasKind(trace, TraceNode::UNEXPLORED_UNSOLVABLE);
 }
 
 bool TraceVisitor::isImmediatelyMissed(QSharedPointer<TraceNode> trace)
 {
-    return !trace.dynamicCast<TraceUnexploredMissed>().isNull();
+    return TraceNode::hasKind(trace, TraceNode::UNEXPLORED_MISSED);
 }
 
 bool TraceVisitor::isImmediatelyQueued(QSharedPointer<TraceNode> trace)
 {
-    return !trace.dynamicCast<TraceUnexploredQueued>().isNull();
+    return TraceNode::hasKind(trace, TraceNode::UNEXPLORED_QUEUED);
 }
 
 bool TraceVisitor::isImmediatelyNotAttempted(QSharedPointer<TraceNode> trace)
 {
-    return isImmediatelyUnexplored(trace) &&
-            !isImmediatelyUnsat(trace) &&
-            !isImmediatelyUnsolvable(trace) &&
-            !isImmediatelyMissed(trace) &&
-            !isImmediatelyQueued(trace);
+    return TraceNode::hasKind(trace, TraceNode::UNEXPLORED);
 }
 
 
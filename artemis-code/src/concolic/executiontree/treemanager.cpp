@@ -21,6 +21,11 @@
 namespace artemis
 {
 
+TreeManager::TreeManager()
+    : mTreeLog(ExecutionTreeLogPtr())
+{
+}
+
 bool TreeManager::isUnexplored(ExplorationDescriptor target)
 {
     return TraceVisitor::isImmediatelyUnexplored(targetRoot(target));
@@ -57,6 +62,15 @@ void TreeManager::markExplorationIndex(ExplorationDescriptor target, uint index)
     assert(!target.branch.isNull());
 
     target.branch->markExploration(index, target.branchDirection);
+
+    if (!mTreeLog.isNull()) {
+        mTreeLog->logExplorationIndex(target, index);
+    }
+}
+
+void TreeManager::setTreeLog(ExecutionTreeLogPtr treeLog)
+{
+    mTreeLog = treeLog;
 }
 
 TraceNodePtr TreeManager::targetRoot(ExplorationDescriptor target)
@@ -76,9 +90,13 @@ void TreeManager::setTargetBranch(ExplorationDescriptor target, TraceNodePtr new
     assert(isQueuedOrNotAttempted(target)); // Sanity check for the calling code; not required here.
 
     if (target.branchDirection) {
-        return target.branch->setTrueBranch(newBranch);
+        target.branch->setTrueBranch(newBranch);
     } else {
-        return target.branch->setFalseBranch(newBranch);
+        target.branch->setFalseBranch(newBranch);
+    }
+
+    if (!mTreeLog.isNull()) {
+        mTreeLog->logJoin(target.branch, target.branchDirection ? 1 : 0, newBranch);
     }
 }
 
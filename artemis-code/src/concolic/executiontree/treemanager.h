@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <QSharedPointer>
+
 #include "concolic/search/explorationdescriptor.h"
 #include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/executiontreelog.h"
 
 #ifndef TREEMANAGER_H
 #define TREEMANAGER_H
@@ -27,24 +30,32 @@ namespace artemis
 class TreeManager
 {
 public:
+    TreeManager();
 
     // Returns true if the node is not attempted, UNSAT, unsolvable, or missed.
     static bool isUnexplored(ExplorationDescriptor target);
     // Returns true if the node has not yet been attempted (UNSAT etc. return false).
     static bool isQueuedOrNotAttempted(ExplorationDescriptor target);
 
-    static void markNodeUnsat(ExplorationDescriptor target);
-    static void markNodeUnsolvable(ExplorationDescriptor target);
-    static void markNodeMissed(ExplorationDescriptor target);
-    static void markNodeQueued(ExplorationDescriptor target);
+    void markNodeUnsat(ExplorationDescriptor target);
+    void markNodeUnsolvable(ExplorationDescriptor target);
+    void markNodeMissed(ExplorationDescriptor target);
+    void markNodeQueued(ExplorationDescriptor target);
+
+    void markExplorationIndex(ExplorationDescriptor target, uint index);
 
-    static void markExplorationIndex(ExplorationDescriptor target, uint index);
+    // If set, the markings above are also written to the log.
+    void setTreeLog(ExecutionTreeLogPtr treeLog);
 
 protected:
     static TraceNodePtr targetRoot(ExplorationDescriptor target);
-    static void setTargetBranch(ExplorationDescriptor target, TraceNodePtr newBranch);
+    void setTargetBranch(ExplorationDescriptor target, TraceNodePtr newBranch);
+
+    ExecutionTreeLogPtr mTreeLog;
 };
 
+typedef QSharedPointer<TreeManager> TreeManagerPtr;
+
 
 } //namespace artemis
 #endif // TREEMANAGER_H
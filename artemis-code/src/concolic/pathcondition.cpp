@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <sstream>
 #include <QDebug>
+#include <QStack>
 
 #include "concolic/solver/expressionprinter.h"
 #include "concolic/solver/expressionvalueprinter.h"
@@ -39,74 +40,77 @@ PathCondition::PathCondition()
  */
 PathConditionPtr PathCondition::createFromTrace(TraceNodePtr trace)
 {
-    BranchCheckingVisitor branchFinder;
+    // Walks the trace with an explicit stack, as traces can be too deep to recurse over.
+    // Children are pushed in reverse so they are visited in the same order as a recursive pre-order walk.
+    PathBranchList branches;
+    QStack<TraceNode*> pending;
 
     if (!trace.isNull()) {
-        trace->accept(&branchFinder);
+        pending.push(trace.data());
     }
 
-    return createFromBranchList(branchFinder.mBranches);
-}
+    while (!pending.isEmpty()) {
+        TraceNode* node = pending.pop();
 
-QSharedPointer<PathCondition> PathCondition::createFromBranchList(PathBranchList branches)
-{
-    // In order to make a best-effort at searching for a new node, we simply ignore the conditions of branches which are known to be unsolvable.
-    PathConditionPtr pc = PathConditionPtr(new PathCondition);
-    foreach(PathBranch br, branches) {
-        if(!br.first->isDifficult()) {
-            pc->addCondition(br.first->getSymbolicCondition(), br.second, br.first);
+        switch (node->getKind()) {
+
+        case TraceNode::SYMBOLIC_BRANCH: {
+            TraceSymbolicBranch* branch = static_cast<TraceSymbolicBranch*>(node);
+            bool outcome = TraceVisitor::isImmediatelyUnexplored(branch->getFalseBranch());
+            branches.append(PathBranch(branch, outcome));
+
+            pending.push(outcome ? branch->getTrueBranch().data() : branch->getFalseBranch().data());
+            break;
         }
-    }
-    return pc;
-}
 
-void PathCondition::BranchCheckingVisitor::visit(TraceNode* node)
-{
-    // We should not fall back to this node, this indicates that we are missing a case
-    qWarning("Warning: TraceNode catch-all reached, this should not happen");
-    exit(1);
-}
+        case TraceNode::CONCRETE_BRANCH: {
+            // Ignore the concrete branches
+            TraceConcreteBranch* branch = static_cast<TraceConcreteBranch*>(node);
+            pending.push(branch->getFalseBranch().data());
+            pending.push(branch->getTrueBranch().data());
+            break;
+        }
 
-void PathCondition::BranchCheckingVisitor::visit(TraceSymbolicBranch* node)
-{
-    bool outcome = TraceVisitor::isImmediatelyUnexplored(node->getFalseBranch());
-    mBranches.append(PathBranch(node, outcome));
+        case TraceNode::CONCRETE_SUMMARISATION: {
+            // Ignore concrete summaries.
+            TraceConcreteSummarisation* summary = static_cast<TraceConcreteSummarisation*>(node);
+            for (int i = summary->executions.size() - 1; i >= 0; i--) {
+                pending.push(summary->executions.at(i).second.data());
+            }
+            break;
+        }
 
-    if (outcome) {
-        node->getTrueBranch()->accept(this);
-    } else {
-        node->getFalseBranch()->accept(this);
+        default:
+            if (node->isAnnotation()) {
+                pending.push(static_cast<TraceAnnotation*>(node)->next.data());
+            }
+            // Ignore unexplored and end nodes
+            break;
+        }
     }
-}
 
-void PathCondition::BranchCheckingVisitor::visit(TraceUnexplored* node)
-{
-    // Ignore
-}
-
-void PathCondition::BranchCheckingVisitor::visit(TraceAnnotation* node)
-{
-    node->next->accept(this);
+    return createFromBranchList(branches);
 }
 
-void PathCondition::BranchCheckingVisitor::visit(TraceConcreteSummarisation *node)
+QSharedPointer<PathCondition> PathCondition::withoutDifficultBranches()
 {
-    // Ignore concrete summaries.
-    foreach(TraceConcreteSummarisation::SingleExecution execution, node->executions) {
-        execution.second->accept(this);
+    PathBranchList branches;
+    for (int i = 0; i < mConditions.size(); i++) {
+        branches.append(PathBranch(mConditions.at(i).second, mConditions.at(i).first.second));
     }
+    return createFromBranchList(branches);
 }
 
-void PathCondition::BranchCheckingVisitor::visit(TraceConcreteBranch *node)
-{
-    // Ignore the concrete branches
-    node->getTrueBranch()->accept(this);
-    node->getFalseBranch()->accept(this);
-}
-
-void PathCondition::BranchCheckingVisitor::visit(TraceEnd* node)
+QSharedPointer<PathCondition> PathCondition::createFromBranchList(PathBranchList branches)
 {
-    // Ignore the end node
+    // In order to make a best-effort at searching for a new node, we simply ignore the conditions of branches which are known to be unsolvable.
+    PathConditionPtr pc = PathConditionPtr(new PathCondition);
+    foreach(PathBranch br, branches) {
+        if(!br.first->isDifficult()) {
+            pc->addCondition(br.first->getSymbolicCondition(), br.second, br.first);
+        }
+    }
+    return pc;
 }
 
 void PathCondition::addCondition(Symbolic::Expression* condition, bool outcome, TraceSymbolicBranch* branch)
@@ -23,7 +23,6 @@
 #include "JavaScriptCore/symbolic/expr.h"
 
 #include "concolic/executiontree/tracenodes.h"
-#include "concolic/executiontree/tracevisitor.h"
 
 #ifndef PATHCONDITION_H
 #define PATHCONDITION_H
@@ -41,6 +40,9 @@ public:
 
     static QSharedPointer<PathCondition> createFromBranchList(QList<QPair<TraceSymbolicBranch*, bool> > branches);
 
+    // Rebuilds this PC without the branches which have been marked as difficult since it was created.
+    QSharedPointer<PathCondition> withoutDifficultBranches();
+
     const QPair<Symbolic::Expression*, bool> get(int index);
     TraceSymbolicBranch* getBranch(int index);
     uint size();
@@ -56,20 +58,6 @@ public:
 
 private:
     QList<QPair<QPair<Symbolic::Expression*, bool>, TraceSymbolicBranch*> > mConditions;
-
-    class BranchCheckingVisitor : public TraceVisitor
-    {
-    public:
-        void visit(TraceNode* node);
-        void visit(TraceConcreteBranch* node);
-        void visit(TraceSymbolicBranch* node);
-        void visit(TraceUnexplored* node);
-        void visit(TraceAnnotation* node);
-        void visit(TraceConcreteSummarisation* node);
-        void visit(TraceEnd* node);
-
-        QList<QPair<TraceSymbolicBranch*, bool> > mBranches;
-    };
 };
 
 typedef QSharedPointer<PathCondition> PathConditionPtr;
@@ -89,7 +89,7 @@ QPair<QPair<uint, uint>, bool> AvoidUnsatSelector::getId(TraceBranch* node, bool
     QPair<QPair<uint, uint>, bool> id;
 
     // id representing the source and the line number within the source
-    id.first.first = SourceInfo::getId(node->getSource()->getUrl(), node->getSource()->getStartLine());
+    id.first.first = SourceInfo::getId(node->getSource());
 
     // representing the offset
     id.first.second = node->getSourceOffset();
@@ -16,14 +16,18 @@
 
 #include "randomaccesssearch.h"
 #include <assert.h>
+#include <QStack>
+#include "concolic/executiontree/treemanager.h"
 
 namespace artemis {
 
-RandomAccessSearch::RandomAccessSearch(TraceNodePtr tree, AbstractSelectorPtr selector, uint searchBudget) :
+RandomAccessSearch::RandomAccessSearch(TraceNodePtr tree, TreeManagerPtr treeManager, AbstractSelectorPtr selector, uint searchBudget) :
     mTree(tree),
+    mTreeManager(treeManager),
     mSelector(selector),
     mBudget(searchBudget),
     mUnlimitedBudget(searchBudget == 0),
+    mBudgetUsed(0),
     mNotifiedFirstTrace(false)
 {
 }
@@ -37,11 +41,11 @@ bool RandomAccessSearch::chooseNextTarget()
     }
 
     // If the budget is exhausted, the search is over.
-    if(!(mUnlimitedBudget || mBudget > 0)) {
+    if(!(mUnlimitedBudget || mBudgetUsed < mBudget)) {
         mTarget = ExplorationDescriptor();
         return false;
     }
-    mBudget--;
+    mBudgetUsed++;
 
     // Call analyseTree to get the set of possible explorations.
     analyseTree();
@@ -130,6 +134,16 @@ ExplorationDescriptor RandomAccessSearch::getTargetDescriptor()
     return mTarget;
 }
 
+uint RandomAccessSearch::getBudgetUsed()
+{
+    return mBudgetUsed;
+}
+
+void RandomAccessSearch::setBudgetUsed(uint budgetUsed)
+{
+    mBudgetUsed = budgetUsed;
+}
+
 
 // Analyse the tree and set the following:
 // mPossibleExplorations, mBranchParents, mMarkerParents, mBranchParentMarkers
@@ -140,171 +154,138 @@ void RandomAccessSearch::analyseTree()
     mMarkerParents.clear();
     mBranchParentMarkers.clear();
 
-    mCurrentBranchParent = TraceSymbolicBranchPtr();
-    // mCurrentBranchParentDirection
-    mCurrentMarkerParent = TraceMarkerPtr();
-    mCurrentSymbolicDepth = 0;
+    QStack<AnalyseItem> pending;
+    AnalyseItem root = {mTree, TraceSymbolicBranchPtr(), false, TraceMarkerPtr(), 0};
+    pending.push(root);
 
-    // All calls to the visitor must go through analyseNode, so that mThisNode is always valid.
-    analyseNode(mTree);
-}
-
-void RandomAccessSearch::analyseNode(TraceNodePtr node)
-{
-    mThisNode = node;
-    node->accept(this);
-}
-
-
-// Called whenever a new trace (suffix) is added to the tree.
-void RandomAccessSearch::slNewTraceAdded(TraceNodePtr parent, int direction, TraceNodePtr suffix, TraceNodePtr fullTrace)
-{
-    mSelector->newTraceAdded(parent, direction, suffix, fullTrace);
-}
+    while (!pending.isEmpty()) {
+        AnalyseItem item = pending.pop();
 
+        if (item.node.isNull()) {
+            addTarget(item.branchParent, item.branchParentDirection, item.symbolicDepth);
+            continue;
+        }
 
+        switch (item.node->getKind()) {
 
+        case TraceNode::CONCRETE_BRANCH: {
+            // Just continue on both children, the false branch first.
+            TraceBranchPtr branch = item.node.staticCast<TraceBranch>();
 
+            AnalyseItem trueItem = item;
+            trueItem.node = branch->getTrueBranch();
+            pending.push(trueItem);
 
-// The visitor part, used to analyse the full tree.
+            AnalyseItem falseItem = item;
+            falseItem.node = branch->getFalseBranch();
+            pending.push(falseItem);
+            break;
+        }
 
-void RandomAccessSearch::visit(TraceNode *node)
-{
-    Log::fatal("Error: Reached a node of unknown type while searching the tree (RandomAccessSearch).");
-    exit(1);
-}
+        case TraceNode::SYMBOLIC_BRANCH: {
+            TraceSymbolicBranchPtr branch = item.node.staticCast<TraceSymbolicBranch>();
+
+            // Update the tables.
+            mBranchParents.insert(branch, QPair<TraceSymbolicBranchPtr, bool>(item.branchParent, item.branchParentDirection));
+            mBranchParentMarkers.insert(branch, item.markerParent);
+
+            // If either child is unexplored, this is a new exploration target.
+            // Otherwise, analyse the children.
+            AnalyseItem trueItem = {branch->getTrueBranch(), branch, true, item.markerParent, item.symbolicDepth + 1};
+            if (TraceVisitor::isImmediatelyNotAttempted(trueItem.node)) {
+                trueItem.node = TraceNodePtr();
+            }
+            pending.push(trueItem);
+
+            AnalyseItem falseItem = {branch->getFalseBranch(), branch, false, item.markerParent, item.symbolicDepth + 1};
+            if (TraceVisitor::isImmediatelyNotAttempted(falseItem.node)) {
+                falseItem.node = TraceNodePtr();
+            }
+            pending.push(falseItem);
+            break;
+        }
 
-void RandomAccessSearch::visit(TraceConcreteBranch *node)
-{
-    // Just recurse on both children.
+        case TraceNode::CONCRETE_SUMMARISATION: {
+            // Just continue on all children, in order.
+            TraceConcreteSummarisationPtr summary = item.node.staticCast<TraceConcreteSummarisation>();
 
-    // But reset the visitor state correctly for the second one.
-    TraceSymbolicBranchPtr currentBranchParent = mCurrentBranchParent;
-    bool currentBranchParentDirection = mCurrentBranchParentDirection;
-    TraceMarkerPtr currentMarkerParent = mCurrentMarkerParent;
-    unsigned int currentSymbolicDepth = mCurrentSymbolicDepth;
+            for (int i = summary->executions.size() - 1; i >= 0; i--) {
+                AnalyseItem executionItem = item;
+                executionItem.node = summary->executions.at(i).second;
+                pending.push(executionItem);
+            }
+            break;
+        }
 
-    analyseNode(node->getFalseBranch());
+        case TraceNode::MARKER: {
+            TraceMarkerPtr marker = item.node.staticCast<TraceMarker>();
 
-    mCurrentBranchParent = currentBranchParent;
-    mCurrentBranchParentDirection = currentBranchParentDirection;
-    mCurrentMarkerParent = currentMarkerParent;
-    mCurrentSymbolicDepth = currentSymbolicDepth;
+            // Update the tables
+            mMarkerParents.insert(marker, item.markerParent);
 
-    analyseNode(node->getTrueBranch());
-}
+            // Continue
+            AnalyseItem nextItem = item;
+            nextItem.node = marker->next;
+            nextItem.markerParent = marker;
+            pending.push(nextItem);
+            break;
+        }
 
-void RandomAccessSearch::visit(TraceSymbolicBranch *node)
-{
-    TraceSymbolicBranchPtr thisSymBranch = mThisNode.dynamicCast<TraceSymbolicBranch>();
-    assert(!thisSymBranch.isNull());
-
-    // Keep the current marker parent so we can reset it correctly for both branches.
-    TraceMarkerPtr currentMarkerParent = mCurrentMarkerParent;
-    unsigned int currentSymbolicDepth = mCurrentSymbolicDepth + 1;
-
-    // Update the tables.
-    QPair<TraceSymbolicBranchPtr, bool> parent = QPair<TraceSymbolicBranchPtr, bool>(mCurrentBranchParent, mCurrentBranchParentDirection);
-    mBranchParents.insert(thisSymBranch, parent);
-    mBranchParentMarkers.insert(thisSymBranch, mCurrentMarkerParent);
-
-    // If either child is unexplored, this is a new exploration target.
-    // Otherwise, analyse the children.
-    if (isImmediatelyNotAttempted(node->getFalseBranch())) {
-        ExplorationDescriptor explore;
-        explore.branch = thisSymBranch;
-        explore.branchDirection = false;
-        explore.symbolicDepth = currentSymbolicDepth;
-
-        // If this node is difficult, replace the unexplored child with CNS and ignore it.
-        if (node->isDifficult()) {
-            node->setFalseBranch(TraceUnexploredUnsolvable::getInstance());
-            mSelector->newUnsolvable(explore);
-        } else {
-            // Otherwise, add it to the exploration list.
-            mPossibleExplorations.append(explore);
+        case TraceNode::ALERT:
+        case TraceNode::DOM_MODIFICATION:
+        case TraceNode::PAGE_LOAD:
+        case TraceNode::FUNCTION_CALL: {
+            // Ignore and continue.
+            AnalyseItem nextItem = item;
+            nextItem.node = item.node.staticCast<TraceAnnotation>()->next;
+            pending.push(nextItem);
+            break;
         }
-    } else {
-        mCurrentBranchParent = thisSymBranch;
-        mCurrentBranchParentDirection = false;
-        mCurrentMarkerParent = currentMarkerParent;
-        mCurrentSymbolicDepth = currentSymbolicDepth;
-        analyseNode(node->getFalseBranch());
-    }
 
-    if (isImmediatelyNotAttempted(node->getTrueBranch())) {
-        ExplorationDescriptor explore;
-        explore.branch = thisSymBranch;
-        explore.branchDirection = true;
-        explore.symbolicDepth = currentSymbolicDepth;
-
-        // If this node is difficult, replace the unexplored child with CNS and ignore it.
-        if (node->isDifficult()) {
-            node->setTrueBranch(TraceUnexploredUnsolvable::getInstance());
-            mSelector->newUnsolvable(explore);
-        } else {
-            // Otherwise, add it to the exploration list.
-            mPossibleExplorations.append(explore);
+        case TraceNode::UNEXPLORED:
+        case TraceNode::UNEXPLORED_UNSAT:
+        case TraceNode::UNEXPLORED_UNSOLVABLE:
+        case TraceNode::UNEXPLORED_MISSED:
+        case TraceNode::UNEXPLORED_QUEUED:
+            // All types of unexplored node are ignored.
+            // Possible explorations are added to the list by their parent branch and are not visited.
+            break;
+
+        case TraceNode::END_SUCCESS:
+        case TraceNode::END_FAILURE:
+        case TraceNode::END_UNKNOWN:
+            // Ignore.
+            break;
+
+        default:
+            Log::fatal("Error: Reached a node of unknown type while searching the tree (RandomAccessSearch).");
+            exit(1);
         }
-    } else {
-        mCurrentBranchParent = thisSymBranch;
-        mCurrentBranchParentDirection = true;
-        mCurrentMarkerParent = currentMarkerParent;
-        mCurrentSymbolicDepth = currentSymbolicDepth;
-        analyseNode(node->getTrueBranch());
     }
-
 }
 
-void RandomAccessSearch::visit(TraceConcreteSummarisation *node)
+void RandomAccessSearch::addTarget(TraceSymbolicBranchPtr branch, bool direction, uint symbolicDepth)
 {
-    // Just recurse on all children.
-
-    // But reset the visitor state correctly for the second one.
-    TraceSymbolicBranchPtr currentBranchParent = mCurrentBranchParent;
-    bool currentBranchParentDirection = mCurrentBranchParentDirection;
-    TraceMarkerPtr currentMarkerParent = mCurrentMarkerParent;
-    unsigned int currentSymbolicDepth = mCurrentSymbolicDepth;
-
-    foreach(TraceConcreteSummarisation::SingleExecution ex, node->executions) {
-        mCurrentBranchParent = currentBranchParent;
-        mCurrentBranchParentDirection = currentBranchParentDirection;
-        mCurrentMarkerParent = currentMarkerParent;
-        mCurrentSymbolicDepth = currentSymbolicDepth;
-
-        analyseNode(ex.second);
+    ExplorationDescriptor explore;
+    explore.branch = branch;
+    explore.branchDirection = direction;
+    explore.symbolicDepth = symbolicDepth;
+
+    // If this node is difficult, replace the unexplored child with CNS and ignore it.
+    if (branch->isDifficult()) {
+        mTreeManager->markNodeUnsolvable(explore);
+        mSelector->newUnsolvable(explore);
+    } else {
+        // Otherwise, add it to the exploration list.
+        mPossibleExplorations.append(explore);
     }
 }
 
-void RandomAccessSearch::visit(TraceMarker *node)
-{
-    TraceMarkerPtr thisMarker = mThisNode.dynamicCast<TraceMarker>();
-    assert(!thisMarker.isNull());
-
-    // Update the tables
-    mMarkerParents.insert(thisMarker, mCurrentMarkerParent);
-
-    // Continue
-    mCurrentMarkerParent = thisMarker;
-
-    analyseNode(node->next);
-}
-
-void RandomAccessSearch::visit(TraceUnexplored *node)
-{
-    // All types of unexplored node are ignored.
-    // Possible explorations are aded to the list by their parent branch and are not visited.
-}
-
-void RandomAccessSearch::visit(TraceAnnotation *node)
-{
-    // Ignore and continue.
-    analyseNode(node->next);
-}
 
-void RandomAccessSearch::visit(TraceEnd *node)
+// Called whenever a new trace (suffix) is added to the tree.
+void RandomAccessSearch::slNewTraceAdded(TraceNodePtr parent, int direction, TraceNodePtr suffix, TraceNodePtr fullTrace)
 {
-    // Ignore.
+    mSelector->newTraceAdded(parent, direction, suffix, fullTrace);
 }
 
 
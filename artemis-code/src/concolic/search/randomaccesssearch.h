@@ -23,6 +23,7 @@
 #include "search.h"
 #include "explorationdescriptor.h"
 #include "abstractselector.h"
+#include "concolic/executiontree/treemanager.h"
 
 namespace artemis
 {
@@ -42,7 +43,7 @@ class RandomAccessSearch : public QObject, public TreeSearch
     Q_OBJECT
 
 public:
-    RandomAccessSearch(TraceNodePtr tree, AbstractSelectorPtr selector, uint searchBudget);
+    RandomAccessSearch(TraceNodePtr tree, TreeManagerPtr treeManager, AbstractSelectorPtr selector, uint searchBudget);
 
     bool chooseNextTarget();
 
@@ -50,6 +51,11 @@ public:
     QSet<SelectRestriction> getTargetDomConstraints();
     ExplorationDescriptor getTargetDescriptor();
 
+    // The number of search attempts made so far. Restoring it lets a resumed session continue with the budget which
+    // is left.
+    uint getBudgetUsed();
+    void setBudgetUsed(uint budgetUsed);
+
 
 public slots:
     void slNewTraceAdded(TraceNodePtr parent, int direction, TraceNodePtr suffix, TraceNodePtr fullTrace);
@@ -58,12 +64,16 @@ private:
     // The tree
     TraceNodePtr mTree;
 
+    // Marks the difficult targets which are not searched.
+    TreeManagerPtr mTreeManager;
+
     // The selector
     AbstractSelectorPtr mSelector;
 
-    // The number of search attempts this class is allowed to make.
+    // The number of search attempts this class is allowed to make, and has made.
     uint mBudget;
     bool mUnlimitedBudget;
+    uint mBudgetUsed;
 
     // After a call to chooseNextTarget (which returned true), these hold the current state of the search position.
     ExplorationDescriptor mTarget;
@@ -87,13 +97,19 @@ private:
     // Alternatively, we could just analyse all of the possible exploration targets from the previous call.
     void analyseTree();
 
-    // Temp variables used by the visitors.
-    TraceSymbolicBranchPtr mCurrentBranchParent;
-    bool mCurrentBranchParentDirection;
-    TraceMarkerPtr mCurrentMarkerParent;
-    unsigned int mCurrentSymbolicDepth;
-    TraceNodePtr mThisNode; // Tracks a smart pointer vaersion of 'this' throughout the visitor.
-    void analyseNode(TraceNodePtr node);
+    // A pending step of analyseTree, which walks the tree with an explicit stack as it can be too deep to recurse
+    // over. An item either analyses a node, given the nearest symbolic branch and marker above it, or (if node is
+    // null) adds branchParent in branchParentDirection as an exploration target. Targets are deferred so they are
+    // listed in walk order, false branches before true branches.
+    struct AnalyseItem {
+        TraceNodePtr node;
+        TraceSymbolicBranchPtr branchParent;
+        bool branchParentDirection;
+        TraceMarkerPtr markerParent;
+        uint symbolicDepth;
+    };
+
+    void addTarget(TraceSymbolicBranchPtr branch, bool direction, uint symbolicDepth);
 
     // Helpers for chooseNextTarget
     PathConditionPtr calculatePC(ExplorationDescriptor target);
@@ -101,19 +117,6 @@ private:
 
     // Whether we have notified about the initial tree yet.
     bool mNotifiedFirstTrace;
-
-
-    // The visitor part.
-    // Should only be called by analyseTree().
-    void visit(TraceNode* node);
-    void visit(TraceConcreteBranch* node);
-    void visit(TraceSymbolicBranch* node);
-    void visit(TraceConcreteSummarisation *node);
-    void visit(TraceMarker* node);
-    void visit(TraceUnexplored* node);
-    void visit(TraceAnnotation* node);
-    void visit(TraceEnd* node);
-
 };
 
 } //namespace artemis
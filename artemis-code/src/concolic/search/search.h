@@ -34,9 +34,11 @@ namespace artemis
  */
 
 
-class TreeSearch : public TraceVisitor
+class TreeSearch
 {
 public:
+    virtual ~TreeSearch() {}
+
     // Selects an unexplored node from the tree to be explored next.
     // Returns true iff a target was found.
     virtual bool chooseNextTarget() = 0;
@@ -26,15 +26,17 @@ namespace artemis
 
 
 
-DepthFirstSearch::DepthFirstSearch(TraceNodePtr tree, unsigned int depthLimit, unsigned int restartLimit) :
+DepthFirstSearch::DepthFirstSearch(TraceNodePtr tree, TreeManagerPtr treeManager, unsigned int depthLimit, unsigned int restartLimit) :
     mTree(tree),
+    mTreeManager(treeManager),
     mDepthLimit(depthLimit),
     mInitialDepthLimit(depthLimit),
     mCurrentDepth(0),
     mRestartsRemaining(restartLimit),
     mUnlimitedRestarts(restartLimit == 0),
     mPreviousPassFoundTarget(false),
-    mIsPreviousRun(false)
+    mIsPreviousRun(false),
+    mPreviousParent(NULL)
 {
     mCurrentDomConstraints = QSet<SelectRestriction>();
 }
@@ -76,7 +78,7 @@ bool DepthFirstSearch::chooseNextTarget()
         // The depth, PC, etc. are all already set from the previous call.
 
 
-        if(isImmediatelyUnexplored(current)){
+        if(TraceVisitor::isImmediatelyUnexplored(current)){
             // Then the previous run did not reach the intended target.
             // Use the same method as continueFromLeaf() to jump to the next node to be searched.
             // If the parent stack is empty here, then we have reached the end of the search.
@@ -93,13 +95,13 @@ bool DepthFirstSearch::chooseNextTarget()
         current = mTree;
     }
 
-    // Call the visitor to continue the search.
-    current->accept(this);
+    // Continue the search.
+    search(current);
 
     // Future runs should continue wherever we left off.
     mIsPreviousRun = true;
 
-    // The visitor will set its own "output" in mCurrentPC.
+    // The search will set its own "output" in mCurrentPC.
     // This function returns whether we reached the end of the iteration or not.
     if(mFoundTarget) {
         mPreviousPassFoundTarget = true;
@@ -134,7 +136,7 @@ ExplorationDescriptor DepthFirstSearch::getTargetDescriptor()
     // However we know that mPreviousParent must be a pointer to a TraceSymbolicBranch instance at the time when this
     // method is called. It can only be TraceConcreteBranch during the intermediate part of the search.
 
-    TraceSymbolicBranch* parent = dynamic_cast<TraceSymbolicBranch*>(mPreviousParent);
+    TraceSymbolicBranch* parent = getPreviousSymbolicParent();
     assert(parent); // N.B. This assertion could fail with certain impossible-to-generate tree structures, where a concrete branch is not immediately unexplored but also does not lead to a symbolic branch before being unexplored (i.e. a partial trace under a concrete branch).
 
     return getCurrentExplorationDescriptor(parent);
@@ -161,6 +163,22 @@ void DepthFirstSearch::restartSearch()
     mCurrentDomConstraints = QSet<SelectRestriction>();
 }
 
+// The pass at the given depth starts over from the beginning of the tree, so targets which were queued when the
+// previous session stopped are found again.
+void DepthFirstSearch::resumeAtDepthLimit(unsigned int depth)
+{
+    if (depth > mInitialDepthLimit && mInitialDepthLimit > 0 && !mUnlimitedRestarts) {
+        unsigned int restartsUsed = (depth - mInitialDepthLimit) / mInitialDepthLimit;
+        mRestartsRemaining = restartsUsed < mRestartsRemaining ? mRestartsRemaining - restartsUsed : 0;
+    }
+
+    setDepthLimit(depth);
+    restartSearch();
+
+    // The earlier passes did find targets, or the search would not have deepened.
+    mPreviousPassFoundTarget = depth > mInitialDepthLimit;
+}
+
 // Increase the depth limit and restart.
 bool DepthFirstSearch::deepenRestartAndChoose()
 {
@@ -183,159 +201,162 @@ bool DepthFirstSearch::deepenRestartAndChoose()
 
 
 
-// The visitor part of this class preforms the actual searching.
-// Note at any point where the search stops (i.e. there is no call to accept(this) or continueFromLeaf()) then
-// we MUST set mFoundTarget appropriately! (This includes in the body of continueFromLeaf().)
+// The search walks the tree one node at a time. step() handles a single node and returns the next node to visit, so
+// the search runs in constant stack space however deep the tree is.
+// Note at any point where the search stops (i.e. step() returns NULL) then we MUST set mFoundTarget appropriately!
+// (This includes in the body of continueFromLeaf().)
 
-void DepthFirstSearch::visit(TraceNode *node)
+void DepthFirstSearch::search(TraceNodePtr start)
 {
-    Log::fatal("Error: Reached a node of unknown type while searching the tree (DFS).");
-    exit(1);
+    TraceNode* node = start.data();
+    while (node != NULL) {
+        node = step(node);
+    }
 }
 
-void DepthFirstSearch::visit(TraceConcreteBranch *node)
+TraceNode* DepthFirstSearch::step(TraceNode* node)
 {
-    // Concrete branches are basically ignored by this search.
-    // If there are unexplored nodes as children of a concrete branch, then we ignore them and only search through children of symbolic branches.
+    switch (node->getKind()) {
 
-    if(isImmediatelyUnexplored(node->getFalseBranch()) && isImmediatelyUnexplored(node->getTrueBranch())){
-        Log::fatal("Reached a branch where both branches are unexplored during search.");
-        exit(1);
+    case TraceNode::CONCRETE_BRANCH: {
+        // Concrete branches are basically ignored by this search.
+        // If there are unexplored nodes as children of a concrete branch, then we ignore them and only search through children of symbolic branches.
+        TraceBranch* branch = static_cast<TraceBranch*>(node);
 
-    }else if(isImmediatelyUnexplored(node->getFalseBranch())){
-        // Then we treat this node as a pass-through to the 'true' subtree
-        node->getTrueBranch()->accept(this);
+        if(TraceVisitor::isImmediatelyUnexplored(branch->getFalseBranch()) && TraceVisitor::isImmediatelyUnexplored(branch->getTrueBranch())){
+            Log::fatal("Reached a branch where both branches are unexplored during search.");
+            exit(1);
 
-    }else if(isImmediatelyUnexplored(node->getTrueBranch())){
-        // Then we treat this node as a pass-through to the 'false' subtree
-        node->getFalseBranch()->accept(this);
+        }else if(TraceVisitor::isImmediatelyUnexplored(branch->getFalseBranch())){
+            // Then we treat this node as a pass-through to the 'true' subtree
+            return branch->getTrueBranch().data();
 
-    }else{
-        // Both branches are explored, so we must search each in turn.
-        mParentStack.push(SavedPosition(node, mCurrentDepth, mCurrentPC, mCurrentDomConstraints));
-        //mCurrentDepth++; // Do not increase depth for concrete branches.
-        mPreviousParent = node;
-        mPreviousDirection = false; // We are always taking the false branch to begin with.
-        node->getFalseBranch()->accept(this);
-    }
-}
+        }else if(TraceVisitor::isImmediatelyUnexplored(branch->getTrueBranch())){
+            // Then we treat this node as a pass-through to the 'false' subtree
+            return branch->getFalseBranch().data();
 
-void DepthFirstSearch::visit(TraceSymbolicBranch *node)
-{
-    // At a branch, we explore only the 'false' subtree.
-    // Once we reach a leaf, the parent stack is used to return to branches and explore their 'true' children (see continueFromLeaf()).
-    // This allows us to stop the search once we find a node we would like to explore.
-    // The depth limit is also enforced here.
-    if(mCurrentDepth < mDepthLimit){
-        mParentStack.push(SavedPosition(node, mCurrentDepth, mCurrentPC, mCurrentDomConstraints));
-        mCurrentDepth++;
-        mPreviousParent = node;
-        mPreviousDirection = false;
-        mCurrentPC.append(PathBranch(node, false)); // We are always taking the false branch here.
-        node->getFalseBranch()->accept(this);
-    }else{
-        continueFromLeaf();
+        }else{
+            // Both branches are explored, so we must search each in turn.
+            mParentStack.push(SavedPosition(branch, mCurrentDepth, mCurrentPC, mCurrentDomConstraints));
+            //mCurrentDepth++; // Do not increase depth for concrete branches.
+            mPreviousParent = branch;
+            mPreviousDirection = false; // We are always taking the false branch to begin with.
+            return branch->getFalseBranch().data();
+        }
     }
-}
 
-void DepthFirstSearch::visit(TraceConcreteSummarisation *node)
-{
-    // If this node has only one execution path then it is just an annotation and we pass over it.
-    if(node->executions.length() == 1) {
-        node->executions[0].second->accept(this);
-        return;
+    case TraceNode::SYMBOLIC_BRANCH: {
+        // At a branch, we explore only the 'false' subtree.
+        // Once we reach a leaf, the parent stack is used to return to branches and explore their 'true' children (see continueFromLeaf()).
+        // This allows us to stop the search once we find a node we would like to explore.
+        // The depth limit is also enforced here.
+        TraceSymbolicBranch* branch = static_cast<TraceSymbolicBranch*>(node);
+
+        if(mCurrentDepth < mDepthLimit){
+            mParentStack.push(SavedPosition(branch, mCurrentDepth, mCurrentPC, mCurrentDomConstraints));
+            mCurrentDepth++;
+            mPreviousParent = branch;
+            mPreviousDirection = false;
+            mCurrentPC.append(PathBranch(branch, false)); // We are always taking the false branch here.
+            return branch->getFalseBranch().data();
+        }else{
+            return continueFromLeaf();
+        }
     }
 
-    // If there are multiple children, we must add this node to the parent stack so we can explore the rest.
-    // The depth limit is ignored for concrete branches.
-    if(node->executions.length() > 1) {
-        mParentStack.push(SavedPosition(node, mCurrentDepth, mCurrentPC, mCurrentDomConstraints, 1));
-        node->executions[0].second->accept(this);
-        // N.B. we do not update mPreviousParent or mPreviousDirection as these should not be used to refer to a
-        // concrete summarisation. They are used when we find an unexplored node and attempt to explore it and then
-        // need to work out where it used to be in the tree to see if we replaced it or not. Seeing as there must be a
-        // true branch node after a concrete summary before we can see an unexplored node these are not necessary here.
+    case TraceNode::CONCRETE_SUMMARISATION: {
+        TraceConcreteSummarisation* summary = static_cast<TraceConcreteSummarisation*>(node);
 
-    }
-}
+        // If this node has only one execution path then it is just an annotation and we pass over it.
+        if(summary->executions.length() == 1) {
+            return summary->executions[0].second.data();
+        }
 
-void DepthFirstSearch::visit(TraceMarker *node)
-{
-    // Markers may optionally contain some DOM constraints which need to be recorded.
-    if(node->isSelectRestriction) {
-        mCurrentDomConstraints.insert(node->selectRestriction);
-    }
-    node->next->accept(this);
-}
+        // If there are multiple children, we must add this node to the parent stack so we can explore the rest.
+        // The depth limit is ignored for concrete branches.
+        if(summary->executions.length() > 1) {
+            mParentStack.push(SavedPosition(summary, mCurrentDepth, mCurrentPC, mCurrentDomConstraints, 1));
+            // N.B. we do not update mPreviousParent or mPreviousDirection as these should not be used to refer to a
+            // concrete summarisation. They are used when we find an unexplored node and attempt to explore it and then
+            // need to work out where it used to be in the tree to see if we replaced it or not. Seeing as there must be a
+            // true branch node after a concrete summary before we can see an unexplored node these are not necessary here.
+            return summary->executions[0].second.data();
+        }
 
-void DepthFirstSearch::visit(TraceUnexplored *node)
-{
-    // If this is a direct child of a difficult branch, we should skip it without attempting to solve.
-    // This is NOT just an optimisation. The search should not return the direct children of difficult branches.
-    TraceSymbolicBranch* parent = dynamic_cast<TraceSymbolicBranch*>(mPreviousParent);
-
-    if (parent && parent->isDifficult()) {
-        TreeManager::markNodeUnsolvable(getCurrentExplorationDescriptor(parent));
-        continueFromLeaf();
-        return;
+        // A summary without executions is not built by the TraceBuilder, treat it as a leaf.
+        return continueFromLeaf();
     }
 
-    // When we reach an unexplored node, we want to return it.
-    // Stop the visitor. The PC to return is in mCurrentPC.
-    mFoundTarget = true;
-}
+    case TraceNode::MARKER: {
+        // Markers may optionally contain some DOM constraints which need to be recorded.
+        TraceMarker* marker = static_cast<TraceMarker*>(node);
+        if(marker->isSelectRestriction) {
+            mCurrentDomConstraints.insert(marker->selectRestriction);
+        }
+        return marker->next.data();
+    }
 
-void DepthFirstSearch::visit(TraceUnexploredMissed *node)
-{
-    // For now we will not re-try the same path again (as we don't have any way to generate a different injection).
-    continueFromLeaf();
-}
+    case TraceNode::ALERT:
+    case TraceNode::DOM_MODIFICATION:
+    case TraceNode::PAGE_LOAD:
+    case TraceNode::FUNCTION_CALL:
+        // Skip all annotations, which are only relevant to classification and not searching.
+        return static_cast<TraceAnnotation*>(node)->next.data();
+
+    case TraceNode::UNEXPLORED: {
+        // If this is a direct child of a difficult branch, we should skip it without attempting to solve.
+        // This is NOT just an optimisation. The search should not return the direct children of difficult branches.
+        TraceSymbolicBranch* parent = getPreviousSymbolicParent();
+
+        if (parent && parent->isDifficult()) {
+            mTreeManager->markNodeUnsolvable(getCurrentExplorationDescriptor(parent));
+            return continueFromLeaf();
+        }
 
-void DepthFirstSearch::visit(TraceUnexploredUnsat *node)
-{
-    // For now we will not re-try the same path again (as we don't have any way to generate a different injection).
-    continueFromLeaf();
-}
+        // When we reach an unexplored node, we want to return it.
+        // Stop the search. The PC to return is in mCurrentPC.
+        mFoundTarget = true;
+        return NULL;
+    }
 
-void DepthFirstSearch::visit(TraceUnexploredUnsolvable *node)
-{
-    // For now we will not re-try the same path again (as we don't have any way to generate a different injection).
-    continueFromLeaf();
-}
+    case TraceNode::UNEXPLORED_MISSED:
+    case TraceNode::UNEXPLORED_UNSAT:
+    case TraceNode::UNEXPLORED_UNSOLVABLE:
+        // For now we will not re-try the same path again (as we don't have any way to generate a different injection).
+        return continueFromLeaf();
 
-void DepthFirstSearch::visit(TraceUnexploredQueued *node)
-{
-    // Already marked for exploration, so skip.
-    continueFromLeaf();
-}
+    case TraceNode::UNEXPLORED_QUEUED:
+        // Already marked for exploration, so skip.
+        return continueFromLeaf();
 
-void DepthFirstSearch::visit(TraceAnnotation *node)
-{
-    // Skip all annotations, which are only relevant to classification and not searching.
-    node->next->accept(this);
-}
+    case TraceNode::END_SUCCESS:
+    case TraceNode::END_FAILURE:
+    case TraceNode::END_UNKNOWN:
+        // When reaching a leaf, we just continue the search and ignore it.
+        return continueFromLeaf();
 
-void DepthFirstSearch::visit(TraceEnd *node)
-{
-    // When reaching a leaf, we just continue the search and ignore it.
-    continueFromLeaf();
+    default:
+        Log::fatal("Error: Reached a node of unknown type while searching the tree (DFS).");
+        exit(1);
+    }
 }
 
 
 // When at a leaf node, we can use the parent stack to find the next node to explore.
-void DepthFirstSearch::continueFromLeaf()
+TraceNode* DepthFirstSearch::continueFromLeaf()
 {
-    // Simply pop from the parent stack and take the 'true' branch from there (see visit(TraceBranch*)).
+    // Simply pop from the parent stack and take the 'true' branch from there (see step()).
     // If the parent stack is empty, then we are finished.
     if(mParentStack.empty()){
         mFoundTarget = false;
+        return NULL;
     }else{
-        nextAfterLeaf()->accept(this);
+        return nextAfterLeaf().data();
     }
 }
 
 // From a leaf node, does any bookwork required to move to the next node to explore and returns that node.
-// It reminas for the caller to call accept() on the branch this function returns.
+// It reminas for the caller to continue the search from the node this function returns.
 // PRECONDITION: Parent stack is non-empty.
 TraceNodePtr DepthFirstSearch::nextAfterLeaf()
 {
@@ -351,9 +372,9 @@ TraceNodePtr DepthFirstSearch::nextAfterLeaf()
     if(parent.node != NULL) {
 
         // If the branch is symbolic, we need to add its condition to the current PC.
-        // Also update the depth, as we would have done in DepthFirstSearch::visit(TraceSymbolicBranch *node).
-        TraceSymbolicBranch* sym = dynamic_cast<TraceSymbolicBranch*>(parent.node);
-        if(sym){
+        // Also update the depth, as we would have done in DepthFirstSearch::step() on the way down.
+        if(parent.node->getKind() == TraceNode::SYMBOLIC_BRANCH){
+            TraceSymbolicBranch* sym = static_cast<TraceSymbolicBranch*>(parent.node);
             mCurrentPC.append(PathBranch(sym, true)); // We are always taking the true branch here.
             mCurrentDepth++;
         }
@@ -369,7 +390,7 @@ TraceNodePtr DepthFirstSearch::nextAfterLeaf()
         assert(parent.childrenVisited < parent.summaryNode->executions.length());
 
         // As this branching is concrete, we can leave the PC, depth, etc. as-is.
-        // And we also ignore previous parent as in visit(TraceConcreteSummarisation)
+        // And we also ignore previous parent as on the way down in step().
 
         // Push a new entry onto the parent stack to deal with any remaining children, then explore the current one.
         unsigned int currentChild = parent.childrenVisited;
@@ -388,6 +409,15 @@ TraceNodePtr DepthFirstSearch::nextAfterLeaf()
 
 
 
+// The previous parent, if it is a symbolic branch, or NULL.
+TraceSymbolicBranch* DepthFirstSearch::getPreviousSymbolicParent()
+{
+    if (mPreviousParent == NULL || mPreviousParent->getKind() != TraceNode::SYMBOLIC_BRANCH) {
+        return NULL;
+    }
+    return static_cast<TraceSymbolicBranch*>(mPreviousParent);
+}
+
 ExplorationDescriptor DepthFirstSearch::getCurrentExplorationDescriptor(TraceSymbolicBranch* parent)
 {
     // This is a complete hack becuase DepthFirstSearch predates any support for ExplorationDescriptor.
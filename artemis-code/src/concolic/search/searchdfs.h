@@ -22,6 +22,7 @@
 
 #include "search.h"
 #include "concolic/pathcondition.h"
+#include "concolic/executiontree/treemanager.h"
 
 
 namespace artemis
@@ -47,7 +48,7 @@ namespace artemis
 class DepthFirstSearch : public TreeSearch
 {
 public:
-    DepthFirstSearch(TraceNodePtr tree, unsigned int depthLimit, unsigned int restartLimit);
+    DepthFirstSearch(TraceNodePtr tree, TreeManagerPtr treeManager, unsigned int depthLimit, unsigned int restartLimit);
 
     // Selects an unexplored node from the tree to be explored next.
     bool chooseNextTarget();
@@ -69,25 +70,16 @@ public:
     void restartSearch();
     bool deepenRestartAndChoose();
 
-
-    // The visitor part which does the actual searching.
-    void visit(TraceNode* node);            // Abstract nodes. An error if we reach this.
-    void visit(TraceConcreteBranch* node);
-    void visit(TraceSymbolicBranch* node);
-    void visit(TraceConcreteSummarisation *node);
-    void visit(TraceMarker* node);
-    void visit(TraceUnexplored* node);
-    void visit(TraceUnexploredMissed* node);
-    void visit(TraceUnexploredUnsat* node);
-    void visit(TraceUnexploredUnsolvable* node);
-    void visit(TraceUnexploredQueued* node);
-    void visit(TraceAnnotation* node);      // Ignore all other annotations.
-    void visit(TraceEnd* node);             // Stop searching at *any* end node.
+    // Continue a search which had already deepened to the given limit, counting the restarts it took to get there.
+    void resumeAtDepthLimit(unsigned int depth);
 
 private:
     // The root of the tree we are searching.
     TraceNodePtr mTree;
 
+    // Marks the difficult targets skipped by the search.
+    TreeManagerPtr mTreeManager;
+
     // The maximum depth (in symbolic branches only) that we will search in the tree.
     unsigned int mDepthLimit;
     unsigned int mInitialDepthLimit;
@@ -121,7 +113,7 @@ private:
     // A stack of the ancestor branch nodes to the current position in the search.
     // Each ancestor node is paired with its depth in the tree and the PC up to that point.
     // This is used for backtracking during the DFS.
-    // N.B. We could avoid this if we included parent pointers in the tree, but this would involve some iterative traversal, going against the idea of using a visitor in the first place!
+    // N.B. We could avoid this if we included parent pointers in the tree.
     // Exactly one of node and summaryNode should be non-null. childrenVisited is only valid for summaryNode.
     struct SavedPosition {
         SavedPosition(){}
@@ -139,11 +131,16 @@ private:
     };
     QStack<SavedPosition> mParentStack;
 
-    // Helper methods for the visitors.
-    void continueFromLeaf();
+    // The search itself, which loops over the tree calling step() until it returns NULL.
+    void search(TraceNodePtr start);
+    TraceNode* step(TraceNode* node);
+
+    // Helper methods for step().
+    TraceNode* continueFromLeaf();
     TraceNodePtr nextAfterLeaf();
+    TraceSymbolicBranch* getPreviousSymbolicParent();
 
-    // This is a hack used by getTargetDescriptor() and visit(TraceUnexplored)
+    // This is a hack used by getTargetDescriptor() and step() on unexplored nodes
     ExplorationDescriptor getCurrentExplorationDescriptor(TraceSymbolicBranch* parent);
     static void pointerDeleterNoOp(TraceSymbolicBranch* branch) {}
 };
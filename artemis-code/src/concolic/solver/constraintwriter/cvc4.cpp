@@ -37,11 +37,43 @@ namespace artemis
 
 CVC4ConstraintWriter::CVC4ConstraintWriter(ConcolicBenchmarkFeatures disabledFeatures)
     : SMTConstraintWriter(disabledFeatures)
+    , mStandalone(true)
     , mTypeAnalysis(new CVC4TypeAnalysis())
 {
 }
 
-bool CVC4ConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::string outputFile) {
+std::string CVC4ConstraintWriter::preamble()
+{
+    std::ostringstream output;
+    output << "(set-logic UFSLIA)" << std::endl;
+    output << "(set-option :produce-models true)" << std::endl;
+    output << "(set-option :strings-exp true)" << std::endl;
+    //output << "(set-option :strings-fmf true)" << std::endl;
+    //output << "(set-option :fmf-bound-int true)" << std::endl;
+    //output << "(set-option :finite-model-find true)" << std::endl;
+    output << std::endl;
+    return output.str();
+}
+
+std::string CVC4ConstraintWriter::postamble()
+{
+    std::ostringstream output;
+    output << std::endl;
+    output << "(check-sat)" << std::endl;
+    output << "(get-model)" << std::endl;
+    return output.str();
+}
+
+bool CVC4ConstraintWriter::writeAssertions(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::vector<std::string>* frames)
+{
+    mStandalone = false;
+    bool result = writeFrames(pathCondition, formRestrictions, frames);
+    mStandalone = true;
+
+    return result;
+}
+
+bool CVC4ConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::ostream& output) {
 
     // pre analysis
     for (uint i = 0; i < pathCondition->size(); i++) {
@@ -49,7 +81,7 @@ bool CVC4ConstraintWriter::write(PathConditionPtr pathCondition, FormRestriction
     }
 
     // main visitor
-    bool result = SMTConstraintWriter::write(pathCondition, formRestrictions, outputFile);
+    bool result = SMTConstraintWriter::write(pathCondition, formRestrictions, output);
 
     // cleanup
     mTypeAnalysis->reset();
@@ -59,15 +91,14 @@ bool CVC4ConstraintWriter::write(PathConditionPtr pathCondition, FormRestriction
 
 void CVC4ConstraintWriter::preVisitPathConditionsHook(QSet<QString> varsUsed)
 {
-    mOutput << "(set-logic UFSLIA)" << std::endl;
-    mOutput << "(set-option :produce-models true)" << std::endl;
-    mOutput << "(set-option :strings-exp true)" << std::endl;
-    //mOutput << "(set-option :strings-fmf true)" << std::endl;
-    //mOutput << "(set-option :fmf-bound-int true)" << std::endl;
-    //mOutput << "(set-option :finite-model-find true)" << std::endl;
-    mOutput << std::endl;
-
-    foreach (QString var, varsUsed) {
+    if (mStandalone) {
+        mOutput << preamble();
+    }
+}
+
+void CVC4ConstraintWriter::preVisitClauseHook(QSet<QString> varsIntroduced, QSet<QString> varsUsedBefore)
+{
+    foreach (QString var, varsIntroduced) {
         if (var.contains("SYM_IN_INT")) {
             // a select index, I'm not happy about these name checks
             // force positive numbers
@@ -76,14 +107,17 @@ void CVC4ConstraintWriter::preVisitPathConditionsHook(QSet<QString> varsUsed)
         }
     }
 
-    // Only write the form restrictions which relate to variables which are actually used in the PC.
+    // Only write the form restrictions which relate to variables which are actually used in the PC, once the first
+    // of their variables is used.
     foreach(SelectRestriction sr, mFormRestrictions.first) {
         // TODO: Hack to guess the variable names, as in helperSelectRestriction().
         QString name = QString("SYM_IN_%1").arg(sr.variable);
         QString idxname = QString("SYM_IN_INT_%1").arg(sr.variable);
 
-        if(varsUsed.contains(name) && varsUsed.contains(idxname)) {
-            if (!mDisabledFeatures.testFlag(SELECT_LINK_VALUE_INDEX)) {
+        bool linked = !mDisabledFeatures.testFlag(SELECT_LINK_VALUE_INDEX);
+
+        if(varsIntroduced.contains(name) && varsIntroduced.contains(idxname)) {
+            if (linked) {
                 // Default behaviour: link value and index constraints.
                 helperSelectRestriction(sr, VALUE_INDEX);
             } else {
@@ -91,23 +125,26 @@ void CVC4ConstraintWriter::preVisitPathConditionsHook(QSet<QString> varsUsed)
                 helperSelectRestriction(sr, VALUE_ONLY);
                 helperSelectRestriction(sr, INDEX_ONLY);
             }
-        } else if(varsUsed.contains(name)) {
-            helperSelectRestriction(sr, VALUE_ONLY);
-        } else if(varsUsed.contains(idxname)) {
-            helperSelectRestriction(sr, INDEX_ONLY);
+        } else if(varsIntroduced.contains(name)) {
+            // When the other half of the select was used by an earlier clause, it is linked to this one now.
+            helperSelectRestriction(sr, linked && varsUsedBefore.contains(idxname) ? VALUE_INDEX : VALUE_ONLY);
+        } else if(varsIntroduced.contains(idxname)) {
+            helperSelectRestriction(sr, linked && varsUsedBefore.contains(name) ? VALUE_INDEX : INDEX_ONLY);
         }
-        // else this select is not mentioned in the PC, so ignore.
+        // else this select is not mentioned by the clause, or it was written before.
     }
     foreach(RadioRestriction rr, mFormRestrictions.second) {
         QString name;
-        bool variableMatch = false;
+        bool variableIntroduced = false;
+        bool variableUsedBefore = false;
         foreach(QString var, rr.variables) {
             // TODO: Hack to guess the variable name in the constraint, as in helperRadioRestriction().
             name = QString("SYM_IN_BOOL_%1").arg(var);
-            variableMatch = variableMatch || varsUsed.contains(name);
+            variableIntroduced = variableIntroduced || varsIntroduced.contains(name);
+            variableUsedBefore = variableUsedBefore || varsUsedBefore.contains(name);
         }
 
-        if(variableMatch) {
+        if(variableIntroduced && !variableUsedBefore) {
             helperRadioRestriction(rr);
         }
     }
@@ -118,9 +155,9 @@ void CVC4ConstraintWriter::postVisitPathConditionsHook()
 {
     emitDOMConstraints();
 
-    mOutput << std::endl;
-    mOutput << "(check-sat)" << std::endl;
-    mOutput << "(get-model)" << std::endl;
+    if (mStandalone) {
+        mOutput << postamble();
+    }
 
     if(!mSuccessfulCoercions.empty()) {
         Statistics::statistics()->accumulate("Concolic::Solver::SuccessfulCoercionOptimisations", (int)mSuccessfulCoercions.size());
@@ -40,7 +40,19 @@ public:
 
     CVC4ConstraintWriter(ConcolicBenchmarkFeatures disabledFeatures);
 
-    bool write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::string outputFile);
+    using SMTConstraintWriter::write;
+    bool write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::ostream& output);
+
+    /**
+     * Writes only the declarations and assertions of the PC (split into frames, see writeFrames),
+     * leaving out the logic and option preamble and the check-sat and get-model commands. Used when
+     * the constraints are sent to a running solver session which owns the preamble and queries the
+     * result itself.
+     */
+    bool writeAssertions(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::vector<std::string>* frames);
+
+    static std::string preamble();
+    static std::string postamble();
 
 protected:
 
@@ -75,6 +87,7 @@ protected:
     virtual void visit(Symbolic::SymbolicObject* obj, void* arg);
 
     virtual void preVisitPathConditionsHook(QSet<QString> varsUsed);
+    virtual void preVisitClauseHook(QSet<QString> varsIntroduced, QSet<QString> varsUsedBefore);
     virtual void postVisitPathConditionsHook();
 
     void emitDOMConstraints();
@@ -90,6 +103,8 @@ protected:
     void helperSelectRestriction(SelectRestriction constraint, SelectConstraintType type);
     void helperRadioRestriction(RadioRestriction constraint);
 
+    bool mStandalone;
+
     std::set<unsigned long> m_singletonCompilations;
 
     CVC4TypeAnalysisPtr mTypeAnalysis;
@@ -27,6 +27,7 @@
 
 #include "util/loggingutil.h"
 #include "statistics/statsstorage.h"
+#include "concolic/solver/expressionfreevariablelister.h"
 
 #include "smt.h"
 
@@ -46,6 +47,10 @@ void SMTConstraintWriter::preVisitPathConditionsHook(QSet<QString> varsUsed)
 {
 }
 
+void SMTConstraintWriter::preVisitClauseHook(QSet<QString> varsIntroduced, QSet<QString> varsUsedBefore)
+{
+}
+
 void SMTConstraintWriter::postVisitPathConditionsHook()
 {
 }
@@ -56,20 +61,43 @@ std::string SMTConstraintWriter::ifLabel()
 }
 
 bool SMTConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::string outputFile)
+{
+    std::ofstream output(outputFile.data());
+    bool result = write(pathCondition, formRestrictions, output);
+    output.close();
+
+    return result;
+}
+
+bool SMTConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::ostream& output)
 {
     mError = false;
     mCurrentClause = -1;
 
     mFormRestrictions = formRestrictions;
 
-    mOutput.open(outputFile.data());
+    mOutput.str("");
+    mFrameOffsets.clear();
 
     QSet<QString> freeVars = pathCondition->freeVariables().keys().toSet();
     preVisitPathConditionsHook(freeVars);
+    mFrameOffsets.push_back((size_t)mOutput.tellp());
+
+    ExpressionFreeVariableLister lister;
+    QSet<QString> varsUsedBefore;
 
     for (uint i = 0; i < pathCondition->size(); i++) {
         mCurrentClause = i;
 
+        // Anything relating to a variable is written in the frame of the first clause using it, such that the
+        // frames of a common prefix do not change when later clauses introduce new variables.
+        pathCondition->get(i).first->accept(&lister);
+        QSet<QString> varsIntroduced = lister.getResult().keys().toSet().subtract(varsUsedBefore);
+        lister.clear();
+
+        preVisitClauseHook(varsIntroduced, varsUsedBefore);
+        varsUsedBefore.unite(varsIntroduced);
+
         pathCondition->get(i).first->accept(this);
         if(!checkType(Symbolic::BOOL) && !checkType(Symbolic::TYPEERROR)){
             error("Writing the PC did not result in a boolean constraint");
@@ -78,12 +106,14 @@ bool SMTConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions
         mOutput << "(assert (= " << mExpressionBuffer;
         mOutput << (pathCondition->get(i).second ? " true" : " false");
         mOutput << "))\n";
+        mFrameOffsets.push_back((size_t)mOutput.tellp());
     }
     mCurrentClause = -1;
 
     postVisitPathConditionsHook();
+    mFrameOffsets.push_back((size_t)mOutput.tellp());
 
-    mOutput.close();
+    output << mOutput.str();
 
     if (mError) {
         return false;
@@ -99,6 +129,23 @@ bool SMTConstraintWriter::write(PathConditionPtr pathCondition, FormRestrictions
     return true;
 }
 
+bool SMTConstraintWriter::writeFrames(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::vector<std::string>* frames)
+{
+    std::ostringstream output;
+    bool result = write(pathCondition, formRestrictions, output);
+
+    std::string constraints = output.str();
+
+    frames->clear();
+    size_t begin = 0;
+    for (std::vector<size_t>::iterator iter = mFrameOffsets.begin(); iter != mFrameOffsets.end(); iter++) {
+        frames->push_back(constraints.substr(begin, *iter - begin));
+        begin = *iter;
+    }
+
+    return result;
+}
+
 /** Symbolic Integer/String/Boolean **/
 
 
@@ -18,7 +18,9 @@
 #define SMT_H
 
 #include <fstream>
+#include <sstream>
 #include <map>
+#include <vector>
 
 #include <QSharedPointer>
 
@@ -74,7 +76,18 @@ public:
 
     SMTConstraintWriter(ConcolicBenchmarkFeatures disabledFeatures);
 
-    virtual bool write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::string outputFile);
+    bool write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::string outputFile);
+    virtual bool write(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::ostream& output);
+
+    /**
+     * Writes the PC split into frames: the first frame holds everything emitted before the
+     * first clause, frame i+1 holds the declarations and restrictions of the variables first
+     * used by clause i and its assertion, and the last frame holds everything emitted after
+     * the last clause. Frames of a common PC prefix are thus identical.
+     *
+     * Concatenating the frames gives the same output as write().
+     */
+    bool writeFrames(PathConditionPtr pathCondition, FormRestrictions formRestrictions, std::vector<std::string>* frames);
 
     std::string getErrorReason() {
         return mErrorReason;
@@ -156,6 +169,7 @@ protected:
 
     // Output writing
     virtual void preVisitPathConditionsHook(QSet<QString> varsUsed);
+    virtual void preVisitClauseHook(QSet<QString> varsIntroduced, QSet<QString> varsUsedBefore);
     virtual void postVisitPathConditionsHook();
 
     virtual std::string ifLabel();
@@ -201,7 +215,10 @@ protected:
     void error(std::string reason);
 
     std::map<std::string, Symbolic::Type> mTypemap;
-    std::ofstream mOutput;
+    std::ostringstream mOutput;
+
+    // Offsets into mOutput where each frame ends, see writeFrames()
+    std::vector<size_t> mFrameOffsets;
 
     // holds the current subexpression returned by the previous call to visit
     std::string mExpressionBuffer;
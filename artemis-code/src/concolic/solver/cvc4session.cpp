@@ -0,0 +1,230 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+#include <cstdlib>
+#include <sstream>
+
+#include <QDir>
+#include <QStringList>
+
+#include "concolic/solver/constraintwriter/cvc4.h"
+#include "statistics/statsstorage.h"
+
+#include "cvc4session.h"
+
+namespace artemis
+{
+
+CVC4Session::CVC4Session(int timeout)
+    : mProcess(NULL)
+    , mTimeout(timeout)
+{
+}
+
+CVC4Session::~CVC4Session()
+{
+    kill();
+}
+
+CVC4Session::Result CVC4Session::query(const std::vector<std::string>& frames)
+{
+    assert(!frames.empty());
+
+    std::string error;
+    if (!ensureStarted(&error)) {
+        return fail(ERROR, error);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Find the longest prefix of frames which is already asserted, the last frame is never reused.
+    size_t reused = 0;
+    while (reused < mAsserted.size() && reused < frames.size() - 1 && mAsserted[reused] == frames[reused]) {
+        reused++;
+    }
+
+    std::ostringstream commands;
+
+    if (reused < mAsserted.size()) {
+        commands << "(pop " << (mAsserted.size() - reused) << ")\n";
+        mAsserted.resize(reused);
+    }
+
+    for (size_t i = reused; i < frames.size() - 1; i++) {
+        commands << "(push 1)\n" << frames[i];
+        mAsserted.push_back(frames[i]);
+    }
+
+    commands << "(push 1)\n" << frames.back() << "\n(check-sat)\n";
+
+    Statistics::statistics()->accumulate("Concolic::Solver::IncrementalFramesReused", (int)reused);
+    Statistics::statistics()->accumulate("Concolic::Solver::IncrementalFramesAsserted", (int)(frames.size() - reused));
+
+    if (!send(commands.str())) {
+        return fail(ERROR, "Could not send the constraints to CVC4.");
+    }
+
+    std::string line;
+    do {
+        if (!readLine(&line, timer)) {
+            return fail(mProcess->state() == QProcess::Running ? TIMEOUT : ERROR, "CVC4 did not answer check-sat.");
+        }
+    } while (line.empty());
+
+    Result result;
+    result.status = ERROR;
+
+    if (line.compare("unsat") == 0) {
+        result.status = UNSAT;
+    } else if (line.compare("sat") == 0 || line.compare("unknown") == 0) {
+        result.status = line.compare("sat") == 0 ? SAT : UNKNOWN;
+
+        if (!send("(get-model)\n")) {
+            return fail(ERROR, "Could not request the model from CVC4.");
+        }
+
+        // The model is printed as "(model" followed by one define-fun per line and a closing ")".
+        do {
+            if (!readLine(&line, timer)) {
+                return fail(mProcess->state() == QProcess::Running ? TIMEOUT : ERROR, "CVC4 did not return a complete model.");
+            }
+        } while (line.empty());
+
+        while (true) {
+            if (!readLine(&line, timer)) {
+                return fail(mProcess->state() == QProcess::Running ? TIMEOUT : ERROR, "CVC4 did not return a complete model.");
+            }
+
+            if (line.compare(")") == 0) {
+                break;
+            }
+
+            result.model.push_back(line);
+        }
+
+    } else {
+        // Typically an (error "...") response to one of the assertions.
+        return fail(ERROR, line);
+    }
+
+    // Only drop the temporary scope of the last frame, the prefix stays asserted for the next query.
+    if (!send("(pop 1)\n")) {
+        kill();
+    }
+
+    return result;
+}
+
+bool CVC4Session::ensureStarted(std::string* error)
+{
+    if (mProcess != NULL && mProcess->state() == QProcess::Running) {
+        return true;
+    }
+
+    kill();
+
+    char* artemisdir = std::getenv("ARTEMISDIR");
+    if (artemisdir == NULL) {
+        *error = "Warning, ARTEMISDIR environment variable not set!";
+        return false;
+    }
+
+    // Same binary and options as contrib/CVC4/timed-cvc4.sh, which is kept for replaying logged constraints.
+    QDir solverpath = QDir(QString(artemisdir));
+    QString exec = "cvc4-2014-09-19-x86_64-linux-opt";
+
+    if (!solverpath.cd("contrib") || !solverpath.cd("CVC4") || !solverpath.exists(exec)) {
+        *error = "Could not find CVC4 binary.";
+        return false;
+    }
+
+    QStringList arguments;
+    arguments << "--strings-exp" << "--lang=smtlib2" << "--rewrite-divk"  // --rewrite-divk enables div and mod by a constant factor
+              << "--incremental" << "--interactive" << "--no-interactive-prompt";
+
+    mProcess = new QProcess();
+    mProcess->setProcessChannelMode(QProcess::MergedChannels);
+    mProcess->start(solverpath.filePath(exec), arguments);
+
+    if (!mProcess->waitForStarted()) {
+        *error = "Could not start CVC4.";
+        kill();
+        return false;
+    }
+
+    Statistics::statistics()->accumulate("Concolic::Solver::SessionsStarted", 1);
+
+    if (!send(CVC4ConstraintWriter::preamble())) {
+        *error = "Could not initialise CVC4.";
+        kill();
+        return false;
+    }
+
+    return true;
+}
+
+void CVC4Session::kill()
+{
+    mAsserted.clear();
+
+    if (mProcess == NULL) {
+        return;
+    }
+
+    if (mProcess->state() != QProcess::NotRunning) {
+        mProcess->kill();
+        mProcess->waitForFinished();
+    }
+
+    delete mProcess;
+    mProcess = NULL;
+}
+
+bool CVC4Session::send(const std::string& commands)
+{
+    qint64 written = mProcess->write(commands.data(), commands.size());
+    return written == (qint64)commands.size();
+}
+
+bool CVC4Session::readLine(std::string* line, const QElapsedTimer& timer)
+{
+    while (!mProcess->canReadLine()) {
+        int remaining = mTimeout - timer.elapsed();
+
+        if (remaining <= 0 || !mProcess->waitForReadyRead(remaining)) {
+            return false;
+        }
+    }
+
+    *line = QString(mProcess->readLine()).trimmed().toStdString();
+    return true;
+}
+
+CVC4Session::Result CVC4Session::fail(Status status, const std::string& error)
+{
+    // The solver is in an unknown state (possibly still solving), start over on the next query.
+    kill();
+
+    Result result;
+    result.status = status;
+    result.error = error;
+    return result;
+}
+
+}
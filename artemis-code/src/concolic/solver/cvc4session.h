@@ -0,0 +1,89 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CVC4SESSION_H
+#define CVC4SESSION_H
+
+#include <string>
+#include <vector>
+
+#include <QSharedPointer>
+#include <QProcess>
+#include <QElapsedTimer>
+
+namespace artemis
+{
+
+/**
+ * A long running CVC4 process in incremental mode.
+ *
+ * Constraints are written to the solver over a pipe and the result and model are read back from its output,
+ * such that solving a path condition neither spawns a shell nor touches any (fixed) temporary files. The
+ * logic and options are set once when the process starts, and assertions are scoped with push/pop such that
+ * declarations and assertions do not leak between queries.
+ *
+ * Consecutive queries from the search usually share most of their path condition. Each query is therefore
+ * given as a list of frames (see SMTConstraintWriter::writeFrames) and every frame except the last is kept
+ * asserted in its own push scope. A new query only pops back to the longest prefix of frames which is
+ * identical to the ones already asserted and pushes the remaining ones, so walking down the tree adds a
+ * single frame and backtracking pops. The last frame (constraints emitted after the clauses) is always
+ * asserted in a temporary scope which is popped again once the query is answered.
+ *
+ * Timeouts are enforced by the session. If CVC4 exceeds its time budget or its state can otherwise not be
+ * trusted (an error or unexpected output) the process is killed and a new one is started for the next query.
+ */
+class CVC4Session
+{
+public:
+
+    enum Status {
+        SAT, UNSAT, UNKNOWN, TIMEOUT, ERROR
+    };
+
+    struct Result {
+        Status status;
+        std::vector<std::string> model; // one line per (define-fun ...) in the model
+        std::string error;
+    };
+
+    static const int DEFAULT_TIMEOUT = 600000; // ms, matches timed-cvc4.sh
+
+    CVC4Session(int timeout = DEFAULT_TIMEOUT);
+    ~CVC4Session();
+
+    Result query(const std::vector<std::string>& frames);
+
+private:
+    bool ensureStarted(std::string* error);
+    void kill();
+
+    bool send(const std::string& commands);
+    bool readLine(std::string* line, const QElapsedTimer& timer);
+    Result fail(Status status, const std::string& error);
+
+    QProcess* mProcess;
+    int mTimeout;
+
+    // Frames currently asserted by the solver, one push scope per frame
+    std::vector<std::string> mAsserted;
+};
+
+typedef QSharedPointer<CVC4Session> CVC4SessionPtr;
+
+}
+
+#endif // CVC4SESSION_H
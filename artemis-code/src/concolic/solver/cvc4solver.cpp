@@ -24,6 +24,8 @@
 #include <QString>
 #include <QDateTime>
 #include <QElapsedTimer>
+#include <QMutex>
+#include <QSet>
 
 #include "concolic/solver/constraintwriter/cvc4.h"
 
@@ -34,8 +36,35 @@
 namespace artemis
 {
 
-CVC4Solver::CVC4Solver(ConcolicBenchmarkFeatures disabledFeatures)
+/**
+ * Solvers in a SolverPool run concurrently and share the constraint log and index. Each query is written to a buffer,
+ * which is appended to the file in one go once the query is done.
+ */
+class BufferedLog : public std::ostringstream
+{
+public:
+    BufferedLog(const QString& path)
+        : mPath(path)
+    {
+    }
+
+    ~BufferedLog()
+    {
+        static QMutex mutex;
+        QMutexLocker locker(&mutex);
+
+        std::ofstream file(mPath.toStdString().c_str(), std::ofstream::out | std::ofstream::app);
+        file << str();
+    }
+
+private:
+    QString mPath;
+};
+
+CVC4Solver::CVC4Solver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir)
     : Solver(disabledFeatures)
+    , mConstraintDir(constraintDir)
+    , mSession(new CVC4Session())
 {
 }
 
@@ -47,23 +76,33 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
 {
     // 0. Emit debug information
 
-    QDir().mkdir("/tmp/constraints/");
-    QDir constraintsPath = QDir("/tmp/constraints/");
+    QDir().mkpath(QDir(mConstraintDir).filePath("constraints"));
+    QDir constraintsPath = QDir(QDir(mConstraintDir).filePath("constraints"));
 
     QString identifier = QDateTime::currentDateTime().toString("dd-MM-yy-hh-mm-ss");
 
-    int next = 0;
-    while (constraintsPath.exists(identifier)) {
-        if (identifier.contains("--")) {
-            identifier.chop(identifier.size() - identifier.indexOf("--"));
+    {
+        // Solvers in a SolverPool run concurrently and share the constraint directory, and the constraint file is only
+        // written once solved, so identifiers handed out by this process are remembered as well.
+        static QMutex identifierMutex;
+        static QSet<QString> reservedIdentifiers;
+        QMutexLocker locker(&identifierMutex);
+
+        int next = 0;
+        while (constraintsPath.exists(identifier) || reservedIdentifiers.contains(identifier)) {
+            if (identifier.contains("--")) {
+                identifier.chop(identifier.size() - identifier.indexOf("--"));
+            }
+
+            identifier = identifier + QString("--") + QString::number(next++);
         }
 
-        identifier = identifier + QString("--") + QString::number(next++);
+        reservedIdentifiers.insert(identifier);
     }
     mLastConstraintID = identifier;
 
-    std::ofstream clog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
-    std::ofstream constraintIndex("/tmp/constraintindex", std::ofstream::out | std::ofstream::app);
+    BufferedLog clog(QDir(mConstraintDir).filePath("constraintlog"));
+    BufferedLog constraintIndex(QDir(mConstraintDir).filePath("constraintindex"));
 
     Log::info(QString("  Constraint file: %1").arg(identifier).toStdString());
 
@@ -77,7 +116,8 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
 
     CVC4ConstraintWriterPtr cw = CVC4ConstraintWriterPtr(new CVC4ConstraintWriter(mDisabledFeatures));
 
-    if (!cw->write(pc, formRestrictions, "/tmp/cvc4input")) {
+    std::vector<std::string> frames;
+    if (!cw->writeAssertions(pc, formRestrictions, &frames)) {
 
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotWritten", 1);
 
@@ -87,40 +127,27 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
 
     }
 
-    Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsWritten", 1);
-
-    // 2. run the solver on the file
-
-    char* artemisdir;
-    artemisdir = std::getenv("ARTEMISDIR");
-
-    if (artemisdir == NULL) {
-        return emitError(clog, "Warning, ARTEMISDIR environment variable not set!");
+    mLastConstraints.clear();
+    for (std::vector<std::string>::iterator iter = frames.begin(); iter != frames.end(); iter++) {
+        mLastConstraints += *iter;
     }
 
-    QDir solverpath = QDir(QString(artemisdir));
-    QString exec = "timed-cvc4.sh";
+    Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsWritten", 1);
 
-    if (!solverpath.cd("contrib") || !solverpath.cd("CVC4") || !solverpath.exists(exec)) {
-        return emitError(clog, "Could not find CVC4 binary.");
-    }
+    // 2. run the solver session on the constraints
 
     Log::info("Solving...");
     QElapsedTimer timer;
 
-    // --rewrite-divk enables div and mod by a constant factor
-    std::string cmd = solverpath.filePath(exec).toStdString() + " /tmp/cvc4input > /tmp/cvc4result 2> /tmp/cvc4result";
     timer.start();
-    int result = std::system(cmd.data()); // result of command interpreted in step 3
-    // We cannot use the return code for error checking as it will be an "error" in all unsat cases (because we try to get the model). Error checking is done below.
-    // However we can use it to check whether the timeout script had to kill CVC4 or not.
+    CVC4Session::Result result = mSession->query(frames);
 
     double time = (double)timer.elapsed()/1000;
     Log::info(QString("  Took %1s").arg(time).toStdString());
     Statistics::statistics()->accumulate("Concolic::Solver::TotalSolverTime", time);
     clog << "Duration: " << time << "s" << std::endl;
 
-    if (WEXITSTATUS(result) == 124) {
+    if (result.status == CVC4Session::TIMEOUT) {
         Statistics::statistics()->accumulate("Concolic::Solver::SolverTimeouts", 1);
         return emitError(clog, "CVC4 execution timed-out..");
     }
@@ -129,19 +156,24 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
 
     SolutionPtr solution = SolutionPtr(new Solution(true, false));
 
-    std::string line;
-    std::ifstream fp("/tmp/cvc4result");
+    if (result.status == CVC4Session::ERROR) {
 
-    if (!fp.is_open()) {
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
-        return emitError(clog, "Could not read result file.");
+
+        // Copy the constraints and the solver response for debugging
+
+        clog << "Constraints:" << std::endl << std::endl;
+        clog << mLastConstraints << std::endl;
+        clog << "Result: " << std::endl;
+        clog << result.error << std::endl;
+        clog << std::endl;
+
+        return emitError(clog, "CVC4 responded with an error while solving the constraints: " + result.error);
     }
 
     Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
 
-    std::getline(fp, line); // load sat line
-
-    if (line.compare("unsat") == 0) {
+    if (result.status == CVC4Session::UNSAT) {
 
         // UNSAT
         emitConstraints(constraintIndex, identifier, false);
@@ -150,57 +182,17 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
         clog << "Solved as UNSAT." << std::endl << std::endl;
         return SolutionPtr(new Solution(false, true));
 
-    } else if (line.compare("sat") != 0 && line.compare("unknown") != 0) {
-
-        // ERROR, we can't use return types to detect errors, since an unsat result will result in an error code (because we try to access the model)
-
-        Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
-
-        // Copy contents of constraint files for debugging
-
-        clog << "Constraints:" << std::endl << std::endl;
-
-        std::ifstream fp_input;
-        fp_input.open ("/tmp/cvc4input");
-        std::string line;
-        while (std::getline(fp_input, line)) {
-            clog << line << std::endl;
-        }
-        fp_input.close();
-
-        clog << "Result: " << std::endl;
-
-        std::ifstream fp_result;
-        fp_result.open ("/tmp/cvc4result");
-        while (std::getline(fp_result, line)) {
-            clog << line << std::endl;
-        }
-        fp_result.close();
-
-        clog << std::endl;
-
-        fp.close(); // The main fp.
-
-        return emitError(clog, "CVC4 responded with an error while solving the constraints.");
     }
 
     // Notice, we interpret sat and unknown internally as sat
 
     emitConstraints(constraintIndex, identifier, true);
 
-    std::getline(fp, line); // discard model line
-
     clog << "Solved as:\n";
 
-    while (fp.good()) {
+    for (std::vector<std::string>::const_iterator iter = result.model.begin(); iter != result.model.end(); iter++) {
 
-        // split each line
-        std::getline(fp, line);
-
-        // check for end-of-solutions
-        if (line.compare(")") == 0) {
-            break;
-        }
+        const std::string& line = *iter;
 
         std::string symbol;
         std::string type;
@@ -263,15 +255,11 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc, FormRestrictions formRestrict
     }
 
     clog << std::endl;
-    clog.close();
-    constraintIndex.close();
-
-    fp.close();
 
     return solution;
 }
 
-SolutionPtr CVC4Solver::decodeDOMInputResult(std::ofstream& clog,
+SolutionPtr CVC4Solver::decodeDOMInputResult(std::ostream& clog,
                                              std::string identifier,
                                              std::string type,
                                              std::string value,
@@ -390,17 +378,21 @@ SolutionPtr CVC4Solver::decodeDOMInputResult(std::ofstream& clog,
     return SolutionPtr(NULL);
 }
 
-SolutionPtr CVC4Solver::emitError(std::ofstream& clog, const std::string& reason, int clause)
+SolutionPtr CVC4Solver::emitError(std::ostream& clog, const std::string& reason, int clause)
 {
     clog << "ERROR: " << reason << std::endl << std::endl;
 
     return SolutionPtr(new Solution(false, false, QString::fromStdString(reason), clause));
 }
 
-void CVC4Solver::emitConstraints(std::ofstream& constraintIndex, const QString& identifier, bool sat)
+void CVC4Solver::emitConstraints(std::ostream& constraintIndex, const QString& identifier, bool sat)
 {
     constraintIndex << identifier.toStdString() << "," << (sat ? "sat/unknown" : "unsat") << std::endl;
-    QFile::copy("/tmp/cvc4input", QString::fromStdString("/tmp/constraints/") + identifier);
+
+    // Store a standalone copy of the constraints, which can be replayed with contrib/CVC4/timed-cvc4.sh
+    std::ofstream constraintFile(QDir(mConstraintDir).filePath("constraints/" + identifier).toStdString().data());
+    constraintFile << CVC4ConstraintWriter::preamble() << mLastConstraints << CVC4ConstraintWriter::postamble();
+    constraintFile.close();
 }
 
 } // namespace artemis
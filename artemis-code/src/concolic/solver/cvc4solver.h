@@ -17,10 +17,13 @@
 #ifndef CVC4SOLVER_H
 #define CVC4SOLVER_H
 
-#include "solver.h"
+#include <ostream>
 
 #include <QString>
 
+#include "solver.h"
+#include "cvc4session.h"
+
 namespace artemis
 {
 
@@ -32,7 +35,7 @@ class CVC4Solver : public Solver
 {
 public:
 
-    CVC4Solver(ConcolicBenchmarkFeatures disabledFeatures);
+    CVC4Solver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir);
     ~CVC4Solver();
 
     SolutionPtr solve(PathConditionPtr pc, FormRestrictions formRestrictions);
@@ -40,11 +43,16 @@ public:
     QString getLastConstraintID() { return mLastConstraintID; }
 
 private:
-    SolutionPtr emitError(std::ofstream& clog, const std::string& reason, int clause = -1);
-    void emitConstraints(std::ofstream& constraintIndex, const QString& identifier, bool sat);
-    SolutionPtr decodeDOMInputResult(std::ofstream& clog, std::string identifier, std::string type, std::string value, Symbolvalue* result, const FormRestrictions& formRestrictions);
+    SolutionPtr emitError(std::ostream& clog, const std::string& reason, int clause = -1);
+    void emitConstraints(std::ostream& constraintIndex, const QString& identifier, bool sat);
+    SolutionPtr decodeDOMInputResult(std::ostream& clog, std::string identifier, std::string type, std::string value, Symbolvalue* result, const FormRestrictions& formRestrictions);
+
+    QString mConstraintDir;
 
     QString mLastConstraintID;
+    std::string mLastConstraints;
+
+    CVC4SessionPtr mSession;
 };
 
 typedef QSharedPointer<CVC4Solver> CVC4SolverPtr;
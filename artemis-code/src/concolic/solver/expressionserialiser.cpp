@@ -0,0 +1,765 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+
+#include "JavaScriptCore/symbolic/expression/expressionarena.h"
+
+#include "expressionserialiser.h"
+
+namespace artemis
+{
+
+/**
+ * DOM snapshots are normally taken by WebCore, these are only used to restore the node xpaths and attributes.
+ */
+class RestoredDOMSnapshotNode : public Symbolic::DOMSnapshotNode
+{
+public:
+    RestoredDOMSnapshotNode(const std::string& xpath, const Symbolic::DOMSnapshotNodeAttributes& attributes)
+        : Symbolic::DOMSnapshotNode()
+    {
+        m_xpath = xpath;
+        m_attributes = attributes;
+    }
+};
+
+class RestoredDOMSnapshot : public Symbolic::DOMSnapshot
+{
+public:
+    void addNode(Symbolic::DOMSnapshotNodeId id, Symbolic::DOMSnapshotNode* node)
+    {
+        m_nodes.insert(std::make_pair(id, node));
+    }
+};
+
+/* Serialiser */
+
+ExpressionSerialiser::ExpressionSerialiser(QDataStream* stream)
+    : mStream(stream)
+    , mNextIndex(0)
+{
+}
+
+quint32 ExpressionSerialiser::write(Symbolic::Expression* expression)
+{
+    assert(expression != NULL);
+
+    if (!mIndices.contains(expression)) {
+        expression->accept(this); // Writes any new sub-expressions before the expression itself.
+    }
+
+    return mIndices.value(expression);
+}
+
+void ExpressionSerialiser::finish()
+{
+    *mStream << (quint8)END_OF_TABLE;
+}
+
+void ExpressionSerialiser::begin(void* record, RecordType type)
+{
+    mIndices.insert(record, mNextIndex++);
+    *mStream << (quint8)type;
+}
+
+void ExpressionSerialiser::writeString(const std::string& string)
+{
+    *mStream << QByteArray(string.data(), string.size());
+}
+
+qint32 ExpressionSerialiser::writeSnapshot(Symbolic::SymbolicSource source)
+{
+    Symbolic::DOMSnapshot* snapshot = source.getDOMSnapshot();
+
+    if (snapshot == NULL) {
+        return NO_SNAPSHOT;
+    }
+
+    if (mIndices.contains(snapshot)) {
+        return mIndices.value(snapshot);
+    }
+
+    std::map<Symbolic::DOMSnapshotNodeId, Symbolic::DOMSnapshotNode*> nodes = snapshot->getNodes();
+
+    begin(snapshot, DOM_SNAPSHOT);
+    *mStream << (quint32)nodes.size();
+
+    std::map<Symbolic::DOMSnapshotNodeId, Symbolic::DOMSnapshotNode*>::iterator iter;
+    for (iter = nodes.begin(); iter != nodes.end(); ++iter) {
+        Symbolic::DOMSnapshotNodeAttributes attributes = iter->second->getAttributes();
+
+        *mStream << (qint64)iter->first;
+        writeString(iter->second->getXpath());
+        *mStream << (quint32)attributes.size();
+
+        Symbolic::DOMSnapshotNodeAttributes::iterator attribute;
+        for (attribute = attributes.begin(); attribute != attributes.end(); ++attribute) {
+            writeString(attribute->first);
+            writeString(attribute->second);
+        }
+    }
+
+    return mIndices.value(snapshot);
+}
+
+void ExpressionSerialiser::writeSource(const Symbolic::SymbolicSource& source, qint32 snapshot)
+{
+    *mStream << (quint8)source.getType() << (quint8)source.getIdentifierMethod();
+    writeString(source.getIdentifier());
+    *mStream << snapshot;
+}
+
+QList<quint32> ExpressionSerialiser::writeList(const std::list<Symbolic::Expression*>& expressions)
+{
+    QList<quint32> indices;
+
+    std::list<Symbolic::Expression*>::const_iterator iter;
+    for (iter = expressions.begin(); iter != expressions.end(); ++iter) {
+        indices.append(write(*iter));
+    }
+
+    return indices;
+}
+
+void ExpressionSerialiser::visit(Symbolic::ConstantObject* obj, void* arg)
+{
+    begin(obj, CONSTANT_OBJECT);
+    *mStream << (quint32)obj->getInstanceidentifier();
+}
+
+void ExpressionSerialiser::visit(Symbolic::ObjectBinaryOperation* obj, void* arg)
+{
+    quint32 lhs = write(obj->getLhs());
+    quint32 rhs = write(obj->getRhs());
+
+    begin(obj, OBJECT_BINARY_OPERATION);
+    *mStream << lhs << (qint32)obj->getOp() << rhs;
+}
+
+void ExpressionSerialiser::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    qint32 snapshot = writeSnapshot(symbolicinteger->getSource());
+
+    begin(symbolicinteger, SYMBOLIC_INTEGER);
+    writeSource(symbolicinteger->getSource(), snapshot);
+}
+
+void ExpressionSerialiser::visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+{
+    begin(constantinteger, CONSTANT_INTEGER);
+    *mStream << constantinteger->getValue();
+}
+
+void ExpressionSerialiser::visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg)
+{
+    quint32 lhs = write(integerbinaryoperation->getLhs());
+    quint32 rhs = write(integerbinaryoperation->getRhs());
+
+    begin(integerbinaryoperation, INTEGER_BINARY_OPERATION);
+    *mStream << lhs << (qint32)integerbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerialiser::visit(Symbolic::IntegerCoercion* integercoercion, void* arg)
+{
+    quint32 expression = write(integercoercion->getExpression());
+
+    begin(integercoercion, INTEGER_COERCION);
+    *mStream << expression;
+}
+
+void ExpressionSerialiser::visit(Symbolic::IntegerMaxMin* obj, void* arg)
+{
+    QList<quint32> expressions = writeList(obj->getExpressions());
+
+    begin(obj, INTEGER_MAX_MIN);
+    *mStream << expressions << obj->getMax();
+}
+
+void ExpressionSerialiser::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    qint32 snapshot = writeSnapshot(symbolicstring->getSource());
+
+    begin(symbolicstring, SYMBOLIC_STRING);
+    writeSource(symbolicstring->getSource(), snapshot);
+}
+
+void ExpressionSerialiser::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    begin(constantstring, CONSTANT_STRING);
+    writeString(*constantstring->getValue());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg)
+{
+    quint32 lhs = write(stringbinaryoperation->getLhs());
+    quint32 rhs = write(stringbinaryoperation->getRhs());
+
+    begin(stringbinaryoperation, STRING_BINARY_OPERATION);
+    *mStream << lhs << (qint32)stringbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringCoercion* stringcoercion, void* arg)
+{
+    quint32 expression = write(stringcoercion->getExpression());
+
+    begin(stringcoercion, STRING_COERCION);
+    *mStream << expression;
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringCharAt* stringcharat, void* arg)
+{
+    quint32 source = write(stringcharat->getSource());
+
+    begin(stringcharat, STRING_CHAR_AT);
+    *mStream << source << (quint32)stringcharat->getPosition();
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+{
+    quint32 source = write(stringregexreplace->getSource());
+
+    begin(stringregexreplace, STRING_REGEX_REPLACE);
+    *mStream << source;
+    writeString(*stringregexreplace->getRegexpattern());
+    writeString(*stringregexreplace->getReplace());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexSubmatch* submatch, void* arg)
+{
+    quint32 source = write(submatch->getSource());
+
+    begin(submatch, STRING_REGEX_SUBMATCH);
+    *mStream << source;
+    writeString(*submatch->getRegexpattern());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg)
+{
+    quint32 source = write(submatchIndex->getSource());
+
+    begin(submatchIndex, STRING_REGEX_SUBMATCH_INDEX);
+    *mStream << source;
+    writeString(*submatchIndex->getRegexpattern());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexSubmatchArray* exp, void* arg)
+{
+    quint32 source = write(exp->getSource());
+
+    begin(exp, STRING_REGEX_SUBMATCH_ARRAY);
+    *mStream << (quint32)exp->getIdentifier() << source;
+    writeString(*exp->getRegexpattern());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg)
+{
+    quint32 match = write(exp->getMatch());
+
+    begin(exp, STRING_REGEX_SUBMATCH_ARRAY_AT);
+    *mStream << match << (qint32)exp->getGroup();
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg)
+{
+    quint32 match = write(exp->getMatch());
+
+    begin(exp, STRING_REGEX_SUBMATCH_ARRAY_MATCH);
+    *mStream << match;
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringReplace* stringreplace, void* arg)
+{
+    quint32 source = write(stringreplace->getSource());
+
+    begin(stringreplace, STRING_REPLACE);
+    *mStream << source;
+    writeString(*stringreplace->getPattern());
+    writeString(*stringreplace->getReplace());
+}
+
+void ExpressionSerialiser::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    qint32 snapshot = writeSnapshot(symbolicboolean->getSource());
+
+    begin(symbolicboolean, SYMBOLIC_BOOLEAN);
+    writeSource(symbolicboolean->getSource(), snapshot);
+}
+
+void ExpressionSerialiser::visit(Symbolic::ConstantBoolean* constantboolean, void* arg)
+{
+    begin(constantboolean, CONSTANT_BOOLEAN);
+    *mStream << constantboolean->getValue();
+}
+
+void ExpressionSerialiser::visit(Symbolic::BooleanCoercion* booleancoercion, void* arg)
+{
+    quint32 expression = write(booleancoercion->getExpression());
+
+    begin(booleancoercion, BOOLEAN_COERCION);
+    *mStream << expression;
+}
+
+void ExpressionSerialiser::visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg)
+{
+    quint32 lhs = write(booleanbinaryoperation->getLhs());
+    quint32 rhs = write(booleanbinaryoperation->getRhs());
+
+    begin(booleanbinaryoperation, BOOLEAN_BINARY_OPERATION);
+    *mStream << lhs << (qint32)booleanbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringLength* stringlength, void* arg)
+{
+    quint32 string = write(stringlength->getString());
+
+    begin(stringlength, STRING_LENGTH);
+    *mStream << string;
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringIndexOf* stringindexof, void* arg)
+{
+    quint32 source = write(stringindexof->getSource());
+    quint32 pattern = write(stringindexof->getPattern());
+    quint32 offset = write(stringindexof->getOffset());
+
+    begin(stringindexof, STRING_INDEX_OF);
+    *mStream << source << pattern << offset;
+}
+
+void ExpressionSerialiser::visit(Symbolic::SymbolicObject* symbolicobject, void* arg)
+{
+    qint32 snapshot = writeSnapshot(symbolicobject->getSource());
+
+    begin(symbolicobject, SYMBOLIC_OBJECT);
+    writeSource(symbolicobject->getSource(), snapshot);
+}
+
+void ExpressionSerialiser::visit(Symbolic::ObjectArrayIndexOf* objectarrayindexof, void* arg)
+{
+    quint32 searchElement = write(objectarrayindexof->getSearchelement());
+    QList<quint32> array = writeList(objectarrayindexof->getArray());
+
+    begin(objectarrayindexof, OBJECT_ARRAY_INDEX_OF);
+    *mStream << array << searchElement;
+}
+
+void ExpressionSerialiser::visit(Symbolic::SymbolicObjectPropertyString* obj, void* arg)
+{
+    quint32 object = write(obj->getObj());
+
+    begin(obj, SYMBOLIC_OBJECT_PROPERTY_STRING);
+    *mStream << object;
+    writeString(obj->getPropertyname());
+}
+
+void ExpressionSerialiser::visit(Symbolic::StringSubstring* obj, void* arg)
+{
+    quint32 source = write(obj->getSource());
+
+    begin(obj, STRING_SUBSTRING);
+    *mStream << source << (qint32)obj->getFrom() << (qint32)obj->getLength();
+}
+
+/* Deserialiser */
+
+ExpressionDeserialiser::ExpressionDeserialiser(QDataStream* stream)
+    : mStream(stream)
+{
+}
+
+bool ExpressionDeserialiser::read()
+{
+    while (mStream->status() == QDataStream::Ok) {
+        quint8 type;
+        *mStream >> type;
+
+        if (mStream->status() != QDataStream::Ok || type > ExpressionSerialiser::DOM_SNAPSHOT) {
+            return false;
+        }
+
+        if (type == ExpressionSerialiser::END_OF_TABLE) {
+            return true;
+        }
+
+        if (!readRecord((ExpressionSerialiser::RecordType)type) || mStream->status() != QDataStream::Ok) {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+Symbolic::Expression* ExpressionDeserialiser::get(quint32 index) const
+{
+    return index < (quint32)mExpressions.size() ? mExpressions.at(index) : NULL;
+}
+
+std::string ExpressionDeserialiser::readString()
+{
+    QByteArray string;
+    *mStream >> string;
+    return std::string(string.constData(), string.size());
+}
+
+bool ExpressionDeserialiser::readSource(Symbolic::SymbolicSource* source)
+{
+    quint8 type;
+    quint8 identifierMethod;
+    std::string identifier;
+    qint32 snapshot;
+
+    *mStream >> type >> identifierMethod;
+    identifier = readString();
+    *mStream >> snapshot;
+
+    if (type > Symbolic::UNKNOWN || identifierMethod > Symbolic::EVENT_TARGET_IDENT) {
+        return false;
+    }
+
+    Symbolic::DOMSnapshot* domSnapshot = NULL;
+    if (snapshot != ExpressionSerialiser::NO_SNAPSHOT) {
+        if (snapshot < 0 || snapshot >= mSnapshots.size() || mSnapshots.at(snapshot) == NULL) {
+            return false;
+        }
+        domSnapshot = mSnapshots.at(snapshot);
+    }
+
+    *source = Symbolic::SymbolicSource((Symbolic::SourceType)type,
+                                       (Symbolic::SourceIdentifierMethod)identifierMethod,
+                                       identifier, domSnapshot);
+    return true;
+}
+
+bool ExpressionDeserialiser::readList(std::list<Symbolic::Expression*>* expressions)
+{
+    QList<quint32> indices;
+    *mStream >> indices;
+
+    foreach (quint32 index, indices) {
+        Symbolic::Expression* expression = get(index);
+        if (expression == NULL) {
+            return false;
+        }
+        expressions->push_back(expression);
+    }
+
+    return true;
+}
+
+bool ExpressionDeserialiser::readRecord(ExpressionSerialiser::RecordType type)
+{
+    Symbolic::ExpressionArena* arena = Symbolic::ExpressionArena::persistent();
+    Symbolic::SymbolicSource source(Symbolic::UNKNOWN, Symbolic::INPUT_NAME, "");
+    Symbolic::Expression* expression = NULL;
+
+    switch (type) {
+    case ExpressionSerialiser::DOM_SNAPSHOT: {
+        RestoredDOMSnapshot* snapshot = new RestoredDOMSnapshot();
+
+        quint32 numNodes;
+        *mStream >> numNodes;
+
+        for (quint32 i = 0; i < numNodes && mStream->status() == QDataStream::Ok; i++) {
+            qint64 id;
+            quint32 numAttributes;
+            Symbolic::DOMSnapshotNodeAttributes attributes;
+
+            *mStream >> id;
+            std::string xpath = readString();
+            *mStream >> numAttributes;
+
+            for (quint32 j = 0; j < numAttributes && mStream->status() == QDataStream::Ok; j++) {
+                std::string name = readString();
+                attributes[name] = readString();
+            }
+
+            snapshot->addNode((Symbolic::DOMSnapshotNodeId)id, new RestoredDOMSnapshotNode(xpath, attributes));
+        }
+
+        mExpressions.append(NULL);
+        mSnapshots.append(snapshot);
+        return true;
+    }
+
+    case ExpressionSerialiser::SYMBOLIC_INTEGER:
+        if (readSource(&source)) {
+            expression = Symbolic::SymbolicInteger::create(arena, source);
+        }
+        break;
+
+    case ExpressionSerialiser::CONSTANT_INTEGER: {
+        double value;
+        *mStream >> value;
+        expression = Symbolic::ConstantInteger::create(arena, value);
+        break;
+    }
+
+    case ExpressionSerialiser::INTEGER_BINARY_OPERATION: {
+        Symbolic::IntegerExpression* lhs = readExpression<Symbolic::IntegerExpression>();
+        qint32 op;
+        *mStream >> op;
+        Symbolic::IntegerExpression* rhs = readExpression<Symbolic::IntegerExpression>();
+        if (lhs != NULL && rhs != NULL) {
+            expression = Symbolic::IntegerBinaryOperation::create(arena, lhs, (Symbolic::IntegerBinaryOp)op, rhs);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::INTEGER_COERCION: {
+        Symbolic::Expression* inner = readExpression<Symbolic::Expression>();
+        if (inner != NULL) {
+            expression = Symbolic::IntegerCoercion::create(arena, inner);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::INTEGER_MAX_MIN: {
+        std::list<Symbolic::Expression*> expressions;
+        bool listRead = readList(&expressions);
+        bool max;
+        *mStream >> max;
+        if (listRead) {
+            expression = Symbolic::IntegerMaxMin::create(arena, expressions, max);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::SYMBOLIC_OBJECT:
+        if (readSource(&source)) {
+            expression = Symbolic::SymbolicObject::create(arena, source);
+        }
+        break;
+
+    case ExpressionSerialiser::SYMBOLIC_OBJECT_PROPERTY_STRING: {
+        Symbolic::SymbolicObject* obj = readExpression<Symbolic::SymbolicObject>();
+        std::string propertyName = readString();
+        if (obj != NULL) {
+            expression = Symbolic::SymbolicObjectPropertyString::create(arena, obj, propertyName);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::CONSTANT_OBJECT: {
+        quint32 instanceIdentifier;
+        *mStream >> instanceIdentifier;
+        expression = Symbolic::ConstantObject::create(arena, instanceIdentifier);
+        break;
+    }
+
+    case ExpressionSerialiser::OBJECT_ARRAY_INDEX_OF: {
+        std::list<Symbolic::Expression*> array;
+        bool listRead = readList(&array);
+        Symbolic::Expression* searchElement = readExpression<Symbolic::Expression>();
+        if (listRead && searchElement != NULL) {
+            expression = Symbolic::ObjectArrayIndexOf::create(arena, array, searchElement);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::OBJECT_BINARY_OPERATION: {
+        Symbolic::ObjectExpression* lhs = readExpression<Symbolic::ObjectExpression>();
+        qint32 op;
+        *mStream >> op;
+        Symbolic::ObjectExpression* rhs = readExpression<Symbolic::ObjectExpression>();
+        if (lhs != NULL && rhs != NULL) {
+            expression = Symbolic::ObjectBinaryOperation::create(arena, lhs, (Symbolic::ObjectBinaryOp)op, rhs);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::SYMBOLIC_STRING:
+        if (readSource(&source)) {
+            expression = Symbolic::SymbolicString::create(arena, source);
+        }
+        break;
+
+    case ExpressionSerialiser::CONSTANT_STRING:
+        expression = Symbolic::ConstantString::create(arena, readString());
+        break;
+
+    case ExpressionSerialiser::STRING_BINARY_OPERATION: {
+        Symbolic::StringExpression* lhs = readExpression<Symbolic::StringExpression>();
+        qint32 op;
+        *mStream >> op;
+        Symbolic::StringExpression* rhs = readExpression<Symbolic::StringExpression>();
+        if (lhs != NULL && rhs != NULL) {
+            expression = Symbolic::StringBinaryOperation::create(arena, lhs, (Symbolic::StringBinaryOp)op, rhs);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_COERCION: {
+        Symbolic::Expression* inner = readExpression<Symbolic::Expression>();
+        if (inner != NULL) {
+            expression = Symbolic::StringCoercion::create(arena, inner);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_LENGTH: {
+        Symbolic::StringExpression* string = readExpression<Symbolic::StringExpression>();
+        if (string != NULL) {
+            expression = Symbolic::StringLength::create(arena, string);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REPLACE: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        std::string pattern = readString();
+        std::string replace = readString();
+        if (stringSource != NULL) {
+            expression = Symbolic::StringReplace::create(arena, stringSource, pattern, replace);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_INDEX_OF: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        Symbolic::StringExpression* pattern = readExpression<Symbolic::StringExpression>();
+        Symbolic::IntegerExpression* offset = readExpression<Symbolic::IntegerExpression>();
+        if (stringSource != NULL && pattern != NULL && offset != NULL) {
+            expression = Symbolic::StringIndexOf::create(arena, stringSource, pattern, offset);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_CHAR_AT: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        quint32 position;
+        *mStream >> position;
+        if (stringSource != NULL) {
+            expression = Symbolic::StringCharAt::create(arena, stringSource, position);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_REPLACE: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        std::string regexPattern = readString();
+        std::string replace = readString();
+        if (stringSource != NULL) {
+            expression = Symbolic::StringRegexReplace::create(arena, stringSource, regexPattern, replace);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_SUBMATCH: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        std::string regexPattern = readString();
+        if (stringSource != NULL) {
+            expression = Symbolic::StringRegexSubmatch::create(arena, stringSource, regexPattern);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_SUBMATCH_INDEX: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        std::string regexPattern = readString();
+        if (stringSource != NULL) {
+            expression = Symbolic::StringRegexSubmatchIndex::create(arena, stringSource, regexPattern);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_SUBMATCH_ARRAY: {
+        quint32 identifier;
+        *mStream >> identifier;
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        std::string regexPattern = readString();
+        if (stringSource != NULL) {
+            expression = Symbolic::StringRegexSubmatchArray::create(arena, identifier, stringSource, regexPattern);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_SUBMATCH_ARRAY_AT: {
+        Symbolic::StringRegexSubmatchArray* match = readExpression<Symbolic::StringRegexSubmatchArray>();
+        qint32 group;
+        *mStream >> group;
+        if (match != NULL) {
+            expression = Symbolic::StringRegexSubmatchArrayAt::create(arena, match, group);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_REGEX_SUBMATCH_ARRAY_MATCH: {
+        Symbolic::StringRegexSubmatchArray* match = readExpression<Symbolic::StringRegexSubmatchArray>();
+        if (match != NULL) {
+            expression = Symbolic::StringRegexSubmatchArrayMatch::create(arena, match);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::STRING_SUBSTRING: {
+        Symbolic::StringExpression* stringSource = readExpression<Symbolic::StringExpression>();
+        qint32 from;
+        qint32 length;
+        *mStream >> from >> length;
+        if (stringSource != NULL) {
+            expression = Symbolic::StringSubstring::create(arena, stringSource, from, length);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::SYMBOLIC_BOOLEAN:
+        if (readSource(&source)) {
+            expression = Symbolic::SymbolicBoolean::create(arena, source);
+        }
+        break;
+
+    case ExpressionSerialiser::CONSTANT_BOOLEAN: {
+        bool value;
+        *mStream >> value;
+        expression = Symbolic::ConstantBoolean::create(arena, value);
+        break;
+    }
+
+    case ExpressionSerialiser::BOOLEAN_COERCION: {
+        Symbolic::Expression* inner = readExpression<Symbolic::Expression>();
+        if (inner != NULL) {
+            expression = Symbolic::BooleanCoercion::create(arena, inner);
+        }
+        break;
+    }
+
+    case ExpressionSerialiser::BOOLEAN_BINARY_OPERATION: {
+        Symbolic::BooleanExpression* lhs = readExpression<Symbolic::BooleanExpression>();
+        qint32 op;
+        *mStream >> op;
+        Symbolic::BooleanExpression* rhs = readExpression<Symbolic::BooleanExpression>();
+        if (lhs != NULL && rhs != NULL) {
+            expression = Symbolic::BooleanBinaryOperation::create(arena, lhs, (Symbolic::BooleanBinaryOp)op, rhs);
+        }
+        break;
+    }
+
+    default:
+        return false;
+    }
+
+    if (expression == NULL) {
+        return false;
+    }
+
+    mExpressions.append(expression);
+    mSnapshots.append(NULL);
+    return true;
+}
+
+} // namespace artemis
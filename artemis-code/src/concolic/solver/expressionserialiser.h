@@ -0,0 +1,147 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXPRESSIONSERIALISER_H
+#define EXPRESSIONSERIALISER_H
+
+#include <string>
+
+#include <QDataStream>
+#include <QHash>
+#include <QList>
+#include <QVector>
+
+#include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/symbolic/expression/visitor.h"
+#include "JavaScriptCore/symbolic/expression/symbolicsource.h"
+
+namespace artemis
+{
+
+/**
+ * Writes symbolic expressions to a stream, so they can be read back with ExpressionDeserialiser.
+ *
+ * The expressions are written as a table of records, where each record only refers to earlier records by their
+ * index. Like in the arena, a sub-expression (or DOM snapshot) shared by several expressions is only written once.
+ * Call write() for each expression to store and keep the returned index, then finish() ends the table.
+ */
+class ExpressionSerialiser : public Symbolic::Visitor
+{
+public:
+    ExpressionSerialiser(QDataStream* stream);
+
+    quint32 write(Symbolic::Expression* expression);
+    void finish();
+
+    void visit(Symbolic::ConstantObject* obj, void* arg);
+    void visit(Symbolic::ObjectBinaryOperation* obj, void* arg);
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg);
+    void visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg);
+    void visit(Symbolic::IntegerCoercion* integercoercion, void* arg);
+    void visit(Symbolic::IntegerMaxMin* obj, void* arg);
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+    void visit(Symbolic::ConstantString* constantstring, void* arg);
+    void visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg);
+    void visit(Symbolic::StringCoercion* stringcoercion, void* arg);
+    void visit(Symbolic::StringCharAt* stringcharat, void* arg);
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg);
+    void visit(Symbolic::StringRegexSubmatch* submatch, void* arg);
+    void visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArray* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg);
+    void visit(Symbolic::StringReplace* stringreplace, void* arg);
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+    void visit(Symbolic::ConstantBoolean* constantboolean, void* arg);
+    void visit(Symbolic::BooleanCoercion* booleancoercion, void* arg);
+    void visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg);
+    void visit(Symbolic::StringLength* stringlength, void* arg);
+    void visit(Symbolic::StringIndexOf* stringindexof, void* arg);
+    void visit(Symbolic::SymbolicObject* symbolicobject, void* arg);
+    void visit(Symbolic::ObjectArrayIndexOf* objectarrayindexof, void* arg);
+    void visit(Symbolic::SymbolicObjectPropertyString* obj, void* arg);
+    void visit(Symbolic::StringSubstring* obj, void* arg);
+
+    enum RecordType {
+        END_OF_TABLE,
+        SYMBOLIC_INTEGER, CONSTANT_INTEGER, INTEGER_BINARY_OPERATION, INTEGER_COERCION, INTEGER_MAX_MIN,
+        SYMBOLIC_OBJECT, SYMBOLIC_OBJECT_PROPERTY_STRING, CONSTANT_OBJECT, OBJECT_ARRAY_INDEX_OF,
+        OBJECT_BINARY_OPERATION,
+        SYMBOLIC_STRING, CONSTANT_STRING, STRING_BINARY_OPERATION, STRING_COERCION, STRING_LENGTH, STRING_REPLACE,
+        STRING_INDEX_OF, STRING_CHAR_AT, STRING_REGEX_REPLACE, STRING_REGEX_SUBMATCH, STRING_REGEX_SUBMATCH_INDEX,
+        STRING_REGEX_SUBMATCH_ARRAY, STRING_REGEX_SUBMATCH_ARRAY_AT, STRING_REGEX_SUBMATCH_ARRAY_MATCH,
+        STRING_SUBSTRING,
+        SYMBOLIC_BOOLEAN, CONSTANT_BOOLEAN, BOOLEAN_COERCION, BOOLEAN_BINARY_OPERATION,
+        DOM_SNAPSHOT
+    };
+
+    static const qint32 NO_SNAPSHOT = -1;
+
+private:
+    void begin(void* record, RecordType type);
+    void writeString(const std::string& string);
+    qint32 writeSnapshot(Symbolic::SymbolicSource source);
+    void writeSource(const Symbolic::SymbolicSource& source, qint32 snapshot);
+    QList<quint32> writeList(const std::list<Symbolic::Expression*>& expressions);
+
+    QDataStream* mStream;
+
+    // Index of each expression or DOM snapshot which has been written.
+    QHash<void*, quint32> mIndices;
+    quint32 mNextIndex;
+};
+
+/**
+ * Reads a table written by ExpressionSerialiser, creating the expressions in the persistent arena.
+ *
+ * DOM snapshots are restored as plain copies of the node xpaths and attributes. They are never released, like the
+ * expressions which refer to them.
+ */
+class ExpressionDeserialiser
+{
+public:
+    ExpressionDeserialiser(QDataStream* stream);
+
+    // Returns false if the table is corrupt.
+    bool read();
+
+    // Returns NULL for an index which is not an expression.
+    Symbolic::Expression* get(quint32 index) const;
+
+private:
+    bool readRecord(ExpressionSerialiser::RecordType type);
+    std::string readString();
+    bool readSource(Symbolic::SymbolicSource* source);
+    bool readList(std::list<Symbolic::Expression*>* expressions);
+
+    template <typename T>
+    T* readExpression()
+    {
+        quint32 index;
+        *mStream >> index;
+        return static_cast<T*>(get(index));
+    }
+
+    QDataStream* mStream;
+
+    QVector<Symbolic::Expression*> mExpressions;
+    QVector<Symbolic::DOMSnapshot*> mSnapshots; // Indexed like mExpressions, NULL for expression records.
+};
+
+} // namespace artemis
+
+#endif // EXPRESSIONSERIALISER_H
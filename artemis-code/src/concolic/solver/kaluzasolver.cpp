@@ -19,6 +19,7 @@
 #include <fstream>
 #include <sstream>
 
+#include <QAtomicInt>
 #include <QDebug>
 #include <QDir>
 #include <QString>
@@ -32,20 +33,30 @@
 namespace artemis
 {
 
-KaluzaSolver::KaluzaSolver(ConcolicBenchmarkFeatures disabledFeatures)
+KaluzaSolver::KaluzaSolver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir)
     : Solver(disabledFeatures)
+    , mConstraintDir(constraintDir)
 {
+    // Each solver pool worker owns its own solver, so the instances must not share their files either.
+    static QAtomicInt nextInstance(0);
+    int instance = nextInstance.fetchAndAddOrdered(1);
+
+    // Absolute, as artemiskaluza.sh changes into the Kaluza directory before reading its input.
+    mInputFile = QDir(mConstraintDir).absoluteFilePath(QString("kaluza-%1").arg(instance));
+    mResultFile = QDir(mConstraintDir).absoluteFilePath(QString("kaluza-result-%1").arg(instance));
 }
 
 SolutionPtr KaluzaSolver::solve(PathConditionPtr pc, FormRestrictions formRestrictions)
 {
     qDebug() << "Warning: KaluzaSolver does not support implicit form restrictions.\n";
 
+    QDir().mkpath(mConstraintDir);
+
     // 1. translate pc to something solvable using the translator
 
     KaluzaConstraintWriterPtr constraintwriter = KaluzaConstraintWriterPtr(new KaluzaConstraintWriter());
 
-    if (!constraintwriter->write(pc, formRestrictions, "/tmp/kaluza")) {
+    if (!constraintwriter->write(pc, formRestrictions, mInputFile.toStdString())) {
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotWritten", 1);
         return SolutionPtr(new Solution(false, false));
     }
@@ -69,7 +80,8 @@ SolutionPtr KaluzaSolver::solve(PathConditionPtr pc, FormRestrictions formRestri
         return SolutionPtr(new Solution(false, false));
     }
 
-    int result = std::system(solverpath.filePath("artemiskaluza.sh").toStdString().data());
+    std::string cmd = solverpath.filePath("artemiskaluza.sh").toStdString() + " \"" + mInputFile.toStdString() + "\" \"" + mResultFile.toStdString() + "\"";
+    int result = std::system(cmd.data());
 
     if (result != 0) {
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
@@ -86,7 +98,7 @@ SolutionPtr KaluzaSolver::solve(PathConditionPtr pc, FormRestrictions formRestri
     }
 
     std::string line;
-    std::ifstream fp("/tmp/kaluza-result");
+    std::ifstream fp(mResultFile.toStdString().data());
 
     if (fp.is_open()) {
         while (fp.good()) {
@@ -26,10 +26,17 @@ class KaluzaSolver : public Solver
 {
 public:
 
-    KaluzaSolver(ConcolicBenchmarkFeatures disabledFeatures);
+    KaluzaSolver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir);
 
     SolutionPtr solve(PathConditionPtr pc, FormRestrictions formRestrictions);
 
+private:
+    QString mConstraintDir;
+
+    // The solver input and result files, inside the constraint directory and distinct for each solver instance.
+    QString mInputFile;
+    QString mResultFile;
+
 };
 
 typedef QSharedPointer<KaluzaSolver> KaluzaSolverPtr;
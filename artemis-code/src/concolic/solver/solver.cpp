@@ -14,11 +14,15 @@
  * limitations under the License.
  */
 
+#include <QCoreApplication>
+#include <QDir>
+
 #include "solver.h"
 
 #include "z3solver.h"
 #include "kaluzasolver.h"
 #include "cvc4solver.h"
+#include "solvercache.h"
 
 namespace artemis
 {
@@ -31,17 +35,38 @@ Solver::Solver(ConcolicBenchmarkFeatures disabledFeatures)
 
 QSharedPointer<Solver> Solver::getSolver(const Options& options)
 {
+    SolverPtr solver;
+
     switch(options.solver) {
     case Z3STR:
-        return Z3SolverPtr(new Z3Solver(options.concolicDisabledFeatures));
+        solver = Z3SolverPtr(new Z3Solver(options.concolicDisabledFeatures, getConstraintDir(options)));
+        break;
     case KALUZA:
-        return KaluzaSolverPtr(new KaluzaSolver(options.concolicDisabledFeatures));
+        solver = KaluzaSolverPtr(new KaluzaSolver(options.concolicDisabledFeatures, getConstraintDir(options)));
+        break;
     case CVC4:
-        return CVC4SolverPtr(new CVC4Solver(options.concolicDisabledFeatures));
+        solver = CVC4SolverPtr(new CVC4Solver(options.concolicDisabledFeatures, getConstraintDir(options)));
+        break;
     default:
         std::cerr << "Unknown solver selected" << std::endl;
         exit(1);
     }
+
+    if (options.concolicSolverCache) {
+        solver = SolverPtr(new CachingSolver(solver, SolverCache::getCache(options), options.concolicDisabledFeatures));
+    }
+
+    return solver;
+}
+
+QString Solver::getConstraintDir(const Options& options)
+{
+    if (!options.concolicConstraintDir.isEmpty()) {
+        return options.concolicConstraintDir;
+    }
+
+    // Concurrent Artemis processes must not overwrite each others constraint files
+    return QDir::temp().filePath(QString("artemis-constraints-%1").arg(QCoreApplication::applicationPid()));
 }
 
 
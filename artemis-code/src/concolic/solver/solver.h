@@ -46,6 +46,9 @@ public:
 
     static QSharedPointer<Solver> getSolver(const Options& options);
 
+    // The directory receiving the constraint log, the constraint index and the constraint files of each query.
+    static QString getConstraintDir(const Options& options);
+
 protected:
     // Benchmarking
     ConcolicBenchmarkFeatures mDisabledFeatures;
@@ -0,0 +1,481 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+
+#include <QDataStream>
+#include <QMutexLocker>
+
+#include "statistics/statsstorage.h"
+#include "util/loggingutil.h"
+
+#include "solvercache.h"
+
+namespace artemis
+{
+
+// Input variables are named after their form field, with a prefix giving the type they were read as.
+static const char* const inputPrefixes[] = {"SYM_IN_INT_", "SYM_IN_BOOL_", "SYM_IN_"};
+
+static bool splitIdentifier(const QString& identifier, QString* prefix, QString* base)
+{
+    for (uint i = 0; i < sizeof(inputPrefixes) / sizeof(inputPrefixes[0]); i++) {
+        if (identifier.startsWith(inputPrefixes[i])) {
+            *prefix = inputPrefixes[i];
+            *base = identifier.mid(prefix->length());
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static QString makeKey(const QStringList& clauses, const QStringList& restrictions)
+{
+    return clauses.join("\n") + "\n\n" + restrictions.join("\n");
+}
+
+static const QString cacheFileMagic = "artemis-solver-cache";
+static const qint32 cacheFileVersion = 1;
+
+QString CanonicalPathCondition::key() const
+{
+    return makeKey(clauses, restrictions);
+}
+
+SolverCache::SolverCache(QString configuration, QString persistentFile)
+    : mConfiguration(configuration)
+    , mFile(persistentFile)
+{
+    if (!persistentFile.isEmpty()) {
+        load();
+    }
+}
+
+SolverCache::~SolverCache()
+{
+    if (mFile.isOpen()) {
+        mFile.close();
+    }
+}
+
+QSharedPointer<SolverCache> SolverCache::getCache(const Options& options)
+{
+    static QMutex cacheMutex;
+    static SolverCachePtr cache;
+
+    QMutexLocker locker(&cacheMutex);
+
+    if (cache.isNull()) {
+        // Solutions are only valid for the solver (and solver features) which produced them.
+        QString configuration = QString("solver=%1 disabled-features=%2").arg(options.solver).arg((int)options.concolicDisabledFeatures);
+        cache = SolverCachePtr(new SolverCache(configuration, options.concolicSolverCacheFile));
+    }
+
+    return cache;
+}
+
+CanonicalPathCondition SolverCache::canonicalise(PathConditionPtr pc, FormRestrictions restrictions)
+{
+    CanonicalPathCondition result;
+    result.cacheable = true;
+
+    CanonicalExpressionPrinter printer(&result);
+    QSet<QString> clauses;
+
+    for (uint i = 0; i < pc->size(); i++) {
+        const QPair<Symbolic::Expression*, bool> condition = pc->get(i);
+
+        printer.clear();
+        condition.first->accept(&printer);
+
+        clauses.insert(QString(condition.second ? "" : "!") + QString::fromStdString(printer.getResult()));
+    }
+
+    result.clauses = clauses.toList();
+    result.clauses.sort();
+
+    // Only the restrictions on variables in the PC are relevant, the others can be satisfied independently.
+    foreach (SelectRestriction sr, restrictions.first) {
+        if (!result.realToCanonical.contains(sr.variable)) {
+            continue;
+        }
+
+        QString line = QString("select %1").arg(result.realToCanonical.value(sr.variable));
+        foreach (QString value, sr.values) {
+            line += QString(" %1:%2").arg(value.length()).arg(value);
+        }
+
+        result.restrictions.append(line);
+    }
+
+    foreach (RadioRestriction rr, restrictions.second) {
+        QStringList variables;
+        bool relevant = false;
+
+        foreach (QString variable, rr.variables) {
+            if (result.realToCanonical.contains(variable)) {
+                variables.append(result.realToCanonical.value(variable));
+                relevant = true;
+            } else {
+                variables.append(QString("=%1").arg(variable));
+            }
+        }
+
+        if (!relevant) {
+            continue;
+        }
+
+        foreach (QString variable, rr.variables) {
+            if (!result.realToCanonical.contains(variable)) {
+                result.verbatim.insert(variable);
+            }
+        }
+
+        variables.sort();
+        result.restrictions.append(QString("radio %1 %2").arg(rr.alwaysSet ? "always-set" : "optional").arg(variables.join(" ")));
+    }
+
+    result.restrictions.sort();
+
+    return result;
+}
+
+SolutionPtr SolverCache::lookup(const CanonicalPathCondition& pc)
+{
+    assert(pc.cacheable);
+
+    QMutexLocker locker(&mMutex);
+
+    QString key = pc.key();
+
+    QHash<QString, SatEntry>::const_iterator sat = mSat.constFind(key);
+    if (sat != mSat.constEnd()) {
+        SolutionPtr solution = SolutionPtr(new Solution(true, false));
+
+        foreach (const CachedSymbol& symbol, sat.value().model) {
+            QString prefix, base;
+            if (symbol.canonical && splitIdentifier(symbol.identifier, &prefix, &base)) {
+                solution->insertSymbol(prefix + pc.canonicalToReal.value(base), symbol.value);
+            } else {
+                solution->insertSymbol(symbol.identifier, symbol.value);
+            }
+        }
+
+        Statistics::statistics()->accumulate("Concolic::Solver::CacheHits", 1);
+        return solution;
+    }
+
+    if (mUnsat.contains(key)) {
+        Statistics::statistics()->accumulate("Concolic::Solver::CacheHits", 1);
+        return SolutionPtr(new Solution(false, true));
+    }
+
+    // Adding clauses or restrictions to an UNSAT PC can not make it SAT.
+    QSet<QString> clauses = pc.clauses.toSet();
+    QSet<QString> restrictions = pc.restrictions.toSet();
+
+    foreach (const UnsatEntry& entry, mUnsatEntries) {
+        if (entry.clauses.size() <= clauses.size() && clauses.contains(entry.clauses) && restrictions.contains(entry.restrictions)) {
+            Statistics::statistics()->accumulate("Concolic::Solver::CacheUnsatSubsumed", 1);
+            return SolutionPtr(new Solution(false, true));
+        }
+    }
+
+    Statistics::statistics()->accumulate("Concolic::Solver::CacheMisses", 1);
+    return SolutionPtr();
+}
+
+void SolverCache::insert(const CanonicalPathCondition& pc, SolutionPtr solution)
+{
+    assert(pc.cacheable);
+
+    // Unsolvable PCs are not cached, as they may be retried with difficult branches removed.
+    if (solution.isNull() || (!solution->isSolved() && !solution->isUnsat())) {
+        return;
+    }
+
+    QList<CachedSymbol> model;
+
+    if (solution->isSolved()) {
+        foreach (QString identifier, solution->symbols()) {
+            CachedSymbol symbol;
+            symbol.value = solution->findSymbol(identifier);
+
+            QString prefix, base;
+            if (!splitIdentifier(identifier, &prefix, &base)) {
+                continue;
+            }
+
+            if (pc.realToCanonical.contains(base)) {
+                symbol.canonical = true;
+                symbol.identifier = prefix + pc.realToCanonical.value(base);
+            } else if (pc.verbatim.contains(base)) {
+                symbol.canonical = false;
+                symbol.identifier = identifier;
+            } else {
+                // Values for fields which are not constrained by this PC are left to the defaults.
+                continue;
+            }
+
+            model.append(symbol);
+        }
+    }
+
+    QMutexLocker locker(&mMutex);
+
+    insertEntry(solution->isSolved(), pc.clauses, pc.restrictions, model);
+
+    if (mFile.isOpen()) {
+        appendToFile(solution->isSolved(), pc.clauses, pc.restrictions, model);
+    }
+}
+
+void SolverCache::insertEntry(bool sat, const QStringList& clauses, const QStringList& restrictions, const QList<CachedSymbol>& model)
+{
+    QString key = makeKey(clauses, restrictions);
+
+    if (sat) {
+        SatEntry entry;
+        entry.clauses = clauses;
+        entry.restrictions = restrictions;
+        entry.model = model;
+        mSat.insert(key, entry);
+
+    } else if (!mUnsat.contains(key)) {
+        mUnsat.insert(key);
+
+        UnsatEntry entry;
+        entry.clauses = clauses.toSet();
+        entry.restrictions = restrictions.toSet();
+        mUnsatEntries.append(entry);
+    }
+}
+
+// The cache file is a header followed by one record per entry, in the order they were found.
+void SolverCache::load()
+{
+    bool reuseFile = false;
+    int loaded = 0;
+
+    if (mFile.open(QIODevice::ReadOnly)) {
+        QDataStream in(&mFile);
+
+        QString magic;
+        qint32 version;
+        QString configuration;
+        in >> magic >> version >> configuration;
+
+        reuseFile = in.status() == QDataStream::Ok && magic == cacheFileMagic && version == cacheFileVersion && configuration == mConfiguration;
+
+        if (!reuseFile) {
+            Log::info(QString("Ignoring solver cache %1, which was written by a different configuration.").arg(mFile.fileName()).toStdString());
+        }
+
+        while (reuseFile && !in.atEnd()) {
+            bool sat;
+            QStringList clauses;
+            QStringList restrictions;
+            qint32 modelSize;
+            in >> sat >> clauses >> restrictions >> modelSize;
+
+            QList<CachedSymbol> model;
+            for (qint32 i = 0; i < modelSize && in.status() == QDataStream::Ok; i++) {
+                CachedSymbol symbol;
+                qint32 kind;
+                qint32 integer;
+                QString string;
+                in >> symbol.canonical >> symbol.identifier >> kind >> integer >> symbol.value.u.boolean >> string;
+
+                symbol.value.found = true;
+                symbol.value.kind = (Symbolic::Type)kind;
+                if (kind == Symbolic::INT) {
+                    symbol.value.u.integer = integer;
+                }
+                symbol.value.string = string.toStdString();
+
+                model.append(symbol);
+            }
+
+            // A run which was killed may have left a partial record at the end of the file.
+            if (in.status() != QDataStream::Ok) {
+                Log::info(QString("Ignoring incomplete entry at the end of solver cache %1.").arg(mFile.fileName()).toStdString());
+                break;
+            }
+
+            insertEntry(sat, clauses, restrictions, model);
+            loaded++;
+        }
+
+        mFile.close();
+    }
+
+    Statistics::statistics()->accumulate("Concolic::Solver::CacheEntriesLoaded", loaded);
+
+    if (reuseFile && mFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return;
+    }
+
+    // Start a new file, which also drops any partial record.
+    if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        Log::error(QString("Could not open solver cache %1 for writing.").arg(mFile.fileName()).toStdString());
+        return;
+    }
+
+    {
+        QDataStream out(&mFile);
+        out << cacheFileMagic << cacheFileVersion << mConfiguration;
+    }
+
+    foreach (const SatEntry& entry, mSat) {
+        appendToFile(true, entry.clauses, entry.restrictions, entry.model);
+    }
+
+    foreach (const UnsatEntry& entry, mUnsatEntries) {
+        QStringList clauses = entry.clauses.toList();
+        QStringList restrictions = entry.restrictions.toList();
+        clauses.sort();
+        restrictions.sort();
+        appendToFile(false, clauses, restrictions, QList<CachedSymbol>());
+    }
+}
+
+void SolverCache::appendToFile(bool sat, const QStringList& clauses, const QStringList& restrictions, const QList<CachedSymbol>& model)
+{
+    QDataStream out(&mFile);
+
+    out << sat << clauses << restrictions << (qint32)model.size();
+
+    foreach (const CachedSymbol& symbol, model) {
+        qint32 integer = symbol.value.kind == Symbolic::INT ? symbol.value.u.integer : 0;
+        bool boolean = symbol.value.kind == Symbolic::BOOL ? symbol.value.u.boolean : false;
+
+        out << symbol.canonical << symbol.identifier << (qint32)symbol.value.kind << integer << boolean << QString::fromStdString(symbol.value.string);
+    }
+
+    mFile.flush();
+}
+
+SolverCache::CanonicalExpressionPrinter::CanonicalExpressionPrinter(CanonicalPathCondition* pc)
+    : mPC(pc)
+{
+}
+
+void SolverCache::CanonicalExpressionPrinter::printVariable(const std::string& identifier)
+{
+    QString prefix, base;
+
+    if (!splitIdentifier(QString::fromStdString(identifier), &prefix, &base)) {
+        mPC->cacheable = false;
+        m_result += identifier;
+        return;
+    }
+
+    QString canonical = mPC->realToCanonical.value(base);
+
+    if (canonical.isEmpty()) {
+        canonical = QString("$%1").arg(mPC->realToCanonical.size());
+        mPC->realToCanonical.insert(base, canonical);
+        mPC->canonicalToReal.insert(canonical, base);
+    }
+
+    m_result += (prefix + canonical).toStdString();
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    printVariable(symbolicinteger->getSource().getIdentifier());
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    printVariable(symbolicstring->getSource().getIdentifier());
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    printVariable(symbolicboolean->getSource().getIdentifier());
+}
+
+// Strings are printed with their length, so constants containing quotes can not make two different PCs look the same.
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    std::ostringstream length;
+    length << constantstring->getValue()->length();
+
+    m_result += length.str();
+    m_result += ':';
+    m_result += *(constantstring->getValue());
+}
+
+// Constraints on DOM objects are solved against the current page, so they are never reused.
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::ConstantObject* obj, void* arg)
+{
+    mPC->cacheable = false;
+    ExpressionValuePrinter::visit(obj, arg);
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::SymbolicObject* symbolicobject, void* arg)
+{
+    mPC->cacheable = false;
+    ExpressionValuePrinter::visit(symbolicobject, arg);
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::SymbolicObjectPropertyString* obj, void* arg)
+{
+    mPC->cacheable = false;
+    ExpressionValuePrinter::visit(obj, arg);
+}
+
+void SolverCache::CanonicalExpressionPrinter::visit(Symbolic::ObjectArrayIndexOf* obj, void* arg)
+{
+    mPC->cacheable = false;
+    ExpressionPrinter::visit(obj, arg);
+}
+
+CachingSolver::CachingSolver(SolverPtr solver, SolverCachePtr cache, ConcolicBenchmarkFeatures disabledFeatures)
+    : Solver(disabledFeatures)
+    , mSolver(solver)
+    , mCache(cache)
+{
+}
+
+SolutionPtr CachingSolver::solve(PathConditionPtr pc, FormRestrictions formRestrictions)
+{
+    CanonicalPathCondition canonical = SolverCache::canonicalise(pc, formRestrictions);
+
+    if (canonical.cacheable) {
+        SolutionPtr cached = mCache->lookup(canonical);
+
+        if (!cached.isNull()) {
+            mLastConstraintID = "";
+            return cached;
+        }
+    }
+
+    SolutionPtr solution = mSolver->solve(pc, formRestrictions);
+    mLastConstraintID = mSolver->getLastConstraintID();
+
+    if (canonical.cacheable) {
+        mCache->insert(canonical, solution);
+    }
+
+    return solution;
+}
+
+} // namespace artemis
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SOLVERCACHE_H
+#define SOLVERCACHE_H
+
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+
+#include "concolic/pathcondition.h"
+#include "runtime/input/forms/formfieldrestrictedvalues.h"
+#include "runtime/options.h"
+
+#include "expressionvalueprinter.h"
+#include "solver.h"
+#include "solution.h"
+
+namespace artemis
+{
+
+/**
+ * A path condition (and the form restrictions on its variables) in a canonical form.
+ *
+ * The clauses are printed with the free variables renamed in order of their first occurrence, and are then sorted,
+ * so two path conditions which only differ in the naming of the form fields (or in the order of their clauses) have
+ * the same canonical form.
+ */
+struct CanonicalPathCondition
+{
+    bool cacheable; // false if the PC depends on the DOM (e.g. a symbolic target), so it can not be reused.
+
+    QStringList clauses;
+    QStringList restrictions;
+
+    QHash<QString, QString> realToCanonical; // Variable names without their SYM_IN_ type prefix.
+    QHash<QString, QString> canonicalToReal;
+    QSet<QString> verbatim; // Variables which only appear in the restrictions, and are therefore not renamed.
+
+    QString key() const;
+};
+
+/**
+ * Solutions of canonicalised path conditions, shared by all solvers of this process.
+ *
+ * SAT models are reused for identical PCs. A PC is known to be UNSAT if it contains all the clauses (and
+ * restrictions) of a PC which was found to be UNSAT before.
+ * If a file is given the cache is loaded from it, and new entries are appended to it as they are found.
+ */
+class SolverCache
+{
+public:
+    SolverCache(QString configuration, QString persistentFile);
+    ~SolverCache();
+
+    static QSharedPointer<SolverCache> getCache(const Options& options);
+
+    static CanonicalPathCondition canonicalise(PathConditionPtr pc, FormRestrictions restrictions);
+
+    // Returns a null pointer if there is no usable entry for this PC.
+    SolutionPtr lookup(const CanonicalPathCondition& pc);
+    void insert(const CanonicalPathCondition& pc, SolutionPtr solution);
+
+private:
+    struct CachedSymbol
+    {
+        bool canonical;
+        QString identifier;
+        Symbolvalue value;
+    };
+
+    struct SatEntry
+    {
+        QStringList clauses;
+        QStringList restrictions;
+        QList<CachedSymbol> model;
+    };
+
+    struct UnsatEntry
+    {
+        QSet<QString> clauses;
+        QSet<QString> restrictions;
+    };
+
+    void load();
+    void appendToFile(bool sat, const QStringList& clauses, const QStringList& restrictions, const QList<CachedSymbol>& model);
+    void insertEntry(bool sat, const QStringList& clauses, const QStringList& restrictions, const QList<CachedSymbol>& model);
+
+    QString mConfiguration;
+    QFile mFile;
+
+    QMutex mMutex;
+    QHash<QString, SatEntry> mSat;
+    QSet<QString> mUnsat;
+    QList<UnsatEntry> mUnsatEntries;
+
+    class CanonicalExpressionPrinter : public ExpressionValuePrinter
+    {
+    public:
+        CanonicalExpressionPrinter(CanonicalPathCondition* pc);
+
+        void visit(Symbolic::ConstantObject* obj, void* arg);
+        void visit(Symbolic::ConstantString* constantstring, void* arg);
+        void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+        void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+        void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+        void visit(Symbolic::SymbolicObject* symbolicobject, void* arg);
+        void visit(Symbolic::SymbolicObjectPropertyString* obj, void* arg);
+        void visit(Symbolic::ObjectArrayIndexOf* obj, void* arg);
+
+    private:
+        void printVariable(const std::string& identifier);
+
+        CanonicalPathCondition* mPC;
+    };
+};
+
+typedef QSharedPointer<SolverCache> SolverCachePtr;
+
+/**
+ * Answers queries from the SolverCache where possible, and passes the rest on to the real solver.
+ */
+class CachingSolver : public Solver
+{
+public:
+    CachingSolver(SolverPtr solver, SolverCachePtr cache, ConcolicBenchmarkFeatures disabledFeatures);
+
+    SolutionPtr solve(PathConditionPtr pc, FormRestrictions formRestrictions);
+
+    QString getLastConstraintID() { return mLastConstraintID; }
+
+private:
+    SolverPtr mSolver;
+    SolverCachePtr mCache;
+    QString mLastConstraintID;
+};
+
+}
+
+#endif // SOLVERCACHE_H
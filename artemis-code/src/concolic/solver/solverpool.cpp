@@ -0,0 +1,137 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <assert.h>
+
+#include "solverpool.h"
+
+namespace artemis
+{
+
+SolverPool::SolverPool(const Options& options, int numWorkers)
+    : mPending(0)
+    , mStopping(false)
+{
+    assert(numWorkers > 0);
+
+    for (int i = 0; i < numWorkers; i++) {
+        SolverWorker* worker = new SolverWorker(options, this);
+        worker->start();
+        mWorkers.append(worker);
+    }
+}
+
+SolverPool::~SolverPool()
+{
+    {
+        QMutexLocker locker(&mMutex);
+
+        mStopping = true;
+        mTaskAvailable.wakeAll();
+    }
+
+    foreach (SolverWorker* worker, mWorkers) {
+        worker->wait();
+        delete worker;
+    }
+}
+
+int SolverPool::size() const
+{
+    return mWorkers.size();
+}
+
+int SolverPool::pending() const
+{
+    QMutexLocker locker(&mMutex);
+
+    return mPending;
+}
+
+void SolverPool::submit(TaskPtr task)
+{
+    QMutexLocker locker(&mMutex);
+
+    mQueued.enqueue(task);
+    mPending++;
+    mTaskAvailable.wakeOne();
+}
+
+SolverPool::TaskPtr SolverPool::takeSolved()
+{
+    QMutexLocker locker(&mMutex);
+
+    assert(mPending > 0);
+
+    while (mSolved.isEmpty()) {
+        mTaskSolved.wait(&mMutex);
+    }
+
+    mPending--;
+    return mSolved.dequeue();
+}
+
+SolverPool::TaskPtr SolverPool::nextTask()
+{
+    QMutexLocker locker(&mMutex);
+
+    while (mQueued.isEmpty() && !mStopping) {
+        mTaskAvailable.wait(&mMutex);
+    }
+
+    if (mStopping) {
+        return TaskPtr();
+    }
+
+    return mQueued.dequeue();
+}
+
+void SolverPool::taskSolved(TaskPtr task)
+{
+    QMutexLocker locker(&mMutex);
+
+    mSolved.enqueue(task);
+    mTaskSolved.wakeOne();
+}
+
+SolverWorker::SolverWorker(const Options& options, SolverPool* pool)
+    : QThread(NULL)
+    , mOptions(options)
+    , mPool(pool)
+{
+}
+
+void SolverWorker::run()
+{
+    // Created here, such that the solver (and any process it starts) belongs to this thread.
+    SolverPtr solver = Solver::getSolver(mOptions);
+
+    forever {
+        SolverPool::TaskPtr task = mPool->nextTask();
+
+        if (task.isNull()) {
+            break;
+        }
+
+        task->solution = solver->solve(task->pc, task->restrictions);
+        task->constraintID = solver->getLastConstraintID();
+
+        mPool->taskSolved(task);
+    }
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SOLVERPOOL_H
+#define SOLVERPOOL_H
+
+#include <QList>
+#include <QQueue>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
+#include <QSharedPointer>
+
+#include "runtime/options.h"
+
+#include "solver.h"
+
+namespace artemis
+{
+
+class SolverWorker;
+
+/**
+ * Solves path conditions concurrently.
+ *
+ * Each worker thread owns its own solver instance (and so its own CVC4 process), which is only ever used from that
+ * thread. The solvers are kept for the lifetime of the pool, such that solver sessions are reused between tasks.
+ *
+ * Submitted tasks wait in a shared queue until a worker is free, and solved tasks are handed back in the order they
+ * are solved, such that a slow query does not hold back the results of the others.
+ */
+class SolverPool
+{
+public:
+    struct Task
+    {
+        PathConditionPtr pc;
+        FormRestrictions restrictions;
+
+        // Set once solved
+        SolutionPtr solution;
+        QString constraintID;
+    };
+
+    typedef QSharedPointer<Task> TaskPtr;
+
+    SolverPool(const Options& options, int numWorkers);
+    ~SolverPool();
+
+    int size() const;
+
+    // The number of submitted tasks which were not taken yet.
+    int pending() const;
+
+    void submit(TaskPtr task);
+
+    // Blocks until a submitted task is solved and returns it.
+    TaskPtr takeSolved();
+
+private:
+    friend class SolverWorker;
+
+    // Used by the workers, returns NULL once the pool is stopping.
+    TaskPtr nextTask();
+    void taskSolved(TaskPtr task);
+
+    QList<SolverWorker*> mWorkers;
+
+    mutable QMutex mMutex;
+    QWaitCondition mTaskAvailable;
+    QWaitCondition mTaskSolved;
+    QQueue<TaskPtr> mQueued;
+    QQueue<TaskPtr> mSolved;
+    int mPending;
+    bool mStopping;
+};
+
+typedef QSharedPointer<SolverPool> SolverPoolPtr;
+
+class SolverWorker : public QThread
+{
+public:
+    SolverWorker(const Options& options, SolverPool* pool);
+
+protected:
+    void run();
+
+private:
+    Options mOptions;
+    SolverPool* mPool;
+};
+
+}
+
+#endif // SOLVERPOOL_H
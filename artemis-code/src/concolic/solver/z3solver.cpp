@@ -20,6 +20,7 @@
 #include <sstream>
 #include <errno.h>
 
+#include <QAtomicInt>
 #include <QDebug>
 #include <QDir>
 #include <QString>
@@ -33,22 +34,30 @@
 namespace artemis
 {
 
-Z3Solver::Z3Solver(ConcolicBenchmarkFeatures disabledFeatures)
+Z3Solver::Z3Solver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir)
     : Solver(disabledFeatures)
+    , mConstraintDir(constraintDir)
 {
+    // Each solver pool worker owns its own solver, so the instances must not share their files either.
+    static QAtomicInt nextInstance(0);
+    int instance = nextInstance.fetchAndAddOrdered(1);
+
+    mInputFile = QDir(mConstraintDir).filePath(QString("z3input-%1").arg(instance));
+    mResultFile = QDir(mConstraintDir).filePath(QString("z3result-%1").arg(instance));
 }
 
 SolutionPtr Z3Solver::solve(PathConditionPtr pc, FormRestrictions formRestrictions)
 {
     qDebug() << "Warning: Z3Solver does not support implicit form restrictions.\n";
 
-    std::ofstream constraintLog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
+    QDir().mkpath(mConstraintDir);
+    std::ofstream constraintLog(QDir(mConstraintDir).filePath("constraintlog").toStdString().c_str(), std::ofstream::out | std::ofstream::app);
 
     // 1. translate pc to something solvable using the translator
 
     Z3STRConstraintWriterPtr cw = Z3STRConstraintWriterPtr(new Z3STRConstraintWriter(mDisabledFeatures));
 
-    if (!cw->write(pc, formRestrictions, "/tmp/z3input")) {
+    if (!cw->write(pc, formRestrictions, mInputFile.toStdString())) {
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsNotWritten", 1);
         constraintLog << "Could not translate the PC into solver input." << std::endl << std::endl;
         return SolutionPtr(new Solution(false, false, "Could not translate the PC into solver input."));
@@ -77,7 +86,7 @@ SolutionPtr Z3Solver::solve(PathConditionPtr pc, FormRestrictions formRestrictio
         return SolutionPtr(new Solution(false, false, "Could not find Z3-str.py."));
     }
 
-    std::string cmd = solverpath.filePath("Z3-str.py").toStdString() + " /tmp/z3input > /tmp/z3result";
+    std::string cmd = solverpath.filePath("Z3-str.py").toStdString() + " \"" + mInputFile.toStdString() + "\" > \"" + mResultFile.toStdString() + "\"";
     int result = std::system(cmd.data());
 
     if (result != 0) {
@@ -100,7 +109,7 @@ SolutionPtr Z3Solver::solve(PathConditionPtr pc, FormRestrictions formRestrictio
     }
 
     std::string line;
-    std::ifstream fp("/tmp/z3result");
+    std::ifstream fp(mResultFile.toStdString().data());
 
     if (fp.is_open()) {
         Statistics::statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
@@ -30,10 +30,17 @@ class Z3Solver : public Solver
 {
 public:
 
-    Z3Solver(ConcolicBenchmarkFeatures disabledFeatures);
+    Z3Solver(ConcolicBenchmarkFeatures disabledFeatures, QString constraintDir);
 
     SolutionPtr solve(PathConditionPtr pc, FormRestrictions formRestrictions);
 
+private:
+    QString mConstraintDir;
+
+    // The solver input and result files, inside the constraint directory and distinct for each solver instance.
+    QString mInputFile;
+    QString mResultFile;
+
 };
 
 typedef QSharedPointer<Z3Solver> Z3SolverPtr;
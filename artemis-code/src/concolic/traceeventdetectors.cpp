@@ -16,6 +16,8 @@
 
 #include <assert.h>
 
+#include <QVector>
+
 #include "traceeventdetectors.h"
 #include "concolic/executiontree/tracebuilder.h"
 
@@ -156,128 +158,168 @@ void TracePageLoadDetector::slPageLoad(QUrl url)
 
 /*
  * DOM Modification Detector
+ */
+
+namespace
+{
+
+/*
+ * Precompiled matcher for the indicator words.
  *
- * Notice, this detector is very memory expensive on large pages (allocates 2^N words where N is the number of tokens on the page).
-*/
-void TraceDomModDetector::slDomModified(QString start, QString end)
+ * The text is split into tokens on whitespace and a few HTML and punctuation characters, and a token matches if it
+ * is equal to one of the words (ignoring case). Since only whole tokens are matched the matcher is a trie over the
+ * words which is walked once per character, without the failure links of a full Aho-Corasick automaton.
+ */
+class IndicatorMatcher
 {
-    // Create the node.
-    QSharedPointer<TraceDomModification> node = QSharedPointer<TraceDomModification>(new TraceDomModification());
 
-    QPair<double, QMap<int, int> > metrics = computeMetrics(start, end);
-    node->amountModified = metrics.first;
-    node->words = metrics.second;
+public:
+    IndicatorMatcher(const QList<QString>& words) :
+        mTransitions(ALPHABET_SIZE, 0),
+        mAccepting(1, -1)
+    {
+        for (int index = 0; index < words.length(); index++) {
+            int state = 0;
+
+            foreach (QChar c, words.at(index).toLower()) {
+                int letter = toLetter(c);
+                assert(letter >= 0); // the words may only contain the letters a-z
+
+                int next = mTransitions[state * ALPHABET_SIZE + letter];
+                if (next == 0) {
+                    next = mAccepting.size();
+                    mTransitions[state * ALPHABET_SIZE + letter] = next;
+                    mTransitions.resize(mTransitions.size() + ALPHABET_SIZE);
+                    mAccepting.append(-1);
+                }
+
+                state = next;
+            }
 
-    // Pass the new node to the trace builder.
-    newNode(node.staticCast<TraceNode>(), &(node->next));
-}
+            mAccepting[state] = index;
+        }
+    }
 
+    // Counts the words found in text into matches, and returns the number of tokens in text.
+    uint scan(const QString& text, QMap<int, int>& matches) const
+    {
+        uint tokens = 0;
+        int state = 0; // -1 when the current token can not match any word
+        bool inToken = false;
+
+        const QChar* data = text.constData();
+        const QChar* end = data + text.length();
+
+        for (; data <= end; data++) {
+            if (data == end || isDelimiter(*data)) {
+                if (inToken) {
+                    tokens++;
+
+                    if (state > 0 && mAccepting[state] != -1) {
+                        matches.insert(mAccepting[state], 1 + matches.value(mAccepting[state], 0));
+                    }
+                }
+
+                inToken = false;
+                state = 0;
+                continue;
+            }
 
-// Takes the two DOM strings and computes the modification metrics.
-// Returns a pair or the amount of modification and the list of indicator words which were added.
-QPair<double, QMap<int, int> > TraceDomModDetector::computeMetrics(QString start, QString end)
-{
-    QStringList startTokens = tokenise(start);
-    QStringList endTokens = tokenise(end);
+            inToken = true;
+
+            if (state != -1) {
+                int letter = toLetter(*data);
+                state = letter == -1 ? -1 : mTransitions[state * ALPHABET_SIZE + letter];
+                state = state == 0 ? -1 : state;
+            }
+        }
 
-    //Log::debug(startTokens.join("\n").toStdString());
+        return tokens;
+    }
 
-    QPair<int, QStringList> result = findInsertions(startTokens, endTokens);
+private:
+    static const int ALPHABET_SIZE = 26;
 
-    Log::debug(QString("Edit distance between DOMs: %1").arg(result.first).toStdString());
-    //Log::debug("Inserted words:");
-    //Log::debug(result.second.join("\n").toStdString());
+    static inline int toLetter(QChar c)
+    {
+        ushort u = c.unicode();
 
-    // Compute the metric of "amount modified". This is not a true percentage, and can even be over 100!
-    double modified = 100.0 * (double)result.first / startTokens.length();
-    Log::debug(QString("Amount modified: %2/%3 = %1%").arg(modified).arg((double)result.first).arg((double)startTokens.length()).toStdString());
-
-    // Check whether any of the inserted words are in our "indicators" list.
-    QMap<int,int> matches;
-    int j;
-    foreach(QString inserted, result.second) {
-        for(j = 0; j < indicators.length(); j++) {
-            if(inserted.compare(indicators.at(j), Qt::CaseInsensitive) == 0) {
-                matches.insert(j, 1 + matches.value(j, 0));
-                Log::debug(QString("On list: %1").arg(inserted).toStdString());
-            }
+        if (u >= 'a' && u <= 'z') {
+            return u - 'a';
+        } else if (u >= 'A' && u <= 'Z') {
+            return u - 'A';
+        }
+
+        return -1;
+    }
+
+    static inline bool isDelimiter(QChar c)
+    {
+        switch (c.unicode()) {
+        case '<': case '>': case '"': case '\'': case ':': case '.': case ',':
+        case '!': case '?': case '/': case ';': case '-':
+            return true;
+        default:
+            return c.isSpace();
         }
     }
 
-    return QPair<double,QMap<int,int> >(modified, matches);
+    QVector<int> mTransitions; // state * ALPHABET_SIZE + letter -> next state, 0 if there is none
+    QVector<int> mAccepting; // state -> index of the word ending in that state, -1 if none
+};
+
 }
 
-// Splits a DOM string into tokens.
-// We split on whitespace and a few HTML characters which will get the text into decently small chunks.
-// Also split on a bunch of punctuation to increase the chance we islate the important words
-// It is not super-important exactly how we define the tokens.
-QStringList TraceDomModDetector::tokenise(QString dom)
+TraceDomModDetector::TraceDomModDetector() :
+    mPageLoaded(false),
+    mLoadedTokens(0),
+    mInsertedTokens(0)
 {
-    QRegExp delimiters("\\s+|<|>|\"|'|:|\\.|,|!|\\?|/|;|-");
-    return dom.split(delimiters, QString::SkipEmptyParts);
 }
 
-// Take two tokenised streams and compute the edit distance (and edits).
-QPair<int, QStringList> TraceDomModDetector::findInsertions(QStringList start, QStringList end)
+void TraceDomModDetector::notifyStartingLoad()
 {
-    int i,j;
-    // This is a pretty simple implementation for now.
-    // I am also only using insertions and deletions (no substitutions). This is because we want a list of what was added and removed, so substitutions are not interesting (and would just add something to both lists anyway).
+    mPageLoaded = false;
+    mLoadedTokens = 0;
+    mInsertedTokens = 0;
+    mWords.clear();
+}
 
-    // Create an array of the distances between each pair of subsequences. Pre-fill with 0s.
-    QVector<QVector<int> > distance(start.length()+1, QVector<int>(end.length()+1, 0));
+void TraceDomModDetector::notifyPageLoaded()
+{
+    mPageLoaded = true;
+}
 
-    // Pre-fill edges with counts 0,1,2,3,...
-    for(i = 1; i <= start.length(); i++) {
-        distance[i][0] = i;
-    }
-    for(j = 1; j <= end.length(); j++) {
-        distance[0][j] = j;
-    }
+void TraceDomModDetector::slDomTextInserted(QString text)
+{
+    static const IndicatorMatcher matcher(indicators);
 
-    // Fill in the matrix row-by-row.
-    for(j = 1; j <= end.length(); j++) {
-        for(i = 1; i <= start.length(); i++) {
-            // If the strings match at this point, then we don't need to do anything. N.B. String indexing is off by one from matrix indexing.
-            if(start.at(i-1).compare(end.at(j-1)) == 0){
-                distance[i][j] = distance[i-1][j-1];
-            }else{
-                // Otherwise, we choose whichever of a deletion or insertion is cheapest.
-                distance[i][j] = min(distance[i-1][j] + 1, distance[i][j-1] + 1);
-            }
-        }
+    if (!mPageLoaded) {
+        QMap<int, int> ignored;
+        mLoadedTokens += matcher.scan(text, ignored);
+        return;
     }
 
-    // Now the edit distance is:
-    int editDistance = distance[start.length()][end.length()];
-
-
-    // To work out the actual edits, we need to backtrack through the table.
-    // We start at the bottom right of the matrix and look for cells with the same or one-lower cost which we can move to.
-    // In this case we are not really interested in the exact solution, just a list of what was added.
-    QStringList insertedWords;
-    i = start.length();
-    j = end.length();
-    while(i > 0 || j > 0) {
-        // If the diagonally-backwards cell d[i-1,j-1] has the same value as d[i,j] and it's the lowes adjacent cell then it is a match which we can ignore.
-        if(i > 0 && j > 0 && distance[i][j] == distance[i-1][j-1] && distance[i-1][j-1] <= distance[i-1][j] && distance[i-1][j-1] <= distance[i][j-1]){
-            i--;
-            j--;
-        } else if(j > 0 && distance[i][j] == distance[i][j-1] + 1) {
-            // Then we have an insertion here.
-            insertedWords.append(end.at(j-1));
-            j--;
-        } else if(i > 0 && distance[i][j] == distance[i-1][j] + 1) {
-            // Then we have a deletion here.
-            i--;
-        } else {
-            // Should never be reached, assuming the matrix was filled correctly.
-            Log::error("Error in TraceDomModDetector::findInsertions() while computing DOM modifications.");
-            break;
-        }
+    mInsertedTokens += matcher.scan(text, mWords);
+}
+
+void TraceDomModDetector::slDomModified(QList<QWebElement> changedElements)
+{
+    // Create the node.
+    QSharedPointer<TraceDomModification> node = QSharedPointer<TraceDomModification>(new TraceDomModification());
+
+    // Compute the metric of "amount modified". This is not a true percentage, and can even be over 100!
+    // Only insertions are counted, removed text is not reported by WebKit.
+    node->amountModified = 100.0 * (double)mInsertedTokens / qMax(mLoadedTokens, 1u);
+    node->words = mWords;
+
+    Log::debug(QString("Amount modified: %2/%3 = %1% (%4 elements changed)").arg(node->amountModified).arg(mInsertedTokens).arg(mLoadedTokens).arg(changedElements.size()).toStdString());
+    foreach (int index, mWords.keys()) {
+        Log::debug(QString("On list: %1").arg(indicators.at(index)).toStdString());
     }
 
-    return QPair<int, QStringList>(editDistance, insertedWords);
+    // Pass the new node to the trace builder.
+    newNode(node.staticCast<TraceNode>(), &(node->next));
 }
 
 // The definition of which words we consider interesting indicators of an error.
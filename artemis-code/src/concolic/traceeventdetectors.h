@@ -16,6 +16,7 @@
 
 #include <QString>
 #include <QWebFrame>
+#include <QWebElement>
 #include <QSharedPointer>
 #include <QSource>
 #include <QWebExecutionListener>
@@ -124,19 +125,29 @@ public slots:
 
 /*
  *  Detector for DOM modifications.
- *  Currently this is used as a "batch" notification of all changes at the end of a trace.
+ *  The text inserted into the document (character data and attribute values) is streamed from WebKit and matched
+ *  against the indicator words as it arrives, only the number of tokens and the indicator hits are kept.
+ *  A single node summarising the modifications is added at the end of a trace which modified the DOM.
  */
 class TraceDomModDetector : public TraceEventDetector
 {
     Q_OBJECT
 
+public:
+    TraceDomModDetector();
+
+    void notifyStartingLoad();
+    void notifyPageLoaded();
+
 public slots:
-    void slDomModified(QString start, QString end);
+    void slDomTextInserted(QString text);
+    void slDomModified(QList<QWebElement> changedElements);
 
 private:
-    static QPair<double, QMap<int, int> > computeMetrics(QString start, QString end);
-    static QStringList tokenise(QString dom);
-    static QPair<int, QStringList> findInsertions(QStringList start, QStringList end);
+    bool mPageLoaded;
+    uint mLoadedTokens; // Tokens inserted while loading the page, the baseline for the amount modified.
+    uint mInsertedTokens; // Tokens inserted after the page was loaded.
+    QMap<int, int> mWords; // Mapping from index of indicators to the number of times it was inserted.
 
     static QList<QString> getIndicators();
 
@@ -14,13 +14,20 @@
  * limitations under the License.
  */
 
+
+#include <algorithm>
+
 #include "codeblockinfo.h"
 
 namespace artemis {
 
 CodeBlockInfo::CodeBlockInfo(QString functionName, size_t bytecodeSize) :
     mFunctionName(functionName),
-    mBytecodeSize(bytecodeSize)
+    mBytecodeSize(bytecodeSize),
+    mNumCoveredBytecodes(0),
+    mCoveredBytecodes(bytecodeSize),
+    mSymbolicCoveredBytecodes(bytecodeSize),
+    mLocations(bytecodeSize)
 {
 }
 
@@ -31,17 +38,136 @@ size_t CodeBlockInfo::getBytecodeSize() const
 
 size_t CodeBlockInfo::numCoveredBytecodes() const
 {
-    return mCoveredBytecodes.size();
+    return mNumCoveredBytecodes;
 }
 
 codeblockid_t CodeBlockInfo::getId(unsigned int sourceOffset, const QString& url, int startline)
 {
-    return sourceOffset * 7 + qHash(url) + 37 * startline;
+    return getIdFromUrlHash(sourceOffset, qHash(url), startline);
+}
+
+bool CodeBlockInfo::setBytecodeCovered(const ByteCodeInfoStruct& binfo)
+{
+    uint offset = binfo.bytecodeOffset;
+
+    if (offset >= mBytecodeSize) {
+        return false;
+    }
+
+    QBitArray& coverage = binfo.isSymbolic ? mSymbolicCoveredBytecodes : mCoveredBytecodes;
+
+    if (coverage.testBit(offset)) {
+        return false;
+    }
+
+    bool newlyCovered = !mCoveredBytecodes.testBit(offset) && !mSymbolicCoveredBytecodes.testBit(offset);
+
+    if (newlyCovered) {
+        BytecodeLocation& location = mLocations[offset];
+        location.linenumber = binfo.linenumber;
+        location.divot = binfo.divot;
+        location.startOffset = binfo.startOffset;
+        location.endOffset = binfo.endOffset;
+
+        mNumCoveredBytecodes++;
+    }
+
+    coverage.setBit(offset);
+
+    return newlyCovered;
+}
+
+void CodeBlockInfo::merge(const CodeBlockInfo& other)
+{
+    if (other.mBytecodeSize != mBytecodeSize) {
+        return;
+    }
+
+    for (size_t offset = 0; offset < mBytecodeSize; offset++) {
+        bool covered = other.mCoveredBytecodes.testBit(offset);
+        bool symbolicCovered = other.mSymbolicCoveredBytecodes.testBit(offset);
+
+        if (!covered && !symbolicCovered) {
+            continue;
+        }
+
+        if (!mCoveredBytecodes.testBit(offset) && !mSymbolicCoveredBytecodes.testBit(offset)) {
+            mLocations[offset] = other.mLocations.at(offset);
+            mNumCoveredBytecodes++;
+        }
+
+        if (covered) {
+            mCoveredBytecodes.setBit(offset);
+        }
+
+        if (symbolicCovered) {
+            mSymbolicCoveredBytecodes.setBit(offset);
+        }
+    }
+}
+
+QDataStream& operator<<(QDataStream& out, const CodeBlockInfo& codeBlock)
+{
+    out << codeBlock.mFunctionName << (quint32)codeBlock.mBytecodeSize << (quint32)codeBlock.mNumCoveredBytecodes;
+    out << codeBlock.mCoveredBytecodes << codeBlock.mSymbolicCoveredBytecodes;
+
+    foreach (const CodeBlockInfo::BytecodeLocation& location, codeBlock.mLocations) {
+        out << (quint32)location.linenumber << (qint32)location.divot << (qint32)location.startOffset << (qint32)location.endOffset;
+    }
+
+    return out;
+}
+
+QDataStream& operator>>(QDataStream& in, CodeBlockInfo& codeBlock)
+{
+    quint32 bytecodeSize;
+    quint32 numCoveredBytecodes;
+
+    in >> codeBlock.mFunctionName >> bytecodeSize >> numCoveredBytecodes;
+    in >> codeBlock.mCoveredBytecodes >> codeBlock.mSymbolicCoveredBytecodes;
+
+    codeBlock.mBytecodeSize = bytecodeSize;
+    codeBlock.mNumCoveredBytecodes = numCoveredBytecodes;
+    codeBlock.mLocations.resize(bytecodeSize);
+
+    for (quint32 offset = 0; offset < bytecodeSize; offset++) {
+        quint32 linenumber;
+        qint32 divot, startOffset, endOffset;
+
+        in >> linenumber >> divot >> startOffset >> endOffset;
+
+        CodeBlockInfo::BytecodeLocation& location = codeBlock.mLocations[offset];
+        location.linenumber = linenumber;
+        location.divot = divot;
+        location.startOffset = startOffset;
+        location.endOffset = endOffset;
+    }
+
+    return in;
+}
+
+void CodeBlockInfo::collectLineCoverage(QSet<uint>& lines, bool symbolic) const
+{
+    const QBitArray& coverage = symbolic ? mSymbolicCoveredBytecodes : mCoveredBytecodes;
+
+    for (size_t offset = 0; offset < mBytecodeSize; offset++) {
+        if (coverage.testBit(offset)) {
+            lines.insert(mLocations.at(offset).linenumber);
+        }
+    }
 }
 
-void CodeBlockInfo::setBytecodeCovered(uint bytecodeOffset)
+void CodeBlockInfo::collectRangeCoverage(QMap<int, int>& startRanges, QMap<int, int>& endRanges, bool symbolic) const
 {
-    mCoveredBytecodes.insert(bytecodeOffset);
+    const QBitArray& coverage = symbolic ? mSymbolicCoveredBytecodes : mCoveredBytecodes;
+
+    for (size_t offset = 0; offset < mBytecodeSize; offset++) {
+        if (coverage.testBit(offset)) {
+            const BytecodeLocation& location = mLocations.at(offset);
+            startRanges[location.divot] = std::max(location.startOffset, startRanges.value(location.divot, 0));
+            endRanges[location.divot] = std::max(location.endOffset, endRanges.value(location.divot, 0));
+        }
+    }
 }
 
 }
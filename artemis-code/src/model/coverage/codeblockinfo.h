@@ -14,16 +14,29 @@
  * limitations under the License.
  */
 
+
 #ifndef CODEBLOCKINFO_H
 #define CODEBLOCKINFO_H
 
 #include <QString>
 #include <QSet>
+#include <QMap>
+#include <QVector>
+#include <QBitArray>
+#include <QDataStream>
+#include <QWebExecutionListener>
 
 namespace artemis {
 
 typedef uint codeblockid_t;
 
+/**
+ * Coverage of a single code block.
+ *
+ * Covered bytecodes are stored in bitmaps sized from the number of instructions in the code block. The source
+ * location of a bytecode is recorded the first time it is covered, such that line and range coverage can be
+ * derived when a report is produced instead of being updated on every executed bytecode.
+ */
 class CodeBlockInfo
 {
 
@@ -31,15 +44,54 @@ public:
     CodeBlockInfo(QString functionName, size_t bytecodeSize);
 
     size_t getBytecodeSize() const;
-    void setBytecodeCovered(uint bytecodeOffset);
+
+    // Returns true if the bytecode is already covered in this mode, or lies outside the code block, so that
+    // setBytecodeCovered would not record anything for it
+    inline bool isBytecodeCovered(uint offset, bool symbolic) const
+    {
+        return offset >= mBytecodeSize || (symbolic ? mSymbolicCoveredBytecodes : mCoveredBytecodes).testBit(offset);
+    }
+
+    // Returns true if the bytecode was not covered before (concretely or symbolically)
+    bool setBytecodeCovered(const ByteCodeInfoStruct& binfo);
     size_t numCoveredBytecodes() const;
 
+    void collectLineCoverage(QSet<uint>& lines, bool symbolic) const;
+    void collectRangeCoverage(QMap<int, int>& startRanges, QMap<int, int>& endRanges, bool symbolic) const;
+
+    void merge(const CodeBlockInfo& other);
+
+    friend QDataStream& operator<<(QDataStream& out, const CodeBlockInfo& codeBlock);
+    friend QDataStream& operator>>(QDataStream& in, CodeBlockInfo& codeBlock);
+
     static codeblockid_t getId(unsigned sourceOffset, const QString& url, int startline);
 
+    // Same id as above, using the url hash precomputed by the source
+    static inline codeblockid_t getId(unsigned sourceOffset, const QSource* source)
+    {
+        return getIdFromUrlHash(sourceOffset, source->getUrlHash(), source->getStartLine());
+    }
+
 private:
+    static inline codeblockid_t getIdFromUrlHash(unsigned sourceOffset, uint urlHash, int startline)
+    {
+        return sourceOffset * 7 + urlHash + 37 * startline;
+    }
+
+    struct BytecodeLocation {
+        uint linenumber;
+        int divot;
+        int startOffset;
+        int endOffset;
+    };
+
     QString mFunctionName;
     size_t mBytecodeSize;
-    QSet<uint> mCoveredBytecodes;
+    size_t mNumCoveredBytecodes;
+
+    QBitArray mCoveredBytecodes;
+    QBitArray mSymbolicCoveredBytecodes;
+    QVector<BytecodeLocation> mLocations;
 
 };
 
@@ -30,7 +30,8 @@ namespace artemis
 CoverageListener::CoverageListener(const QSet<QUrl>& ignoredUrls) :
     QObject(NULL),
     mIgnoredUrls(ignoredUrls),
-    mInputBeingExecuted(-1)
+    mInputBeingExecuted(-1),
+    mAllInputsChanged(false)
 {
     mIgnoredUrls.insert(DONT_MEASURE_COVERAGE);
 }
@@ -98,14 +99,35 @@ void CoverageListener::notifyStartingLoad()
     mInputBeingExecuted = -1;
 }
 
-void CoverageListener::slJavascriptScriptParsed(QString sourceCode, QSource* source)
+bool CoverageListener::takeChangedInputs(QSet<uint>* inputs)
+{
+    bool allInputsChanged = mAllInputsChanged;
+
+    if (!allInputsChanged) {
+        inputs->unite(mChangedInputs);
+
+        foreach (codeblockid_t codeBlockID, mChangedCodeBlocks) {
+            foreach (int inputHash, mCodeBlockToInputMap.value(codeBlockID)) {
+                inputs->insert(inputHash);
+            }
+        }
+    }
+
+    mChangedInputs.clear();
+    mChangedCodeBlocks.clear();
+    mAllInputsChanged = false;
+
+    return !allInputsChanged;
+}
+
+void CoverageListener::slJavascriptScriptParsed(QSourceText sourceCode, QSource* source)
 {   
 
     if(mIgnoredUrls.contains(source->getUrl())){
         return;
     }
 
-    sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
+    sourceid_t sourceID = SourceInfo::getId(source);
 
     if (!mSources.contains(sourceID)) {
 
@@ -119,9 +141,10 @@ void CoverageListener::slJavascriptScriptParsed(QString sourceCode, QSource* sou
 void CoverageListener::slJavascriptStatementExecuted(uint linenumber, QSource* source)
 {
 
-    Statistics::statistics()->accumulate("WebKit::coverage::covered", 1);
+    static Statistics::Counter covered("WebKit::coverage::covered");
+    covered.add(1);
 
-    sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
+    sourceid_t sourceID = SourceInfo::getId(source);
     SourceInfoPtr sourceInfo = mSources.value(sourceID, SourceInfoPtr(NULL));
 
     if (sourceInfo.isNull()) {
@@ -135,41 +158,159 @@ void CoverageListener::slJavascriptStatementExecuted(uint linenumber, QSource* s
 void CoverageListener::slJavascriptFunctionCalled(QString functionName, size_t bytecodeSize, uint functionStartLine, uint sourceOffset, QSource* source)
 {
 
-    codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source->getUrl(), source->getStartLine());
+    codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source);
 
     if (!mCodeBlocks.contains(codeBlockID)) {
         mCodeBlocks.insert(codeBlockID, QSharedPointer<CodeBlockInfo>(new CodeBlockInfo(functionName, bytecodeSize)));
     }
 
     if (mInputBeingExecuted != -1) {
-        mInputToCodeBlockMap.value(mInputBeingExecuted)->insert(codeBlockID);
+        QSet<codeblockid_t>* codeBlocks = mInputToCodeBlockMap.value(mInputBeingExecuted);
+
+        if (!codeBlocks->contains(codeBlockID)) {
+            codeBlocks->insert(codeBlockID);
+            mCodeBlockToInputMap[codeBlockID].insert(mInputBeingExecuted);
+            mChangedInputs.insert(mInputBeingExecuted);
+        }
     }
 
 }
 
-void CoverageListener::slJavascriptBytecodeExecuted(const ByteCodeInfoStruct& binfo, uint sourceOffset, QSource* source)
+void CoverageListener::slJavascriptBytecodesExecuted(const ByteCodeInfoBatch& batch)
 {
+    // Bytecodes arrive in runs from the same code block, only look up the coverage info when the code block changes.
+    // Line and range coverage of the source is derived from the code blocks when a report is produced.
+    QSource* lastSource = NULL;
+    uint lastSourceOffset = 0;
+    codeblockid_t codeBlockID = 0;
+
+    QSharedPointer<CodeBlockInfo> codeBlockInfo;
+    SourceInfoPtr sourceInfo;
+
+    foreach (const ByteCodeInfoStruct& binfo, batch) {
+
+        if (binfo.source != lastSource || binfo.sourceOffset != lastSourceOffset) {
+            lastSource = binfo.source;
+            lastSourceOffset = binfo.sourceOffset;
+
+            codeBlockID = CodeBlockInfo::getId(binfo.sourceOffset, binfo.source);
+            codeBlockInfo = mCodeBlocks.value(codeBlockID, QSharedPointer<CodeBlockInfo>(NULL));
 
-    codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source->getUrl(), source->getStartLine());
-    QSharedPointer<CodeBlockInfo> codeBlockInfo = mCodeBlocks.value(codeBlockID, QSharedPointer<CodeBlockInfo>(NULL));
+            // Code blocks for global and eval code are never reported as function calls, they are kept apart so
+            // they only count towards the line and range coverage of the source.
+            if (codeBlockInfo.isNull()) {
+                codeBlockInfo = mGlobalCodeBlocks.value(codeBlockID, QSharedPointer<CodeBlockInfo>(NULL));
 
-    if (!codeBlockInfo.isNull()) {
-        codeBlockInfo->setBytecodeCovered(binfo.bytecodeOffset);
+                if (codeBlockInfo.isNull()) {
+                    codeBlockInfo = QSharedPointer<CodeBlockInfo>(new CodeBlockInfo("", binfo.codeBlockSize));
+                    mGlobalCodeBlocks.insert(codeBlockID, codeBlockInfo);
+                }
+            }
+
+            sourceid_t sourceID = SourceInfo::getId(binfo.source);
+            sourceInfo = mSources.value(sourceID, SourceInfoPtr(NULL));
+
+            if (!sourceInfo.isNull()) {
+                sourceInfo->addCodeBlock(codeBlockID, codeBlockInfo);
+            }
+        }
+
+        if (codeBlockInfo->isBytecodeCovered(binfo.bytecodeOffset, binfo.isSymbolic)) {
+            continue;
+        }
+
+        // The source location is only needed the first time a bytecode is covered.
+        ByteCodeInfoStruct located = binfo;
+        QWebExecutionListener::resolveBytecodeLocation(located);
+
+        if (codeBlockInfo->setBytecodeCovered(located)) {
+            mChangedCodeBlocks.insert(codeBlockID);
+        }
     }
 
-    sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
-    SourceInfoPtr sourceInfo = mSources.value(sourceID, SourceInfoPtr(NULL));
+}
 
-    if (!sourceInfo.isNull()) {
-        if(binfo.isSymbolic){
-            sourceInfo->setRangeSymbolicCovered(binfo.divot,binfo.startOffset,binfo.endOffset);
-            sourceInfo->setLineSymbolicCovered(binfo.linenumber);
-        } else {
-            sourceInfo->setRangeCovered(binfo.divot,binfo.startOffset,binfo.endOffset);
-            sourceInfo->setLineCovered(binfo.linenumber);
+void CoverageListener::writeCoverage(QDataStream& out) const
+{
+    out << (quint32)mSources.size();
+
+    foreach (sourceid_t sourceID, mSources.keys()) {
+        SourceInfoPtr sourceInfo = mSources.value(sourceID);
+        out << (quint32)sourceID << sourceInfo->getSource() << sourceInfo->getURL() << (qint32)sourceInfo->getStartLine();
+        out << sourceInfo->getCodeBlockIDs();
+    }
+
+    writeCodeBlocks(out, mCodeBlocks);
+    writeCodeBlocks(out, mGlobalCodeBlocks);
+}
+
+void CoverageListener::writeCodeBlocks(QDataStream& out, const QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> >& codeBlocks)
+{
+    out << (quint32)codeBlocks.size();
+
+    foreach (codeblockid_t codeBlockID, codeBlocks.keys()) {
+        out << (quint32)codeBlockID << *codeBlocks.value(codeBlockID);
+    }
+}
+
+void CoverageListener::mergeCoverage(QDataStream& in)
+{
+    QMap<sourceid_t, QList<codeblockid_t> > sourceCodeBlocks;
+
+    quint32 numSources;
+    in >> numSources;
+
+    for (quint32 i = 0; i < numSources; i++) {
+        quint32 sourceID;
+        QString source;
+        QString url;
+        qint32 startline;
+        QList<codeblockid_t> codeBlockIDs;
+
+        in >> sourceID >> source >> url >> startline >> codeBlockIDs;
+
+        if (!mSources.contains(sourceID)) {
+            mSources.insert(sourceID, SourceInfoPtr(new SourceInfo(QSourceText(source), url, startline)));
+        }
+
+        sourceCodeBlocks.insert(sourceID, codeBlockIDs);
+    }
+
+    mergeCodeBlocks(in, &mCodeBlocks);
+    mergeCodeBlocks(in, &mGlobalCodeBlocks);
+
+    foreach (sourceid_t sourceID, sourceCodeBlocks.keys()) {
+        SourceInfoPtr sourceInfo = mSources.value(sourceID);
+
+        foreach (codeblockid_t codeBlockID, sourceCodeBlocks.value(sourceID)) {
+            if (mCodeBlocks.contains(codeBlockID)) {
+                sourceInfo->addCodeBlock(codeBlockID, mCodeBlocks.value(codeBlockID));
+            } else if (mGlobalCodeBlocks.contains(codeBlockID)) {
+                sourceInfo->addCodeBlock(codeBlockID, mGlobalCodeBlocks.value(codeBlockID));
+            }
         }
     }
 
+    mAllInputsChanged = true;
+}
+
+void CoverageListener::mergeCodeBlocks(QDataStream& in, QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> >* codeBlocks)
+{
+    quint32 numCodeBlocks;
+    in >> numCodeBlocks;
+
+    for (quint32 i = 0; i < numCodeBlocks; i++) {
+        quint32 codeBlockID;
+        QSharedPointer<CodeBlockInfo> codeBlockInfo(new CodeBlockInfo("", 0));
+
+        in >> codeBlockID >> *codeBlockInfo;
+
+        if (codeBlocks->contains(codeBlockID)) {
+            codeBlocks->value(codeBlockID)->merge(*codeBlockInfo);
+        } else {
+            codeBlocks->insert(codeBlockID, codeBlockInfo);
+        }
+    }
 }
 
 QString CoverageListener::toString() const
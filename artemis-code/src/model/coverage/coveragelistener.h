@@ -22,8 +22,10 @@
 #include <QObject>
 #include <QUrl>
 #include <QMap>
+#include <QHash>
 #include <QSet>
 #include <QSharedPointer>
+#include <QDataStream>
 #include <QWebExecutionListener>
 #include <QSource>
 
@@ -54,8 +56,22 @@ public:
     void notifyStartingEvent(QSharedPointer<const BaseInput> inputEvent);
     void notifyStartingLoad();
 
+    /**
+     * Hash codes of the inputs whose bytecode coverage may have changed since the last call, either because the
+     * input reached new code blocks or because code blocks it reaches had new bytecodes covered.
+     * Returns false if the coverage of any input may have changed, e.g. after merging coverage from another process.
+     */
+    bool takeChangedInputs(QSet<uint>* inputs);
+
     QString toString() const;
 
+    /**
+     * Coverage of sources and code blocks can be written by one process and merged into the coverage of another.
+     * Per input coverage is not included, it is only used for prioritization within a single process.
+     */
+    void writeCoverage(QDataStream& out) const;
+    void mergeCoverage(QDataStream& in);
+
 private:
 
     QSet<QUrl> mIgnoredUrls;
@@ -64,18 +80,33 @@ private:
     QMap<int, QSet<codeblockid_t>* > mInputToCodeBlockMap;
     int mInputBeingExecuted;
 
+    // (codeBlockID -> set<inputHashCode>), inverse of the above
+    QHash<codeblockid_t, QSet<int> > mCodeBlockToInputMap;
+
+    // Changes since the last takeChangedInputs
+    QSet<uint> mChangedInputs;
+    QSet<codeblockid_t> mChangedCodeBlocks;
+    bool mAllInputsChanged;
+
     // (sourceID -> SourceInfo)
     QMap<sourceid_t, SourceInfoPtr> mSources;
 
     // (codeBlockID -> CodeBlockInfo)
     QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> > mCodeBlocks;
 
+    // (codeBlockID -> CodeBlockInfo) for global and eval code, which is never reported as a function call.
+    // These only contribute to the line and range coverage of their source, not to the code block coverage above.
+    QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> > mGlobalCodeBlocks;
+
+    static void writeCodeBlocks(QDataStream& out, const QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> >& codeBlocks);
+    static void mergeCodeBlocks(QDataStream& in, QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> >* codeBlocks);
+
 
 public slots:
 
-    void slJavascriptScriptParsed(QString sourceCode, QSource* source);
+    void slJavascriptScriptParsed(QSourceText sourceCode, QSource* source);
     void slJavascriptFunctionCalled(QString functionName, size_t bytecodeSize, uint functionStartLine, uint sourceOffset, QSource* source);
-    void slJavascriptBytecodeExecuted(const ByteCodeInfoStruct& binfo, uint sourceOffset, QSource* source);
+    void slJavascriptBytecodesExecuted(const ByteCodeInfoBatch& batch);
     void slJavascriptStatementExecuted(uint linenumber, QSource* source);
 
 };
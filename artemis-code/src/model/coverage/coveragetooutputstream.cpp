@@ -126,7 +126,10 @@ void writeCoverageHtml(CoverageListenerPtr cov, QString& pathToFile)
     bool first = true;
     foreach(uint sourceID, cov->getSourceIDs()) {
 
-        QString url = Qt::escape(cov->getSourceInfo(sourceID)->getURL()).trimmed(), id = "ID"+QString::number(sourceID);
+        // Line and range coverage are derived from the code block bitmaps, so only ask for them once per source.
+        SourceInfoPtr sourceInfo = cov->getSourceInfo(sourceID);
+
+        QString url = Qt::escape(sourceInfo->getURL()).trimmed(), id = "ID"+QString::number(sourceID);
 
         res += "<div id='"+id+"' class='code'>";
         res += "<a href='"+url+"' target='_blank' class='openLink'><div class='arrow-container'><div class='arrow-right'>&nbsp;</div></div>Go to file</a>";
@@ -141,13 +144,13 @@ void writeCoverageHtml(CoverageListenerPtr cov, QString& pathToFile)
         res += tail.size()>0?"<b>"+tail+"</b>":"";
         res += "<a href='#?' class='expandLink'>show code coverage</a>";
 
-        int startline = cov->getSourceInfo(sourceID)->getStartLine();
+        int startline = sourceInfo->getStartLine();
         res += "<pre class='linenums "+(startline >1 ? "startline startlinenr["+QString::number(startline)+"]":"")+"'>";
 
         int currentChar = 0, currentLine = 1;
 
-        QMap<int,int> coverageRange = cov->getSourceInfo(sourceID)->getRangeCoverage(),
-                symbolicCoverageRange = cov->getSourceInfo(sourceID)->getSymbolicRangeCoverage();
+        QMap<int,int> coverageRange = sourceInfo->getRangeCoverage(),
+                symbolicCoverageRange = sourceInfo->getSymbolicRangeCoverage();
 
         QList<int> rangeKeys = coverageRange.keys(),
                 symbolicRangeKeys = symbolicCoverageRange.keys();
@@ -163,13 +166,13 @@ void writeCoverageHtml(CoverageListenerPtr cov, QString& pathToFile)
 
         QString s = "\""+id+"\":[";
 
-        coverageJSString += s + generateLineCoverageJSListElements( cov->getSourceInfo(sourceID)->getLineCoverage())+"]";
-        symbolicCoverageJSString += s + generateLineCoverageJSListElements( cov->getSourceInfo(sourceID)->getSymbolicLineCoverage())+"]";
+        coverageJSString += s + generateLineCoverageJSListElements( sourceInfo->getLineCoverage())+"]";
+        symbolicCoverageJSString += s + generateLineCoverageJSListElements( sourceInfo->getSymbolicLineCoverage())+"]";
 
         coverageRangeString += s;
         symbolicCoverageRangeString += s;
 
-        foreach(QString line, cov->getSourceInfo(sourceID)->getSource().split("\n", QString::KeepEmptyParts)) {
+        foreach(QString line, sourceInfo->getSource().split("\n", QString::KeepEmptyParts)) {
 
             int lineLength = line.length()+1;
             res += QTextDocument(line).toPlainText().replace("&","&amp;").replace("<","&lt;").replace(">","&gt;").replace(QRegExp("\\s*$"), "") + "&nbsp;\n";
@@ -20,7 +20,7 @@
 namespace artemis
 {
 
-SourceInfo::SourceInfo(const QString source, const QString url, const int startline) :
+SourceInfo::SourceInfo(const QSourceText source, const QString url, const int startline) :
     mSource(source),
     mUrl(url),
     mStartLine(startline)
@@ -29,7 +29,7 @@ SourceInfo::SourceInfo(const QString source, const QString url, const int startl
 
 QString SourceInfo::getSource() const
 {
-    return mSource;
+    return mSource.getText();
 }
 
 int SourceInfo::getStartLine() const
@@ -42,43 +42,62 @@ QString SourceInfo::getURL() const
     return mUrl;
 }
 
-void SourceInfo::setLineCovered(uint lineNumber)
+void SourceInfo::addCodeBlock(codeblockid_t codeBlockID, QSharedPointer<const CodeBlockInfo> codeBlock)
 {
-    mCoverage.insert(lineNumber);
+    mCodeBlocks.insert(codeBlockID, codeBlock);
 }
 
-void SourceInfo::setLineSymbolicCovered(uint lineNumber){
-    mSymbolicCoverage.insert(lineNumber);
+QList<codeblockid_t> SourceInfo::getCodeBlockIDs() const
+{
+    return mCodeBlocks.keys();
 }
 
-void SourceInfo::setRangeCovered(int divot, int startOffset, int endOffset){
-    mStartRangeCoverage[divot] = std::max(startOffset,mStartRangeCoverage[divot]);
-    mEndRangeCoverage[divot] = std::max(endOffset,mEndRangeCoverage[divot]);
-}
+QSet<uint> SourceInfo::getLineCoverage() const
+{
+    QSet<uint> lines;
+
+    foreach (QSharedPointer<const CodeBlockInfo> codeBlock, mCodeBlocks) {
+        codeBlock->collectLineCoverage(lines, false);
+    }
 
-void SourceInfo::setRangeSymbolicCovered(int divot, int startOffset, int endOffset){
-    mSymbolicStartRangeCoverage[divot] = std::max(startOffset,mSymbolicStartRangeCoverage[divot]);
-    mSymbolicEndRangeCoverage[divot] = std::max(endOffset,mSymbolicEndRangeCoverage[divot]);
+    return lines;
 }
 
+QSet<uint> SourceInfo::getSymbolicLineCoverage() const
+{
+    QSet<uint> lines;
 
-QSet<uint> SourceInfo::getLineCoverage() const
+    foreach (QSharedPointer<const CodeBlockInfo> codeBlock, mCodeBlocks) {
+        codeBlock->collectLineCoverage(lines, true);
+    }
+
+    return lines;
+}
+
+QMap<int,int> SourceInfo::getRangeCoverage() const
 {
-    return mCoverage;
+    return getRangeCoverage(false);
 }
 
-QSet<uint> SourceInfo::getSymbolicLineCoverage() const
+QMap<int,int> SourceInfo::getSymbolicRangeCoverage() const
 {
-    return mSymbolicCoverage;
+    return getRangeCoverage(true);
 }
 
-QMap<int,int> SourceInfo::getRangeCoverage() const
+QMap<int,int> SourceInfo::getRangeCoverage(bool symbolic) const
 {
+    QMap<int,int> startRanges;
+    QMap<int,int> endRanges;
+
+    foreach (QSharedPointer<const CodeBlockInfo> codeBlock, mCodeBlocks) {
+        codeBlock->collectRangeCoverage(startRanges, endRanges, symbolic);
+    }
+
     QMap<int,int> returnMap;
     int lastEnd = 0,lastStart = 0;
-    foreach(int key, mStartRangeCoverage.keys()){
-        int end = key+mEndRangeCoverage[key],
-                start = key-mStartRangeCoverage[key];
+    foreach(int key, startRanges.keys()){
+        int end = key+endRanges[key],
+                start = key-startRanges[key];
         if(start < end){
 
             if(start <= lastEnd){
@@ -95,33 +114,9 @@ QMap<int,int> SourceInfo::getRangeCoverage() const
     return returnMap;
 }
 
-QMap<int,int> SourceInfo::getSymbolicRangeCoverage() const
-{
-    QMap<int,int> returnMap;
-    int lastEnd = 0,lastStart = 0;
-    foreach(int key, mSymbolicStartRangeCoverage.keys()){
-        int end = key+mSymbolicEndRangeCoverage[key],
-                start = key-mSymbolicStartRangeCoverage[key];
-        if(start < end){
-
-        if(start <= lastEnd){
-            returnMap[lastStart] = end;
-        } else {
-            returnMap[start] = end;
-        }
-        }
-        lastEnd = end;
-        lastStart = start;
-    }
-
-    return returnMap;
-}
-
-
-
 QString SourceInfo::toString() const
 {
-    return "[" + mUrl + ", " + QString::number(mStartLine) + ", " + mSource + "ENDOFJSOURCE]";
+    return "[" + mUrl + ", " + QString::number(mStartLine) + ", " + mSource.getText() + "ENDOFJSOURCE]";
 }
 
 QDebug operator<<(QDebug dbg, const SourceInfo& e)
@@ -132,7 +127,7 @@ QDebug operator<<(QDebug dbg, const SourceInfo& e)
 
 sourceid_t SourceInfo::getId(const QString& sourceUrl, uint sourceStartLine)
 {
-    return qHash(sourceUrl) * 53 + sourceStartLine * 29;
+    return getIdFromUrlHash(qHash(sourceUrl), sourceStartLine);
 }
 
 }
@@ -21,6 +21,9 @@
 
 #include <QDebug>
 #include <QSharedPointer>
+#include <QHash>
+
+#include "codeblockinfo.h"
 
 namespace artemis
 {
@@ -31,17 +34,16 @@ class SourceInfo
 {
 
 public:
-    SourceInfo(const QString source, const QString url, const int startline);
+    SourceInfo(const QSourceText source, const QString url, const int startline);
 
     QString getSource() const;
     QString getURL() const;
 
     int getStartLine() const;
 
-    void setLineCovered(uint lineNumber);
-    void setLineSymbolicCovered(uint lineNumber);
-    void setRangeCovered(int divot, int startOffset, int endOffset);
-    void setRangeSymbolicCovered(int divot, int startOffset, int endOffset);
+    void addCodeBlock(codeblockid_t codeBlockID, QSharedPointer<const CodeBlockInfo> codeBlock);
+    QList<codeblockid_t> getCodeBlockIDs() const;
+
     QSet<uint> getLineCoverage() const;
     QSet<uint> getSymbolicLineCoverage() const;
     QMap<int,int> getRangeCoverage() const;
@@ -52,16 +54,27 @@ public:
 
     static sourceid_t getId(const QString& sourceUrl, uint sourceStartLine);
 
+    // Same id as above, using the url hash precomputed by the source
+    static inline sourceid_t getId(const QSource* source)
+    {
+        return getIdFromUrlHash(source->getUrlHash(), source->getStartLine());
+    }
+
 private:
-    QString mSource;
+    static inline sourceid_t getIdFromUrlHash(uint urlHash, uint sourceStartLine)
+    {
+        return urlHash * 53 + sourceStartLine * 29;
+    }
+
+    // Shared with the script's source provider, only converted when the text is needed for a report
+    QSourceText mSource;
     QString mUrl;
     int mStartLine;
-    QSet<uint> mCoverage;
-    QSet<uint> mSymbolicCoverage;
-    QMap<int, int> mSymbolicStartRangeCoverage;
-    QMap<int,int> mSymbolicEndRangeCoverage;
-    QMap<int,int> mStartRangeCoverage;
-    QMap<int,int> mEndRangeCoverage;
+
+    // Coverage is kept by the code blocks, and only derived per line and range when requested.
+    QHash<codeblockid_t, QSharedPointer<const CodeBlockInfo> > mCodeBlocks;
+
+    QMap<int,int> getRangeCoverage(bool symbolic) const;
 };
 
 typedef QSharedPointer<SourceInfo> SourceInfoPtr;
@@ -34,11 +34,11 @@ void JavascriptStatistics::notifyStartingEvent(QSharedPointer<const BaseInput> i
     mInputBeingExecuted = inputEvent->hashCode();
 
     if (!mPropertyReadSet.contains(mInputBeingExecuted)) {
-        mPropertyReadSet.insert(mInputBeingExecuted, new QSet<QString>());
+        mPropertyReadSet.insert(mInputBeingExecuted, QBitArray());
     }
 
     if (!mPropertyWriteSet.contains(mInputBeingExecuted)) {
-        mPropertyWriteSet.insert(mInputBeingExecuted, new QSet<QString>());
+        mPropertyWriteSet.insert(mInputBeingExecuted, QBitArray());
     }
 }
 
@@ -48,52 +48,63 @@ void JavascriptStatistics::notifyStartingLoad()
     mInputBeingExecuted = 0;
 }
 
-void JavascriptStatistics::slJavascriptPropertyRead(QString propertyName, intptr_t codeBlockID, intptr_t sourceID, QSource* source)
+bool JavascriptStatistics::insertProperty(QBitArray* set, uint propertyId)
+{
+    if ((uint)set->size() <= propertyId) {
+        // Grow geometrically, new properties are mostly seen early in the run.
+        set->resize(qMax(propertyId + 1, (uint)set->size() * 2));
+    } else if (set->testBit(propertyId)) {
+        return false;
+    }
+
+    set->setBit(propertyId);
+    return true;
+}
+
+void JavascriptStatistics::slJavascriptPropertyRead(uint propertyId, intptr_t codeBlockID, intptr_t sourceID, QSource* source)
 {
     if (source->getUrl() == DONT_MEASURE_COVERAGE) {
         return;
     }
 
-    Statistics::statistics()->accumulate("WebKit::readproperties", 1);
+    static Statistics::Counter readProperties("WebKit::readproperties");
+    readProperties.add(1);
 
-    if (mInputBeingExecuted != 0) {
-        mPropertyReadSet.value(mInputBeingExecuted)->insert(propertyName);
+    if (mInputBeingExecuted != 0 && insertProperty(&mPropertyReadSet[mInputBeingExecuted], propertyId)) {
+        mChangedInputs.insert(mInputBeingExecuted);
     }
 }
 
-void JavascriptStatistics::slJavascriptPropertyWritten(QString propertyName, intptr_t codeBlockID, intptr_t sourceID, QSource* source)
+void JavascriptStatistics::slJavascriptPropertyWritten(uint propertyId, intptr_t codeBlockID, intptr_t sourceID, QSource* source)
 {
     if (source->getUrl() == DONT_MEASURE_COVERAGE) {
         return;
     }
 
-    Statistics::statistics()->accumulate("WebKit::writtenproperties", 1);
+    static Statistics::Counter writtenProperties("WebKit::writtenproperties");
+    writtenProperties.add(1);
 
-    if (mInputBeingExecuted != 0) {
-        mPropertyWriteSet.value(mInputBeingExecuted)->insert(propertyName);
+    if (mInputBeingExecuted != 0 && insertProperty(&mPropertyWriteSet[mInputBeingExecuted], propertyId)) {
+        mChangedInputs.insert(mInputBeingExecuted);
     }
 }
 
-QSet<QString> JavascriptStatistics::getPropertiesWritten(const QSharedPointer<const BaseInput>& input) const
+QBitArray JavascriptStatistics::getPropertiesWritten(const QSharedPointer<const BaseInput>& input) const
 {
-    uint hashcode = input->hashCode();
-
-    if (mPropertyWriteSet.contains(hashcode)) {
-        return *mPropertyWriteSet.value(hashcode);
-    }
-
-    return QSet<QString>();
+    return mPropertyWriteSet.value(input->hashCode());
 }
 
-QSet<QString> JavascriptStatistics::getPropertiesRead(const QSharedPointer<const BaseInput>& input) const
+QBitArray JavascriptStatistics::getPropertiesRead(const QSharedPointer<const BaseInput>& input) const
 {
-    uint hashcode = input->hashCode();
+    return mPropertyReadSet.value(input->hashCode());
+}
 
-    if (mPropertyReadSet.contains(hashcode)) {
-        return *mPropertyReadSet.value(hashcode);
-    }
+QSet<uint> JavascriptStatistics::takeChangedInputs()
+{
+    QSet<uint> changedInputs = mChangedInputs;
+    mChangedInputs.clear();
 
-    return QSet<QString>();
+    return changedInputs;
 }
 
 }
@@ -21,6 +21,7 @@
 #include <QSharedPointer>
 #include <QSet>
 #include <QHash>
+#include <QBitArray>
 #include <QSource>
 
 #include "runtime/input/baseinput.h"
@@ -38,22 +39,30 @@ public:
     void notifyStartingEvent(QSharedPointer<const BaseInput> inputEvent);
     void notifyStartingLoad();
 
-    QSet<QString> getPropertiesWritten(const QSharedPointer<const BaseInput>& input) const;
-    QSet<QString> getPropertiesRead(const QSharedPointer<const BaseInput>& input) const;
+    // Sets of property ids, see QWebExecutionListener::getPropertyName.
+    QBitArray getPropertiesWritten(const QSharedPointer<const BaseInput>& input) const;
+    QBitArray getPropertiesRead(const QSharedPointer<const BaseInput>& input) const;
+
+    // Hash codes of the inputs whose read or write sets grew since the last call.
+    QSet<uint> takeChangedInputs();
 
 private:
 
-    // InputHash -> set<PropertyString>
-    QHash<uint, QSet<QString>* > mPropertyReadSet;
+    // InputHash -> set<PropertyId>
+    QHash<uint, QBitArray> mPropertyReadSet;
 
-    // InputHash -> set<PropertyString>
-    QHash<uint, QSet<QString>* > mPropertyWriteSet;
+    // InputHash -> set<PropertyId>
+    QHash<uint, QBitArray> mPropertyWriteSet;
 
     uint mInputBeingExecuted;
 
+    QSet<uint> mChangedInputs;
+
+    static bool insertProperty(QBitArray* set, uint propertyId);
+
 public slots:
-    void slJavascriptPropertyRead(QString propertyName, intptr_t codeBlockID, intptr_t sourceID, QSource* source);
-    void slJavascriptPropertyWritten(QString propertyName, intptr_t codeBlockID, intptr_t sourceID, QSource* source);
+    void slJavascriptPropertyRead(uint propertyId, intptr_t codeBlockID, intptr_t sourceID, QSource* source);
+    void slJavascriptPropertyWritten(uint propertyId, intptr_t codeBlockID, intptr_t sourceID, QSource* source);
 
 };
 
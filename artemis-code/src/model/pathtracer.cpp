@@ -86,7 +86,7 @@ void PathTracer::slJavascriptFunctionCalled(QString functionName, size_t bytecod
     item.type = FUNCALL;
     item.string = displayedFunctionName(functionName);
     item.lineInFile = functionStartLine;
-    item.sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
+    item.sourceID = SourceInfo::getId(source);
     appendItem(item);
 }
 
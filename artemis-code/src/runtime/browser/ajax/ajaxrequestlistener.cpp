@@ -17,6 +17,7 @@
 #include "ajaxrequestlistener.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
+#include <QBuffer>
 
 
 namespace artemis
@@ -24,14 +25,48 @@ namespace artemis
 
 AjaxRequestListener::AjaxRequestListener(QObject* parent) :
     QNetworkAccessManager(parent)
+    , mNetworkCache(NULL)
 {
 }
 
+void AjaxRequestListener::setNetworkCache(NetworkCache* networkCache)
+{
+    mNetworkCache = networkCache;
+}
+
 QNetworkReply* AjaxRequestListener::createRequest(Operation op, const QNetworkRequest& req, QIODevice* outgoingData)
 
 {
-    //super call
-    QNetworkReply* reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+    QNetworkReply* reply = NULL;
+    QByteArray body;
+    QBuffer* bodyBuffer = NULL;
+
+    if (mNetworkCache != NULL) {
+
+        // The body is part of the cache key, keep a copy to hand on to the network
+        if (outgoingData != NULL) {
+            body = outgoingData->readAll();
+            bodyBuffer = new QBuffer();
+            bodyBuffer->setData(body);
+            bodyBuffer->open(QIODevice::ReadOnly);
+            outgoingData = bodyBuffer;
+        }
+
+        reply = mNetworkCache->replay(this, op, req, body);
+    }
+
+    if (reply == NULL) {
+        //super call
+        reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
+
+        if (mNetworkCache != NULL) {
+            reply = mNetworkCache->record(this, op, req, body, reply);
+        }
+    }
+
+    if (bodyBuffer != NULL) {
+        bodyBuffer->setParent(reply);
+    }
 
     if (op == GetOperation)
         { emit this->pageGet(req.url()); }
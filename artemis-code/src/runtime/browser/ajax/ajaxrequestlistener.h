@@ -18,6 +18,9 @@
 #define AJAXREQUESTLISTENER_H
 #include <QNetworkAccessManager>
 #include <QUrl>
+
+#include "runtime/browser/snapshot/networkcache.h"
+
 namespace artemis
 {
 
@@ -30,6 +33,11 @@ public:
     explicit AjaxRequestListener(QObject* parent = 0);
     QNetworkReply* createRequest(Operation op, const QNetworkRequest& req, QIODevice* outgoingData = 0);
 
+    void setNetworkCache(NetworkCache* networkCache);
+
+private:
+    NetworkCache* mNetworkCache;
+
 signals:
     void pageGet(QUrl url);
     void pagePost(QUrl url);
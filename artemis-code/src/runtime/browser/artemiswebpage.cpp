@@ -63,6 +63,11 @@ bool ArtemisWebPage::javaScriptPrompt(QWebFrame* frame, const QString& msg, cons
     return true;
 }
 
+DOMElementResolver* ArtemisWebPage::getElementResolver()
+{
+    return &mElementResolver;
+}
+
 void ArtemisWebPage::setCustomUserAgent(QString ua)
 {
     mCustomUserAgent = ua;
@@ -22,6 +22,8 @@
 #include <QSharedPointer>
 #include <QNetworkRequest>
 
+#include "domelementresolver.h"
+
 namespace artemis
 {
 
@@ -56,11 +58,15 @@ public:
     void setCustomUserAgent(QString ua);
     QString userAgentForUrl ( const QUrl & url ) const;
 
+    // Used by DOMElementDescriptor to find elements in the current page.
+    DOMElementResolver* getElementResolver();
+
     bool mAcceptNavigation; // Used when in manual mode; see acceptNavigationRequest.
 
 protected:
     virtual bool acceptNavigationRequest(QWebFrame *frame, const QNetworkRequest &request, NavigationType type);
     QString mCustomUserAgent;
+    DOMElementResolver mElementResolver;
 
 signals:
     void sigJavascriptAlert(QWebFrame* frame, QString msg);
@@ -0,0 +1,113 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "statistics/statsstorage.h"
+
+#include "domelementresolver.h"
+
+namespace artemis
+{
+
+DOMElementResolver::DOMElementResolver() :
+    mFrame(NULL),
+    mVersion(0)
+{
+}
+
+QWebElement DOMElementResolver::resolve(QWebFrame* frame, quint64 descriptorId, const QList<int>& elementPath)
+{
+    validate(frame);
+
+    QHash<quint64, QWebElement>::const_iterator cached = mResolved.constFind(descriptorId);
+    if (cached != mResolved.constEnd()) {
+        return cached.value();
+    }
+
+    static Statistics::Counter resolved("WebKit::elementresolver::resolved");
+    resolved.add(1);
+
+    int current = 0;
+
+    foreach(int n, elementPath) {
+        current = child(current, n);
+
+        if (current == -1) {
+            break;
+        }
+    }
+
+    QWebElement element = current == -1 ? QWebElement() : mElements.at(current).element;
+    mResolved.insert(descriptorId, element);
+
+    return element;
+}
+
+QWebElement DOMElementResolver::body(QWebFrame* frame)
+{
+    validate(frame);
+    return mElements.at(0).element;
+}
+
+void DOMElementResolver::validate(QWebFrame* frame)
+{
+    Q_CHECK_PTR(frame);
+
+    quint64 version = frame->documentElement().childListVersion();
+
+    if (frame == mFrame && version == mVersion && !mElements.empty()) {
+        return;
+    }
+
+    mFrame = frame;
+    mVersion = version;
+    mResolved.clear();
+    mElements.clear();
+
+    IndexedElement body;
+    body.element = frame->findFirstElement("body");
+    body.indexed = false;
+    mElements.append(body);
+}
+
+int DOMElementResolver::child(int parent, int n)
+{
+    if (!mElements.at(parent).indexed) {
+        QVector<int> children;
+
+        for (QWebElement c = mElements.at(parent).element.firstChild(); !c.isNull(); c = c.nextSibling()) {
+            IndexedElement indexed;
+            indexed.element = c;
+            indexed.indexed = false;
+
+            children.append(mElements.size());
+            mElements.append(indexed);
+        }
+
+        // Appending may have reallocated mElements, so the parent is looked up again
+        mElements[parent].children = children;
+        mElements[parent].indexed = true;
+    }
+
+    const QVector<int>& children = mElements.at(parent).children;
+
+    if (n < 1 || n > children.size()) {
+        return -1;
+    }
+
+    return children.at(n - 1);
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DOMELEMENTRESOLVER_H
+#define DOMELEMENTRESOLVER_H
+
+#include <QWebFrame>
+#include <QWebElement>
+#include <QVector>
+#include <QHash>
+#include <QList>
+
+namespace artemis
+{
+
+/**
+ * Resolves element paths (1-indexed element children, starting from <body>) as stored by DOMElementDescriptor.
+ *
+ * Resolved elements are cached per descriptor, and the element children of every element passed on the way are
+ * indexed the first time they are needed, such that resolving a path is O(depth) instead of a sibling walk at every
+ * level. Everything is discarded when nodes are inserted into or removed from the document, or a new document is
+ * loaded, see QWebElement::childListVersion.
+ */
+class DOMElementResolver
+{
+
+public:
+    DOMElementResolver();
+
+    QWebElement resolve(QWebFrame* frame, quint64 descriptorId, const QList<int>& elementPath);
+    QWebElement body(QWebFrame* frame);
+
+private:
+    struct IndexedElement {
+        QWebElement element;
+        bool indexed;
+        QVector<int> children;
+    };
+
+    void validate(QWebFrame* frame);
+    int child(int parent, int n);
+
+    QWebFrame* mFrame;
+    quint64 mVersion;
+
+    // Element tree, mElements[0] is <body>, children refer to indexes in mElements
+    QVector<IndexedElement> mElements;
+
+    // (descriptorId -> element)
+    QHash<quint64, QWebElement> mResolved;
+};
+
+}
+
+#endif // DOMELEMENTRESOLVER_H
@@ -27,11 +27,6 @@ ExecutionResult::ExecutionResult()
     mStateHash = 0;
 }
 
-QString ExecutionResult::getPageContents() const
-{
-    return mPageContents;
-}
-
 QList<int> ExecutionResult::getAjaxCallbackHandlers() const
 {
     return mAjaxCallbackHandlers;
@@ -43,7 +43,6 @@ public:
 
     bool isDomModified() const;
     long getPageStateHash() const;
-    QString getPageContents() const;
 
     QSet<QSharedPointer<AjaxRequest> > getAjaxRequests() const;
     QList<int> getAjaxCallbackHandlers() const;
@@ -64,7 +63,6 @@ private:
 
     bool mModifiedDom;
     long mStateHash;
-    QString mPageContents;
 
     QSet<QSharedPointer<AjaxRequest> > mAjaxRequest;
     QList<int> mAjaxCallbackHandlers;
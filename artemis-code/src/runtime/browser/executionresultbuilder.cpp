@@ -41,12 +41,13 @@ void ExecutionResultBuilder::reset()
 {
     mResult = QSharedPointer<ExecutionResult>(new ExecutionResult());
     mElementPointers.clear();
-    mPageStateAfterLoad = QString("");
+    mPageStateAfterLoad = 0;
 }
 
 void ExecutionResultBuilder::notifyPageLoaded()
 {
-    mPageStateAfterLoad = mPage->mainFrame()->toHtml();
+    // Hashes the whole page once, afterwards only the mutated subtrees are rehashed
+    mPageStateAfterLoad = mPage->mainFrame()->documentElement().fingerprint();
 }
 
 void ExecutionResultBuilder::notifyStartingEvent()
@@ -64,12 +65,13 @@ QSharedPointer<ExecutionResult> ExecutionResultBuilder::getResult()
     registerFromFieldsIntoResult();
     registerEventHandlersIntoResult();
 
-    mResult->mPageContents = mPage->mainFrame()->toHtml();
-    mResult->mStateHash = qHash(mResult->mPageContents);
-    mResult->mModifiedDom = mResult->mPageContents.localeAwareCompare(mPageStateAfterLoad) != 0;
+    QList<QWebElement> changedElements;
+
+    mResult->mStateHash = mPage->mainFrame()->documentElement().fingerprint(&changedElements);
+    mResult->mModifiedDom = mResult->mStateHash != mPageStateAfterLoad;
 
     if(mResult->mModifiedDom){
-        emit sigDomModified(mPageStateAfterLoad, mResult->mPageContents);
+        emit sigDomModified(changedElements);
     }
 
     return mResult;
@@ -115,7 +117,8 @@ void ExecutionResultBuilder::registerEventHandlersIntoResult()
             }
         }
 
-        Statistics::statistics()->accumulate("WebKit::events::added", 1);
+        static Statistics::Counter eventsAdded("WebKit::events::added");
+        eventsAdded.add(1);
         mResult->mEventHandlers.append(handler);
 
     }
@@ -128,10 +131,12 @@ void ExecutionResultBuilder::registerFromFieldsIntoResult()
 
     foreach(QWebFrame* frame, getAllFrames()) {
         // Gather all form field elements.
-        // We select them all at once so we can maintain the DOM ordering of the form filds list.
-        foreach(QWebElement field, frame->findAllElements("input, textarea, select")) {
-            if(field.tagName().toLower() == "input") {
-                FormFieldTypes type =  getTypeFromAttr(field.attribute("type"));
+        // We collect them all at once so we can maintain the DOM ordering of the form filds list.
+        foreach(QWebFormControl control, frame->documentElement().formControls()) {
+            QWebElement& field = control.element;
+
+            if(control.tagName == "input") {
+                FormFieldTypes type =  getTypeFromAttr(control.type);
 
                 if (type == NO_INPUT) {
                     if (mDisabledFeatures.testFlag(CONCRETE_VALUE_PROPERTY)) {
@@ -146,12 +151,12 @@ void ExecutionResultBuilder::registerFromFieldsIntoResult()
 
                 mResult->mFormFields.append(fieldDescriptor);
 
-            } else if(field.tagName().toLower() == "textarea") {
+            } else if(control.tagName == "textarea") {
                 FormFieldDescriptorPtr taf = FormFieldDescriptorPtr(new FormFieldDescriptor(TEXT, DOMElementDescriptorConstPtr(new DOMElementDescriptor(&field))));
                 mResult->mFormFields.append(taf);
 
-            } else if(field.tagName().toLower() == "select") {
-                QSet<QString> options = getSelectOptions(field);
+            } else if(control.tagName == "select") {
+                QSet<QString> options = getSelectOptions(control);
                 FormFieldDescriptorPtr ssf = FormFieldDescriptorPtr(new FormFieldDescriptor(FIXED_INPUT, DOMElementDescriptorConstPtr(new DOMElementDescriptor(&field)), options));
                 mResult->mFormFields.append(ssf);
 
@@ -177,15 +182,14 @@ QSet<QWebFrame*> ExecutionResultBuilder::getAllFrames()
     return res;
 }
 
-QSet<QString> ExecutionResultBuilder::getSelectOptions(const QWebElement& e)
+QSet<QString> ExecutionResultBuilder::getSelectOptions(const QWebFormControl& select)
 {
     QSet<QString> res;
-    QWebElementCollection options = e.findAll("option");
-    foreach(QWebElement o, options) {
-        QString valueAttr = o.attribute("value");
+    foreach(const QWebFormOption& o, select.options) {
+        QString valueAttr = o.hasValueAttribute ? o.value : QString();
 
         if (!valueAttr.isEmpty())
-            { valueAttr = o.toPlainText(); }
+            { valueAttr = o.text; }
 
         if (valueAttr.isEmpty()) {
             Log::warning("Found empty option element in select, ignoring");
@@ -277,7 +281,8 @@ void ExecutionResultBuilder::slAjaxRequestInitiated(QUrl u, QString postData)
 
 void ExecutionResultBuilder::slJavascriptConstantStringEncountered(QString constant)
 {
-    Statistics::statistics()->accumulate("WebKit::jsconstants", 1);
+    static Statistics::Counter constants("WebKit::jsconstants");
+    constants.add(1);
     mResult->mJavascriptConstantsObservedForLastEvent.insert(constant);
 }
 
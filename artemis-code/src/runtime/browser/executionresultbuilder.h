@@ -20,6 +20,7 @@
 #include <QObject>
 #include <QSharedPointer>
 #include <QWebElement>
+#include <QWebFormControl>
 #include <QPair>
 #include <QList>
 #include <QString>
@@ -64,12 +65,12 @@ private:
     void registerFromFieldsIntoResult();
     void registerEventHandlersIntoResult();
 
-    QSet<QString> getSelectOptions(const QWebElement&);
+    QSet<QString> getSelectOptions(const QWebFormControl&);
     QSet<QWebFrame*> getAllFrames();
 
     QSharedPointer<ExecutionResult> mResult;
     ArtemisWebPagePtr mPage;
-    QString mPageStateAfterLoad;
+    uint mPageStateAfterLoad; // fingerprint of the DOM after the page load
 
     QList<QPair<QWebElement*, QString> > mElementPointers;
 
@@ -92,7 +93,7 @@ public slots:
     void slJavascriptConstantStringEncountered(QString constant);
 
 signals:
-    void sigDomModified(QString start, QString end); // Only fired at the end, not for every modification.
+    void sigDomModified(QList<QWebElement> changedElements); // Only fired at the end, with the elements changed since the page load.
 };
 
 typedef QSharedPointer<ExecutionResultBuilder> ExecutionResultBuilderPtr;
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QDebug>
+#include <QCryptographicHash>
+#include <QVariant>
+
+#include "statistics/statsstorage.h"
+#include "util/loggingutil.h"
+
+#include "networkcache.h"
+
+namespace artemis
+{
+
+static const quint32 ARCHIVE_MAGIC = 0x41524e43; // "ARNC"
+static const quint32 ARCHIVE_VERSION = 1;
+
+NetworkCache::NetworkCache(QObject* parent, NetworkCacheMode mode, const QString& archivePath)
+    : QObject(parent)
+    , mMode(mode)
+    , mLoading(false)
+    , mReplaying(false)
+    , mLocked(false)
+    , mArchive(archivePath)
+{
+    if (!archivePath.isEmpty() && mMode != NETWORK_CACHE_PAGE_LOAD) {
+        loadArchive();
+    }
+}
+
+void NetworkCache::notifyStartingLoad(const QUrl& url)
+{
+    mCurrentUrl = url;
+    mLoading = true;
+
+    if (mMode != NETWORK_CACHE_PAGE_LOAD) {
+        return;
+    }
+
+    mReplaying = mSnapshotUrls.contains(url);
+
+    if (mReplaying) {
+        Statistics::statistics()->accumulate("WebKit::networkcache::loads-replayed", 1);
+    } else {
+        qDebug() << "Recording page load of" << url.toString();
+    }
+}
+
+void NetworkCache::notifyPageLoaded(bool ok)
+{
+    // A page which failed to load is recorded again on the next attempt.
+    if (mMode == NETWORK_CACHE_PAGE_LOAD && !mReplaying && ok) {
+        mSnapshotUrls.insert(mCurrentUrl);
+    }
+
+    if (mMode == NETWORK_CACHE_STRICT && ok) {
+        mLocked = true;
+    }
+
+    mLoading = false;
+    mReplaying = false;
+}
+
+bool NetworkCache::isCached(QNetworkAccessManager::Operation op, const QNetworkRequest& request) const
+{
+    if (mMode == NETWORK_CACHE_PAGE_LOAD) {
+        return op == QNetworkAccessManager::GetOperation;
+    }
+
+    QString scheme = request.url().scheme();
+    return scheme == "http" || scheme == "https";
+}
+
+QByteArray NetworkCache::requestKey(QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body)
+{
+    QByteArray key;
+
+    switch (op) {
+    case QNetworkAccessManager::HeadOperation:
+        key = "HEAD";
+        break;
+    case QNetworkAccessManager::GetOperation:
+        key = "GET";
+        break;
+    case QNetworkAccessManager::PutOperation:
+        key = "PUT";
+        break;
+    case QNetworkAccessManager::PostOperation:
+        key = "POST";
+        break;
+    case QNetworkAccessManager::DeleteOperation:
+        key = "DELETE";
+        break;
+    default:
+        key = request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+        break;
+    }
+
+    key += ' ';
+    key += request.url().toEncoded();
+
+    if (!body.isEmpty()) {
+        key += ' ';
+        key += QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex();
+    }
+
+    return key;
+}
+
+QNetworkReply* NetworkCache::replay(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body)
+{
+    if (!isCached(op, request) || (mMode == NETWORK_CACHE_PAGE_LOAD && !mReplaying)) {
+        return NULL;
+    }
+
+    QHash<QByteArray, SnapshotResponseConstPtr>::const_iterator response = mResponses.constFind(requestKey(op, request, body));
+
+    if (response != mResponses.constEnd()) {
+        Statistics::statistics()->accumulate("WebKit::networkcache::responses-replayed", 1);
+        return new ReplayReply(parent, op, request, response.value());
+    }
+
+    if (mLocked) {
+        Log::warning("Network cache: failing request which was not recorded: " + request.url().toString().toStdString());
+        Statistics::statistics()->accumulate("WebKit::networkcache::responses-unseen", 1);
+        return new ReplayReply(parent, op, request, SnapshotResponseConstPtr());
+    }
+
+    // e.g. cache busting query strings, these are fetched from the server as usual
+    Statistics::statistics()->accumulate("WebKit::networkcache::responses-missed", 1);
+    return NULL;
+}
+
+QNetworkReply* NetworkCache::record(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body, QNetworkReply* reply)
+{
+    if (!isCached(op, request)) {
+        return reply;
+    }
+
+    if (mMode == NETWORK_CACHE_PAGE_LOAD && (!mLoading || mReplaying)) {
+        return reply;
+    }
+
+    RecordingReply* recordingReply = new RecordingReply(parent, reply, requestKey(op, request, body));
+    QObject::connect(recordingReply, SIGNAL(sigRecorded(SnapshotResponseConstPtr)),
+                     this, SLOT(slRecorded(SnapshotResponseConstPtr)));
+
+    return recordingReply;
+}
+
+void NetworkCache::slRecorded(SnapshotResponseConstPtr response)
+{
+    // Keep the first response, such that every replayed request sees the same one
+    if (mMode != NETWORK_CACHE_PAGE_LOAD && mResponses.contains(response->key)) {
+        return;
+    }
+
+    mResponses.insert(response->key, response);
+
+    Statistics::statistics()->accumulate("WebKit::networkcache::responses-recorded", 1);
+
+    if (mArchive.isOpen()) {
+        appendToArchive(response);
+    }
+}
+
+void NetworkCache::loadArchive()
+{
+    if (mArchive.exists()) {
+
+        if (!mArchive.open(QIODevice::ReadOnly)) {
+            Log::error("Could not read the network cache archive " + mArchive.fileName().toStdString());
+            return;
+        }
+
+        QDataStream in(&mArchive);
+        quint32 magic, version;
+        in >> magic >> version;
+
+        if (magic != ARCHIVE_MAGIC || version != ARCHIVE_VERSION) {
+            Log::error("Not a network cache archive: " + mArchive.fileName().toStdString());
+            mArchive.close();
+            return;
+        }
+
+        qint64 validSize = mArchive.pos();
+
+        while (!in.atEnd()) {
+            SnapshotResponse* response = new SnapshotResponse();
+            quint32 numHeaders;
+
+            in >> response->key >> response->url >> response->statusCode >> response->reasonPhrase >> response->redirectionTarget >> numHeaders;
+
+            for (quint32 i = 0; i < numHeaders && in.status() == QDataStream::Ok; i++) {
+                QNetworkReply::RawHeaderPair header;
+                in >> header.first >> header.second;
+                response->headers.append(header);
+            }
+
+            in >> response->body;
+
+            if (in.status() != QDataStream::Ok) {
+                // Truncated by an earlier run which was killed while appending
+                delete response;
+                break;
+            }
+
+            mResponses.insert(response->key, SnapshotResponseConstPtr(response));
+            validSize = mArchive.pos();
+        }
+
+        mArchive.close();
+
+        if (validSize < mArchive.size()) {
+            Log::warning("Dropping the incomplete last record of the network cache archive " + mArchive.fileName().toStdString());
+            mArchive.resize(validSize);
+        }
+
+        Statistics::statistics()->accumulate("WebKit::networkcache::responses-loaded", mResponses.size());
+
+        if (mMode == NETWORK_CACHE_STRICT && !mResponses.isEmpty()) {
+            mLocked = true;
+        }
+    }
+
+    bool newArchive = !mArchive.exists() || mArchive.size() == 0;
+
+    if (!mArchive.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        Log::error("Could not write the network cache archive " + mArchive.fileName().toStdString());
+        return;
+    }
+
+    mArchiveStream.setDevice(&mArchive);
+
+    if (newArchive) {
+        mArchiveStream << ARCHIVE_MAGIC << ARCHIVE_VERSION;
+    }
+}
+
+void NetworkCache::appendToArchive(SnapshotResponseConstPtr response)
+{
+    mArchiveStream << response->key << response->url << response->statusCode << response->reasonPhrase << response->redirectionTarget;
+    mArchiveStream << (quint32)response->headers.size();
+
+    foreach (const QNetworkReply::RawHeaderPair& header, response->headers) {
+        mArchiveStream << header.first << header.second;
+    }
+
+    mArchiveStream << response->body;
+
+    mArchive.flush();
+}
+
+}
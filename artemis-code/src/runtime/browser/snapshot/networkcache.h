@@ -0,0 +1,107 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NETWORKCACHE_H
+#define NETWORKCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QUrl>
+#include <QFile>
+#include <QDataStream>
+#include <QByteArray>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+
+#include "runtime/options.h"
+
+#include "snapshotreply.h"
+
+namespace artemis
+{
+
+/**
+ * Records the responses the network delivers and serves them from memory when the same request is made again.
+ *
+ * Requests are identified by their method, URL and body. The mode decides what is recorded and replayed:
+ *
+ *  - NETWORK_CACHE_PAGE_LOAD: only GET requests issued while the page is loading. Once a page load of a URL has
+ *    been recorded completely, later loads of the URL are served from memory. Requests made by the input sequence
+ *    always go to the server.
+ *  - NETWORK_CACHE_REPLAY: every HTTP request. The first response to a request is recorded, every later identical
+ *    request is answered with it, whether made by the page load or by the input sequence.
+ *  - NETWORK_CACHE_STRICT: as NETWORK_CACHE_REPLAY, but only the first page load (or nothing, if an archive was
+ *    loaded) is recorded. Requests which were not seen then fail, so every iteration sees exactly the same responses.
+ *
+ * In the replay and strict modes the recorded responses can be kept in an archive file. Responses in the archive
+ * are loaded on start up, and newly recorded responses are appended to it.
+ */
+class NetworkCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    NetworkCache(QObject* parent, NetworkCacheMode mode, const QString& archivePath);
+
+    void notifyStartingLoad(const QUrl& url);
+    void notifyPageLoaded(bool ok);
+
+    /**
+     * Returns a reply serving the recorded response for request, or NULL if
+     * the request should go to the network.
+     */
+    QNetworkReply* replay(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body);
+
+    /**
+     * Returns the reply to hand to WebKit in place of reply. If the request
+     * is being recorded the response is captured on the way through.
+     */
+    QNetworkReply* record(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body, QNetworkReply* reply);
+
+private:
+    static QByteArray requestKey(QNetworkAccessManager::Operation op, const QNetworkRequest& request, const QByteArray& body);
+    bool isCached(QNetworkAccessManager::Operation op, const QNetworkRequest& request) const;
+
+    void loadArchive();
+    void appendToArchive(SnapshotResponseConstPtr response);
+
+    NetworkCacheMode mMode;
+
+    // (requestKey -> response)
+    QHash<QByteArray, SnapshotResponseConstPtr> mResponses;
+
+    // Page load mode, URLs of which a complete page load was recorded
+    QSet<QUrl> mSnapshotUrls;
+
+    QUrl mCurrentUrl;
+    bool mLoading;
+    bool mReplaying;
+
+    // Strict mode, unseen requests fail once this is set
+    bool mLocked;
+
+    QFile mArchive;
+    QDataStream mArchiveStream;
+
+private slots:
+    void slRecorded(SnapshotResponseConstPtr response);
+};
+
+}
+
+#endif // NETWORKCACHE_H
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <string.h>
+
+#include <QTimer>
+
+#include "snapshotreply.h"
+
+namespace artemis
+{
+
+RecordingReply::RecordingReply(QObject* parent, QNetworkReply* reply, const QByteArray& key)
+    : QNetworkReply(parent)
+    , mReply(reply)
+    , mKey(key)
+{
+    mReply->setParent(this);
+
+    setRequest(mReply->request());
+    setOperation(mReply->operation());
+    setUrl(mReply->url());
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    QObject::connect(mReply, SIGNAL(metaDataChanged()), this, SLOT(slMetaDataChanged()));
+    QObject::connect(mReply, SIGNAL(readyRead()), this, SLOT(slReadyRead()));
+    QObject::connect(mReply, SIGNAL(error(QNetworkReply::NetworkError)), this, SLOT(slError(QNetworkReply::NetworkError)));
+    QObject::connect(mReply, SIGNAL(finished()), this, SLOT(slFinished()));
+    QObject::connect(mReply, SIGNAL(downloadProgress(qint64, qint64)), this, SIGNAL(downloadProgress(qint64, qint64)));
+    QObject::connect(mReply, SIGNAL(uploadProgress(qint64, qint64)), this, SIGNAL(uploadProgress(qint64, qint64)));
+}
+
+void RecordingReply::abort()
+{
+    mReply->abort();
+}
+
+void RecordingReply::ignoreSslErrors()
+{
+    mReply->ignoreSslErrors();
+}
+
+void RecordingReply::setReadBufferSize(qint64 size)
+{
+    QNetworkReply::setReadBufferSize(size);
+    mReply->setReadBufferSize(size);
+}
+
+bool RecordingReply::isSequential() const
+{
+    return true;
+}
+
+qint64 RecordingReply::bytesAvailable() const
+{
+    return QNetworkReply::bytesAvailable() + mBuffer.size();
+}
+
+qint64 RecordingReply::readData(char* data, qint64 maxSize)
+{
+    if (mBuffer.isEmpty()) {
+        return isFinished() ? -1 : 0;
+    }
+
+    qint64 size = qMin(maxSize, (qint64)mBuffer.size());
+    memcpy(data, mBuffer.constData(), size);
+    mBuffer.remove(0, size);
+
+    return size;
+}
+
+void RecordingReply::slMetaDataChanged()
+{
+    setUrl(mReply->url());
+
+    foreach(QNetworkReply::RawHeaderPair header, mReply->rawHeaderPairs()) {
+        setRawHeader(header.first, header.second);
+    }
+
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, mReply->attribute(QNetworkRequest::HttpStatusCodeAttribute));
+    setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, mReply->attribute(QNetworkRequest::HttpReasonPhraseAttribute));
+    setAttribute(QNetworkRequest::RedirectionTargetAttribute, mReply->attribute(QNetworkRequest::RedirectionTargetAttribute));
+
+    emit metaDataChanged();
+}
+
+void RecordingReply::slReadyRead()
+{
+    QByteArray data = mReply->readAll();
+
+    if (data.isEmpty()) {
+        return;
+    }
+
+    mBuffer.append(data);
+    mBody.append(data);
+
+    emit readyRead();
+}
+
+void RecordingReply::slError(QNetworkReply::NetworkError code)
+{
+    setError(code, mReply->errorString());
+    emit error(code);
+}
+
+void RecordingReply::slFinished()
+{
+    if (mReply->bytesAvailable() > 0) {
+        slReadyRead();
+    }
+
+    // Failed or aborted loads are not worth replaying, the next load should ask the server again.
+    if (mReply->error() == QNetworkReply::NoError) {
+        SnapshotResponse* response = new SnapshotResponse();
+        response->key = mKey;
+        response->url = mReply->url();
+        response->statusCode = mReply->attribute(QNetworkRequest::HttpStatusCodeAttribute);
+        response->reasonPhrase = mReply->attribute(QNetworkRequest::HttpReasonPhraseAttribute);
+        response->redirectionTarget = mReply->attribute(QNetworkRequest::RedirectionTargetAttribute);
+        response->headers = mReply->rawHeaderPairs();
+        response->body = mBody;
+
+        emit sigRecorded(SnapshotResponseConstPtr(response));
+    }
+
+    mBody.clear();
+
+    setFinished(true);
+    emit finished();
+}
+
+ReplayReply::ReplayReply(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, SnapshotResponseConstPtr response)
+    : QNetworkReply(parent)
+    , mResponse(response)
+    , mOffset(0)
+    , mAborted(false)
+{
+    setRequest(request);
+    setOperation(op);
+    open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+
+    if (mResponse.isNull()) {
+        setUrl(request.url());
+    } else {
+        setUrl(mResponse->url);
+
+        foreach(QNetworkReply::RawHeaderPair header, mResponse->headers) {
+            setRawHeader(header.first, header.second);
+        }
+
+        setAttribute(QNetworkRequest::HttpStatusCodeAttribute, mResponse->statusCode);
+        setAttribute(QNetworkRequest::HttpReasonPhraseAttribute, mResponse->reasonPhrase);
+        setAttribute(QNetworkRequest::RedirectionTargetAttribute, mResponse->redirectionTarget);
+    }
+
+    // WebKit expects the reply signals to arrive asynchronously, as they would from the network.
+    QTimer::singleShot(0, this, SLOT(slDeliver()));
+}
+
+void ReplayReply::abort()
+{
+    if (isFinished()) {
+        return;
+    }
+
+    mAborted = true;
+
+    setError(QNetworkReply::OperationCanceledError, "Operation canceled");
+    emit error(QNetworkReply::OperationCanceledError);
+
+    setFinished(true);
+    emit finished();
+}
+
+bool ReplayReply::isSequential() const
+{
+    return true;
+}
+
+qint64 ReplayReply::bytesAvailable() const
+{
+    if (mResponse.isNull()) {
+        return QNetworkReply::bytesAvailable();
+    }
+
+    return QNetworkReply::bytesAvailable() + mResponse->body.size() - mOffset;
+}
+
+qint64 ReplayReply::readData(char* data, qint64 maxSize)
+{
+    if (mResponse.isNull() || mOffset >= mResponse->body.size()) {
+        return -1;
+    }
+
+    qint64 size = qMin(maxSize, mResponse->body.size() - mOffset);
+    memcpy(data, mResponse->body.constData() + mOffset, size);
+    mOffset += size;
+
+    return size;
+}
+
+void ReplayReply::slDeliver()
+{
+    if (mAborted) {
+        return;
+    }
+
+    if (mResponse.isNull()) {
+        setError(QNetworkReply::ContentNotFoundError, "Request was not recorded by the network cache");
+        emit error(QNetworkReply::ContentNotFoundError);
+
+        setFinished(true);
+        emit finished();
+        return;
+    }
+
+    emit metaDataChanged();
+    emit downloadProgress(mResponse->body.size(), mResponse->body.size());
+
+    if (!mResponse->body.isEmpty()) {
+        emit readyRead();
+    }
+
+    // The page may have cancelled the request from one of the handlers above.
+    if (mAborted) {
+        return;
+    }
+
+    setFinished(true);
+    emit finished();
+}
+
+}
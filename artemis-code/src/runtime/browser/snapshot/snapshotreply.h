@@ -0,0 +1,116 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef SNAPSHOTREPLY_H
+#define SNAPSHOTREPLY_H
+
+#include <QNetworkReply>
+#include <QSharedPointer>
+#include <QByteArray>
+#include <QVariant>
+#include <QList>
+#include <QUrl>
+
+namespace artemis
+{
+
+/**
+ * A network response captured by the network cache, sufficient to hand the
+ * same response to WebKit again without contacting the server.
+ */
+class SnapshotResponse
+{
+public:
+    QByteArray key; // identifies the request, see NetworkCache::requestKey
+    QUrl url;
+    QVariant statusCode;
+    QVariant reasonPhrase;
+    QVariant redirectionTarget;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    QByteArray body;
+};
+
+typedef QSharedPointer<const SnapshotResponse> SnapshotResponseConstPtr;
+
+/**
+ * Wraps a live reply, forwarding everything to WebKit while keeping a copy of
+ * the response for the network cache.
+ */
+class RecordingReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    RecordingReply(QObject* parent, QNetworkReply* reply, const QByteArray& key);
+
+    void abort();
+    void ignoreSslErrors();
+    void setReadBufferSize(qint64 size);
+    bool isSequential() const;
+    qint64 bytesAvailable() const;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize);
+
+private:
+    QNetworkReply* mReply;
+    QByteArray mKey;
+    QByteArray mBuffer;
+    QByteArray mBody;
+
+private slots:
+    void slMetaDataChanged();
+    void slReadyRead();
+    void slError(QNetworkReply::NetworkError code);
+    void slFinished();
+
+signals:
+    void sigRecorded(SnapshotResponseConstPtr response);
+};
+
+/**
+ * Serves a previously recorded response from memory.
+ *
+ * A null response fails the request with ContentNotFoundError, this is used
+ * for requests the network cache refuses to send to the server.
+ */
+class ReplayReply : public QNetworkReply
+{
+    Q_OBJECT
+
+public:
+    ReplayReply(QObject* parent, QNetworkAccessManager::Operation op, const QNetworkRequest& request, SnapshotResponseConstPtr response);
+
+    void abort();
+    bool isSequential() const;
+    qint64 bytesAvailable() const;
+
+protected:
+    qint64 readData(char* data, qint64 maxSize);
+
+private:
+    SnapshotResponseConstPtr mResponse;
+    qint64 mOffset;
+    bool mAborted;
+
+private slots:
+    void slDeliver();
+};
+
+}
+
+#endif // SNAPSHOTREPLY_H
@@ -0,0 +1,145 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "statistics/statsstorage.h"
+
+#include "virtualclock.h"
+
+namespace artemis
+{
+
+VirtualClock::VirtualClock(QObject* parent, QWebExecutionListener* listener)
+    : QObject(parent)
+    , mListener(listener)
+    , mNow(0)
+    , mSequence(0)
+{
+    mListener->enableVirtualTime();
+
+    QObject::connect(mListener, SIGNAL(addedTimer(int, int, bool)),
+                     this, SLOT(slTimerAdded(int, int, bool)));
+    QObject::connect(mListener, SIGNAL(removedTimer(int)),
+                     this, SLOT(slTimerRemoved(int)));
+    QObject::connect(mListener, SIGNAL(firingTimer(int)),
+                     this, SLOT(slTimerFiring(int)));
+}
+
+void VirtualClock::reset()
+{
+    mTimers.clear();
+    mQueue.clear();
+
+    mNow = 0;
+    mListener->setVirtualTimeOffset(0);
+}
+
+quint64 VirtualClock::now() const
+{
+    return mNow;
+}
+
+void VirtualClock::runTimers(quint64 horizon)
+{
+    quint64 limit = mNow + horizon;
+    uint fired = 0;
+
+    while (!mQueue.isEmpty() && mQueue.constBegin().key().first <= limit) {
+
+        if (fired == MAX_FIRED_PER_RUN) {
+            Statistics::statistics()->accumulate("WebKit::virtualtime::runs-truncated", 1);
+            break;
+        }
+
+        QueueKey key = mQueue.constBegin().key();
+        int timerId = mQueue.constBegin().value();
+
+        mListener->timerFire(timerId);
+        fired++;
+
+        // The timer did not fire, e.g. its document is gone, it must not block the queue
+        if (mQueue.contains(key)) {
+            unschedule(timerId);
+        }
+    }
+}
+
+void VirtualClock::schedule(int timerId, quint64 due)
+{
+    ScheduledTimer& timer = mTimers[timerId];
+    timer.key = QueueKey(due, mSequence++);
+
+    mQueue.insert(timer.key, timerId);
+}
+
+void VirtualClock::unschedule(int timerId)
+{
+    QHash<int, ScheduledTimer>::iterator timer = mTimers.find(timerId);
+
+    if (timer != mTimers.end()) {
+        mQueue.remove(timer->key);
+        mTimers.erase(timer);
+    }
+}
+
+void VirtualClock::advanceTo(quint64 time)
+{
+    if (time <= mNow) {
+        return;
+    }
+
+    Statistics::statistics()->accumulate("WebKit::virtualtime::skipped-ms", (int)(time - mNow));
+
+    mNow = time;
+    mListener->setVirtualTimeOffset(mNow);
+}
+
+void VirtualClock::slTimerAdded(int timerId, int timeout, bool singleShot)
+{
+    ScheduledTimer timer;
+    timer.interval = qMax(timeout, 1); // as WebKit, timers wait at least 1ms
+    timer.singleShot = singleShot;
+
+    mTimers.insert(timerId, timer);
+    schedule(timerId, mNow + timer.interval);
+}
+
+void VirtualClock::slTimerRemoved(int timerId)
+{
+    unschedule(timerId);
+}
+
+void VirtualClock::slTimerFiring(int timerId)
+{
+    QHash<int, ScheduledTimer>::iterator timer = mTimers.find(timerId);
+
+    if (timer == mTimers.end()) {
+        return;
+    }
+
+    Statistics::statistics()->accumulate("WebKit::virtualtime::timers-fired", 1);
+
+    advanceTo(timer->key.first);
+
+    // Reschedule before the callback runs, it may clear the interval
+    if (timer->singleShot) {
+        unschedule(timerId);
+    } else {
+        mQueue.remove(timer->key);
+        schedule(timerId, mNow + timer->interval);
+    }
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIRTUALCLOCK_H
+#define VIRTUALCLOCK_H
+
+#include <QObject>
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QtWebKit/qwebexecutionlistener.h>
+
+namespace artemis
+{
+
+/**
+ * Deterministic scheduler for the DOM timers of the page under virtual time.
+ *
+ * WebKit does not arm the timers (see QWebExecutionListener::enableVirtualTime), the clock keeps them in a queue
+ * ordered by due time instead. Time only moves when a timer is fired: the clock jumps to the due time of the timer,
+ * and Date in the page is advanced by the same amount. Timers fired early (e.g. by a TimerInput) move the clock
+ * likewise. Timers due at the same time fire in the order they were added.
+ */
+class VirtualClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    VirtualClock(QObject* parent, QWebExecutionListener* listener);
+
+    // Forget all timers and start over at time 0, for a new page load
+    void reset();
+
+    // Fires the timers due within horizon ms of the current time, including the ones added while doing so
+    void runTimers(quint64 horizon);
+
+    quint64 now() const;
+
+private:
+    typedef QPair<quint64, quint64> QueueKey; // (due time, sequence number)
+
+    struct ScheduledTimer {
+        QueueKey key;
+        quint64 interval;
+        bool singleShot;
+    };
+
+    void schedule(int timerId, quint64 due);
+    void unschedule(int timerId);
+    void advanceTo(quint64 time);
+
+    QWebExecutionListener* mListener;
+
+    quint64 mNow;
+    quint64 mSequence;
+
+    QHash<int, ScheduledTimer> mTimers;
+    QMap<QueueKey, int> mQueue;
+
+    // Bound on the number of timers fired by one runTimers, intervals can keep each other busy indefinitely
+    static const uint MAX_FIRED_PER_RUN = 1000;
+
+private slots:
+    void slTimerAdded(int timerId, int timeout, bool singleShot);
+    void slTimerRemoved(int timerId);
+    void slTimerFiring(int timerId);
+};
+
+}
+
+#endif // VIRTUALCLOCK_H
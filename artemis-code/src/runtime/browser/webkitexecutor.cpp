@@ -48,9 +48,19 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
                                AjaxRequestListener* ajaxListener,
                                bool enableConstantStringInstrumentation,
                                bool enablePropertyAccessInstrumentation,
+                               bool enableBytecodeCoverageInstrumentation,
+                               bool enableDomModificationDetection,
                                bool enableEventVisibilityFiltering,
+                               NetworkCacheMode networkCacheMode,
+                               const QString& networkCacheArchive,
+                               VirtualTimeMode virtualTimeMode,
+                               uint virtualTimeHorizon,
                                ConcolicBenchmarkFeatures disabledFeatures)
     : QObject(parent)
+    , mNetworkCache(NULL)
+    , mVirtualClock(NULL)
+    , mRunVirtualTimers(virtualTimeMode == VIRTUAL_TIME_AUTO)
+    , mVirtualTimeHorizon(virtualTimeHorizon)
     , mNextOpCanceled(false), mKeepOpen(false)
     , mSymbolicMode(MODE_CONCRETE)
 {
@@ -61,6 +71,11 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
     mAjaxListener = ajaxListener;
     mAjaxListener->setParent(this);
 
+    if (networkCacheMode != NETWORK_CACHE_OFF) {
+        mNetworkCache = new NetworkCache(this, networkCacheMode, networkCacheArchive);
+        mAjaxListener->setNetworkCache(mNetworkCache);
+    }
+
     mPage = ArtemisWebPagePtr(new ArtemisWebPage());
     mPage->setNetworkAccessManager(mAjaxListener);
 
@@ -88,15 +103,23 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
         mWebkitListener->enablePropertyAccessInstrumentation();
     }
 
+    if (!enableBytecodeCoverageInstrumentation) {
+        mWebkitListener->disableBytecodeCoverageInstrumentation();
+    }
+
+    if (virtualTimeMode != VIRTUAL_TIME_OFF) {
+        mVirtualClock = new VirtualClock(this, mWebkitListener);
+    }
+
     QObject::connect(mWebkitListener, SIGNAL(jqueryEventAdded(QString, QString, QString)),
                      mJquery, SLOT(slEventAdded(QString, QString, QString)));
 
-    QObject::connect(mWebkitListener, SIGNAL(loadedJavaScript(QString, QSource*)),
-                     mCoverageListener.data(), SLOT(slJavascriptScriptParsed(QString, QSource*)));
+    QObject::connect(mWebkitListener, SIGNAL(loadedJavaScript(QSourceText, QSource*)),
+                     mCoverageListener.data(), SLOT(slJavascriptScriptParsed(QSourceText, QSource*)));
     QObject::connect(mWebkitListener, SIGNAL(statementExecuted(uint, QSource*)),
                      mCoverageListener.data(), SLOT(slJavascriptStatementExecuted(uint, QSource*)));
-    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptBytecodeExecuted(const ByteCodeInfoStruct, uint, QSource*)),
-                     mCoverageListener.data(), SLOT(slJavascriptBytecodeExecuted(const ByteCodeInfoStruct, uint, QSource*)));
+    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptBytecodesExecuted(const ByteCodeInfoBatch&)),
+                     mCoverageListener.data(), SLOT(slJavascriptBytecodesExecuted(const ByteCodeInfoBatch&)));
     QObject::connect(mWebkitListener, SIGNAL(sigJavascriptFunctionCalled(QString, size_t, uint, uint, QSource*)),
                      mCoverageListener.data(), SLOT(slJavascriptFunctionCalled(QString, size_t, uint, uint, QSource*)));
 
@@ -107,10 +130,10 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
     QObject::connect(mPage.data(), SIGNAL(sigJavascriptAlert(QWebFrame*, QString)),
                      mPathTracer.data(), SLOT(slJavascriptAlert(QWebFrame*, QString)));
 
-    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptPropertyRead(QString,intptr_t,intptr_t, QSource*)),
-                     mJavascriptStatistics.data(), SLOT(slJavascriptPropertyRead(QString,intptr_t,intptr_t, QSource*)));
-    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptPropertyWritten(QString,intptr_t,intptr_t, QSource*)),
-                     mJavascriptStatistics.data(), SLOT(slJavascriptPropertyWritten(QString,intptr_t,intptr_t, QSource*)));
+    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptPropertyRead(uint,intptr_t,intptr_t, QSource*)),
+                     mJavascriptStatistics.data(), SLOT(slJavascriptPropertyRead(uint,intptr_t,intptr_t, QSource*)));
+    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptPropertyWritten(uint,intptr_t,intptr_t, QSource*)),
+                     mJavascriptStatistics.data(), SLOT(slJavascriptPropertyWritten(uint,intptr_t,intptr_t, QSource*)));
 
     QObject::connect(mWebkitListener, SIGNAL(addedEventListener(QWebElement*, QString)),
                      mResultBuilder.data(), SLOT(slEventListenerAdded(QWebElement*, QString)));
@@ -168,13 +191,16 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
 
     // The event marker detector is created and connected in the concolic runtime.
 
-    // The DOM modification "detector".
-    /* Disable for now, we are running out of memory on large pages
-    QSharedPointer<TraceDomModDetector> domModDetector(new TraceDomModDetector());
-    QObject::connect(mResultBuilder.data(), SIGNAL(sigDomModified(QString, QString)),
-                     domModDetector.data(), SLOT(slDomModified(QString, QString)));
-    mTraceBuilder->addDetector(domModDetector);
-    */
+    // The DOM modification detector.
+    // Only connected when the traces are used, as the listener then converts and reports all text entering the DOM.
+    mDomModDetector = QSharedPointer<TraceDomModDetector>(new TraceDomModDetector());
+    if (enableDomModificationDetection) {
+        QObject::connect(mWebkitListener, SIGNAL(sigDomTextInserted(QString)),
+                         mDomModDetector.data(), SLOT(slDomTextInserted(QString)));
+        QObject::connect(mResultBuilder.data(), SIGNAL(sigDomModified(QList<QWebElement>)),
+                         mDomModDetector.data(), SLOT(slDomModified(QList<QWebElement>)));
+        mTraceBuilder->addDetector(mDomModDetector);
+    }
 
 
 }
@@ -209,6 +235,7 @@ void WebKitExecutor::executeSequence(ExecutableConfigurationConstPtr conf, SYMBO
     mResultBuilder->notifyStartingLoad();
     mJavascriptStatistics->notifyStartingLoad();
     mPathTracer->notifyStartingLoad();
+    mDomModDetector->notifyStartingLoad();
 
     mSymbolicMode = symbolicMode;
     if (symbolicMode == MODE_CONCOLIC || symbolicMode == MODE_CONCOLIC_CONTINOUS) {
@@ -217,6 +244,14 @@ void WebKitExecutor::executeSequence(ExecutableConfigurationConstPtr conf, SYMBO
 
     mWebkitListener->clearAjaxCallbacks(); // reset the ajax callback ids
 
+    if (mNetworkCache != NULL) {
+        mNetworkCache->notifyStartingLoad(conf->getUrl());
+    }
+
+    if (mVirtualClock != NULL) {
+        mVirtualClock->reset();
+    }
+
     mPage->mainFrame()->load(conf->getUrl());
 }
 
@@ -249,6 +284,10 @@ void WebKitExecutor::slLoadFinished(bool ok)
         return;
     }
 
+    if (mNetworkCache != NULL) {
+        mNetworkCache->notifyPageLoaded(ok);
+    }
+
     if(!ok){
         QString html = mPage->mainFrame()->toHtml();
         if(html == "<html><head></head><body></body></html>"){
@@ -256,7 +295,15 @@ void WebKitExecutor::slLoadFinished(bool ok)
             return;
         }        
     }
+
+    // Timers set up by the page load, e.g. delayed initialisation, count as part of the load
+    if (mRunVirtualTimers) {
+        mVirtualClock->runTimers(mVirtualTimeHorizon);
+    }
+
+    mWebkitListener->flushBytecodes(); // attribute the page load bytecodes before any event is started
     mResultBuilder->notifyPageLoaded();
+    mDomModDetector->notifyPageLoaded();
 
     // Populate forms (preset)
 
@@ -288,6 +335,7 @@ void WebKitExecutor::slLoadFinished(bool ok)
             mWebkitListener->beginSymbolicSession();
         }
 
+        mWebkitListener->flushBytecodes();
         mResultBuilder->notifyStartingEvent();
         mCoverageListener->notifyStartingEvent(input);
         mJavascriptStatistics->notifyStartingEvent(input);
@@ -296,10 +344,17 @@ void WebKitExecutor::slLoadFinished(bool ok)
         mPage->updateFormIdentifiers();
 
         input->apply(this->mPage, this->mWebkitListener);
+
+        // e.g. debounced handlers and animations started by the input
+        if (mRunVirtualTimers) {
+            mVirtualClock->runTimers(mVirtualTimeHorizon);
+        }
     }
 
     qDebug() << "\n------------ POST PROCESSING -----------" << endl;
 
+    mWebkitListener->flushBytecodes();
+
     if (mSymbolicMode == MODE_CONCOLIC || mSymbolicMode == MODE_CONCOLIC_LAST_EVENT) {
         mWebkitListener->endSymbolicSession();
     }
@@ -28,6 +28,8 @@
 
 #include "runtime/executableconfiguration.h"
 #include "runtime/browser/ajax/ajaxrequestlistener.h"
+#include "runtime/browser/snapshot/networkcache.h"
+#include "runtime/browser/virtualclock.h"
 #include "runtime/appmodel.h"
 #include "model/coverage/coveragelistener.h"
 #include "model/pathtracer.h"
@@ -64,7 +66,13 @@ public:
                    AjaxRequestListener* ajaxListener,
                    bool enableConstantStringInstrumentation,
                    bool enablePropertyAccessInstrumentation,
+                   bool enableBytecodeCoverageInstrumentation,
+                   bool enableDomModificationDetection,
                    bool enableEventVisibilityFiltering,
+                   NetworkCacheMode networkCacheMode,
+                   const QString& networkCacheArchive,
+                   VirtualTimeMode virtualTimeMode,
+                   uint virtualTimeHorizon,
                    ConcolicBenchmarkFeatures disabledFeatures);
     ~WebKitExecutor();
 
@@ -84,6 +92,10 @@ private:
     ExecutionResultBuilderPtr mResultBuilder;
     ExecutableConfigurationConstPtr currentConf;
     AjaxRequestListener* mAjaxListener;
+    NetworkCache* mNetworkCache;
+    VirtualClock* mVirtualClock;
+    bool mRunVirtualTimers;
+    uint mVirtualTimeHorizon;
     JQueryListener* mJquery;
     QMap<QString, InjectionValue> mPresetFields;
 
@@ -95,6 +107,7 @@ private:
     bool testingDone;
 
     TraceBuilder* mTraceBuilder;
+    QSharedPointer<TraceDomModDetector> mDomModDetector;
 
     SYMBOLIC_MODE mSymbolicMode;
 
@@ -15,6 +15,7 @@
  */
 
 #include <QFile>
+#include <QWebExecutionListener>
 
 #include "demowindow.h"
 
@@ -704,6 +705,7 @@ void DemoModeMainWindow::slShowCoverageReport()
 void DemoModeMainWindow::slExportLinkedReports()
 {
     // Write out the reports (and set the file names used for viewing).
+    QWebExecutionListener::getListener()->flushBytecodes();
     writeCoverageHtml(mAppModel->getCoverageListener(), mCoverageFilename);
     mAppModel->getPathTracer()->writePathTraceHTML(true, mCoverageFilename, mPathTraceFilename);
 
@@ -40,6 +40,7 @@ public:
     QString toString() const;
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
     int mCallbackId;
 };
 
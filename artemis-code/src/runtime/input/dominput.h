@@ -55,6 +55,7 @@ public:
     TargetDescriptorConstPtr getTarget() const;
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
     EventHandlerDescriptorConstPtr mEventHandler;
     FormInputCollectionConstPtr mFormInput;
     EventParametersConstPtr mEvtParams;
@@ -31,6 +31,7 @@ public:
     EventType getType() const;
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
     QString name;
     bool cancelable;
     bool bubbles;
@@ -26,7 +26,10 @@ namespace artemis
 
 const QWebElement NULL_WEB_ELEMENT;
 
+quint64 DOMElementDescriptor::mNextDescriptorId = 0;
+
 DOMElementDescriptor::DOMElementDescriptor(QWebElement* elm) :
+    mDescriptorId(++mNextDescriptorId),
     mIsDocument(false),
     mIsBody(false),
     mIsMainframe(false),
@@ -53,10 +56,19 @@ DOMElementDescriptor::DOMElementDescriptor(QWebElement* elm) :
     }
 }
 
+DOMElementDescriptor::DOMElementDescriptor() :
+    mDescriptorId(++mNextDescriptorId),
+    mIsDocument(false),
+    mIsBody(false),
+    mIsMainframe(false),
+    mInvalid(false)
+{
+}
+
 QWebElement DOMElementDescriptor::getElement(ArtemisWebPagePtr page) const
 {
     QWebFrame* frame = selectFrame(page);
-    QWebElement elm = selectElement(frame);
+    QWebElement elm = selectElement(frame, page->getElementResolver());
 
     Q_ASSERT(elm != NULL_WEB_ELEMENT);
     return elm;
@@ -77,7 +89,7 @@ QWebFrame* DOMElementDescriptor::selectFrame(ArtemisWebPagePtr page) const
     return current;
 }
 
-QWebElement DOMElementDescriptor::selectElement(QWebFrame* frame) const
+QWebElement DOMElementDescriptor::selectElement(QWebFrame* frame, DOMElementResolver* resolver) const
 {
     Q_CHECK_PTR(frame);
 
@@ -86,37 +98,20 @@ QWebElement DOMElementDescriptor::selectElement(QWebFrame* frame) const
     }
 
     if (mIsBody) {
-        QWebElement body = frame->findFirstElement("body");
+        QWebElement body = resolver->body(frame);
         Q_ASSERT(body != NULL_WEB_ELEMENT);
         return body;
     }
 
-    QWebElement current = frame->findFirstElement("body");
-    Q_ASSERT(current != NULL_WEB_ELEMENT);
+    Q_ASSERT(resolver->body(frame) != NULL_WEB_ELEMENT);
 
-    foreach(int id, mElementPath) {
-        current = selectNthChild(current, id);
-
-        if (current == NULL_WEB_ELEMENT) {
-            qDebug() << "ERROR: Invalid DOM element descriptor applied to web page";
-            return QWebElement();
-        }
-    }
-
-    return current;
-}
-
-QWebElement DOMElementDescriptor::selectNthChild(QWebElement elm, int n) const
-{
-    QWebElement currentChild = elm.firstChild();
+    QWebElement element = resolver->resolve(frame, mDescriptorId, mElementPath);
 
-    int i = 1;
-    while (i < n) {
-        currentChild = currentChild.nextSibling();
-        i++;
+    if (element == NULL_WEB_ELEMENT) {
+        qDebug() << "ERROR: Invalid DOM element descriptor applied to web page";
     }
 
-    return currentChild;
+    return element;
 }
 
 /*
@@ -62,6 +62,9 @@ public:
     QString toString() const;
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
+    DOMElementDescriptor();
+
     // Stored attributes
     QString mId;
     QString mTagName;
@@ -74,6 +77,10 @@ private:
     // Path from the frame containing the element to the actual element
     QList<int> mElementPath;
 
+    // Identifies this descriptor (and its copies) in the element cache of the page
+    quint64 mDescriptorId;
+    static quint64 mNextDescriptorId;
+
     // Special cases
     bool mIsDocument;
     bool mIsBody;
@@ -86,8 +93,7 @@ private:
     void setElementPath(QWebElement* elm);
 
     QWebFrame* selectFrame(ArtemisWebPagePtr page) const;
-    QWebElement selectElement(QWebFrame* frame) const;
-    QWebElement selectNthChild(QWebElement elm, int n) const;
+    QWebElement selectElement(QWebFrame* frame, DOMElementResolver* resolver) const;
 };
 
 typedef QSharedPointer<DOMElementDescriptor> DOMElementDescriptorPtr;
@@ -61,6 +61,9 @@ public:
 
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
+    EventHandlerDescriptor() {}
+
     DOMElementDescriptorConstPtr mElement;
     QString mEventName;
     QString mXPath;
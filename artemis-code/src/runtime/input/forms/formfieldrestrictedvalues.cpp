@@ -20,6 +20,8 @@
 #include <QDebug>
 #include <QMap>
 #include <QWebElement>
+#include <QWebFrame>
+#include <QWebFormControl>
 
 namespace artemis
 {
@@ -29,28 +31,39 @@ FormRestrictions FormFieldRestrictedValues::getRestrictions(QList<FormFieldDescr
     QSet<SelectRestriction> selects;
     QMap<QString, RadioRestriction > radioGroups;
 
+    // Read all form controls of the page in one pass, and look up the fields among them.
+    // Fields are always resolved in the main frame, see DOMElementDescriptor::selectFrame.
+    QList<QWebFormControl> controls = page->mainFrame()->documentElement().formControls();
+    QHash<uint, int> controlIndexes;
+
+    for (int i = 0; i < controls.size(); i++) {
+        controlIndexes.insert(controls.at(i).elementId, i);
+    }
+
     // Loop through form fields and add them to selects or radios (or ignore) as appropriate.
     foreach(FormFieldDescriptorConstPtr field, formFields) {
+        int index = controlIndexes.value(field->getDomElement()->getElement(page).artemisId(), -1);
+        const QWebFormControl* control = index == -1 ? NULL : &controls.at(index);
+
         if (field->getType() == FIXED_INPUT) {
             SelectRestriction result;
             result.variable = getVariableName(field);
-            // A small JS injection to make sure the value property is correctly set on all option elements.
-            field->getDomElement()->getElement(page).evaluateJavaScript("for(i=0; i<this.length; i++){ this.options[i].value = this.options[i].value; }"); // Surprisingly not necessarily a no-op.
-            // Read back the values.
-            QWebElementCollection options = field->getDomElement()->getElement(page).findAll("option");
-            foreach(QWebElement o, options) {
-                result.values.append(o.attribute("value"));
+            // The value property of an option is its value attribute, or its text if there is no value attribute.
+            if (control != NULL) {
+                foreach(const QWebFormOption& o, control->options) {
+                    result.values.append(o.value);
+                }
             }
             selects.insert(result);
 
-        } else if (field->getDomElement()->getElement(page).attribute("type") == "radio") {
+        } else if (control != NULL && control->type == "radio") {
             QString varName = getVariableName(field);
             QString groupName = field->getDomElement()->getName();
 
             // radioGroups[groupName] gives a default constructed RadioRestriction if groupName is not yet in the map.
             radioGroups[groupName].groupName = groupName;
             radioGroups[groupName].variables.insert(varName);
-            radioGroups[groupName].alwaysSet = radioGroups[groupName].alwaysSet || field->getDomElement()->getElement(page).hasAttribute("checked");
+            radioGroups[groupName].alwaysSet = radioGroups[groupName].alwaysSet || control->checked;
 
         }
     }
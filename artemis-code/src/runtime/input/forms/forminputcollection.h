@@ -52,6 +52,7 @@ public:
     QDebug friend operator<<(QDebug dbg, FormInputCollection* f);
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
     QList<FormInputPair> mInputs;
 
     bool mTriggerOnAllFields;
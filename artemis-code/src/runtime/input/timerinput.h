@@ -39,6 +39,7 @@ public:
     QString toString() const;
 
 private:
+    friend class ConfigurationSerialiser; // writes and reads the fields directly
     QSharedPointer<const Timer> mTimer;
 };
 
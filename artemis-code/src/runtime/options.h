@@ -56,7 +56,7 @@ enum PathTraceReport {
 };
 
 enum ConcolicTreeOutput {
-    TREE_NONE, TREE_FINAL, TREE_ALL
+    TREE_NONE, TREE_FINAL, TREE_ALL, TREE_LOG
 };
 
 enum HeapReport{
@@ -67,6 +67,14 @@ enum ExportEventSequence{
     DONT_EXPORT, EXPORT_SELENIUM, EXPORT_JSON
 };
 
+enum NetworkCacheMode {
+    NETWORK_CACHE_OFF, NETWORK_CACHE_PAGE_LOAD, NETWORK_CACHE_REPLAY, NETWORK_CACHE_STRICT
+};
+
+enum VirtualTimeMode {
+    VIRTUAL_TIME_OFF, VIRTUAL_TIME_MANUAL, VIRTUAL_TIME_AUTO
+};
+
 enum SMTSolver {
     KALUZA, Z3STR, CVC4
 };
@@ -98,6 +106,7 @@ typedef struct OptionsType {
         reportPathTrace(NO_TRACES),
         concolicTreeOutput(TREE_FINAL),
         concolicTreeOutputOverview(false),
+        concolicTreeReplayIteration(-1),
         concolicTriggerEventHandlers(false),
         concolicEventHandlerReport(false),
         concolicEventHandlerPermutation(""),
@@ -106,12 +115,24 @@ typedef struct OptionsType {
         concolicDfsRestartLimit(3),
         concolicSearchBudget(25),
         solver(CVC4),
+        concolicSolverWorkers(1),
+        concolicSolverCache(false),
+        concolicCheckpointInterval(10),
+        concolicConstraintDir(""),
         exportEventSequence(DONT_EXPORT),
         reportHeap(NO_CALLS),
         heapReportFactor(1),
         concolicDisabledFeatures(0),
         debugConcolic(false),
-        enableEventVisibilityFiltering(false)
+        enableEventVisibilityFiltering(false),
+        networkCache(NETWORK_CACHE_OFF),
+        enableBytecodeCoverage(true),
+        enableConstantStringInstrumentation(false),
+        enablePropertyAccessInstrumentation(false),
+        virtualTime(VIRTUAL_TIME_OFF),
+        virtualTimeHorizon(10000),
+        workers(1),
+        workerShard(-1)
     {}
 
     QMap<QString, InjectionValue> presetFormfields;
@@ -140,6 +161,8 @@ typedef struct OptionsType {
 
     ConcolicTreeOutput concolicTreeOutput;
     bool concolicTreeOutputOverview;
+    QString concolicTreeReplayFile;
+    int concolicTreeReplayIteration; // The latest tree in the log if negative
     QString concolicEntryPoint;
     bool concolicTriggerEventHandlers;
     bool concolicEventHandlerReport;
@@ -153,6 +176,15 @@ typedef struct OptionsType {
     unsigned int concolicSearchBudget;
 
     SMTSolver solver;
+    int concolicSolverWorkers;
+    bool concolicSolverCache;
+    QString concolicSolverCacheFile;
+
+    QString concolicCheckpointFile;
+    unsigned int concolicCheckpointInterval; // iterations
+    QString concolicResumeFile;
+
+    QString concolicConstraintDir; // empty for a directory private to this process
 
     ExportEventSequence exportEventSequence;
 
@@ -166,6 +198,20 @@ typedef struct OptionsType {
 
     bool debugConcolic;
     bool enableEventVisibilityFiltering;
+    NetworkCacheMode networkCache;
+    QString networkCacheArchive;
+    bool enableBytecodeCoverage;
+    bool enableConstantStringInstrumentation;
+    bool enablePropertyAccessInstrumentation;
+    VirtualTimeMode virtualTime;
+    unsigned int virtualTimeHorizon; // ms
+
+    int workers;
+    int workerShard; // set in worker processes started by a coordinator, -1 otherwise
+    QString workerOutput;
+
+    QString statisticsJSON;
+    QString statisticsTimeline;
 
 } Options;
 
@@ -19,6 +19,7 @@
 
 #include <QSharedPointer>
 #include <QDebug>
+#include <QWebExecutionListener>
 
 #include "model/coverage/coveragetooutputstream.h"
 #include "util/loggingutil.h"
@@ -56,6 +57,8 @@
 #include "concolic/solver/cvc4solver.h"
 #include "concolic/pathcondition.h"
 
+#include "runtime/worker/workerpool.h"
+
 #include "runtime.h"
 
 using namespace std;
@@ -66,6 +69,7 @@ namespace artemis
 Runtime::Runtime(QObject* parent, const Options& options, const QUrl& url)
     : QObject(parent)
     , mDisabledFeatures(options.concolicDisabledFeatures)
+    , mStatisticsIteration(0)
 {
     Log::info("Artemis - Automated tester for JavaScript");
     Log::info("Started: " + QDateTime::currentDateTime().toString().toStdString());
@@ -74,6 +78,11 @@ Runtime::Runtime(QObject* parent, const Options& options, const QUrl& url)
 
     mOptions = options;
 
+    if (!options.statisticsTimeline.isEmpty()) {
+        mStatisticsTimeline.open(options.statisticsTimeline.toStdString().c_str(), std::ofstream::out | std::ofstream::trunc);
+        mStatisticsSnapshot = Statistics::statistics()->snapshot();
+    }
+
     /** Proxy support **/
 
     if (!options.useProxy.isNull()) {
@@ -104,13 +113,29 @@ Runtime::Runtime(QObject* parent, const Options& options, const QUrl& url)
 
     mAppmodel = AppModelPtr(new AppModel(options));
 
-    bool enableConstantStringInstrumentation = options.formInputGenerationStrategy == ConstantString;
-    bool enablePropertyAccessInstrumentation = options.prioritizerStrategy == READWRITE;
+    bool enableConstantStringInstrumentation = options.enableConstantStringInstrumentation ||
+            options.formInputGenerationStrategy == ConstantString;
+    bool enablePropertyAccessInstrumentation = options.enablePropertyAccessInstrumentation ||
+            options.prioritizerStrategy == READWRITE;
+    bool enableBytecodeCoverageInstrumentation = options.enableBytecodeCoverage ||
+            options.outputCoverage != NONE ||
+            options.prioritizerStrategy == COVERAGE ||
+            options.prioritizerStrategy == ALL_STRATEGIES ||
+            options.majorMode == MANUAL;
+    // The traces are only used by the concolic analysis and the concolic target generator.
+    bool enableDomModificationDetection = options.majorMode == CONCOLIC ||
+            options.targetStrategy == TARGET_CONCOLIC;
     mWebkitExecutor = new WebKitExecutor(this, mAppmodel, options.presetFormfields,
                                          jqueryListener, ajaxRequestListner,
                                          enableConstantStringInstrumentation,
                                          enablePropertyAccessInstrumentation,
+                                         enableBytecodeCoverageInstrumentation,
+                                         enableDomModificationDetection,
                                          options.enableEventVisibilityFiltering,
+                                         options.networkCache,
+                                         options.networkCacheArchive,
+                                         options.virtualTime,
+                                         options.virtualTimeHorizon,
                                          options.concolicDisabledFeatures);
 
     if(!options.customUserAgent.isEmpty()) {
@@ -230,6 +255,16 @@ void Runtime::done()
 
     Log::info("Artemis: Testing done...");
 
+    QWebExecutionListener::getListener()->flushBytecodes();
+
+    if (mOptions.workerShard >= 0) {
+        // Reports are produced by the coordinator from the merged results of all workers
+        WorkerPool::writeResults(mOptions.workerOutput, mOptions.workerShard, mAppmodel);
+
+        emit sigTestingDone();
+        std::exit(0);
+    }
+
     switch (mOptions.outputCoverage) {
     case HTML:
         writeCoverageHtml(mAppmodel->getCoverageListener(), coveragePath);
@@ -301,12 +336,34 @@ void Runtime::done()
     Statistics::statistics()->writeToStdOut();
     Log::info("\n=== Statistics END ===\n\n");
 
+    if (!mOptions.statisticsJSON.isEmpty()) {
+        std::ofstream statisticsJSON(mOptions.statisticsJSON.toStdString().c_str());
+        Statistics::statistics()->writeJSON(statisticsJSON);
+    }
+
     Log::info("Artemis terminated on: "+ QDateTime::currentDateTime().toString().toStdString());
 
     emit sigTestingDone();
     std::exit(0);
 }
 
+void Runtime::recordStatisticsIteration()
+{
+    if (!mStatisticsTimeline.is_open()) {
+        return;
+    }
+
+    Statistics::StatsSnapshot snapshot = Statistics::statistics()->snapshot();
+
+    mStatisticsTimeline << "{\"iteration\": " << mStatisticsIteration++
+                        << ", \"time\": " << QDateTime::currentMSecsSinceEpoch()
+                        << ", \"statistics\": ";
+    Statistics::StatsStorage::writeJSONDiff(mStatisticsTimeline, mStatisticsSnapshot, snapshot);
+    mStatisticsTimeline << "}" << std::endl;
+
+    mStatisticsSnapshot = snapshot;
+}
+
 void Runtime::slAbortedExecution(QString reason)
 {
     cerr << reason.toStdString() << std::endl;
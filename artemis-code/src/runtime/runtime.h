@@ -21,6 +21,7 @@
 #include <QUrl>
 #include <QNetworkProxy>
 #include <set>
+#include <fstream>
 #include <QString>
 
 #include "strategies/inputgenerator/inputgeneratorstrategy.h"
@@ -37,6 +38,7 @@
 
 #include "concolic/solver/solver.h"
 #include "model/eventexecutionstatistics.h"
+#include "statistics/statsstorage.h"
 
 namespace artemis
 {
@@ -54,6 +56,9 @@ public:
 protected:
     virtual void done();
 
+    // Should be called once per iteration, writes the statistics which changed since the last call to the timeline.
+    void recordStatisticsIteration();
+
     AppModelPtr mAppmodel;
     WebKitExecutor* mWebkitExecutor;
     set<long> mVisitedStates;
@@ -74,6 +79,10 @@ protected:
 private:
     QString* mHeapReport;
 
+    std::ofstream mStatisticsTimeline;
+    Statistics::StatsSnapshot mStatisticsSnapshot;
+    int mStatisticsIteration;
+
 private slots:
     void slAbortedExecution(QString reason);
 
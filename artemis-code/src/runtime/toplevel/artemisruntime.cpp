@@ -28,7 +28,10 @@ namespace artemis
 
 ArtemisRuntime::ArtemisRuntime(QObject* parent, const Options& options, const QUrl& url) :
     Runtime(parent, options, url),
-    mEntryPointDetector(mWebkitExecutor->getPage())
+    mEntryPointDetector(mWebkitExecutor->getPage()),
+    mWorkerPool(NULL),
+    mWorkerQueue(NULL),
+    mWorkerQueueDone(false)
 {
     mIterations = 1;
     QObject::connect(mWebkitExecutor, SIGNAL(sigExecutedSequence(ExecutableConfigurationConstPtr, QSharedPointer<ExecutionResult>)),
@@ -39,6 +42,23 @@ ArtemisRuntime::ArtemisRuntime(QObject* parent, const Options& options, const QU
 
 void ArtemisRuntime::run(const QUrl& url)
 {
+    if (mOptions.workers > 1 && mOptions.workerShard < 0) {
+        mWorkerPool = new WorkerPool(this, mOptions.workers);
+        QObject::connect(mWorkerPool, SIGNAL(sigFinished()),
+                         this, SLOT(slWorkersFinished()));
+
+        mWorkerPool->start();
+        return;
+    }
+
+    if (mOptions.workerShard >= 0) {
+        mWorkerQueue = new WorkerQueue(this, mOptions, mTargetGenerator, mExecStat);
+        QObject::connect(mWorkerQueue, SIGNAL(sigReceived(QList<QSharedPointer<ExecutableConfiguration> >)),
+                         this, SLOT(slWorkerQueueReceived(QList<QSharedPointer<ExecutableConfiguration> >)));
+        QObject::connect(mWorkerQueue, SIGNAL(sigDone()),
+                         this, SLOT(slWorkerQueueDone()));
+    }
+
     QSharedPointer<ExecutableConfiguration> initialConfiguration =
         QSharedPointer<ExecutableConfiguration>(new ExecutableConfiguration(QSharedPointer<InputSequence>(new InputSequence()), url));
 
@@ -51,6 +71,12 @@ void ArtemisRuntime::preConcreteExecution()
 {
     if (mWorklist->empty() ||
         mTerminationStrategy->shouldTerminate()) {
+        if (mWorkerQueue != NULL && !mWorkerQueueDone) {
+            // Other workers may still send configurations to this one, a non-empty worklist means the iterations are used
+            mWorkerQueue->wait(!mWorklist->empty());
+            return;
+        }
+
         if(!((mIterations-1)%25)){
             cout << "\n";
         }
@@ -103,6 +129,7 @@ void ArtemisRuntime::preConcreteExecution()
 
 void ArtemisRuntime::postConcreteExecution(ExecutableConfigurationConstPtr configuration, ExecutionResultPtr result)
 {
+    recordStatisticsIteration();
     notifyAboutNewIteration(configuration);
 
     mLatestFormFields = result->getFormFields();
@@ -128,6 +155,18 @@ void ArtemisRuntime::postConcreteExecution(ExecutableConfigurationConstPtr confi
 
     // Generate new inputs
     QList<QSharedPointer<ExecutableConfiguration> > newConfigurations = mInputgenerator->addNewConfigurations(configuration, result);
+
+    if (mWorkerQueue != NULL && configuration->isInitial() && mOptions.workerShard != 0) {
+        // Every worker loads the page, but the configurations found by the initial load are not guaranteed to be the
+        // same in each of them (handler registration timing, random input values). Only the first worker deals them
+        // out, the others wait for their share.
+        newConfigurations.clear();
+
+    } else if (mWorkerQueue != NULL) {
+        // Configurations are dealt out between the workers as they are found
+        newConfigurations = mWorkerQueue->deal(newConfigurations);
+    }
+
     foreach(QSharedPointer<ExecutableConfiguration> newConfiguration, newConfigurations) {
         mWorklist->add(newConfiguration, mAppmodel);
     }
@@ -136,6 +175,31 @@ void ArtemisRuntime::postConcreteExecution(ExecutableConfigurationConstPtr confi
     preConcreteExecution();
 }
 
+void ArtemisRuntime::slWorkerQueueReceived(QList<QSharedPointer<ExecutableConfiguration> > configurations)
+{
+    foreach(QSharedPointer<ExecutableConfiguration> configuration, configurations) {
+        mWorklist->add(configuration, mAppmodel);
+    }
+
+    preConcreteExecution();
+}
+
+void ArtemisRuntime::slWorkerQueueDone()
+{
+    mWorkerQueueDone = true;
+    preConcreteExecution();
+}
+
+void ArtemisRuntime::slWorkersFinished()
+{
+    cout << "\n" << endl;
+
+    mWorkerPool->mergeResults(mAppmodel);
+
+    mWebkitExecutor->detach();
+    done();
+}
+
 
 void ArtemisRuntime::notifyAboutNewIteration(ExecutableConfigurationConstPtr configuration)
 {
@@ -20,6 +20,8 @@
 #include "runtime/worklist/worklist.h"
 
 #include "runtime/runtime.h"
+#include "runtime/worker/workerpool.h"
+#include "runtime/worker/workerqueue.h"
 #include "concolic/entrypoints.h"
 
 namespace artemis
@@ -51,8 +53,16 @@ protected:
 private:
     int mIterations;
 
+    WorkerPool* mWorkerPool;
+
+    WorkerQueue* mWorkerQueue; // set in worker processes
+    bool mWorkerQueueDone;
+
 private slots:
     void postConcreteExecution(ExecutableConfigurationConstPtr configuration, QSharedPointer<ExecutionResult> result);
+    void slWorkersFinished();
+    void slWorkerQueueReceived(QList<QSharedPointer<ExecutableConfiguration> > configurations);
+    void slWorkerQueueDone();
 
 };
 
@@ -17,9 +17,12 @@
 #include <fstream>
 #include <assert.h>
 
+#include <QDir>
+
 #include "util/loggingutil.h"
 #include "util/fileutil.h"
 #include "concolic/traceeventdetectors.h"
+#include "concolic/solver/solver.h"
 #include "statistics/statsstorage.h"
 
 #include "concolicruntime.h"
@@ -34,6 +37,7 @@ ConcolicRuntime::ConcolicRuntime(QObject* parent, const Options& options, const
     , mTraceDisplay(options.outputCoverage != NONE)
     , mTraceDisplayOverview(options.outputCoverage != NONE)
     , mHandlerTracker(options.concolicEventHandlerReport)
+    , mResuming(false)
     , mNumIterations(0)
 {
     QObject::connect(mWebkitExecutor, SIGNAL(sigExecutedSequence(ExecutableConfigurationConstPtr, QSharedPointer<ExecutionResult>)),
@@ -78,8 +82,28 @@ void ConcolicRuntime::run(const QUrl& url)
     mGraphOutputIndex = 1;
     mGraphOutputNameFormat = QString("tree-%1_%2%3-%4.gv").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss"));
 
+    if(mOptions.concolicTreeOutput == TREE_FINAL || mOptions.concolicTreeOutput == TREE_LOG){
+        QString logName = QString("tree-%1.treelog").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss"));
+        mTreeLog = ExecutionTreeLogPtr(new ExecutionTreeLog(logName, mOptions.outputCoverage != NONE));
+        mConcolicAnalysis->setTreeLog(mTreeLog);
+    }
+
+    // The checkpoint is read up front so a bad file is reported before anything runs. The session itself is only
+    // restored after the first load, which finds the form fields and entry point again.
+    if (!mOptions.concolicResumeFile.isEmpty()) {
+        if (!ExecutionTreeCheckpoint::load(mOptions.concolicResumeFile, &mResumeState)) {
+            Log::fatal(QString("Could not read the concolic checkpoint %1").arg(mOptions.concolicResumeFile).toStdString());
+            exit(1);
+        }
+        mResuming = true;
+    }
+
+    QString constraintDir = Solver::getConstraintDir(mOptions);
+    QDir().mkpath(constraintDir);
+    Log::info(QString("Constraints are logged to %1").arg(constraintDir).toStdString());
+
     std::ofstream constraintLog;
-    constraintLog.open("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
+    constraintLog.open(QDir(constraintDir).filePath("constraintlog").toStdString().c_str(), std::ofstream::out | std::ofstream::app);
 
     constraintLog << "================================================================================\n";
     constraintLog << "Begin concolic analysis of " << url.toString().toStdString() << " at " << QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss").toStdString() << "\n";
@@ -208,6 +232,8 @@ void ConcolicRuntime::postConcreteExecution(ExecutableConfigurationConstPtr conf
      *  3. Neither: A normal run, where we add to the tree and choose a new target.
      */
 
+    recordStatisticsIteration();
+
     if (mRunningFirstLoad){
 
         postInitialConcreteExecution(result); // Runs the next iteration itself.
@@ -225,6 +251,10 @@ void ConcolicRuntime::postConcreteExecution(ExecutableConfigurationConstPtr conf
     }
 
     mNumIterations++;
+
+    if (!mOptions.concolicCheckpointFile.isEmpty() && mNumIterations % mOptions.concolicCheckpointInterval == 0) {
+        saveCheckpoint(mNumIterations);
+    }
 }
 
 
@@ -240,34 +270,29 @@ void ConcolicRuntime::outputTreeGraph()
     if(mOptions.concolicTreeOutput == TREE_NONE){
         return;
     }
-    // Output the graphs, and if we are in TREE_FINAL mode, then delete the older ones.
-    // We do it like this to make sure there is always an up-to-date version of the tree saved out either for
-    // viewing the progress or in case of crashes.
 
+    // With a tree log only the changes since the previous update are written. In TREE_FINAL mode the graph itself is
+    // written once by done(), and the log keeps an up-to-date version of the tree in case of crashes.
+    if(!mTreeLog.isNull()){
+        mTreeLog->logUpdate(mNumIterations);
+        return;
+    }
+
+    writeTreeGraph();
+}
+
+// Writes the whole tree out as a graph.
+void ConcolicRuntime::writeTreeGraph()
+{
     // We want all the graphs from a certain run to have the same "base" name and an increasing index, so they can be easily grouped.
     QString name = mGraphOutputNameFormat.arg("").arg(mNumIterations).arg(mGraphOutputIndex);
     QString name_min = mGraphOutputNameFormat.arg("min_").arg(mNumIterations).arg(mGraphOutputIndex);
     Log::debug(QString("CONCOLIC-INFO: Writing tree to file %1").arg(name).toStdString());
     mGraphOutputIndex++;
 
-    QString previous_name = mGraphOutputPreviousName;
-    QString previous_name_min = mGraphOutputOverviewPreviousName;
-
     mTraceDisplay.writeGraphFile(mConcolicAnalysis->getExecutionTree(), name, false);
-    mGraphOutputPreviousName = name;
     if(mOptions.concolicTreeOutputOverview){
         mTraceDisplayOverview.writeGraphFile(mConcolicAnalysis->getExecutionTree(), name_min, false);
-        mGraphOutputOverviewPreviousName = name_min;
-    }
-
-    if(mOptions.concolicTreeOutput == TREE_FINAL){
-        // Delete the older graph files.
-        if(!previous_name.isEmpty()){ // Empty if we have not written a graph yet.
-            QFile::remove(previous_name);
-        }
-        if(!previous_name_min.isEmpty()){ // Empty if we have not written a graph yet.
-            QFile::remove(previous_name_min);
-        }
     }
 }
 
@@ -395,10 +420,53 @@ void ConcolicRuntime::postInitialConcreteExecution(QSharedPointer<ExecutionResul
     // Create the new event sequence and set mNextConfiguration.
     setupNextConfiguration(formInput);
 
+    if (mResuming) {
+        resumeFromCheckpoint(); // Runs the next iteration itself.
+        return;
+    }
+
     // Execute the next configuration.
     preConcreteExecution();
 }
 
+// Continues the saved session in place of the run with initial values, whose trace is already in the tree.
+void ConcolicRuntime::resumeFromCheckpoint()
+{
+    if (mResumeState.url != mUrl.toString()) {
+        Log::info(QString("  Warning: the checkpoint was saved for %1").arg(mResumeState.url).toStdString());
+    }
+
+    Log::info(QString("  Resuming after iteration %1 from %2").arg(mResumeState.iterations).arg(mOptions.concolicResumeFile).toStdString());
+
+    mResuming = false;
+    mRunningWithInitialValues = false;
+
+    // postConcreteExecution counts the first load once this returns.
+    mNumIterations = mResumeState.iterations - 1;
+
+    mConcolicAnalysis->restoreSession(mResumeState);
+    mResumeState = ConcolicSessionState(); // The tree is owned by the analysis from now on.
+
+    chooseNextTargetAndExplore();
+}
+
+void ConcolicRuntime::saveCheckpoint(int iterations)
+{
+    ConcolicSessionState state;
+    mConcolicAnalysis->saveSession(&state);
+
+    if (state.tree.isNull()) {
+        return;
+    }
+
+    state.url = mUrl.toString();
+    state.iterations = iterations;
+
+    if (!ExecutionTreeCheckpoint::save(mOptions.concolicCheckpointFile, state)) {
+        Log::error(QString("Could not write the concolic checkpoint %1").arg(mOptions.concolicCheckpointFile).toStdString());
+    }
+}
+
 // Re-orders the form fields list given the permutation supplied as an argument.
 // Format should be "[2,4,3,1]" but validity needs to be checked here.
 QList<FormFieldDescriptorConstPtr> ConcolicRuntime::permuteFormFields(QList<FormFieldDescriptorConstPtr> fields, QString permutation)
@@ -910,6 +978,15 @@ void ConcolicRuntime::logInjectionValues(TraceClassificationResult classificatio
 
 void ConcolicRuntime::done()
 {
+    if(mOptions.concolicTreeOutput == TREE_FINAL && !mConcolicAnalysis->getExecutionTree().isNull()){
+        writeTreeGraph();
+    }
+
+    // done() is reached before postConcreteExecution has counted the current iteration.
+    if (!mOptions.concolicCheckpointFile.isEmpty()) {
+        saveCheckpoint(mNumIterations + 1);
+    }
+
     reportStatistics();
     Runtime::done();
 }
@@ -27,6 +27,7 @@
 #include "concolic/executiontree/traceprinter.h"
 #include "concolic/executiontree/tracedisplay.h"
 #include "concolic/executiontree/tracedisplayoverview.h"
+#include "concolic/executiontree/executiontreelog.h"
 #include "concolic/traceclassifier.h"
 #include "concolic/tracestatistics.h"
 #include "concolic/handlerdependencytracker.h"
@@ -84,12 +85,18 @@ protected:
 
     // Method and variables for generating a graphviz graph of the execution tree.
     void outputTreeGraph();
+    void writeTreeGraph();
     TraceDisplay mTraceDisplay;
     TraceDisplayOverview mTraceDisplayOverview;
     QString mGraphOutputNameFormat;
     int mGraphOutputIndex;
-    QString mGraphOutputPreviousName;
-    QString mGraphOutputOverviewPreviousName;
+    ExecutionTreeLogPtr mTreeLog;
+
+    // Checkpoints of the session, see --concolic-checkpoint and --concolic-resume.
+    void saveCheckpoint(int iterations);
+    void resumeFromCheckpoint();
+    bool mResuming;
+    ConcolicSessionState mResumeState;
 
     // Helper methods for postConcreteExecution.
     void setupNextConfiguration(QSharedPointer<FormInputCollection> formInput);
@@ -0,0 +1,372 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "runtime/input/timerinput.h"
+#include "runtime/input/ajaxinput.h"
+#include "runtime/input/events/mouseeventparameters.h"
+#include "runtime/input/events/keyboardeventparameters.h"
+#include "runtime/input/events/baseeventparameters.h"
+#include "runtime/input/events/toucheventparameters.h"
+#include "runtime/input/events/unknowneventparameters.h"
+#include "strategies/inputgenerator/targets/legacytarget.h"
+#include "strategies/inputgenerator/targets/jquerytarget.h"
+
+#include "configurationserialiser.h"
+
+namespace artemis
+{
+
+ConfigurationSerialiser::ConfigurationSerialiser(TargetGeneratorConstPtr targetGenerator, EventExecutionStatistics* execStat)
+    : mTargetGenerator(targetGenerator)
+    , mExecStat(execStat)
+{
+}
+
+bool ConfigurationSerialiser::canWrite(ExecutableConfigurationConstPtr configuration)
+{
+    foreach (BaseInputConstPtr input, configuration->getInputSequence()->toList()) {
+        DomInputConstPtr domInput = input.dynamicCast<const DomInput>();
+
+        if (!domInput.isNull()) {
+            if (domInput->mTarget.dynamicCast<const LegacyTarget>().isNull() &&
+                domInput->mTarget.dynamicCast<const JQueryTarget>().isNull()) {
+                return false;
+            }
+
+        } else if (input.dynamicCast<const TimerInput>().isNull() &&
+                   input.dynamicCast<const AjaxInput>().isNull()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void ConfigurationSerialiser::write(QDataStream& out, ExecutableConfigurationConstPtr configuration)
+{
+    Q_ASSERT(canWrite(configuration));
+
+    mWrittenFields.clear();
+
+    QList<BaseInputConstPtr> inputs = configuration->getInputSequence()->toList();
+
+    out << configuration->getUrl() << (quint32)inputs.size();
+
+    foreach (BaseInputConstPtr input, inputs) {
+        DomInputConstPtr domInput = input.dynamicCast<const DomInput>();
+        QSharedPointer<const TimerInput> timerInput = input.dynamicCast<const TimerInput>();
+        QSharedPointer<const AjaxInput> ajaxInput = input.dynamicCast<const AjaxInput>();
+
+        if (!domInput.isNull()) {
+            out << (quint8)DOM_INPUT;
+            writeDomInput(out, domInput);
+
+        } else if (!timerInput.isNull()) {
+            out << (quint8)TIMER_INPUT;
+            out << (qint32)timerInput->mTimer->getId() << (qint32)timerInput->mTimer->getTimeout()
+                << timerInput->mTimer->isSingleShot();
+
+        } else {
+            out << (quint8)AJAX_INPUT;
+            out << (qint32)ajaxInput->mCallbackId;
+        }
+    }
+}
+
+ExecutableConfigurationPtr ConfigurationSerialiser::read(QDataStream& in)
+{
+    mReadFields.clear();
+
+    QUrl url;
+    quint32 numInputs;
+    in >> url >> numInputs;
+
+    QList<BaseInputConstPtr> inputs;
+
+    for (quint32 i = 0; i < numInputs; i++) {
+        quint8 type;
+        in >> type;
+
+        switch (type) {
+        case DOM_INPUT:
+            inputs.append(readDomInput(in));
+            break;
+
+        case TIMER_INPUT: {
+            qint32 id, timeout;
+            bool singleShot;
+            in >> id >> timeout >> singleShot;
+
+            inputs.append(BaseInputConstPtr(new TimerInput(QSharedPointer<const Timer>(new Timer(id, timeout, singleShot)))));
+            break;
+        }
+
+        case AJAX_INPUT: {
+            qint32 callbackId;
+            in >> callbackId;
+
+            inputs.append(BaseInputConstPtr(new AjaxInput(callbackId)));
+            break;
+        }
+
+        default:
+            return ExecutableConfigurationPtr(NULL);
+        }
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        return ExecutableConfigurationPtr(NULL);
+    }
+
+    return ExecutableConfigurationPtr(new ExecutableConfiguration(InputSequenceConstPtr(new InputSequence(inputs)), url));
+}
+
+void ConfigurationSerialiser::writeDomInput(QDataStream& out, DomInputConstPtr input)
+{
+    writeEventHandler(out, input->mEventHandler);
+    writeFormInput(out, input->mFormInput);
+    writeEventParameters(out, input->mEvtParams);
+}
+
+BaseInputConstPtr ConfigurationSerialiser::readDomInput(QDataStream& in)
+{
+    EventHandlerDescriptorConstPtr eventHandler = readEventHandler(in);
+    FormInputCollectionConstPtr formInput = readFormInput(in);
+    EventParametersConstPtr parameters = readEventParameters(in);
+
+    return BaseInputConstPtr(new DomInput(eventHandler, formInput, parameters,
+                                          mTargetGenerator->generateTarget(eventHandler), mExecStat));
+}
+
+void ConfigurationSerialiser::writeEventHandler(QDataStream& out, EventHandlerDescriptorConstPtr eventHandler)
+{
+    out << eventHandler->mEventName << eventHandler->mXPath;
+    writeElement(out, eventHandler->mElement);
+}
+
+EventHandlerDescriptorConstPtr ConfigurationSerialiser::readEventHandler(QDataStream& in)
+{
+    EventHandlerDescriptor* eventHandler = new EventHandlerDescriptor();
+
+    in >> eventHandler->mEventName >> eventHandler->mXPath;
+    eventHandler->mElement = readElement(in);
+
+    return EventHandlerDescriptorConstPtr(eventHandler);
+}
+
+void ConfigurationSerialiser::writeElement(QDataStream& out, DOMElementDescriptorConstPtr element)
+{
+    out << element->mId << element->mTagName << element->mName << element->mClassLine
+        << element->mFramePath << element->mElementPath
+        << element->mIsDocument << element->mIsBody << element->mIsMainframe << element->mInvalid;
+}
+
+DOMElementDescriptorConstPtr ConfigurationSerialiser::readElement(QDataStream& in)
+{
+    // The descriptor gets a new id, the element cache of this process has never seen it
+    DOMElementDescriptor* element = new DOMElementDescriptor();
+
+    in >> element->mId >> element->mTagName >> element->mName >> element->mClassLine
+       >> element->mFramePath >> element->mElementPath
+       >> element->mIsDocument >> element->mIsBody >> element->mIsMainframe >> element->mInvalid;
+
+    return DOMElementDescriptorConstPtr(element);
+}
+
+void ConfigurationSerialiser::writeFormInput(QDataStream& out, FormInputCollectionConstPtr formInput)
+{
+    QList<FormInputPair> inputs = formInput->getInputs();
+
+    out << (quint32)inputs.size();
+
+    foreach (FormInputPair input, inputs) {
+        writeField(out, input.first);
+
+        QVariant::Type type = input.second.getType();
+        out << (qint32)type;
+
+        if (type == QVariant::Bool) {
+            out << input.second.getBool();
+        } else if (type == QVariant::Int) {
+            out << (qint32)input.second.getInt();
+        } else {
+            out << input.second.getString();
+        }
+    }
+
+    out << formInput->mTriggerOnAllFields << (quint32)formInput->mAllFields.size();
+
+    foreach (FormFieldDescriptorConstPtr field, formInput->mAllFields) {
+        writeField(out, field);
+    }
+}
+
+FormInputCollectionConstPtr ConfigurationSerialiser::readFormInput(QDataStream& in)
+{
+    quint32 numInputs;
+    in >> numInputs;
+
+    QList<FormInputPair> inputs;
+
+    for (quint32 i = 0; i < numInputs; i++) {
+        FormFieldDescriptorConstPtr field = readField(in);
+
+        qint32 type;
+        in >> type;
+
+        if (type == QVariant::Bool) {
+            bool value;
+            in >> value;
+            inputs.append(FormInputPair(field, InjectionValue(value)));
+        } else if (type == QVariant::Int) {
+            qint32 value;
+            in >> value;
+            inputs.append(FormInputPair(field, InjectionValue((int)value)));
+        } else {
+            QString value;
+            in >> value;
+            inputs.append(FormInputPair(field, InjectionValue(value)));
+        }
+    }
+
+    bool triggerOnAllFields;
+    quint32 numFields;
+    in >> triggerOnAllFields >> numFields;
+
+    QList<FormFieldDescriptorConstPtr> allFields;
+
+    for (quint32 i = 0; i < numFields; i++) {
+        allFields.append(readField(in));
+    }
+
+    return FormInputCollectionConstPtr(new FormInputCollection(inputs, triggerOnAllFields, allFields));
+}
+
+void ConfigurationSerialiser::writeField(QDataStream& out, FormFieldDescriptorConstPtr field)
+{
+    if (mWrittenFields.contains(field.data())) {
+        out << true << mWrittenFields.value(field.data());
+        return;
+    }
+
+    out << false << (qint32)field->getType() << field->getInputOptions();
+    writeElement(out, field->getDomElement());
+
+    mWrittenFields.insert(field.data(), mWrittenFields.size());
+}
+
+FormFieldDescriptorConstPtr ConfigurationSerialiser::readField(QDataStream& in)
+{
+    bool written;
+    in >> written;
+
+    if (written) {
+        quint32 index;
+        in >> index;
+
+        return index < (quint32)mReadFields.size() ? mReadFields.at(index) : FormFieldDescriptorConstPtr(NULL);
+    }
+
+    qint32 type;
+    QSet<QString> inputOptions;
+    in >> type >> inputOptions;
+
+    FormFieldDescriptorConstPtr field(new FormFieldDescriptor((FormFieldTypes)type, readElement(in), inputOptions));
+    mReadFields.append(field);
+
+    return field;
+}
+
+void ConfigurationSerialiser::writeEventParameters(QDataStream& out, EventParametersConstPtr parameters)
+{
+    QSharedPointer<const MouseEventParameters> mouse = parameters.dynamicCast<const MouseEventParameters>();
+    QSharedPointer<const KeyboardEventParameters> keyboard = parameters.dynamicCast<const KeyboardEventParameters>();
+    QSharedPointer<const BaseEventParameters> base = parameters.dynamicCast<const BaseEventParameters>();
+
+    if (!mouse.isNull()) {
+        out << (quint8)MOUSE_PARAMETERS;
+        out << mouse->typeN << mouse->canBubble << mouse->cancelable << (qint32)mouse->detail
+            << (qint32)mouse->screenX << (qint32)mouse->screenY << (qint32)mouse->clientX << (qint32)mouse->clientY
+            << mouse->ctrlKey << mouse->altKey << mouse->shiftKey << mouse->metaKey << (qint32)mouse->button;
+
+    } else if (!keyboard.isNull()) {
+        out << (quint8)KEYBOARD_PARAMETERS;
+        out << keyboard->eventType << keyboard->canBubble << keyboard->cancelable << keyboard->keyIdentifier
+            << (quint32)keyboard->keyLocation << keyboard->ctrlKey << keyboard->altKey << keyboard->shiftKey
+            << keyboard->metaKey << keyboard->altGraphKey;
+
+    } else if (!base.isNull()) {
+        out << (quint8)BASE_PARAMETERS;
+        out << base->name << base->bubbles << base->cancelable;
+
+    } else if (parameters->getType() == TOUCH_EVENT) {
+        out << (quint8)TOUCH_PARAMETERS;
+
+    } else {
+        out << (quint8)UNKNOWN_PARAMETERS;
+    }
+}
+
+EventParametersConstPtr ConfigurationSerialiser::readEventParameters(QDataStream& in)
+{
+    quint8 type;
+    in >> type;
+
+    switch (type) {
+    case MOUSE_PARAMETERS: {
+        QString typeN;
+        bool canBubble, cancelable, ctrlKey, altKey, shiftKey, metaKey;
+        qint32 detail, screenX, screenY, clientX, clientY, button;
+
+        in >> typeN >> canBubble >> cancelable >> detail >> screenX >> screenY >> clientX >> clientY
+           >> ctrlKey >> altKey >> shiftKey >> metaKey >> button;
+
+        return EventParametersConstPtr(new MouseEventParameters(typeN, canBubble, cancelable, detail,
+                                                                screenX, screenY, clientX, clientY,
+                                                                ctrlKey, altKey, shiftKey, metaKey, button));
+    }
+
+    case KEYBOARD_PARAMETERS: {
+        QString eventType, keyIdentifier;
+        bool canBubble, cancelable, ctrlKey, altKey, shiftKey, metaKey, altGraphKey;
+        quint32 keyLocation;
+
+        in >> eventType >> canBubble >> cancelable >> keyIdentifier >> keyLocation
+           >> ctrlKey >> altKey >> shiftKey >> metaKey >> altGraphKey;
+
+        return EventParametersConstPtr(new KeyboardEventParameters(eventType, canBubble, cancelable, keyIdentifier, keyLocation,
+                                                                   ctrlKey, altKey, shiftKey, metaKey, altGraphKey));
+    }
+
+    case BASE_PARAMETERS: {
+        QString name;
+        bool bubbles, cancelable;
+
+        in >> name >> bubbles >> cancelable;
+
+        return EventParametersConstPtr(new BaseEventParameters(name, bubbles, cancelable));
+    }
+
+    case TOUCH_PARAMETERS:
+        return EventParametersConstPtr(new TouchEventParameters());
+
+    default:
+        return EventParametersConstPtr(new UnknownEventParameters());
+    }
+}
+
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef CONFIGURATIONSERIALISER_H
+#define CONFIGURATIONSERIALISER_H
+
+#include <QDataStream>
+#include <QMap>
+
+#include "runtime/executableconfiguration.h"
+#include "runtime/input/dominput.h"
+#include "strategies/inputgenerator/targets/targetgenerator.h"
+#include "model/eventexecutionstatistics.h"
+
+namespace artemis
+{
+
+/**
+ * Writes executable configurations to a stream and reads them back in another Artemis process.
+ *
+ * DOM element descriptors are stored by their attributes and path, such that they resolve to the same element when
+ * the configuration is executed by another process. Targets are not stored, they are regenerated by the target
+ * generator of the reading process. This only works for targets depending on nothing but the event handler, so
+ * configurations with concolic targets or inputs specific to the concolic mode can not be written (see canWrite).
+ */
+class ConfigurationSerialiser
+{
+
+public:
+    ConfigurationSerialiser(TargetGeneratorConstPtr targetGenerator, EventExecutionStatistics* execStat);
+
+    static bool canWrite(ExecutableConfigurationConstPtr configuration);
+
+    void write(QDataStream& out, ExecutableConfigurationConstPtr configuration);
+    ExecutableConfigurationPtr read(QDataStream& in);
+
+private:
+    enum InputType {
+        DOM_INPUT, TIMER_INPUT, AJAX_INPUT
+    };
+
+    enum EventParametersType {
+        MOUSE_PARAMETERS, KEYBOARD_PARAMETERS, BASE_PARAMETERS, TOUCH_PARAMETERS, UNKNOWN_PARAMETERS
+    };
+
+    void writeDomInput(QDataStream& out, DomInputConstPtr input);
+    BaseInputConstPtr readDomInput(QDataStream& in);
+
+    void writeEventHandler(QDataStream& out, EventHandlerDescriptorConstPtr eventHandler);
+    EventHandlerDescriptorConstPtr readEventHandler(QDataStream& in);
+
+    void writeElement(QDataStream& out, DOMElementDescriptorConstPtr element);
+    DOMElementDescriptorConstPtr readElement(QDataStream& in);
+
+    void writeFormInput(QDataStream& out, FormInputCollectionConstPtr formInput);
+    FormInputCollectionConstPtr readFormInput(QDataStream& in);
+
+    void writeField(QDataStream& out, FormFieldDescriptorConstPtr field);
+    FormFieldDescriptorConstPtr readField(QDataStream& in);
+
+    void writeEventParameters(QDataStream& out, EventParametersConstPtr parameters);
+    EventParametersConstPtr readEventParameters(QDataStream& in);
+
+    TargetGeneratorConstPtr mTargetGenerator;
+    EventExecutionStatistics* mExecStat;
+
+    // Form fields are shared between the inputs of a configuration, they are written once and then referred to by index
+    QMap<const FormFieldDescriptor*, quint32> mWrittenFields;
+    QList<FormFieldDescriptorConstPtr> mReadFields;
+};
+
+}
+
+#endif // CONFIGURATIONSERIALISER_H
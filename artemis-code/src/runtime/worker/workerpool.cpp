@@ -0,0 +1,139 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <fstream>
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QDataStream>
+#include <QFile>
+#include <QDir>
+
+#include "util/loggingutil.h"
+#include "util/fileutil.h"
+#include "statistics/statsstorage.h"
+
+#include "workerqueue.h"
+#include "workerpool.h"
+
+namespace artemis
+{
+
+WorkerPool::WorkerPool(QObject* parent, int numWorkers)
+    : QObject(parent)
+    , mNumWorkers(numWorkers)
+    , mNumFinished(0)
+    , mNumFailed(0)
+{
+    mOutputDir = QDir::temp().filePath(QString("artemis-workers-%1").arg(QCoreApplication::applicationPid()));
+}
+
+void WorkerPool::start()
+{
+    QDir().mkpath(mOutputDir);
+
+    Log::info("Starting " + QString::number(mNumWorkers).toStdString() + " workers, output is written to " + mOutputDir.toStdString());
+
+    QStringList arguments = QCoreApplication::arguments();
+    QString program = arguments.takeFirst();
+
+    for (int shard = 0; shard < mNumWorkers; shard++) {
+        QProcess* worker = new QProcess(this);
+        worker->setProcessChannelMode(QProcess::MergedChannels);
+        worker->setStandardOutputFile(QDir(mOutputDir).filePath(QString("worker-%1.log").arg(shard)));
+
+        QObject::connect(worker, SIGNAL(finished(int, QProcess::ExitStatus)),
+                         this, SLOT(slWorkerFinished(int, QProcess::ExitStatus)));
+
+        worker->start(program, QStringList(arguments)
+                      << "--worker-shard" << QString::number(shard)
+                      << "--worker-output" << mOutputDir);
+
+        mWorkers.append(worker);
+    }
+
+    Statistics::statistics()->accumulate("Workers::started", mNumWorkers);
+}
+
+void WorkerPool::slWorkerFinished(int exitCode, QProcess::ExitStatus exitStatus)
+{
+    if (exitStatus != QProcess::NormalExit || exitCode != 0) {
+        Log::error("A worker terminated abnormally, see the worker logs in " + mOutputDir.toStdString());
+        Statistics::statistics()->accumulate("Workers::failed", 1);
+        mNumFailed++;
+
+        // The other workers would wait for it forever
+        WorkerQueue::stop(mOutputDir);
+    }
+
+    mNumFinished++;
+
+    if (mNumFinished == mNumWorkers) {
+        emit sigFinished();
+    }
+}
+
+void WorkerPool::mergeResults(AppModelPtr appmodel)
+{
+    for (int shard = 0; shard < mNumWorkers; shard++) {
+        QFile coverageFile(coveragePath(mOutputDir, shard));
+
+        if (!coverageFile.open(QIODevice::ReadOnly)) {
+            Log::error("Worker " + QString::number(shard).toStdString() + " did not produce any results");
+            continue;
+        }
+
+        QDataStream coverage(&coverageFile);
+        appmodel->getCoverageListener()->mergeCoverage(coverage);
+
+        std::ifstream statistics(statisticsPath(mOutputDir, shard).toStdString().c_str());
+        Statistics::statistics()->mergeFrom(statistics);
+    }
+
+    // The logs are kept if something went wrong
+    if (mNumFailed == 0) {
+        removeDir(mOutputDir);
+    }
+}
+
+void WorkerPool::writeResults(const QString& outputDir, int shard, AppModelPtr appmodel)
+{
+    QFile coverageFile(coveragePath(outputDir, shard));
+
+    if (!coverageFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        Log::error("Could not write worker results to " + outputDir.toStdString());
+        return;
+    }
+
+    QDataStream coverage(&coverageFile);
+    appmodel->getCoverageListener()->writeCoverage(coverage);
+
+    std::ofstream statistics(statisticsPath(outputDir, shard).toStdString().c_str());
+    Statistics::statistics()->writeTo(statistics);
+}
+
+QString WorkerPool::coveragePath(const QString& outputDir, int shard)
+{
+    return QDir(outputDir).filePath(QString("coverage-%1").arg(shard));
+}
+
+QString WorkerPool::statisticsPath(const QString& outputDir, int shard)
+{
+    return QDir(outputDir).filePath(QString("statistics-%1").arg(shard));
+}
+
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+#include <QProcess>
+
+#include "runtime/appmodel.h"
+
+namespace artemis
+{
+
+/**
+ * Runs an Artemis analysis in a number of worker processes.
+ *
+ * Each worker is started with the same command line as the coordinator and is told its shard number. A worker
+ * executes the initial configuration like any other run, but only keeps its share of the configurations found
+ * by it (see ArtemisRuntime::postConcreteExecution) and explores them with its own WebKit page and worklist.
+ * The configurations found later on are dealt out between the workers through a WorkerQueue.
+ *
+ * When a worker is done it writes its coverage and statistics to the output directory of the pool
+ * (see writeResults) and exits, the coordinator merges these into its own model once all workers are done and
+ * removes the output directory. The output of each worker is written to worker-<shard>.log in the same directory,
+ * which is kept if a worker failed.
+ */
+class WorkerPool : public QObject
+{
+    Q_OBJECT
+
+public:
+    WorkerPool(QObject* parent, int numWorkers);
+
+    void start();
+    void mergeResults(AppModelPtr appmodel);
+
+    static void writeResults(const QString& outputDir, int shard, AppModelPtr appmodel);
+
+private:
+    static QString coveragePath(const QString& outputDir, int shard);
+    static QString statisticsPath(const QString& outputDir, int shard);
+
+    int mNumWorkers;
+    int mNumFinished;
+    int mNumFailed;
+    QString mOutputDir;
+    QList<QProcess*> mWorkers;
+
+private slots:
+    void slWorkerFinished(int exitCode, QProcess::ExitStatus exitStatus);
+
+signals:
+    void sigFinished();
+};
+
+}
+
+#endif // WORKERPOOL_H
@@ -0,0 +1,273 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QDir>
+#include <QFile>
+#include <QTimer>
+#include <QDataStream>
+
+#include "util/loggingutil.h"
+#include "statistics/statsstorage.h"
+
+#include "workerqueue.h"
+
+namespace artemis
+{
+
+const int POLL_INTERVAL = 100; // ms
+
+WorkerQueue::WorkerQueue(QObject* parent, const Options& options, TargetGeneratorConstPtr targetGenerator, EventExecutionStatistics* execStat)
+    : QObject(parent)
+    , mOutputDir(options.workerOutput)
+    , mShard(options.workerShard)
+    , mNumWorkers(options.workers)
+    , mSerialiser(targetGenerator, execStat)
+    , mNumDealt(options.workerShard + 1)
+    , mNextFile(0)
+    , mSent(0)
+    , mReceived(0)
+    , mFinished(false)
+{
+    QDir().mkpath(inboxPath(mShard));
+}
+
+QList<QSharedPointer<ExecutableConfiguration> > WorkerQueue::deal(const QList<QSharedPointer<ExecutableConfiguration> >& configurations)
+{
+    QList<QSharedPointer<ExecutableConfiguration> > kept;
+    QMap<int, QList<QSharedPointer<ExecutableConfiguration> > > dealt;
+
+    // Workers which have used their iterations would drop what they are sent
+    QList<int> shards;
+    for (int shard = 0; shard < mNumWorkers; shard++) {
+        if (shard == mShard || !isFinished(shard)) {
+            shards.append(shard);
+        }
+    }
+
+    foreach (QSharedPointer<ExecutableConfiguration> configuration, configurations) {
+        if (!ConfigurationSerialiser::canWrite(configuration)) {
+            kept.append(configuration);
+            continue;
+        }
+
+        int shard = shards.at(mNumDealt++ % shards.size());
+
+        if (shard == mShard) {
+            kept.append(configuration);
+        } else {
+            dealt[shard].append(configuration);
+        }
+    }
+
+    foreach (int shard, dealt.keys()) {
+        QString name = QString("%1-%2").arg(mShard).arg(mNextFile++);
+        QString temporaryPath = QDir(mOutputDir).filePath("." + name);
+
+        QFile file(temporaryPath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            Log::error("Could not write configurations to " + temporaryPath.toStdString());
+            kept.append(dealt.value(shard));
+            continue;
+        }
+
+        QDataStream out(&file);
+        out << (quint32)dealt.value(shard).size();
+
+        foreach (QSharedPointer<ExecutableConfiguration> configuration, dealt.value(shard)) {
+            mSerialiser.write(out, configuration);
+        }
+
+        file.close();
+
+        // The file only appears in the inbox once it is complete
+        QDir().mkpath(inboxPath(shard));
+        if (!QFile::rename(temporaryPath, QDir(inboxPath(shard)).filePath(name))) {
+            Log::error("Could not send configurations to worker " + QString::number(shard).toStdString());
+            QFile::remove(temporaryPath);
+            kept.append(dealt.value(shard));
+            continue;
+        }
+
+        mSent++;
+        Statistics::statistics()->accumulate("Workers::configurations-sent", dealt.value(shard).size());
+    }
+
+    return kept;
+}
+
+void WorkerQueue::wait(bool finished)
+{
+    mFinished = finished;
+    writeState();
+
+    QTimer::singleShot(POLL_INTERVAL, this, SLOT(slPoll()));
+}
+
+void WorkerQueue::slPoll()
+{
+    QDir inbox(inboxPath(mShard));
+    QStringList names = inbox.entryList(QDir::Files, QDir::Name);
+
+    if (names.isEmpty()) {
+        if (allDone()) {
+            emit sigDone();
+        } else {
+            QTimer::singleShot(POLL_INTERVAL, this, SLOT(slPoll()));
+        }
+        return;
+    }
+
+    // The state file is removed before the inbox is emptied, such that the others never see this worker as waiting
+    // with an empty inbox while it still has work (see allDone)
+    QFile::remove(statePath(mShard));
+
+    QList<QSharedPointer<ExecutableConfiguration> > configurations;
+
+    foreach (QString name, names) {
+        QFile file(inbox.filePath(name));
+
+        if (file.open(QIODevice::ReadOnly)) {
+            QDataStream in(&file);
+
+            quint32 numConfigurations;
+            in >> numConfigurations;
+
+            for (quint32 i = 0; i < numConfigurations; i++) {
+                QSharedPointer<ExecutableConfiguration> configuration = mSerialiser.read(in);
+
+                if (configuration.isNull()) {
+                    Log::error("Could not read the configurations in " + file.fileName().toStdString());
+                    break;
+                }
+
+                configurations.append(configuration);
+            }
+
+            file.close();
+        }
+
+        file.remove();
+        mReceived++;
+    }
+
+    Statistics::statistics()->accumulate("Workers::configurations-received", configurations.size());
+
+    if (mFinished || configurations.isEmpty()) {
+        // This worker has used its iterations, the configurations are dropped like the rest of its worklist
+        wait(mFinished);
+        return;
+    }
+
+    emit sigReceived(configurations);
+}
+
+void WorkerQueue::writeState()
+{
+    QString path = statePath(mShard);
+    QString temporaryPath = QDir(mOutputDir).filePath(QString(".state-%1").arg(mShard));
+
+    QFile file(temporaryPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        Log::error("Could not write the worker state to " + temporaryPath.toStdString());
+        return;
+    }
+
+    QDataStream out(&file);
+    out << mSent << mReceived << mFinished;
+    file.close();
+
+    QFile::remove(path);
+    QFile::rename(temporaryPath, path);
+}
+
+bool WorkerQueue::isFinished(int shard) const
+{
+    QFile file(statePath(shard));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+    quint64 sent, received;
+    bool finished;
+    in >> sent >> received >> finished;
+
+    return in.status() == QDataStream::Ok && finished;
+}
+
+bool WorkerQueue::allDone() const
+{
+    if (QFile::exists(QDir(mOutputDir).filePath("stop"))) {
+        return true;
+    }
+
+    // Every worker is waiting and all sent files are received. The states are read twice, if a worker took
+    // configurations from its inbox in between, its state was removed or has changed.
+    QList<QByteArray> states;
+
+    for (int wave = 0; wave < 2; wave++) {
+        quint64 sent = 0;
+        quint64 received = 0;
+
+        for (int shard = 0; shard < mNumWorkers; shard++) {
+            QFile file(statePath(shard));
+            if (!file.open(QIODevice::ReadOnly)) {
+                return false;
+            }
+
+            QByteArray state = file.readAll();
+
+            if (wave == 0) {
+                states.append(state);
+            } else if (states.at(shard) != state) {
+                return false;
+            }
+
+            QDataStream in(state);
+            quint64 shardSent, shardReceived;
+            in >> shardSent >> shardReceived;
+
+            sent += shardSent;
+            received += shardReceived;
+        }
+
+        if (sent != received) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void WorkerQueue::stop(const QString& outputDir)
+{
+    QFile file(QDir(outputDir).filePath("stop"));
+    file.open(QIODevice::WriteOnly);
+    file.close();
+}
+
+QString WorkerQueue::inboxPath(int shard) const
+{
+    return QDir(mOutputDir).filePath(QString("inbox-%1").arg(shard));
+}
+
+QString WorkerQueue::statePath(int shard) const
+{
+    return QDir(mOutputDir).filePath(QString("state-%1").arg(shard));
+}
+
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef WORKERQUEUE_H
+#define WORKERQUEUE_H
+
+#include <QObject>
+#include <QList>
+#include <QString>
+
+#include "runtime/options.h"
+#include "runtime/executableconfiguration.h"
+
+#include "configurationserialiser.h"
+
+namespace artemis
+{
+
+/**
+ * The work queue shared by the worker processes of a WorkerPool, kept in the output directory of the pool.
+ *
+ * Every worker explores the configurations in its own worklist. The configurations found by each of its executions
+ * are dealt out between the workers round-robin (see deal), those dealt to another worker are written to the
+ * inbox-<shard> directory of that worker. Configurations which can not be written (see ConfigurationSerialiser) are
+ * always kept by the worker which found them. Every worker loads the page itself, but only worker 0 deals out the
+ * configurations found by that initial load, as they can differ between the workers.
+ *
+ * A worker with an empty worklist, or which has used its iterations, waits for configurations in its inbox. While
+ * waiting it keeps a state-<shard> file with the number of inbox files it has sent and received. The workers are
+ * done once two consecutive reads of all state files agree and as many files were received as were sent.
+ */
+class WorkerQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    WorkerQueue(QObject* parent, const Options& options, TargetGeneratorConstPtr targetGenerator, EventExecutionStatistics* execStat);
+
+    QList<QSharedPointer<ExecutableConfiguration> > deal(const QList<QSharedPointer<ExecutableConfiguration> >& configurations);
+
+    // Emits sigReceived with the configurations sent to this worker, or sigDone once all workers are done.
+    // A finished worker discards the configurations sent to it.
+    void wait(bool finished);
+
+    // Written by the coordinator if a worker fails, such that the others stop waiting for it
+    static void stop(const QString& outputDir);
+
+private:
+    QString inboxPath(int shard) const;
+    QString statePath(int shard) const;
+
+    void writeState();
+    bool isFinished(int shard) const;
+    bool allDone() const;
+
+    QString mOutputDir;
+    int mShard;
+    int mNumWorkers;
+
+    ConfigurationSerialiser mSerialiser;
+
+    int mNumDealt; // offset by the shard of this worker, such that the workers do not all start dealing to the same one
+    quint64 mNextFile;
+
+    quint64 mSent;
+    quint64 mReceived;
+    bool mFinished;
+
+private slots:
+    void slPoll();
+
+signals:
+    void sigReceived(QList<QSharedPointer<ExecutableConfiguration> > configurations);
+    void sigDone();
+};
+
+}
+
+#endif // WORKERQUEUE_H
@@ -14,79 +14,230 @@
  * limitations under the License.
  */
 
-#include <stdlib.h>
+#include "statistics/statsstorage.h"
 
 #include "deterministicworklist.h"
 
 namespace artemis
 {
 
+static const int HEAP_ARITY = 4;
+
 DeterministicWorkList::DeterministicWorkList(PrioritizerStrategyPtr prioritizer) :
     WorkList(),
+    mNextOrder(0),
     mPrioritizer(prioritizer)
 {
 }
 
 void DeterministicWorkList::add(ExecutableConfigurationConstPtr configuration, AppModelConstPtr appmodel)
 {
-    mQueue.push(WorkListItem(mPrioritizer->prioritize(configuration, appmodel), configuration));
+    int entry;
+
+    if (mFreeEntries.isEmpty()) {
+        entry = mEntries.size();
+        mEntries.append(Entry());
+    } else {
+        entry = mFreeEntries.last();
+        mFreeEntries.pop_back();
+    }
+
+    Entry& item = mEntries[entry];
+    item.priority = mPrioritizer->prioritize(configuration, appmodel);
+    item.order = mNextOrder++;
+    item.configuration = configuration;
+    item.inputs.clear();
+
+    foreach (QSharedPointer<const BaseInput> input, configuration->getInputSequence()->toList()) {
+        uint inputHash = input->hashCode();
+
+        if (!item.inputs.contains(inputHash)) {
+            item.inputs.append(inputHash);
+            mEntriesByInput[inputHash].insert(entry);
+        }
+    }
+
+    mHeap.append(entry);
+    item.heapIndex = mHeap.size() - 1;
+    siftUp(item.heapIndex);
 }
 
 ExecutableConfigurationConstPtr DeterministicWorkList::remove()
 {
-    Q_ASSERT(!mQueue.empty());
+    Q_ASSERT(!mHeap.empty());
+
+    int entry = mHeap.first();
+    Entry& item = mEntries[entry];
 
-    ExecutableConfigurationConstPtr configuration = mQueue.top().second;
-    mQueue.pop();
+    ExecutableConfigurationConstPtr configuration = item.configuration;
+
+    foreach (uint inputHash, item.inputs) {
+        QHash<uint, QSet<int> >::iterator entries = mEntriesByInput.find(inputHash);
+        entries.value().remove(entry);
+
+        if (entries.value().isEmpty()) {
+            mEntriesByInput.erase(entries);
+        }
+    }
+
+    item.configuration.clear();
+    item.inputs.clear();
+    mFreeEntries.append(entry);
+
+    int last = mHeap.last();
+    mHeap.pop_back();
+
+    if (!mHeap.empty()) {
+        place(0, last);
+        siftDown(0);
+    }
 
     return configuration;
 }
 
 void DeterministicWorkList::reprioritize(AppModelConstPtr appmodel)
 {
-    QList<WorkListItem> tmps;
+    QSet<uint> changedInputs;
 
-    while (!mQueue.empty()) {
-        tmps.append(mQueue.top());
-        mQueue.pop();
+    if (!mPrioritizer->collectChangedInputs(appmodel, &changedInputs)) {
+
+        foreach (int entry, mHeap) {
+            mEntries[entry].priority = mPrioritizer->prioritize(mEntries[entry].configuration, appmodel);
+        }
+
+        for (int heapIndex = (mHeap.size() - 2) / HEAP_ARITY; heapIndex >= 0; heapIndex--) {
+            siftDown(heapIndex);
+        }
+
+        Statistics::statistics()->accumulate("WorkList::rescored", mHeap.size());
+        return;
+    }
+
+    QSet<int> affected;
+
+    foreach (uint inputHash, changedInputs) {
+        QHash<uint, QSet<int> >::const_iterator entries = mEntriesByInput.constFind(inputHash);
+
+        if (entries != mEntriesByInput.constEnd()) {
+            affected.unite(entries.value());
+        }
     }
 
-    foreach (WorkListItem item, tmps) {
-        item.first = mPrioritizer->prioritize(item.second, appmodel);
-        mQueue.push(item);
+    foreach (int entry, affected) {
+        updatePriority(entry, mPrioritizer->prioritize(mEntries[entry].configuration, appmodel));
     }
+
+    Statistics::statistics()->accumulate("WorkList::rescored", affected.size());
 }
 
 int DeterministicWorkList::size()
 {
-    return mQueue.size();
+    return mHeap.size();
 }
 
 bool DeterministicWorkList::empty()
 {
-    return mQueue.empty();
+    return mHeap.empty();
 }
 
 QString DeterministicWorkList::toString() const
 {
-    // We can't iterate over a priority_queue, thus the ugliness here
-    // TODO find a priority_queue implementation supporting iteration
+    // Listed in heap order, only the first entry is guaranteed to be the next one removed
+    QString output;
+
+    foreach (int entry, mHeap) {
+        const Entry& item = mEntries.at(entry);
+        output += QString::number(item.priority) + QString(" => ") + item.configuration->toString() + QString("\n");
+    }
 
-    QList<WorkListItem> tmps;
+    return output;
+}
+
+bool DeterministicWorkList::before(int lhs, int rhs) const
+{
+    const Entry& left = mEntries.at(lhs);
+    const Entry& right = mEntries.at(rhs);
 
-    while (!mQueue.empty()) {
-        tmps.append(mQueue.top());
-        mQueue.pop();
+    if (left.priority != right.priority) {
+        return left.priority > right.priority;
     }
 
-    QString output;
+    return left.order < right.order;
+}
+
+void DeterministicWorkList::place(int heapIndex, int entry)
+{
+    mHeap[heapIndex] = entry;
+    mEntries[entry].heapIndex = heapIndex;
+}
+
+void DeterministicWorkList::siftUp(int heapIndex)
+{
+    int entry = mHeap.at(heapIndex);
+
+    while (heapIndex > 0) {
+        int parentIndex = (heapIndex - 1) / HEAP_ARITY;
+        int parent = mHeap.at(parentIndex);
 
-    foreach (WorkListItem item, tmps) {
-        mQueue.push(item);
-        output += QString::number(item.first) + QString(" => ") + item.second->toString() + QString("\n");
+        if (!before(entry, parent)) {
+            break;
+        }
+
+        place(heapIndex, parent);
+        heapIndex = parentIndex;
     }
 
-    return output;
+    place(heapIndex, entry);
+}
+
+void DeterministicWorkList::siftDown(int heapIndex)
+{
+    int entry = mHeap.at(heapIndex);
+    int size = mHeap.size();
+
+    while (true) {
+        int firstChild = heapIndex * HEAP_ARITY + 1;
+
+        if (firstChild >= size) {
+            break;
+        }
+
+        int bestIndex = firstChild;
+        int lastChild = qMin(firstChild + HEAP_ARITY, size);
+
+        for (int childIndex = firstChild + 1; childIndex < lastChild; childIndex++) {
+            if (before(mHeap.at(childIndex), mHeap.at(bestIndex))) {
+                bestIndex = childIndex;
+            }
+        }
+
+        if (!before(mHeap.at(bestIndex), entry)) {
+            break;
+        }
+
+        place(heapIndex, mHeap.at(bestIndex));
+        heapIndex = bestIndex;
+    }
+
+    place(heapIndex, entry);
+}
+
+void DeterministicWorkList::updatePriority(int entry, double priority)
+{
+    Entry& item = mEntries[entry];
+    double oldPriority = item.priority;
+
+    if (priority == oldPriority) {
+        return;
+    }
+
+    item.priority = priority;
+
+    if (priority > oldPriority) {
+        siftUp(item.heapIndex);
+    } else {
+        siftDown(item.heapIndex);
+    }
 }
 
 }
@@ -17,31 +17,28 @@
 #ifndef DETERMINISTICWORKLIST_H
 #define DETERMINISTICWORKLIST_H
 
-#include <queue>
-#include <vector>
-
 #include <QPair>
+#include <QVector>
+#include <QHash>
+#include <QSet>
 #include <QSharedPointer>
 
 #include "strategies/prioritizer/prioritizerstrategy.h"
 
 #include "worklist.h"
 
-using namespace std;
-
 namespace artemis
 {
 
-typedef QPair<double, ExecutableConfigurationConstPtr> WorkListItem;
-
-struct WorkListItemComperator
-{
-    bool operator() (const WorkListItem& lhs, const WorkListItem& rhs)
-    {
-        return lhs.first < rhs.first;
-    }
-};
-
+/**
+ * Worklist ordered by the priorities assigned by a PrioritizerStrategy, highest priority first and in insertion order
+ * among equal priorities.
+ *
+ * Configurations are kept in an indexed 4-ary heap, each entry knowing its position in the heap, such that the
+ * priority of a single configuration can be updated in place. Entries are indexed by the hash codes of the inputs in
+ * their sequence, and reprioritize only rescores the configurations containing inputs reported as changed by the
+ * prioritizer (see PrioritizerStrategy::collectChangedInputs).
+ */
 class DeterministicWorkList : public WorkList
 {
 public:
@@ -58,8 +55,29 @@ public:
     QString toString() const;
 
 private:
-    // mutable here is a hack to support toString
-    mutable priority_queue<WorkListItem, vector<WorkListItem>, WorkListItemComperator> mQueue;
+    struct Entry {
+        double priority;
+        quint64 order;
+        ExecutableConfigurationConstPtr configuration;
+        QList<uint> inputs;
+        int heapIndex;
+    };
+
+    bool before(int lhs, int rhs) const;
+    void siftUp(int heapIndex);
+    void siftDown(int heapIndex);
+    void place(int heapIndex, int entry);
+    void updatePriority(int entry, double priority);
+
+    // Entries are addressed by their index in mEntries, slots of removed entries are reused
+    QVector<Entry> mEntries;
+    QVector<int> mFreeEntries;
+    QVector<int> mHeap;
+
+    // (inputHashCode -> set<entry>)
+    QHash<uint, QSet<int> > mEntriesByInput;
+
+    quint64 mNextOrder;
     PrioritizerStrategyPtr mPrioritizer;
 
 };
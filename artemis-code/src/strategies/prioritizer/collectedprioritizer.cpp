@@ -35,6 +35,17 @@ double CollectedPrioritizer::prioritize(QSharedPointer<const ExecutableConfigura
     return priority;
 }
 
+bool CollectedPrioritizer::collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs)
+{
+    // Every strategy is asked, such that their change tracking is reset even if one of them requires a full rescore
+    bool incremental = true;
+    list<PrioritizerStrategy*>::iterator iter;
+    for(iter = strategies->begin(); iter != strategies->end(); iter++){
+        incremental = (*iter)->collectChangedInputs(appmodel, changedInputs) && incremental;
+    }
+    return incremental;
+}
+
 void CollectedPrioritizer::addPrioritizer(PrioritizerStrategy* strategy){
     strategies->push_front(strategy);
 }
@@ -12,6 +12,7 @@ public:
     CollectedPrioritizer();
     double prioritize(QSharedPointer<const ExecutableConfiguration> newConf,
                       AppModelConstPtr);
+    bool collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs);
     void addPrioritizer(PrioritizerStrategy* strategy);
 private:
     list<PrioritizerStrategy*>* strategies;
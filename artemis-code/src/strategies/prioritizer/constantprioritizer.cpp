@@ -29,4 +29,9 @@ double ConstantPrioritizer::prioritize(QSharedPointer<const ExecutableConfigurat
     return 1;
 }
 
+bool ConstantPrioritizer::collectChangedInputs(AppModelConstPtr, QSet<uint>*)
+{
+    return true;
+}
+
 }
@@ -30,6 +30,7 @@ public:
     ConstantPrioritizer();
     double prioritize(QSharedPointer<const ExecutableConfiguration> newConf,
                       AppModelConstPtr);
+    bool collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs);
 };
 
 typedef QSharedPointer<ConstantPrioritizer> ConstantPrioritizerPtr;
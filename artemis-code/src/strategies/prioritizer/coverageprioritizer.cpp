@@ -40,4 +40,9 @@ double CoveragePrioritizer::prioritize(ExecutableConfigurationConstPtr configura
     return 1 - coverage;
 }
 
+bool CoveragePrioritizer::collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs)
+{
+    return appmodel->getCoverageListener()->takeChangedInputs(changedInputs);
+}
+
 }
@@ -28,6 +28,7 @@ public:
     CoveragePrioritizer();
 
     double prioritize(QSharedPointer<const ExecutableConfiguration> newConf, AppModelConstPtr);
+    bool collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs);
 
 };
 
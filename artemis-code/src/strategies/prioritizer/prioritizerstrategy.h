@@ -18,6 +18,7 @@
 #define ABSTRACTPRIORITIZER_H
 
 #include <QSharedPointer>
+#include <QSet>
 
 #include "runtime/browser/executionresult.h"
 #include "runtime/worklist/worklist.h"
@@ -34,6 +35,17 @@ public:
 
     virtual double prioritize(QSharedPointer<const ExecutableConfiguration> newConf,
                               AppModelConstPtr appmodel) = 0;
+
+    /**
+     * Add the hash codes of the inputs whose contribution to the priority may have changed since the last call.
+     * Configurations not containing any of these inputs keep their priority when the worklist is reprioritized.
+     *
+     * Returns false if the priority of any configuration may have changed, which is the default.
+     */
+    virtual bool collectChangedInputs(AppModelConstPtr, QSet<uint>*)
+    {
+        return false;
+    }
 };
 
 typedef QSharedPointer<PrioritizerStrategy> PrioritizerStrategyPtr;
@@ -19,6 +19,7 @@
 #include <QSharedPointer>
 #include <QList>
 #include <QString>
+#include <QBitArray>
 
 #include "readwriteprioritizer.h"
 
@@ -40,14 +41,20 @@ double ReadWritePrioritizer::prioritize(QSharedPointer<const ExecutableConfigura
     QSharedPointer<const BaseInput> last = inputSequence.last();
     inputSequence.removeLast();
 
-    QSet<QString> propertiesReadByLast = appmodel->getJavascriptStatistics()->getPropertiesRead(last);
-    QSet<QString> properitesWrittenBeforeLast;
+    QBitArray propertiesReadByLast = appmodel->getJavascriptStatistics()->getPropertiesRead(last);
+    QBitArray properitesWrittenBeforeLast;
 
     foreach(QSharedPointer<const BaseInput> input, inputSequence) {
-        properitesWrittenBeforeLast.unite(appmodel->getJavascriptStatistics()->getPropertiesWritten(input));
+        properitesWrittenBeforeLast |= appmodel->getJavascriptStatistics()->getPropertiesWritten(input);
     }
 
-    return float(properitesWrittenBeforeLast.intersect(propertiesReadByLast).size() + 1) / float(propertiesReadByLast.size() + 1);
+    return float((properitesWrittenBeforeLast & propertiesReadByLast).count(true) + 1) / float(propertiesReadByLast.count(true) + 1);
+}
+
+bool ReadWritePrioritizer::collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs)
+{
+    changedInputs->unite(appmodel->getJavascriptStatistics()->takeChangedInputs());
+    return true;
 }
 
 }
@@ -29,6 +29,7 @@ public:
 
     double prioritize(QSharedPointer<const ExecutableConfiguration> newConf,
                       AppModelConstPtr);
+    bool collectChangedInputs(AppModelConstPtr appmodel, QSet<uint>* changedInputs);
 };
 
 }
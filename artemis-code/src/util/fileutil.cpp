@@ -17,6 +17,7 @@
 #include "fileutil.h"
 #include <QFile>
 #include <QDir>
+#include <QFileInfo>
 #include <QTextStream>
 
 namespace artemis
@@ -41,6 +42,21 @@ void createDir(QString path, QString folderName)
     QDir().mkdir(path + "/" + folderName);
 }
 
+void removeDir(QString path)
+{
+    QDir dir(path);
+
+    foreach (QFileInfo entry, dir.entryInfoList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot)) {
+        if (entry.isDir() && !entry.isSymLink()) {
+            removeDir(entry.filePath());
+        } else {
+            QFile::remove(entry.filePath());
+        }
+    }
+
+    QDir().rmdir(path);
+}
+
 QString readFile(QString fileS)
 {
     QFile f(fileS);
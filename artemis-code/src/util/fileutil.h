@@ -26,6 +26,7 @@ namespace artemis
 void writeStringToFile(QString filename, QString data);
 
 void createDir(QString path, QString folderName);
+void removeDir(QString path);
 QString readFile(QFile& f);
 
 }
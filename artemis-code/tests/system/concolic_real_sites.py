@@ -253,6 +253,7 @@ def test_generator(site_name, site_url, site_ep, dry_run, logger, version, test_
                                      #concolic_selection_procedure='avoid-unsat',
                                      #concolic_selection_budget='50',
                                      concolic_event_handler_report=True,
+                                     concolic_constraint_dir='/tmp',
                                      extra_args=extra_args)
             end_time = time.time()
             
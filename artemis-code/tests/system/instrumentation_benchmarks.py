@@ -0,0 +1,77 @@
+#!/usr/bin/env python
+
+"""
+Compares the running time of Artemis on the legacy benchmarks with all interpreter instrumentation enabled and with
+only the instrumentation which is always on (no bytecode coverage, constant strings or property accesses).
+
+Both runs use the same strategies, such that only the instrumentation differs.
+"""
+
+WEBSERVER_PORT = 8001
+WEBSERVER_ROOT = './fixtures/legacy-benchmarks/'
+WEBSERVER_URL = 'http://localhost:%s' % WEBSERVER_PORT
+
+import time
+from harness.environment import WebServer
+from harness.artemis import execute_artemis
+from benchmarks_results import run_lambda, log_result_to_file
+
+ITERATIONS = 100
+
+
+STRATEGY_FORM_INPUT = 'random'
+STRATEGY_PRIORITY = 'constant'
+
+
+def full_instrumentation_report(name, url):
+    return execute_artemis(name, url,
+                           iterations=ITERATIONS,
+                           strategy_form_input=STRATEGY_FORM_INPUT,
+                           strategy_priority=STRATEGY_PRIORITY,
+                           bytecode_coverage='true',
+                           constant_string_instrumentation='true',
+                           property_access_instrumentation='true')
+
+
+def minimal_instrumentation_report(name, url):
+    return execute_artemis(name, url,
+                           iterations=ITERATIONS,
+                           strategy_form_input=STRATEGY_FORM_INPUT,
+                           strategy_priority=STRATEGY_PRIORITY,
+                           bytecode_coverage='false',
+                           constant_string_instrumentation='false',
+                           property_access_instrumentation='false')
+
+
+def run_instrumentation_benchmarks(benchmarks):
+    file_name = 'instrumentation_results-%s.csv' % int(time.time())
+    with open(file_name, 'w') as fp:
+        fp.write("Benchmark,Time: full,Tries: full,Time: minimal,Tries: minimal,Overhead\n")
+
+    for benchmark in benchmarks:
+        name = benchmark['name']
+        url = WEBSERVER_URL + "/" + benchmark['path']
+
+        print("Starting testing: %s" % name)
+        full = run_lambda(lambda: full_instrumentation_report(name, url))
+        minimal = run_lambda(lambda: minimal_instrumentation_report(name, url))
+
+        overhead = full['time'] / minimal['time'] if full['time'] > 0 and minimal['time'] > 0 else -1
+
+        log_result_to_file(file_name, [name, full['time'], full['attempts'], minimal['time'], minimal['attempts'],
+                                       overhead])
+
+
+if __name__ == '__main__':
+    server = WebServer(WEBSERVER_ROOT, WEBSERVER_PORT)
+    benchmarks = [
+        {"name": "3dmodel", "path": "3dmodel/index.html"},
+        {"name": "ball-pool", "path": "ball_pool/index.html"},
+        {"name": "dragable-boxes", "path": "dragable-boxes/dragable-boxes.html"},
+        {"name": "fractal-viewer", "path": "fractal_viewer/index.html"},
+        {"name": "homeostasis", "path": "homeostasis/index.html"},
+        {"name": "pacman", "path": "pacman/index.html"},
+        {"name": "htmledit", "path": "htmledit/demo_full.html"},
+    ]
+    run_instrumentation_benchmarks(benchmarks)
+    del server
@@ -40,6 +40,15 @@ class TimerTests(unittest.TestCase):
         self.assertEqual(2, report.get('InputGenerator::added-configurations', 0))
         self.assertEqual(1, report.get('timers::fired', 0))
 
+    def test_virtual_time(self):
+        report = execute_artemis('timer-virtual-time', '%s/timers/timer.html' % FIXTURE_ROOT,
+            virtual_time='auto',
+            virtual_time_horizon=5000)
+
+        # The 1000ms interval fires at 1000, 2000, ..., 5000 without waiting for the wall clock
+        self.assertEqual(5, report.get('WebKit::virtualtime::timers-fired', 0))
+        self.assertEqual(5000, report.get('WebKit::virtualtime::skipped-ms', 0))
+
 class InputGeneratorStrategies(unittest.TestCase):
 
     def test_form_input_constant(self):
@@ -0,0 +1,270 @@
+#include "include/gtest/gtest.h"
+
+#include <list>
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/executiontreecheckpoint.h"
+#include "concolic/solver/expressionprinter.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static QString checkpointPath()
+{
+    return QDir::temp().filePath(QString("artemis-checkpointtest-%1").arg(QCoreApplication::applicationPid()));
+}
+
+static TraceSymbolicBranchPtr makeBranch(Symbolic::Expression* condition, TraceNodePtr falseBranch)
+{
+    TraceSymbolicBranchPtr branch = TraceSymbolicBranchPtr(new TraceSymbolicBranch(condition, 0, NULL, 0));
+    branch->setFalseBranch(falseBranch);
+    return branch;
+}
+
+/*
+ * The branch conditions of the test tree. Between them they use every expression type known to
+ * ExpressionSerialiser, and they share their symbolic inputs.
+ */
+static QList<Symbolic::Expression*> makeConditions()
+{
+    using namespace Symbolic;
+
+    SymbolicString* text = SymbolicString::create(SymbolicSource(TEXT, INPUT_NAME, "text"));
+    SymbolicInteger* index = SymbolicInteger::create(SymbolicSource(SELECT_INDEX, ELEMENT_ID, "index"));
+    SymbolicBoolean* checked = SymbolicBoolean::create(SymbolicSource(CHECKBOX, ELEMENT_ID, "checked"));
+    SymbolicObject* target = SymbolicObject::create(SymbolicSource(EVENT_TARGET, EVENT_TARGET_IDENT, "target"));
+
+    QList<Expression*> conditions;
+
+    // Integers
+    std::list<Expression*> maxOf;
+    maxOf.push_back(index);
+    maxOf.push_back(ConstantInteger::create(3));
+    conditions.append(IntegerBinaryOperation::create(IntegerMaxMin::create(maxOf, true), INT_LT,
+                                                     IntegerCoercion::create(text)));
+
+    // Strings
+    conditions.append(StringBinaryOperation::create(
+                          StringBinaryOperation::create(text, CONCAT, StringCoercion::create(index)),
+                          STRING_EQ,
+                          StringReplace::create(StringRegexReplace::create(StringSubstring::create(text, 0, 2), "[0-9]+", "x"),
+                                                "a", "b")));
+
+    conditions.append(IntegerBinaryOperation::create(StringLength::create(StringCharAt::create(text, 1)), INT_EQ,
+                                                     StringIndexOf::create(text, ConstantString::create("@"),
+                                                                           ConstantInteger::create(0))));
+
+    // Regular expressions
+    StringRegexSubmatchArray* submatches = StringRegexSubmatchArray::create(1, text, "(a)(b)");
+
+    conditions.append(BooleanBinaryOperation::create(
+                          StringRegexSubmatch::create(text, "^a+$"),
+                          BOOL_EQ,
+                          BooleanCoercion::create(StringBinaryOperation::create(StringRegexSubmatchArrayAt::create(submatches, 1),
+                                                                                STRING_EQ, ConstantString::create("a")))));
+
+    conditions.append(BooleanBinaryOperation::create(
+                          BooleanCoercion::create(IntegerBinaryOperation::create(StringRegexSubmatchIndex::create(text, "b"),
+                                                                                 INT_GEQ, ConstantInteger::create(0))),
+                          BOOL_NEQ,
+                          ObjectBinaryOperation::create(StringRegexSubmatchArrayMatch::create(submatches), OBJ_NEQ,
+                                                        ConstantObject::create(0))));
+
+    // Booleans
+    conditions.append(BooleanBinaryOperation::create(checked, BOOL_SEQ, ConstantBoolean::create(true)));
+
+    // Objects
+    std::list<Expression*> candidates;
+    candidates.push_back(ConstantObject::create(1));
+    candidates.push_back(target);
+    conditions.append(BooleanBinaryOperation::create(
+                          ObjectBinaryOperation::create(target, OBJ_EQ, ConstantObject::create(1)),
+                          BOOL_EQ,
+                          BooleanCoercion::create(IntegerBinaryOperation::create(ObjectArrayIndexOf::create(candidates, target),
+                                                                                 INT_GEQ, ConstantInteger::create(0)))));
+
+    conditions.append(StringBinaryOperation::create(SymbolicObjectPropertyString::create(target, "value"), STRING_NEQ,
+                                                    ConstantString::create("")));
+
+    return conditions;
+}
+
+/*
+ * Builds a chain of symbolic branches, one for each condition, which continue on their true branch. The false
+ * branches hold every other kind of node.
+ */
+static TraceNodePtr makeTree()
+{
+    QList<Symbolic::Expression*> conditions = makeConditions();
+    QList<TraceNodePtr> falseBranches;
+
+    QSharedPointer<TraceAlert> alert = QSharedPointer<TraceAlert>(new TraceAlert());
+    alert->message = "alert";
+    alert->next = TraceNodePtr(new TraceEndFailure());
+    falseBranches.append(alert);
+
+    QSharedPointer<TraceDomModification> modification = QSharedPointer<TraceDomModification>(new TraceDomModification());
+    modification->amountModified = 0.5;
+    modification->words.insert(0, 2);
+    modification->next = TraceNodePtr(new TraceEndSuccess());
+    falseBranches.append(modification);
+
+    QSharedPointer<TracePageLoad> pageLoad = QSharedPointer<TracePageLoad>(new TracePageLoad());
+    pageLoad->url = QUrl("http://localhost/next.html");
+    pageLoad->next = TraceNodePtr(new TraceEndUnknown());
+    falseBranches.append(pageLoad);
+
+    TraceMarkerPtr marker = TraceMarkerPtr(new TraceMarker());
+    marker->label = "click";
+    marker->index = "1";
+    marker->isSelectRestriction = false;
+    marker->next = TraceUnexploredUnsat::getInstance();
+    falseBranches.append(marker);
+
+    QSharedPointer<TraceFunctionCall> call = QSharedPointer<TraceFunctionCall>(new TraceFunctionCall());
+    call->name = "validate";
+    call->next = TraceUnexploredUnsolvable::getInstance();
+    falseBranches.append(call);
+
+    TraceConcreteSummarisationPtr summary = TraceConcreteSummarisationPtr(new TraceConcreteSummarisation());
+    TraceConcreteSummarisation::SingleExecution execution;
+    execution.first.append(TraceConcreteSummarisation::BRANCH_TRUE);
+    execution.first.append(TraceConcreteSummarisation::FUNCTION_CALL);
+    execution.second = TraceUnexploredMissed::getInstance();
+    summary->executions.append(execution);
+    falseBranches.append(summary);
+
+    TraceBranchPtr concreteBranch = TraceBranchPtr(new TraceConcreteBranch(0, NULL, 0));
+    concreteBranch->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+    falseBranches.append(concreteBranch);
+
+    falseBranches.append(TraceUnexploredQueued::getInstance());
+
+    TraceNodePtr tree = TraceNodePtr(new TraceEndSuccess());
+    for (int i = conditions.size() - 1; i >= 0; i--) {
+        TraceSymbolicBranchPtr branch = makeBranch(conditions.at(i), falseBranches.at(i));
+        branch->setTrueBranch(tree);
+        tree = branch;
+    }
+
+    return tree;
+}
+
+// Describes the tree in pre-order, one line per node, with the printed conditions of the symbolic branches.
+static void describe(TraceNodePtr node, QStringList* lines)
+{
+    TraceNode::Kind kind = node->getKind();
+
+    // Queued nodes are saved as unexplored.
+    if (kind == TraceNode::UNEXPLORED_QUEUED) {
+        kind = TraceNode::UNEXPLORED;
+    }
+
+    QString line = QString::number(kind);
+
+    if (kind == TraceNode::SYMBOLIC_BRANCH) {
+        ExpressionPrinter printer;
+        node.dynamicCast<TraceSymbolicBranch>()->getSymbolicCondition()->accept(&printer);
+        line += " " + QString::fromStdString(printer.getResult());
+    } else if (kind == TraceNode::ALERT) {
+        line += " " + node.dynamicCast<TraceAlert>()->message;
+    } else if (kind == TraceNode::DOM_MODIFICATION) {
+        QSharedPointer<TraceDomModification> modification = node.dynamicCast<TraceDomModification>();
+        line += QString(" %1 %2").arg(modification->amountModified).arg(modification->words.value(0));
+    } else if (kind == TraceNode::PAGE_LOAD) {
+        line += " " + node.dynamicCast<TracePageLoad>()->url.toString();
+    } else if (kind == TraceNode::MARKER) {
+        line += " " + node.dynamicCast<TraceMarker>()->label + " " + node.dynamicCast<TraceMarker>()->index;
+    } else if (kind == TraceNode::FUNCTION_CALL) {
+        line += " " + node.dynamicCast<TraceFunctionCall>()->name;
+    }
+
+    lines->append(line);
+
+    if (node->isBranch()) {
+        describe(node.dynamicCast<TraceBranch>()->getFalseBranch(), lines);
+        describe(node.dynamicCast<TraceBranch>()->getTrueBranch(), lines);
+    } else if (node->isAnnotation()) {
+        describe(node.dynamicCast<TraceAnnotation>()->next, lines);
+    } else if (kind == TraceNode::CONCRETE_SUMMARISATION) {
+        foreach (TraceConcreteSummarisation::SingleExecution execution, node.dynamicCast<TraceConcreteSummarisation>()->executions) {
+            QStringList events;
+            foreach (TraceConcreteSummarisation::EventType event, execution.first) {
+                events.append(QString::number(event));
+            }
+            lines->append(events.join(","));
+            describe(execution.second, lines);
+        }
+    }
+}
+
+static std::string describe(TraceNodePtr tree)
+{
+    QStringList lines;
+    describe(tree, &lines);
+    return lines.join("\n").toStdString();
+}
+
+static ConcolicSessionState makeState()
+{
+    ConcolicSessionState state;
+    state.url = "http://localhost/index.html";
+    state.iterations = 12;
+    state.explorationIndex = 7;
+    state.searchBudgetUsed = 5;
+    state.dfsDepthLimit = 3;
+    state.tree = makeTree();
+    return state;
+}
+
+TEST(ExecutionTreeCheckpointTest, RoundTrip)
+{
+    QString path = checkpointPath();
+    ConcolicSessionState saved = makeState();
+
+    ASSERT_TRUE(ExecutionTreeCheckpoint::save(path, saved));
+
+    ConcolicSessionState loaded;
+    bool success = ExecutionTreeCheckpoint::load(path, &loaded);
+    QFile::remove(path);
+
+    ASSERT_TRUE(success);
+    ASSERT_EQ(saved.url.toStdString(), loaded.url.toStdString());
+    ASSERT_EQ(saved.iterations, loaded.iterations);
+    ASSERT_EQ(saved.explorationIndex, loaded.explorationIndex);
+    ASSERT_EQ(saved.searchBudgetUsed, loaded.searchBudgetUsed);
+    ASSERT_EQ(saved.dfsDepthLimit, loaded.dfsDepthLimit);
+    ASSERT_EQ(describe(saved.tree), describe(loaded.tree));
+}
+
+TEST(ExecutionTreeCheckpointTest, TruncatedFile)
+{
+    QString path = checkpointPath();
+
+    ASSERT_TRUE(ExecutionTreeCheckpoint::save(path, makeState()));
+
+    qint64 size = QFile(path).size();
+    ASSERT_GT(size, 8);
+
+    // Cut inside the header, inside the tables and just before the end of the tree.
+    QList<qint64> lengths;
+    lengths << 4 << size / 2 << size - 1;
+
+    foreach (qint64 length, lengths) {
+        ASSERT_TRUE(QFile::resize(path, length));
+
+        ConcolicSessionState loaded;
+        EXPECT_FALSE(ExecutionTreeCheckpoint::load(path, &loaded)) << "truncated to " << length << " bytes";
+    }
+
+    QFile::remove(path);
+}
+
+}
@@ -0,0 +1,101 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/executiontree/tracemerger.h"
+#include "concolic/executiontree/treemanager.h"
+#include "concolic/search/searchdfs.h"
+#include "concolic/search/randomaccesssearch.h"
+#include "concolic/search/dfsselector.h"
+#include "concolic/pathcondition.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+// Deep enough that any walk over the tree which recurses once per node overflows the stack.
+static const uint DEEP_TRACE_DEPTH = 100000;
+
+static TraceSymbolicBranchPtr makeBranch()
+{
+    Symbolic::SymbolicSource source(Symbolic::UNKNOWN, Symbolic::INPUT_NAME, "deep");
+    return TraceSymbolicBranchPtr(new TraceSymbolicBranch(Symbolic::SymbolicBoolean::create(source), 0, NULL, 0));
+}
+
+/*
+ * Builds a chain of symbolic branches which all take the true branch, except the last one which takes the given
+ * direction. If exploreFalse is set, every other false branch leads to an explored end node instead of being left
+ * unexplored.
+ */
+static TraceNodePtr buildDeepTrace(bool lastDirection, bool exploreFalse)
+{
+    TraceSymbolicBranchPtr root = makeBranch();
+    TraceSymbolicBranchPtr branch = root;
+
+    for (uint depth = 1; depth < DEEP_TRACE_DEPTH; depth++) {
+        TraceSymbolicBranchPtr next = makeBranch();
+        branch->setTrueBranch(next);
+        if (exploreFalse) {
+            branch->setFalseBranch(TraceNodePtr(new TraceEndSuccess()));
+        }
+        branch = next;
+    }
+
+    if (lastDirection) {
+        branch->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+    } else {
+        branch->setFalseBranch(TraceNodePtr(new TraceEndSuccess()));
+    }
+
+    return root;
+}
+
+static TraceBranchPtr lastBranch(TraceNodePtr tree)
+{
+    TraceBranchPtr branch = tree.dynamicCast<TraceBranch>();
+    while (branch->getTrueBranch()->isBranch()) {
+        branch = branch->getTrueBranch().dynamicCast<TraceBranch>();
+    }
+    return branch;
+}
+
+TEST(DeepTraceTest, MergeDeepTrace)
+{
+    TraceNodePtr tree = buildDeepTrace(true, false);
+    TraceNodePtr trace = buildDeepTrace(false, false);
+
+    TraceMerger merger;
+    tree = merger.merge(trace, tree);
+
+    TraceBranchPtr bottom = lastBranch(tree);
+    ASSERT_TRUE(bottom->getTrueBranch()->isEnd());
+    ASSERT_TRUE(bottom->getFalseBranch()->isEnd());
+
+    ASSERT_EQ(DEEP_TRACE_DEPTH, PathCondition::createFromTrace(trace)->size());
+}
+
+TEST(DeepTraceTest, DepthFirstSearchDeepTree)
+{
+    TraceNodePtr tree = buildDeepTrace(true, true);
+
+    DepthFirstSearch search(tree, TreeManagerPtr(new TreeManager()), DEEP_TRACE_DEPTH + 1, 1);
+
+    ASSERT_TRUE(search.chooseNextTarget());
+    ASSERT_EQ(lastBranch(tree), search.getTargetDescriptor().branch);
+    ASSERT_FALSE(search.getTargetDescriptor().branchDirection);
+    ASSERT_EQ(DEEP_TRACE_DEPTH, search.getTargetPC()->size());
+}
+
+TEST(DeepTraceTest, RandomAccessSearchDeepTree)
+{
+    TraceNodePtr tree = buildDeepTrace(true, true);
+
+    RandomAccessSearch search(tree, TreeManagerPtr(new TreeManager()), AbstractSelectorPtr(new DFSSelector()), 0);
+
+    ASSERT_TRUE(search.chooseNextTarget());
+    ASSERT_EQ(lastBranch(tree), search.getTargetDescriptor().branch);
+    ASSERT_FALSE(search.getTargetDescriptor().branchDirection);
+    ASSERT_EQ(DEEP_TRACE_DEPTH, search.getTargetPC()->size());
+}
+
+}
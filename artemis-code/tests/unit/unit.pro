@@ -31,4 +31,6 @@ SOURCES += \
     src/gmock/gmock-all.cc \
     src/strategies/inputgenerator/form/constantstringforminputgeneratortest.cpp \
     src/concolic/solver/cvc4regextest.cpp \
-    src/concolic/solver/cvc4solvertest.cpp
+    src/concolic/solver/cvc4solvertest.cpp \
+    src/concolic/executiontree/deeptracetest.cpp \
+    src/concolic/executiontree/checkpointtest.cpp
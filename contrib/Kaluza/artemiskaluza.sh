@@ -6,8 +6,9 @@
 
 # Modified for Artemis!
 
-INPUT=/tmp/kaluza
-OUTPUT=/tmp/kaluza-result
+# The input and output files can be given as arguments, such that concurrent Artemis processes do not share them.
+INPUT=${1:-/tmp/kaluza}
+OUTPUT=${2:-/tmp/kaluza-result}
 
 if [ -z "${ARTEMISDIR+xxx}" ]; 
 then 
@@ -39,7 +40,7 @@ if [ ! -e "$HAMPIPATH"/hampi.sh ];then
     exit 1;
 fi
 
-if ./ksolver < /tmp/kaluza ;then
+if ./ksolver < "$INPUT" ;then
     if ./solveselects.sh corecstrs.tmp > stdout 2>stderr ;then
         
         if [ ! -e 'corecstrs.tmp.length.ys.out' ];then
@@ -62,7 +63,7 @@ if ./ksolver < /tmp/kaluza ;then
             exit 1
         fi
         
-        cat corecstrs.tmp.length.ys.out | grep -vi 'COPY' | grep -vi "^sat$" | awk '{print $2, substr($3, 1, index($3, ")") - 1)}' > $OUTPUT # ignore lines containing COPY
+        cat corecstrs.tmp.length.ys.out | grep -vi 'COPY' | grep -vi "^sat$" | awk '{print $2, substr($3, 1, index($3, ")") - 1)}' > "$OUTPUT" # ignore lines containing COPY
         
         #./convert.pl < corecstrs.tmp.final.stp.out | grep -vi COPY >> $OUTPUT
         